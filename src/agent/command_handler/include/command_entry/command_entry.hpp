@@ -2,6 +2,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <string>
 
 namespace module_command
@@ -102,6 +103,9 @@ namespace module_command
         /// @brief Time of the command execution
         double Time;
 
+        /// @brief Time the agent received the command, unset for commands not coming from the manager
+        std::chrono::system_clock::time_point ReceivedTime {};
+
         /// @brief Execution mode (sync or async) of the command.
         CommandExecutionMode ExecutionMode;
 
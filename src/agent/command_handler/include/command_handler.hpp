@@ -4,13 +4,18 @@
 #include <configuration_parser.hpp>
 #include <icommand_handler.hpp>
 #include <icommand_store.hpp>
+#include <latency_histogram.hpp>
 
 #include <boost/asio/awaitable.hpp>
+#include <boost/asio/experimental/concurrent_channel.hpp>
+
+#include <nlohmann/json.hpp>
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
-#include <optional>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -35,15 +40,23 @@ namespace command_handler
 
         /// @copydoc ICommandHandler::CommandsProcessingTask
         boost::asio::awaitable<void>
-        CommandsProcessingTask(const std::function<std::optional<module_command::CommandEntry>()> getCommandFromQueue,
-                               const std::function<void()> popCommandFromQueue,
+        CommandsProcessingTask(const std::function<std::vector<module_command::CommandEntry>()> getCommandsFromQueue,
+                               const std::function<void(size_t)> popCommandsFromQueue,
                                const std::function<void(module_command::CommandEntry&)> reportCommandResult,
                                const std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(
                                    module_command::CommandEntry&)> dispatchCommand) override;
 
+        /// @copydoc ICommandHandler::NotifyCommandsQueued
+        void NotifyCommandsQueued() override;
+
         /// @copydoc ICommandHandler::Stop
         void Stop() override;
 
+        /// @brief Returns the latency histograms of the commands dispatched
+        /// @return JSON object with the "queue" (received to dispatched) and "execution" (dispatched to result
+        /// reported) histograms
+        nlohmann::json GetLatencyHistograms() const;
+
     private:
         /// @brief Clean up commands that are in progress when the agent is stopped
         ///
@@ -66,10 +79,43 @@ namespace command_handler
         /// @return True if the command is valid, false otherwise
         bool CheckCommand(module_command::CommandEntry& cmd);
 
+        /// @brief Dispatches a command, updates it in the command store and records its latencies
+        ///
+        /// @param cmd The command to execute
+        /// @param dispatchCommand The function to dispatch the command
+        boost::asio::awaitable<void>
+        ExecuteCommand(module_command::CommandEntry cmd,
+                       std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(
+                           module_command::CommandEntry&)> dispatchCommand);
+
+        /// @brief Waits until commands are queued, an asynchronous command finishes or the handler is stopped
+        boost::asio::awaitable<void> WaitForCommands();
+
+        /// @brief Channel signaled to wake up the processing task, a pending signal absorbs the following ones
+        using CommandsSignal = boost::asio::experimental::concurrent_channel<void(boost::system::error_code)>;
+
         /// @brief Indicates whether the command handler is running or not
         std::atomic<bool> m_keepRunning = true;
 
         /// @brief Unique pointer to the command store
         std::unique_ptr<command_store::ICommandStore> m_commandStore;
+
+        /// @brief Signal of the running processing task, created with its executor
+        std::shared_ptr<CommandsSignal> m_commandsSignal;
+
+        /// @brief Mutex protecting m_commandsSignal
+        std::mutex m_commandsSignalMutex;
+
+        /// @brief Maximum number of asynchronous commands executed concurrently
+        size_t m_maxAsyncCommands;
+
+        /// @brief Number of asynchronous commands being executed
+        std::atomic<size_t> m_asyncCommands = 0;
+
+        /// @brief Time from the command reception to its dispatch
+        LatencyHistogram m_queueLatency;
+
+        /// @brief Time from the command dispatch to its result being reported
+        LatencyHistogram m_executionLatency;
     };
 } // namespace command_handler
@@ -5,7 +5,7 @@
 #include <boost/asio/awaitable.hpp>
 
 #include <functional>
-#include <optional>
+#include <vector>
 
 namespace command_handler
 {
@@ -17,20 +17,23 @@ namespace command_handler
 
         /// @brief Processes commands asynchronously
         ///
-        /// This task retrieves commands from the queue and dispatches them for execution.
-        /// If no command is available, it waits for a specified duration before retrying.
+        /// This task retrieves batches of commands from the queue and dispatches them for execution.
+        /// If no command is available, it waits until NotifyCommandsQueued is called.
         ///
-        /// @param getCommandFromQueue Function to retrieve a command from the queue
-        /// @param popCommandFromQueue Function to remove a command from the queue
+        /// @param getCommandsFromQueue Function to retrieve the next commands from the queue, without removing them
+        /// @param popCommandsFromQueue Function to remove a number of commands from the queue
         /// @param reportCommandResult Function to report a command result
         /// @param dispatchCommand Function to dispatch the command for execution
         virtual boost::asio::awaitable<void>
-        CommandsProcessingTask(const std::function<std::optional<module_command::CommandEntry>()> getCommandFromQueue,
-                               const std::function<void()> popCommandFromQueue,
+        CommandsProcessingTask(const std::function<std::vector<module_command::CommandEntry>()> getCommandsFromQueue,
+                               const std::function<void(size_t)> popCommandsFromQueue,
                                const std::function<void(module_command::CommandEntry&)> reportCommandResult,
                                const std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(
                                    module_command::CommandEntry&)> dispatchCommand) = 0;
 
+        /// @brief Wakes up the processing task, to be called when commands are pushed to the queue
+        virtual void NotifyCommandsQueued() = 0;
+
         /// @brief Stops the command handler
         virtual void Stop() = 0;
     };
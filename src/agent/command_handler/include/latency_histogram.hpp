@@ -0,0 +1,77 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace command_handler
+{
+    /// @brief Thread-safe histogram of latencies over fixed buckets
+    class LatencyHistogram
+    {
+    public:
+        /// @brief Records a latency, negative ones (e.g. clock adjustments) are counted as zero
+        /// @param latency The latency to record
+        void Record(std::chrono::milliseconds latency)
+        {
+            const auto ms = static_cast<uint64_t>(std::max<std::chrono::milliseconds::rep>(latency.count(), 0));
+
+            size_t bucket = 0;
+
+            while (bucket < BUCKETS.size() && ms > BUCKETS[bucket].first)
+            {
+                ++bucket;
+            }
+
+            m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_sumMs.fetch_add(ms, std::memory_order_relaxed);
+        }
+
+        /// @brief Returns the histogram, each bucket counts the latencies less than or equal to its bound
+        /// @return JSON object like {"count": 3, "sum_ms": 120, "buckets": {"10ms": 1, ..., "+Inf": 3}}
+        nlohmann::json ToJson() const
+        {
+            nlohmann::json histogram;
+            histogram["count"] = m_count.load(std::memory_order_relaxed);
+            histogram["sum_ms"] = m_sumMs.load(std::memory_order_relaxed);
+
+            uint64_t cumulative = 0;
+
+            for (size_t bucket = 0; bucket < BUCKETS.size(); ++bucket)
+            {
+                cumulative += m_buckets[bucket].load(std::memory_order_relaxed);
+                histogram["buckets"][BUCKETS[bucket].second] = cumulative;
+            }
+
+            cumulative += m_buckets[BUCKETS.size()].load(std::memory_order_relaxed);
+            histogram["buckets"]["+Inf"] = cumulative;
+
+            return histogram;
+        }
+
+    private:
+        /// @brief Upper bounds of the buckets in milliseconds, and their names
+        static constexpr std::array<std::pair<uint64_t, const char*>, 7> BUCKETS = {{{10, "10ms"},
+                                                                                     {100, "100ms"},
+                                                                                     {1000, "1s"},
+                                                                                     {10000, "10s"},
+                                                                                     {60000, "1m"},
+                                                                                     {600000, "10m"},
+                                                                                     {3600000, "1h"}}};
+
+        /// @brief Latencies per bucket, the last one counts the latencies above all the bounds
+        std::array<std::atomic<uint64_t>, BUCKETS.size() + 1> m_buckets {};
+
+        /// @brief Number of latencies recorded
+        std::atomic<uint64_t> m_count {0};
+
+        /// @brief Sum of the latencies recorded
+        std::atomic<uint64_t> m_sumMs {0};
+    };
+} // namespace command_handler
@@ -42,6 +42,13 @@ namespace command_handler
         const auto dbFolderPath =
             configurationParser->GetConfigOrDefault(config::DEFAULT_DATA_PATH, "agent", "path.data");
 
+        m_maxAsyncCommands = configurationParser->GetConfigInRangeOrDefault<size_t>(
+            config::agent::DEFAULT_MAX_ASYNC_COMMANDS,
+            std::optional<size_t>(1),
+            std::optional<size_t> {},
+            "agent",
+            "max_async_commands");
+
         try
         {
             if (commandStore)
@@ -62,82 +69,156 @@ namespace command_handler
     CommandHandler::~CommandHandler() = default;
 
     boost::asio::awaitable<void> CommandHandler::CommandsProcessingTask(
-        const std::function<std::optional<module_command::CommandEntry>()>
-            getCommandFromQueue,                         // NOLINT(performance-unnecessary-value-param)
-        const std::function<void()> popCommandFromQueue, // NOLINT(performance-unnecessary-value-param)
+        const std::function<std::vector<module_command::CommandEntry>()>
+            getCommandsFromQueue,                               // NOLINT(performance-unnecessary-value-param)
+        const std::function<void(size_t)> popCommandsFromQueue, // NOLINT(performance-unnecessary-value-param)
         const std::function<void(module_command::CommandEntry&)>
             reportCommandResult, // NOLINT(performance-unnecessary-value-param)
         const std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(
             module_command::CommandEntry&)> dispatchCommand) // NOLINT(performance-unnecessary-value-param)
     {
-        using namespace std::chrono_literals;
         const auto executor = co_await boost::asio::this_coro::executor;
-        std::unique_ptr<boost::asio::steady_timer> expTimer = std::make_unique<boost::asio::steady_timer>(executor);
+
+        {
+            const std::lock_guard<std::mutex> lock(m_commandsSignalMutex);
+            m_commandsSignal = std::make_shared<CommandsSignal>(executor, 1);
+        }
 
         CleanUpInProgressCommands(reportCommandResult);
 
         while (m_keepRunning.load())
         {
-            auto cmd = getCommandFromQueue();
-            if (cmd == std::nullopt)
+            auto commands = getCommandsFromQueue();
+
+            if (commands.empty())
             {
-                expTimer->expires_after(1000ms);
-                co_await expTimer->async_wait(boost::asio::use_awaitable);
+                co_await WaitForCommands();
                 continue;
             }
 
-            LogDebug("Processing command: {}({})", cmd.value().Command, cmd.value().Parameters.dump());
+            std::vector<module_command::CommandEntry> storedCommands;
 
-            if (!CheckCommand(cmd.value()))
+            for (auto& cmd : commands)
             {
-                cmd.value().ExecutionResult.ErrorCode = module_command::Status::FAILURE;
-                cmd.value().ExecutionResult.Message = "Command is not valid";
-                LogError("Error checking module and args for command: {} {}. Error: {}",
-                         cmd.value().Id,
-                         cmd.value().Command,
-                         cmd.value().ExecutionResult.Message);
-                reportCommandResult(cmd.value());
-                popCommandFromQueue();
-                continue;
-            }
+                LogDebug("Processing command: {}({})", cmd.Command, cmd.Parameters.dump());
 
-            if (!m_commandStore->StoreCommand(cmd.value()))
-            {
-                cmd.value().ExecutionResult.ErrorCode = module_command::Status::FAILURE;
-                cmd.value().ExecutionResult.Message = "Agent's database failure";
-                LogError("Error storing command: {} {}. Error: {}",
-                         cmd.value().Id,
-                         cmd.value().Command,
-                         cmd.value().ExecutionResult.Message);
-                reportCommandResult(cmd.value());
-                popCommandFromQueue();
-                continue;
-            }
+                if (!CheckCommand(cmd))
+                {
+                    cmd.ExecutionResult.ErrorCode = module_command::Status::FAILURE;
+                    cmd.ExecutionResult.Message = "Command is not valid";
+                    LogError("Error checking module and args for command: {} {}. Error: {}",
+                             cmd.Id,
+                             cmd.Command,
+                             cmd.ExecutionResult.Message);
+                    reportCommandResult(cmd);
+                    continue;
+                }
 
-            popCommandFromQueue();
+                if (!m_commandStore->StoreCommand(cmd))
+                {
+                    cmd.ExecutionResult.ErrorCode = module_command::Status::FAILURE;
+                    cmd.ExecutionResult.Message = "Agent's database failure";
+                    LogError("Error storing command: {} {}. Error: {}",
+                             cmd.Id,
+                             cmd.Command,
+                             cmd.ExecutionResult.Message);
+                    reportCommandResult(cmd);
+                    continue;
+                }
 
-            if (cmd.value().ExecutionMode == module_command::CommandExecutionMode::SYNC)
-            {
-                cmd.value().ExecutionResult = co_await dispatchCommand(cmd.value());
-                m_commandStore->UpdateCommand(cmd.value());
-                LogInfo("Done processing command: {}({})", cmd.value().Command, cmd.value().Module);
+                storedCommands.push_back(std::move(cmd));
             }
-            else
+
+            // Stored commands interrupted by a stop are reported as failed on the next start
+            popCommandsFromQueue(commands.size());
+
+            for (auto& cmd : storedCommands)
             {
+                if (cmd.ExecutionMode == module_command::CommandExecutionMode::SYNC)
+                {
+                    co_await ExecuteCommand(std::move(cmd), dispatchCommand);
+                    continue;
+                }
+
+                while (m_keepRunning.load() && m_asyncCommands.load() >= m_maxAsyncCommands)
+                {
+                    co_await WaitForCommands();
+                }
+
+                if (!m_keepRunning.load())
+                {
+                    break;
+                }
+
+                ++m_asyncCommands;
+
                 // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
                 co_spawn(
                     executor,
-                    [cmd, dispatchCommand, this]() mutable -> boost::asio::awaitable<void>
+                    [cmd = std::move(cmd), dispatchCommand, this]() mutable -> boost::asio::awaitable<void>
                     {
-                        cmd.value().ExecutionResult = co_await dispatchCommand(cmd.value());
-                        m_commandStore->UpdateCommand(cmd.value());
-                        LogInfo("Done processing command: {}({})", cmd.value().Command, cmd.value().Module);
-                        co_return;
+                        co_await ExecuteCommand(std::move(cmd), dispatchCommand);
+                        --m_asyncCommands;
+                        NotifyCommandsQueued();
                     },
                     boost::asio::detached);
                 // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
             }
         }
+
+        const std::lock_guard<std::mutex> lock(m_commandsSignalMutex);
+        m_commandsSignal.reset();
+    }
+
+    boost::asio::awaitable<void> CommandHandler::ExecuteCommand(
+        module_command::CommandEntry cmd,
+        std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(module_command::CommandEntry&)>
+            dispatchCommand) // NOLINT(performance-unnecessary-value-param)
+    {
+        const auto dispatched = std::chrono::system_clock::now();
+
+        if (cmd.ReceivedTime != std::chrono::system_clock::time_point {})
+        {
+            m_queueLatency.Record(std::chrono::duration_cast<std::chrono::milliseconds>(dispatched - cmd.ReceivedTime));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        cmd.ExecutionResult = co_await dispatchCommand(cmd);
+        const auto executionTime =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        m_executionLatency.Record(executionTime);
+
+        m_commandStore->UpdateCommand(cmd);
+        LogInfo("Done processing command: {}({})", cmd.Command, cmd.Module);
+        LogDebug("Command {} executed in {} ms", cmd.Id, executionTime.count());
+    }
+
+    boost::asio::awaitable<void> CommandHandler::WaitForCommands()
+    {
+        std::shared_ptr<CommandsSignal> signal;
+
+        {
+            const std::lock_guard<std::mutex> lock(m_commandsSignalMutex);
+            signal = m_commandsSignal;
+        }
+
+        if (signal)
+        {
+            // The error is only set when the handler is stopped, which the caller checks
+            boost::system::error_code ec;
+            co_await signal->async_receive(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        }
+    }
+
+    void CommandHandler::NotifyCommandsQueued()
+    {
+        const std::lock_guard<std::mutex> lock(m_commandsSignalMutex);
+
+        if (m_commandsSignal)
+        {
+            // A full channel already holds a signal that wakes up the task
+            static_cast<void>(m_commandsSignal->try_send(boost::system::error_code {}));
+        }
     }
 
     void
@@ -207,5 +288,20 @@ namespace command_handler
     void CommandHandler::Stop()
     {
         m_keepRunning.store(false);
+
+        const std::lock_guard<std::mutex> lock(m_commandsSignalMutex);
+
+        if (m_commandsSignal)
+        {
+            m_commandsSignal->close();
+        }
+    }
+
+    nlohmann::json CommandHandler::GetLatencyHistograms() const
+    {
+        nlohmann::json histograms;
+        histograms["queue"] = m_queueLatency.ToJson();
+        histograms["execution"] = m_executionLatency.ToJson();
+        return histograms;
     }
 } // namespace command_handler
@@ -8,7 +8,9 @@
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
@@ -48,15 +50,15 @@ protected:
 
         m_mockCommandFunctions = std::make_unique<MockTestCommandsProcessingTaskFunctions>();
 
-        m_mockGetCommandFromQueue = [this]()
+        m_mockGetCommandsFromQueue = [this]()
         {
             m_commandHandler->Stop();
-            return m_mockCommandFunctions->GetCommandFromQueue();
+            return m_mockCommandFunctions->GetCommandsFromQueue();
         };
 
-        m_mockPopCommandFromQueue = [this]()
+        m_mockPopCommandsFromQueue = [this](size_t numCommands)
         {
-            m_mockCommandFunctions->PopCommandFromQueue();
+            m_mockCommandFunctions->PopCommandsFromQueue(numCommands);
         };
 
         m_mockReportCommandResult = [this](module_command::CommandEntry& cmd)
@@ -78,8 +80,10 @@ protected:
         boost::asio::io_context ioContext;
         boost::asio::co_spawn(
             ioContext,
-            m_commandHandler->CommandsProcessingTask(
-                m_mockGetCommandFromQueue, m_mockPopCommandFromQueue, m_mockReportCommandResult, m_mockDispatchCommand),
+            m_commandHandler->CommandsProcessingTask(m_mockGetCommandsFromQueue,
+                                                     m_mockPopCommandsFromQueue,
+                                                     m_mockReportCommandResult,
+                                                     m_mockDispatchCommand),
             boost::asio::detached);
         ioContext.run();
     }
@@ -96,8 +100,8 @@ protected:
     std::shared_ptr<configuration::ConfigurationParser> m_configurationParser;
     std::unique_ptr<command_handler::CommandHandler> m_commandHandler;
     std::unique_ptr<MockTestCommandsProcessingTaskFunctions> m_mockCommandFunctions;
-    std::function<std::optional<module_command::CommandEntry>()> m_mockGetCommandFromQueue;
-    std::function<void()> m_mockPopCommandFromQueue;
+    std::function<std::vector<module_command::CommandEntry>()> m_mockGetCommandsFromQueue;
+    std::function<void(size_t)> m_mockPopCommandsFromQueue;
     std::function<void(module_command::CommandEntry&)> m_mockReportCommandResult;
     std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(module_command::CommandEntry&)>
         m_mockDispatchCommand;
@@ -114,11 +118,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandSetGroupSuccess
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -139,11 +143,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandSetGroupSuccess
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -160,11 +164,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandFetchConfigSucc
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -184,11 +188,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandFetchConfigWith
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -205,11 +209,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandRestartSuccessf
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -229,11 +233,11 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesCommandRestartWithPara
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
 
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     ExpectDispatchCommandSuccess();
 
@@ -246,13 +250,14 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskNotCommand)
 {
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue())
+        .WillOnce(Return(std::vector<module_command::CommandEntry> {}));
 
     boost::asio::io_context ioContext;
     boost::asio::co_spawn(
         ioContext,
         m_commandHandler->CommandsProcessingTask(
-            m_mockGetCommandFromQueue, m_mockPopCommandFromQueue, m_mockReportCommandResult, m_mockDispatchCommand),
+            m_mockGetCommandsFromQueue, m_mockPopCommandsFromQueue, m_mockReportCommandResult, m_mockDispatchCommand),
         boost::asio::detached);
     ioContext.run();
 }
@@ -268,9 +273,9 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskCheckCommandInvalidCommand)
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
     EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(1);
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     RunCommandsProcessingTask();
 }
@@ -285,9 +290,9 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskCheckCommandSetGroupEmptyParame
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
     EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(1);
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     RunCommandsProcessingTask();
 }
@@ -303,9 +308,9 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskCheckCommandSetGroupArgNoArray)
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
     EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(1);
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     RunCommandsProcessingTask();
 }
@@ -321,12 +326,12 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskStoreCommandFail)
 
     EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(testCommand));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
 
     EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(false));
 
     EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(1);
-    EXPECT_CALL(*m_mockCommandFunctions, PopCommandFromQueue()).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
 
     RunCommandsProcessingTask();
 }
@@ -354,11 +359,110 @@ TEST_F(CommandHandlerTest, CommandsProcessingTaskCleanUpInProgressCommands)
     EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(2);
     EXPECT_CALL(*m_mockCommandStore, UpdateCommand(_)).Times(2);
 
-    EXPECT_CALL(*m_mockCommandFunctions, GetCommandFromQueue()).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue())
+        .WillOnce(Return(std::vector<module_command::CommandEntry> {}));
 
     RunCommandsProcessingTask();
 }
 
+TEST_F(CommandHandlerTest, CommandsProcessingTaskProcessesBatch)
+{
+    module_command::CommandEntry testCommand;
+    testCommand.Id = "command-id-1";
+    testCommand.Command = module_command::FETCH_CONFIG_COMMAND;
+
+    module_command::CommandEntry testCommand2;
+    testCommand2.Id = "command-id-2";
+    testCommand2.Command = "invalid";
+
+    module_command::CommandEntry testCommand3;
+    testCommand3.Id = "command-id-3";
+    testCommand3.Command = module_command::RESTART_COMMAND;
+
+    EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
+
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue())
+        .WillOnce(Return(std::vector {testCommand, testCommand2, testCommand3}));
+
+    EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockCommandFunctions, ReportCommandResult(_)).Times(1);
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(3)).Times(1);
+
+    EXPECT_CALL(*m_mockCommandFunctions, DispatchCommand(_))
+        .Times(2)
+        .WillRepeatedly(
+            [](module_command::CommandEntry&) -> boost::asio::awaitable<module_command::CommandExecutionResult>
+            { co_return module_command::CommandExecutionResult {module_command::Status::SUCCESS}; });
+
+    EXPECT_CALL(*m_mockCommandStore, UpdateCommand(_)).Times(2).WillRepeatedly(Return(true));
+
+    RunCommandsProcessingTask();
+}
+
+TEST_F(CommandHandlerTest, CommandsProcessingTaskWakesUpWhenCommandsAreQueued)
+{
+    module_command::CommandEntry testCommand;
+    testCommand.Id = "command-id-1";
+    testCommand.Command = module_command::FETCH_CONFIG_COMMAND;
+
+    boost::asio::io_context ioContext;
+    size_t calls = 0;
+
+    m_mockGetCommandsFromQueue = [this, &ioContext, &calls, &testCommand]()
+    {
+        if (++calls == 1)
+        {
+            boost::asio::post(ioContext, [this]() { m_commandHandler->NotifyCommandsQueued(); });
+            return std::vector<module_command::CommandEntry> {};
+        }
+
+        m_commandHandler->Stop();
+        return std::vector {testCommand};
+    };
+
+    EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
+    ExpectDispatchCommandSuccess();
+    EXPECT_CALL(*m_mockCommandStore, UpdateCommand(_)).WillOnce(Return(true));
+
+    boost::asio::co_spawn(
+        ioContext,
+        m_commandHandler->CommandsProcessingTask(
+            m_mockGetCommandsFromQueue, m_mockPopCommandsFromQueue, m_mockReportCommandResult, m_mockDispatchCommand),
+        boost::asio::detached);
+
+    // Without the notification the task would wait for commands until the timeout
+    ioContext.run_for(std::chrono::seconds(5));
+    EXPECT_TRUE(ioContext.stopped());
+    EXPECT_EQ(calls, 2u);
+}
+
+TEST_F(CommandHandlerTest, CommandsProcessingTaskRecordsLatencies)
+{
+    module_command::CommandEntry testCommand;
+    testCommand.Id = "command-id-1";
+    testCommand.Command = module_command::FETCH_CONFIG_COMMAND;
+    testCommand.ReceivedTime = std::chrono::system_clock::now() - std::chrono::seconds(2);
+
+    EXPECT_CALL(*m_mockCommandStore, GetCommandByStatus(_)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*m_mockCommandFunctions, GetCommandsFromQueue()).WillOnce(Return(std::vector {testCommand}));
+    EXPECT_CALL(*m_mockCommandStore, StoreCommand(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockCommandFunctions, PopCommandsFromQueue(1)).Times(1);
+    ExpectDispatchCommandSuccess();
+    EXPECT_CALL(*m_mockCommandStore, UpdateCommand(_)).WillOnce(Return(true));
+
+    RunCommandsProcessingTask();
+
+    const auto histograms = m_commandHandler->GetLatencyHistograms();
+    EXPECT_EQ(histograms["queue"]["count"], 1);
+    EXPECT_EQ(histograms["queue"]["buckets"]["1s"], 0);
+    EXPECT_EQ(histograms["queue"]["buckets"]["10s"], 1);
+    EXPECT_EQ(histograms["queue"]["buckets"]["+Inf"], 1);
+    EXPECT_EQ(histograms["execution"]["count"], 1);
+    EXPECT_EQ(histograms["execution"]["buckets"]["+Inf"], 1);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -8,7 +8,7 @@
 #include <boost/asio/awaitable.hpp>
 
 #include <functional>
-#include <optional>
+#include <vector>
 
 namespace command_handler
 {
@@ -17,13 +17,15 @@ namespace command_handler
     public:
         MOCK_METHOD(boost::asio::awaitable<void>,
                     CommandsProcessingTask,
-                    (const std::function<std::optional<module_command::CommandEntry>()>,
-                     const std::function<void()>,
+                    (const std::function<std::vector<module_command::CommandEntry>()>,
+                     const std::function<void(size_t)>,
                      const std::function<void(module_command::CommandEntry&)>,
                      const std::function<boost::asio::awaitable<module_command::CommandExecutionResult>(
                          module_command::CommandEntry&)>),
                     (override));
 
+        MOCK_METHOD(void, NotifyCommandsQueued, (), (override));
+
         MOCK_METHOD(void, Stop, (), (override));
     };
 } // namespace command_handler
@@ -9,7 +9,6 @@
 #include <boost/asio/io_context.hpp>
 
 #include <memory>
-#include <optional>
 #include <string>
 #include <vector>
 
@@ -18,8 +17,8 @@ class ITestCommandsProcessingTaskFunctions
 public:
     virtual ~ITestCommandsProcessingTaskFunctions() = default;
 
-    virtual std::optional<module_command::CommandEntry> GetCommandFromQueue() = 0;
-    virtual void PopCommandFromQueue() = 0;
+    virtual std::vector<module_command::CommandEntry> GetCommandsFromQueue() = 0;
+    virtual void PopCommandsFromQueue(size_t numCommands) = 0;
     virtual void ReportCommandResult(module_command::CommandEntry& cmd) = 0;
     virtual boost::asio::awaitable<module_command::CommandExecutionResult>
     DispatchCommand(module_command::CommandEntry& cmd) = 0;
@@ -28,8 +27,8 @@ public:
 class MockTestCommandsProcessingTaskFunctions : public ITestCommandsProcessingTaskFunctions
 {
 public:
-    MOCK_METHOD(std::optional<module_command::CommandEntry>, GetCommandFromQueue, (), (override));
-    MOCK_METHOD(void, PopCommandFromQueue, (), (override));
+    MOCK_METHOD(std::vector<module_command::CommandEntry>, GetCommandsFromQueue, (), (override));
+    MOCK_METHOD(void, PopCommandsFromQueue, (size_t), (override));
     MOCK_METHOD(void, ReportCommandResult, (module_command::CommandEntry&), (override));
     MOCK_METHOD(boost::asio::awaitable<module_command::CommandExecutionResult>,
                 DispatchCommand,
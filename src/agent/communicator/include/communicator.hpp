@@ -1,5 +1,6 @@
 #pragma once
 
+#include <body_compressor.hpp>
 #include <configuration_parser.hpp>
 #include <ihttp_client.hpp>
 
@@ -25,6 +26,11 @@ namespace communicator
     class Communicator
     {
     public:
+        /// @brief Function that gets a batch of messages of up to the given size, encoded with the given options.
+        /// Returns the number of messages in the batch and the request body
+        using MessageGetter = std::function<boost::asio::awaitable<std::tuple<int, std::string>>(
+            const size_t, const http_client::CompressionOptions)>;
+
         /// @brief Communicator constructor
         /// @tparam ConfigGetter Type of the configuration getter function
         /// @param httpClient The HTTP client to use for communication
@@ -55,18 +61,18 @@ namespace communicator
         GetCommandsFromManager(std::function<void(const int, const std::string&)> onSuccess);
 
         /// @brief Processes messages in a stateful manner
-        /// @param getMessages A function to retrieve a message from the queue
+        /// @param getMessages A function to retrieve a batch of messages from the queue
         /// @param onSuccess A callback function to execute when a message is processed
-        boost::asio::awaitable<void> StatefulMessageProcessingTask(
-            std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> getMessages,
-            std::function<void(const int, const std::string&)> onSuccess);
+        boost::asio::awaitable<void>
+        StatefulMessageProcessingTask(MessageGetter getMessages,
+                                      std::function<void(const int, const std::string&)> onSuccess);
 
         /// @brief Processes messages in a stateless manner
-        /// @param getMessages A function to retrieve a message from the queue
+        /// @param getMessages A function to retrieve a batch of messages from the queue
         /// @param onSuccess A callback function to execute when a message is processed
-        boost::asio::awaitable<void> StatelessMessageProcessingTask(
-            std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> getMessages,
-            std::function<void(const int, const std::string&)> onSuccess);
+        boost::asio::awaitable<void>
+        StatelessMessageProcessingTask(MessageGetter getMessages,
+                                       std::function<void(const int, const std::string&)> onSuccess);
 
         /// @brief Retrieves group configuration from the manager
         /// @param groupName The name of the group to retrieve the configuration for
@@ -89,10 +95,20 @@ namespace communicator
         /// @param reqParams The parameters for the request
         /// @param messageGetter Function to retrieve messages
         /// @param onSuccess Action to take on successful request
-        boost::asio::awaitable<void> ExecuteRequestLoop(
-            http_client::HttpRequestParams reqParams,
-            std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> messageGetter = {},
-            std::function<void(const int, const std::string&)> onSuccess = {});
+        boost::asio::awaitable<void>
+        ExecuteRequestLoop(http_client::HttpRequestParams reqParams,
+                           MessageGetter messageGetter = {},
+                           std::function<void(const int, const std::string&)> onSuccess = {});
+
+        /// @brief Long-polls the manager for commands
+        ///
+        /// A request is sent again as soon as the previous one is answered, or after a jittered exponential
+        /// backoff of up to the retry interval if it failed.
+        /// @param reqParams The parameters for the request
+        /// @param onSuccess Action to take when commands are received
+        boost::asio::awaitable<void>
+        ExecuteCommandsLongPollLoop(http_client::HttpRequestParams reqParams,
+                                    std::function<void(const int, const std::string&)> onSuccess);
 
         /// @brief Indicates if the communication process should keep running
         std::atomic<bool> m_keepRunning = true;
@@ -109,9 +125,12 @@ namespace communicator
         /// @brief Time in milliseconds between authentication attemps in case of failure
         std::time_t m_retryInterval;
 
-        /// @brief Size for batch requests
+        /// @brief Size for batch requests, after compression
         size_t m_batchSize;
 
+        /// @brief Compression of the event batches
+        http_client::CompressionOptions m_compression;
+
         /// @brief The server URL
         std::string m_serverUrl;
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace communicator
+{
+    /// @brief Jittered exponential backoff between reconnection attempts
+    ///
+    /// The ceiling of the delay starts at the initial value and doubles on each consecutive failure up to the
+    /// maximum. Each delay is drawn at random between half the ceiling and the ceiling, so the agents that lost
+    /// the connection at the same time don't reconnect to the manager all at once.
+    class ReconnectBackoff
+    {
+    public:
+        /// @brief Constructor
+        /// @param initial Ceiling of the delay after the first failure
+        /// @param max Maximum ceiling of the delay, the initial one is used if it's lower
+        ReconnectBackoff(std::chrono::milliseconds initial, std::chrono::milliseconds max)
+            : m_initial(std::max(initial, std::chrono::milliseconds(1)))
+            , m_max(std::max(max, m_initial))
+            , m_ceiling(m_initial)
+            , m_generator(std::random_device {}())
+        {
+        }
+
+        /// @brief Returns the delay before the next attempt and raises the ceiling for the following one
+        /// @return The delay to wait
+        std::chrono::milliseconds Next()
+        {
+            const auto ceiling = m_ceiling.count();
+            std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution(ceiling / 2, ceiling);
+
+            m_ceiling = std::min(m_ceiling * 2, m_max);
+
+            return std::chrono::milliseconds(distribution(m_generator));
+        }
+
+        /// @brief Starts over from the initial ceiling, to be called once an attempt succeeds
+        void Reset()
+        {
+            m_ceiling = m_initial;
+        }
+
+    private:
+        /// @brief Ceiling of the delay after the first failure
+        std::chrono::milliseconds m_initial;
+
+        /// @brief Maximum ceiling of the delay
+        std::chrono::milliseconds m_max;
+
+        /// @brief Ceiling of the next delay
+        std::chrono::milliseconds m_ceiling;
+
+        /// @brief Random generator for the jitter
+        std::mt19937 m_generator;
+    };
+} // namespace communicator
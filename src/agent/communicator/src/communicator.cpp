@@ -3,6 +3,7 @@
 #include <config.h>
 #include <http_request_params.hpp>
 #include <logger.hpp>
+#include <reconnect_backoff.hpp>
 
 #include <boost/asio.hpp>
 #include <boost/url.hpp>
@@ -13,6 +14,7 @@
 #include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <optional>
 #include <thread>
 #include <utility>
 
@@ -20,6 +22,8 @@ namespace
 {
     constexpr auto MIN_BATCH_SIZE = 1000ULL;
     constexpr auto MAX_BATCH_SIZE = 100000000ULL;
+    constexpr auto MIN_COMPRESSION_LEVEL = 1;
+    constexpr auto MAX_COMPRESSION_LEVEL = 9;
 
     boost::asio::awaitable<void> WaitForTimer(std::shared_ptr<boost::asio::steady_timer> timer,
                                               const std::time_t retryInMillis)
@@ -33,6 +37,82 @@ namespace
         (*timer).expires_after(duration);
         co_await timer->async_wait(boost::asio::use_awaitable);
     }
+
+    /// @brief Accumulates the drain rate of a message processing loop and logs it periodically
+    ///
+    /// The average wait for a batch tells how far the queue lags behind: close to zero means the
+    /// queue holds a backlog and batches are sent back-to-back, close to batch_interval means the
+    /// drain keeps up with the ingest rate.
+    class DrainStats
+    {
+    public:
+        /// @brief Constructor
+        /// @param endpoint The endpoint the batches are sent to, used to identify the log line
+        explicit DrainStats(std::string endpoint)
+            : m_endpoint(std::move(endpoint))
+            , m_periodStart(std::chrono::steady_clock::now())
+        {
+        }
+
+        /// @brief Accounts the time spent waiting for the queue to provide a batch
+        /// @param wait Time spent in the message getter
+        void AddWait(const std::chrono::steady_clock::duration wait)
+        {
+            m_wait += wait;
+        }
+
+        /// @brief Accounts a batch sent successfully
+        /// @param messages Number of messages in the batch
+        /// @param bytes Size of the batch body
+        void AddBatch(const int messages, const size_t bytes)
+        {
+            ++m_batches;
+            m_messages += static_cast<size_t>(messages);
+            m_bytes += bytes;
+        }
+
+        /// @brief Logs the rates of the current period once it is over and starts a new one
+        void LogIfDue()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const auto elapsed = now - m_periodStart;
+
+            if (elapsed < LOG_INTERVAL)
+            {
+                return;
+            }
+
+            const auto seconds = std::chrono::duration<double>(elapsed).count();
+            const auto averageWait =
+                m_batches ? std::chrono::duration_cast<std::chrono::milliseconds>(m_wait).count() /
+                                static_cast<long long>(m_batches)
+                          : 0LL;
+
+            LogDebug("Drain rate for {}: {:.2f} batches/s, {:.2f} messages/s, {:.0f} B/s, average wait for a batch "
+                     "{} ms.",
+                     m_endpoint,
+                     static_cast<double>(m_batches) / seconds,
+                     static_cast<double>(m_messages) / seconds,
+                     static_cast<double>(m_bytes) / seconds,
+                     averageWait);
+
+            m_periodStart = now;
+            m_wait = {};
+            m_batches = 0;
+            m_messages = 0;
+            m_bytes = 0;
+        }
+
+    private:
+        static constexpr auto LOG_INTERVAL = std::chrono::minutes(1);
+
+        std::string m_endpoint;
+        std::chrono::steady_clock::time_point m_periodStart;
+        std::chrono::steady_clock::duration m_wait {};
+        size_t m_batches = 0;
+        size_t m_messages = 0;
+        size_t m_bytes = 0;
+    };
 } // namespace
 
 namespace communicator
@@ -78,6 +158,29 @@ namespace communicator
         m_batchSize = configurationParser->GetBytesConfigInRangeOrDefault(
             config::agent::DEFAULT_BATCH_SIZE, MIN_BATCH_SIZE, MAX_BATCH_SIZE, "events", "batch_size");
 
+        const auto compression =
+            configurationParser->GetConfigOrDefault(config::agent::DEFAULT_COMPRESSION, "events", "compression");
+
+        if (const auto encoding = http_client::ContentEncodingFromString(compression); encoding.has_value())
+        {
+            m_compression.Encoding = encoding.value();
+        }
+        else
+        {
+            LogWarn("Incorrect value for 'compression', the default value '{}' is used.",
+                    config::agent::DEFAULT_COMPRESSION);
+            m_compression.Encoding =
+                http_client::ContentEncodingFromString(config::agent::DEFAULT_COMPRESSION).value_or(
+                    http_client::ContentEncoding::IDENTITY);
+        }
+
+        m_compression.Level =
+            configurationParser->GetConfigInRangeOrDefault(config::agent::DEFAULT_COMPRESSION_LEVEL,
+                                                           std::optional<int>(MIN_COMPRESSION_LEVEL),
+                                                           std::optional<int>(MAX_COMPRESSION_LEVEL),
+                                                           "events",
+                                                           "compression_level");
+
         m_verificationMode = configurationParser->GetConfigOrDefault(
             config::agent::DEFAULT_VERIFICATION_MODE, "agent", "verification_mode");
 
@@ -265,30 +368,32 @@ namespace communicator
                                                               "",
                                                               "",
                                                               m_timeoutCommands);
-        co_await ExecuteRequestLoop(reqParams, {}, onSuccess);
+        co_await ExecuteCommandsLongPollLoop(reqParams, onSuccess);
     }
 
-    boost::asio::awaitable<void> Communicator::StatefulMessageProcessingTask(
-        std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> getMessages,
-        std::function<void(const int, const std::string&)> onSuccess)
+    boost::asio::awaitable<void>
+    Communicator::StatefulMessageProcessingTask(MessageGetter getMessages,
+                                                std::function<void(const int, const std::string&)> onSuccess)
     {
-        const auto reqParams = http_client::HttpRequestParams(http_client::MethodType::POST,
-                                                              m_serverUrl,
-                                                              "/api/v1/events/stateful",
-                                                              m_getHeaderInfo ? m_getHeaderInfo() : "",
-                                                              m_verificationMode);
+        auto reqParams = http_client::HttpRequestParams(http_client::MethodType::POST,
+                                                        m_serverUrl,
+                                                        "/api/v1/events/stateful",
+                                                        m_getHeaderInfo ? m_getHeaderInfo() : "",
+                                                        m_verificationMode);
+        reqParams.Content_Encoding = m_compression.Encoding;
         co_await ExecuteRequestLoop(reqParams, getMessages, onSuccess);
     }
 
-    boost::asio::awaitable<void> Communicator::StatelessMessageProcessingTask(
-        std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> getMessages,
-        std::function<void(const int, const std::string&)> onSuccess)
+    boost::asio::awaitable<void>
+    Communicator::StatelessMessageProcessingTask(MessageGetter getMessages,
+                                                 std::function<void(const int, const std::string&)> onSuccess)
     {
-        const auto reqParams = http_client::HttpRequestParams(http_client::MethodType::POST,
-                                                              m_serverUrl,
-                                                              "/api/v1/events/stateless",
-                                                              m_getHeaderInfo ? m_getHeaderInfo() : "",
-                                                              m_verificationMode);
+        auto reqParams = http_client::HttpRequestParams(http_client::MethodType::POST,
+                                                        m_serverUrl,
+                                                        "/api/v1/events/stateless",
+                                                        m_getHeaderInfo ? m_getHeaderInfo() : "",
+                                                        m_verificationMode);
+        reqParams.Content_Encoding = m_compression.Encoding;
         co_await ExecuteRequestLoop(reqParams, getMessages, onSuccess);
     }
 
@@ -352,15 +457,16 @@ namespace communicator
         co_return downloaded;
     }
 
-    boost::asio::awaitable<void> Communicator::ExecuteRequestLoop(
-        http_client::HttpRequestParams reqParams,
-        std::function<boost::asio::awaitable<std::tuple<int, std::string>>(const size_t)> messageGetter,
-        std::function<void(const int, const std::string&)> onSuccess)
+    boost::asio::awaitable<void>
+    Communicator::ExecuteRequestLoop(http_client::HttpRequestParams reqParams,
+                                     MessageGetter messageGetter,
+                                     std::function<void(const int, const std::string&)> onSuccess)
     {
         using namespace std::chrono_literals;
 
         auto executor = co_await boost::asio::this_coro::executor;
         auto timer = std::make_shared<boost::asio::steady_timer>(executor);
+        DrainStats drainStats(reqParams.Endpoint);
 
         do
         {
@@ -371,30 +477,37 @@ namespace communicator
             }
 
             auto messagesCount = 0;
+            std::string body;
 
             if (messageGetter != nullptr)
             {
+                const auto waitStart = std::chrono::steady_clock::now();
+
                 while (m_keepRunning.load())
                 {
-                    const auto messages = co_await messageGetter(m_batchSize);
+                    auto messages = co_await messageGetter(m_batchSize, m_compression);
                     messagesCount = std::get<0>(messages);
 
                     if (messagesCount)
                     {
                         LogTrace("Items count: {}", messagesCount);
-                        reqParams.Body = std::get<1>(messages);
+                        body = std::move(std::get<1>(messages));
                         break;
                     }
                 }
-            }
-            else
-            {
-                reqParams.Body = "";
+
+                drainStats.AddWait(std::chrono::steady_clock::now() - waitStart);
             }
 
             reqParams.Token = *m_token;
 
-            const auto [statusCode, responseBody] = co_await m_httpClient->Co_PerformHttpRequest(reqParams);
+            // The batch is moved through to the request, it is not copied on the way
+            const auto bodySize = body.size();
+            auto batchParams = reqParams;
+            batchParams.Body = std::move(body);
+
+            const auto [statusCode, responseBody] =
+                co_await m_httpClient->Co_PerformHttpRequest(std::move(batchParams));
 
             std::time_t timerSleep = A_SECOND_IN_MILLIS;
 
@@ -404,6 +517,15 @@ namespace communicator
                 {
                     onSuccess(messagesCount, responseBody);
                 }
+
+                if (messageGetter != nullptr)
+                {
+                    // The message getter already waits for a full batch or the batch interval, so the next
+                    // batch is requested right away and the queue is drained as fast as it is filled
+                    timerSleep = 0;
+                    drainStats.AddBatch(messagesCount, bodySize);
+                    drainStats.LogIfDue();
+                }
             }
             else
             {
@@ -417,7 +539,62 @@ namespace communicator
                 }
             }
 
-            co_await WaitForTimer(timer, timerSleep);
+            if (timerSleep > 0)
+            {
+                co_await WaitForTimer(timer, timerSleep);
+            }
+        } while (m_keepRunning.load());
+    }
+
+    boost::asio::awaitable<void>
+    Communicator::ExecuteCommandsLongPollLoop(http_client::HttpRequestParams reqParams,
+                                              std::function<void(const int, const std::string&)> onSuccess)
+    {
+        auto executor = co_await boost::asio::this_coro::executor;
+        auto timer = std::make_shared<boost::asio::steady_timer>(executor);
+        ReconnectBackoff backoff(std::chrono::milliseconds(std::min<std::time_t>(A_SECOND_IN_MILLIS, m_retryInterval)),
+                                 std::chrono::milliseconds(m_retryInterval));
+
+        do
+        {
+            if (!m_token || m_token->empty())
+            {
+                co_await WaitForTimer(timer, A_SECOND_IN_MILLIS);
+                continue;
+            }
+
+            reqParams.Token = *m_token;
+
+            // The manager holds the request until there are commands for the agent or the request times out,
+            // and the connection is kept alive in between, so a new request is sent as soon as one is answered
+            const auto [statusCode, responseBody] = co_await m_httpClient->Co_PerformHttpRequest(reqParams);
+
+            if (statusCode >= http_client::HTTP_CODE_OK && statusCode < http_client::HTTP_CODE_MULTIPLE_CHOICES)
+            {
+                backoff.Reset();
+
+                if (onSuccess != nullptr)
+                {
+                    onSuccess(0, responseBody);
+                }
+
+                continue;
+            }
+
+            if (statusCode == http_client::HTTP_CODE_TIMEOUT)
+            {
+                backoff.Reset();
+                continue;
+            }
+
+            if (statusCode == http_client::HTTP_CODE_UNAUTHORIZED || statusCode == http_client::HTTP_CODE_FORBIDDEN)
+            {
+                TryReAuthenticate();
+            }
+
+            const auto delay = backoff.Next();
+            LogDebug("Commands request failed with status {}. Retrying in {} ms.", statusCode, delay.count());
+            co_await WaitForTimer(timer, static_cast<std::time_t>(delay.count()));
         } while (m_keepRunning.load());
     }
 
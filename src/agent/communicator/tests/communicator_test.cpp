@@ -5,6 +5,7 @@
 #include <http_request_params.hpp>
 #include <ihttp_client.hpp>
 #include <mock_http_client.hpp>
+#include <reconnect_backoff.hpp>
 
 #include <jwt-cpp/jwt.h>
 #include <jwt-cpp/traits/nlohmann-json/traits.h>
@@ -19,7 +20,7 @@
 // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
 
 using namespace testing;
-using GetMessagesFuncType = std::function<boost::asio::awaitable<intStringTuple>(const size_t)>;
+using GetMessagesFuncType = communicator::Communicator::MessageGetter;
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
 MATCHER_P3(HttpRequestParamsCheck, expected, token, body, "Check http request params")
@@ -137,7 +138,8 @@ TEST_F(CommunicatorTest, StatelessMessageProcessingTask_FailedAuthenticationLeav
         {
             m_communicator->SendAuthenticationRequest();
             co_await m_communicator->StatelessMessageProcessingTask(
-                [&getMessagesCalled](const size_t) -> boost::asio::awaitable<intStringTuple>
+                [&getMessagesCalled](const size_t,
+                                     const http_client::CompressionOptions) -> boost::asio::awaitable<intStringTuple>
                 {
                     getMessagesCalled = true;
                     co_return intStringTuple {1, std::string {"message"}};
@@ -171,7 +173,8 @@ TEST_F(CommunicatorTest, StatelessMessageProcessingTask_CallsWithValidToken)
         {
             m_communicator->SendAuthenticationRequest();
             co_await m_communicator->StatelessMessageProcessingTask(
-                [&getMessagesCalled](const size_t) -> boost::asio::awaitable<intStringTuple>
+                [&getMessagesCalled](const size_t,
+                                     const http_client::CompressionOptions) -> boost::asio::awaitable<intStringTuple>
                 {
                     getMessagesCalled = true;
                     co_return intStringTuple {1, std::string {"message"}};
@@ -183,6 +186,95 @@ TEST_F(CommunicatorTest, StatelessMessageProcessingTask_CallsWithValidToken)
     EXPECT_TRUE(onSuccessCalled);
 }
 
+TEST_F(CommunicatorTest, StatelessMessageProcessingTask_SendsBatchesBackToBackOnSuccess)
+{
+    constexpr int BATCHES = 3;
+    int requestsCount = 0;
+
+    EXPECT_CALL(*m_mockHttpClientPtr, Co_PerformHttpRequest(testing::_))
+        .Times(BATCHES)
+        .WillRepeatedly(Invoke(
+            [this, &requestsCount]() -> boost::asio::awaitable<intStringTuple>
+            {
+                if (++requestsCount == BATCHES)
+                {
+                    m_communicator->Stop();
+                }
+                co_return intStringTuple {http_client::HTTP_CODE_OK, "Dummy response"};
+            }));
+
+    int onSuccessCount = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    SpawnCoroutine(
+        [this, &onSuccessCount]() mutable -> boost::asio::awaitable<void>
+        {
+            m_communicator->SendAuthenticationRequest();
+            co_await m_communicator->StatelessMessageProcessingTask(
+                [](const size_t, const http_client::CompressionOptions) -> boost::asio::awaitable<intStringTuple>
+                { co_return intStringTuple {1, std::string {"message"}}; },
+                [&onSuccessCount](const int, const std::string&) { ++onSuccessCount; });
+        });
+
+    EXPECT_EQ(onSuccessCount, BATCHES);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_F(CommunicatorTest, StatefulMessageProcessingTask_SendsCompressedBatches)
+{
+    auto mockHttpClient = std::make_unique<MockHttpClient>();
+    auto* const mockHttpClientPtr = mockHttpClient.get();
+
+    const auto configurationParser = std::make_shared<configuration::ConfigurationParser>(std::string(R"(
+        agent:
+          retry_interval: 5
+          verification_mode: none
+        events:
+          batch_size: 1
+          compression: zstd
+          compression_level: 5
+    )"));
+
+    const auto communicator = std::make_shared<communicator::Communicator>(
+        std::move(mockHttpClient), configurationParser, "uuid", "key", nullptr);
+
+    EXPECT_CALL(*mockHttpClientPtr, PerformHttpRequest(testing::_))
+        .WillOnce(Invoke([token = m_mockedToken]() -> intStringTuple
+                         { return {http_client::HTTP_CODE_OK, R"({"token":")" + token + R"("})"}; }));
+
+    http_client::ContentEncoding requestEncoding = http_client::ContentEncoding::IDENTITY;
+
+    EXPECT_CALL(*mockHttpClientPtr, Co_PerformHttpRequest(testing::_))
+        .WillOnce(Invoke(
+            [communicatorPtr = communicator.get(), &requestEncoding](
+                const http_client::HttpRequestParams params) -> boost::asio::awaitable<intStringTuple>
+            {
+                requestEncoding = params.Content_Encoding;
+                communicatorPtr->Stop();
+                co_return intStringTuple {http_client::HTTP_CODE_OK, "Dummy response"};
+            }));
+
+    http_client::CompressionOptions getterOptions;
+
+    SpawnCoroutine(
+        [communicator, &getterOptions]() mutable -> boost::asio::awaitable<void>
+        {
+            communicator->SendAuthenticationRequest();
+            co_await communicator->StatefulMessageProcessingTask(
+                [&getterOptions](const size_t, const http_client::CompressionOptions options)
+                    -> boost::asio::awaitable<intStringTuple>
+                {
+                    getterOptions = options;
+                    co_return intStringTuple {1, std::string {"compressed"}};
+                },
+                [](const int, const std::string&) {});
+        });
+
+    EXPECT_EQ(getterOptions.Encoding, http_client::ContentEncoding::ZSTD);
+    EXPECT_EQ(getterOptions.Level, 5);
+    EXPECT_EQ(requestEncoding, http_client::ContentEncoding::ZSTD);
+}
+
 TEST_F(CommunicatorTest, GetCommandsFromManager_CallsWithValidToken)
 {
     const auto timeout = static_cast<time_t>(11) * 60 * 1000;
@@ -237,6 +329,103 @@ TEST_F(CommunicatorTest, GetCommandsFromManager_Failure)
     EXPECT_FALSE(onSuccessCalled);
 }
 
+TEST_F(CommunicatorTest, GetCommandsFromManager_RequestsAgainRightAfterLongPollTimeout)
+{
+    auto mockHttpClient = std::make_unique<MockHttpClient>();
+    auto* const mockHttpClientPtr = mockHttpClient.get();
+
+    const auto configurationParser = std::make_shared<configuration::ConfigurationParser>(std::string(R"(
+        agent:
+          retry_interval: 10s
+          verification_mode: none
+    )"));
+
+    const auto communicator = std::make_shared<communicator::Communicator>(
+        std::move(mockHttpClient), configurationParser, "uuid", "key", nullptr);
+
+    EXPECT_CALL(*mockHttpClientPtr, PerformHttpRequest(testing::_))
+        .WillOnce(Invoke([token = m_mockedToken]() -> intStringTuple
+                         { return {http_client::HTTP_CODE_OK, R"({"token":")" + token + R"("})"}; }));
+
+    EXPECT_CALL(*mockHttpClientPtr, Co_PerformHttpRequest(testing::_))
+        .WillOnce(Invoke([]() -> boost::asio::awaitable<intStringTuple>
+                         { co_return intStringTuple {http_client::HTTP_CODE_TIMEOUT, ""}; }))
+        .WillOnce(Invoke(
+            [communicatorPtr = communicator.get()]() -> boost::asio::awaitable<intStringTuple>
+            {
+                communicatorPtr->Stop();
+                co_return intStringTuple {http_client::HTTP_CODE_OK, "Dummy response"};
+            }));
+
+    auto onSuccessCalls = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    SpawnCoroutine(
+        [communicator, &onSuccessCalls]() mutable -> boost::asio::awaitable<void>
+        {
+            communicator->SendAuthenticationRequest();
+            co_await communicator->GetCommandsFromManager([&onSuccessCalls](const int, const std::string&)
+                                                          { ++onSuccessCalls; });
+        });
+
+    EXPECT_EQ(onSuccessCalls, 1);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_F(CommunicatorTest, GetCommandsFromManager_RetriesAfterFailures)
+{
+    auto requests = 0;
+
+    EXPECT_CALL(*m_mockHttpClientPtr, Co_PerformHttpRequest(testing::_))
+        .Times(3)
+        .WillRepeatedly(Invoke(
+            [this, &requests]() -> boost::asio::awaitable<intStringTuple>
+            {
+                if (++requests < 3)
+                {
+                    co_return intStringTuple {http_client::HTTP_CODE_INTERNAL_SERVER_ERROR, ""};
+                }
+
+                m_communicator->Stop();
+                co_return intStringTuple {http_client::HTTP_CODE_OK, "Dummy response"};
+            }));
+
+    auto onSuccessCalls = 0;
+
+    SpawnCoroutine(
+        [this, &onSuccessCalls]() mutable -> boost::asio::awaitable<void>
+        {
+            m_communicator->SendAuthenticationRequest();
+            co_await m_communicator->GetCommandsFromManager([&onSuccessCalls](const int, const std::string&)
+                                                            { ++onSuccessCalls; });
+        });
+
+    EXPECT_EQ(onSuccessCalls, 1);
+}
+
+TEST(ReconnectBackoffTest, DelayDoublesUpToTheMaximumWithJitter)
+{
+    communicator::ReconnectBackoff backoff(std::chrono::milliseconds(100), std::chrono::milliseconds(400));
+
+    for (const auto ceiling : {100, 200, 400, 400})
+    {
+        const auto delay = backoff.Next().count();
+        EXPECT_GE(delay, ceiling / 2);
+        EXPECT_LE(delay, ceiling);
+    }
+
+    backoff.Reset();
+    EXPECT_LE(backoff.Next().count(), 100);
+}
+
+TEST(ReconnectBackoffTest, MaximumLowerThanInitial)
+{
+    communicator::ReconnectBackoff backoff(std::chrono::milliseconds(100), std::chrono::milliseconds(10));
+
+    EXPECT_LE(backoff.Next().count(), 100);
+    EXPECT_LE(backoff.Next().count(), 100);
+}
+
 TEST_F(CommunicatorTest, GetGroupConfigurationFromManager_Success)
 {
     const auto reqParams = http_client::HttpRequestParams(
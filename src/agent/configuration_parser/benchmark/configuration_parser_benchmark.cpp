@@ -0,0 +1,118 @@
+#include <configuration_parser.hpp>
+#include <configuration_parser_utils.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_LOOKUPS = 10000;
+
+    /// @brief Lookup as it was before the snapshot: the whole document cloned, then walked key by key
+    template<typename T, typename... Keys>
+    T LegacyGetConfigOrDefault(const YAML::Node& config, const T& defaultValue, Keys... keys)
+    {
+        YAML::Node current = YAML::Clone(config);
+
+        try
+        {
+            // clang-format off
+            ([&current] (const auto& key)
+            {
+                current = current[key];
+
+                if (!current.IsDefined())
+                {
+                    throw std::runtime_error("Key not found");
+                }
+            }(keys), ...);
+            // clang-format on
+
+            return current.as<T>();
+        }
+        catch (const std::exception&)
+        {
+            return defaultValue;
+        }
+    }
+
+    /// @brief Runs the lookups the modules make on setup, in groups of 10 until \p lookups
+    template<typename Lookup>
+    double Run(size_t lookups, Lookup lookup, size_t& checksum)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < lookups; i += 10)
+        {
+            checksum += lookup();
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t lookups = argc > 1 ? std::stoul(argv[1]) : DEFAULT_LOOKUPS;
+    const std::filesystem::path configFile = argc > 2 ? argv[2] : AGENT_CONFIG_FILE;
+
+    const auto document = YAML::LoadFile(configFile.string());
+    const configuration::ConfigurationParser parser {configFile};
+
+    size_t legacyChecksum {0};
+    size_t snapshotChecksum {0};
+
+    const auto legacyMs = Run(
+        lookups,
+        [&document]()
+        {
+            return static_cast<size_t>(LegacyGetConfigOrDefault(document, false, "inventory", "enabled")) +
+                   static_cast<size_t>(LegacyGetConfigOrDefault(document, false, "inventory", "packages")) +
+                   static_cast<size_t>(LegacyGetConfigOrDefault(document, false, "logcollector", "enabled")) +
+                   static_cast<size_t>(LegacyGetConfigOrDefault(document, 0, "agent", "thread_count")) +
+                   static_cast<size_t>(LegacyGetConfigOrDefault(document, 0, "agent", "queue_size")) +
+                   LegacyGetConfigOrDefault<std::string>(document, "", "agent", "server_url").size() +
+                   LegacyGetConfigOrDefault<std::vector<std::string>>(document, {}, "logcollector", "localfiles")
+                       .size() +
+                   static_cast<size_t>(
+                       ParseTimeUnit(LegacyGetConfigOrDefault<std::string>(document, "1h", "inventory", "interval"))) +
+                   static_cast<size_t>(ParseTimeUnit(
+                       LegacyGetConfigOrDefault<std::string>(document, "10s", "events", "batch_interval"))) +
+                   ParseSizeUnit(LegacyGetConfigOrDefault<std::string>(document, "1MB", "events", "batch_size"));
+        },
+        legacyChecksum);
+
+    const auto snapshotMs = Run(
+        lookups,
+        [&parser]()
+        {
+            return static_cast<size_t>(parser.GetConfigOrDefault(false, "inventory", "enabled")) +
+                   static_cast<size_t>(parser.GetConfigOrDefault(false, "inventory", "packages")) +
+                   static_cast<size_t>(parser.GetConfigOrDefault(false, "logcollector", "enabled")) +
+                   static_cast<size_t>(parser.GetConfigOrDefault(0, "agent", "thread_count")) +
+                   static_cast<size_t>(parser.GetConfigOrDefault(0, "agent", "queue_size")) +
+                   parser.GetConfigOrDefault("", "agent", "server_url").size() +
+                   parser.GetConfigOrDefault<std::vector<std::string>>({}, "logcollector", "localfiles").size() +
+                   static_cast<size_t>(parser.GetTimeConfigOrDefault("1h", "inventory", "interval")) +
+                   static_cast<size_t>(parser.GetTimeConfigOrDefault("10s", "events", "batch_interval")) +
+                   parser.GetBytesConfigInRangeOrDefault(
+                       "1MB", 0, std::numeric_limits<size_t>::max(), "events", "batch_size");
+        },
+        snapshotChecksum);
+
+    std::printf("%-16s %8zu lookups %10.2f ms\n", "clone and walk", lookups, legacyMs);
+    std::printf("%-16s %8zu lookups %10.2f ms %8.1fx speedup %s\n",
+                "snapshot",
+                lookups,
+                snapshotMs,
+                legacyMs / snapshotMs,
+                legacyChecksum == snapshotChecksum ? "same result" : "DIFFERENT RESULT");
+    return 0;
+}
@@ -5,13 +5,20 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <atomic>
 #include <ctime>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace configuration
 {
@@ -118,7 +125,7 @@ namespace configuration
                                                   std::time_t max,
                                                   Keys... keys) const
         {
-            return GetParsedConfigInRangeOrDefault(defaultValue, min, max, ParseTimeUnit, keys...);
+            return GetParsedConfigInRangeOrDefault(defaultValue, min, max, ParseTimeUnit, &Value::Time, keys...);
         }
 
         /// @brief Fetches a configuration value as in GetConfigOrDefault, but parses the string value as a time_t.
@@ -148,7 +155,7 @@ namespace configuration
                                                    std::size_t max,
                                                    Keys... keys) const
         {
-            return GetParsedConfigInRangeOrDefault(defaultValue, min, max, ParseSizeUnit, keys...);
+            return GetParsedConfigInRangeOrDefault(defaultValue, min, max, ParseSizeUnit, &Value::Size, keys...);
         }
 
         /// @brief Sets the server URL in the configuration and saves it to the configuration file.
@@ -173,36 +180,110 @@ namespace configuration
         void SetGetGroupIdsFunction(std::function<std::vector<std::string>()> getGroupIdsFunction);
 
         /// @brief Method for loading the new available configuration
-        void ReloadConfiguration();
+        ///
+        /// @return Top-level sections (e.g. "agent", "inventory") added, removed or modified by the reload
+        std::set<std::string> ReloadConfiguration();
 
     private:
+        /// @brief Configuration value, with its scalar already converted to the types most looked up
+        struct Value
+        {
+            /// @brief Copy of the node in the YAML document
+            YAML::Node Node;
+
+            /// @brief Value as a string, if scalar
+            std::optional<std::string> Scalar;
+
+            /// @brief Scalar as a bool, if it converts to one
+            std::optional<bool> Bool;
+
+            /// @brief Scalar as an integer, if it converts to one
+            std::optional<long long> Integer;
+
+            /// @brief Scalar parsed by \ref ParseTimeUnit, if valid
+            std::optional<std::time_t> Time;
+
+            /// @brief Scalar parsed by \ref ParseSizeUnit, if valid
+            std::optional<std::size_t> Size;
+        };
+
+        /// @brief Values of every map node of the configuration by key path, never modified once published
+        using Snapshot = std::unordered_map<std::string, Value>;
+
+        /// @brief Builds the key path of a value in the snapshot.
+        /// @param keys The sequence of keys to the value.
+        /// @return Keys, each one followed by a null character (which keys can't contain).
+        template<typename... Keys>
+        static std::string KeyPath(const Keys&... keys)
+        {
+            std::string path;
+            ((path += keys, path += '\0'), ...);
+            return path;
+        }
+
+        /// @brief Looks up a value in the current snapshot.
+        /// @param keys The sequence of keys to the value.
+        /// @return The value, kept alive by the snapshot holding it, or nullptr if not found.
+        template<typename... Keys>
+        std::shared_ptr<const Value> Find(const Keys&... keys) const
+        {
+            auto snapshot = m_snapshot.load();
+            const auto it = snapshot->find(KeyPath(keys...));
+
+            if (it == snapshot->end())
+            {
+                std::string name;
+                ((name += (name.empty() ? "" : ".") + std::string(keys)), ...);
+                LogDebug("Requested setting not found, default value used. Key not found: {}", name);
+                return nullptr;
+            }
+
+            return {std::move(snapshot), &it->second};
+        }
+
         /// @brief Retrieves a configuration value by following a sequence of nested keys.
         /// @tparam T The expected type of the configuration value to retrieve.
         /// @tparam Keys Variadic template parameters representing the hierarchical path to the desired value.
         /// @param keys A sequence of keys to locate the configuration value within the YAML structure.
         /// @return The configuration value corresponding to the specified keys or std::nullopt.
-        /// @details This method provides a flexible way to retrieve deeply nested configuration values using
-        /// a variadic sequence of keys, which allows specifying paths within the YAML structure.
+        /// @details The value is looked up in the current snapshot, without locking, and the scalars of the types
+        /// converted on its build are returned as they are. Other types are converted from a copy of the node, as
+        /// the snapshot is shared by every thread reading the configuration.
         template<typename T, typename... Keys>
         std::optional<T> GetConfig(Keys... keys) const
         {
-            YAML::Node current = YAML::Clone(m_config);
+            const auto value = Find(keys...);
+
+            if (!value)
+            {
+                return std::nullopt;
+            }
 
             try
             {
-                // clang-format off
-                ([&current] (const auto& key)
+                if constexpr (std::is_same_v<T, std::string>)
                 {
-                    current = current[key];
-
-                    if (!current.IsDefined())
+                    if (value->Scalar)
+                    {
+                        return value->Scalar;
+                    }
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    if (value->Bool)
                     {
-                        throw YAML::Exception(YAML::Mark::null_mark(), "Key not found: " + std::string(key));
+                        return value->Bool;
                     }
-                }(keys), ...);
-                // clang-format on
+                }
+                else if constexpr (std::is_integral_v<T> && sizeof(T) > 1)
+                {
+                    if (value->Integer && std::in_range<T>(*value->Integer))
+                    {
+                        return static_cast<T>(*value->Integer);
+                    }
+                }
 
-                return current.as<T>();
+                return YAML::Clone(value->Node).template as<T>();
             }
             catch (const std::invalid_argument& e)
             {
@@ -224,11 +305,16 @@ namespace configuration
         /// @param min The minimum acceptable value (inclusive) for the parsed value.
         /// @param max The maximum acceptable value (inclusive) for the parsed value.
         /// @param parseFunc The function to parse the configuration value into type T.
+        /// @param parsedValue Member of the value holding its scalar parsed by \p parseFunc, if valid.
         /// @param keys The sequence of keys used to navigate through the configuration hierarchy.
         /// @return The parsed configuration value if found and within range; otherwise, the default value.
         template<typename T, typename ParseFunc, typename... Keys>
-        T GetParsedConfigInRangeOrDefault(
-            const std::string& defaultValue, T min, T max, ParseFunc parseFunc, Keys... keys) const
+        T GetParsedConfigInRangeOrDefault(const std::string& defaultValue,
+                                          T min,
+                                          T max,
+                                          ParseFunc parseFunc,
+                                          std::optional<T> Value::*parsedValue,
+                                          Keys... keys) const
         {
             if (min >= max)
             {
@@ -236,11 +322,13 @@ namespace configuration
                 return parseFunc(defaultValue);
             }
 
-            if (const auto result = GetConfig<std::string>(keys...))
+            if (const auto value = Find(keys...); value && value->Scalar)
             {
                 try
                 {
-                    const auto parsedResult = parseFunc(*result);
+                    // An invalid scalar is parsed again only to report why
+                    const auto& parsed = (*value).*parsedValue;
+                    const auto parsedResult = parsed ? *parsed : parseFunc(*value->Scalar);
 
                     if (min <= parsedResult && parsedResult <= max)
                     {
@@ -268,9 +356,15 @@ namespace configuration
         /// @throws YAML::Exception If there is an error while loading or parsing a YAML file.
         void LoadSharedConfig();
 
+        /// @brief Publishes a snapshot of the current configuration for the lookups.
+        void UpdateSnapshot();
+
         /// @brief Holds the parsed YAML configuration.
         YAML::Node m_config;
 
+        /// @brief Snapshot of \ref m_config the lookups are served from, replaced as a whole on every change.
+        std::atomic<std::shared_ptr<const Snapshot>> m_snapshot {std::make_shared<const Snapshot>()};
+
         /// @brief Holds the location of the configuration file.
         std::filesystem::path m_configFilePath;
 
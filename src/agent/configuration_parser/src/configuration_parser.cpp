@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cctype>
 #include <fstream>
+#include <map>
 #include <queue>
 #include <unordered_set>
 #include <utility>
@@ -13,7 +14,59 @@
 namespace
 {
     const std::filesystem::path CONFIG_FILE = std::filesystem::path(config::DEFAULT_CONFIG_PATH) / "wazuh-agent.yml";
-}
+
+    /// @brief Converts a scalar node, or returns std::nullopt if it doesn't convert to the type
+    template<typename T, typename Convert>
+    std::optional<T> TryConvert(Convert convert)
+    {
+        try
+        {
+            return convert();
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    /// @brief Returns the top-level sections whose content differs between both configurations
+    std::set<std::string> ChangedSections(const YAML::Node& previous, const YAML::Node& current)
+    {
+        std::map<std::string, std::string> sections;
+        std::set<std::string> changed;
+
+        if (previous.IsMap())
+        {
+            for (const auto& section : previous)
+            {
+                sections[section.first.as<std::string>()] = YAML::Dump(section.second);
+            }
+        }
+
+        if (current.IsMap())
+        {
+            for (const auto& section : current)
+            {
+                const auto name = section.first.as<std::string>();
+
+                if (const auto it = sections.find(name); it == sections.end() || it->second != YAML::Dump(section.second))
+                {
+                    changed.insert(name);
+                }
+
+                sections.erase(name);
+            }
+        }
+
+        // Sections left were removed by the reload
+        for (const auto& [name, _] : sections)
+        {
+            changed.insert(name);
+        }
+
+        return changed;
+    }
+} // namespace
 
 namespace configuration
 {
@@ -21,6 +74,7 @@ namespace configuration
         : m_configFilePath(std::move(configFilePath))
     {
         LoadLocalConfig();
+        UpdateSnapshot();
     }
 
     ConfigurationParser::ConfigurationParser()
@@ -39,6 +93,8 @@ namespace configuration
             LogError("Error parsing yaml string: {}.", e.what());
             throw;
         }
+
+        UpdateSnapshot();
     }
 
     void ConfigurationParser::LoadLocalConfig()
@@ -65,6 +121,7 @@ namespace configuration
         try
         {
             m_config["agent"]["server_url"] = value;
+            UpdateSnapshot();
             std::ofstream file(m_configFilePath);
             file << m_config;
             file.close();
@@ -137,13 +194,15 @@ namespace configuration
     {
         m_getGroups = std::move(getGroupIdsFunction);
         LoadSharedConfig();
+        UpdateSnapshot();
     }
 
-    void ConfigurationParser::ReloadConfiguration()
+    std::set<std::string> ConfigurationParser::ReloadConfiguration()
     {
         LogInfo("Reload configuration.");
 
-        // Reset saved configuration
+        // Reset saved configuration, nodes are references so the previous one is kept as a copy
+        const YAML::Node previous = YAML::Clone(m_config);
         m_config = YAML::Node();
 
         // Load local configuration
@@ -152,6 +211,50 @@ namespace configuration
         // Load shared configuration
         LoadSharedConfig();
 
+        // Lookups keep reading the previous configuration until this point
+        UpdateSnapshot();
+
         LogInfo("Reload configuration done.");
+
+        return ChangedSections(previous, m_config);
+    }
+
+    void ConfigurationParser::UpdateSnapshot()
+    {
+        auto snapshot = std::make_shared<Snapshot>();
+        std::queue<std::pair<std::string, YAML::Node>> pending;
+        pending.emplace("", m_config);
+
+        while (!pending.empty())
+        {
+            auto [path, node] = std::move(pending.front());
+            pending.pop();
+
+            Value value;
+            value.Node = YAML::Clone(node);
+
+            if (node.IsScalar())
+            {
+                value.Scalar = node.Scalar();
+                value.Bool = TryConvert<bool>([&node]() { return node.as<bool>(); });
+                value.Integer = TryConvert<long long>([&node]() { return node.as<long long>(); });
+                value.Time = TryConvert<std::time_t>([&value]() { return ParseTimeUnit(*value.Scalar); });
+                value.Size = TryConvert<std::size_t>([&value]() { return ParseSizeUnit(*value.Scalar); });
+            }
+            else if (node.IsMap())
+            {
+                for (const auto& item : node)
+                {
+                    if (item.first.IsScalar())
+                    {
+                        pending.emplace(path + item.first.Scalar() + '\0', item.second);
+                    }
+                }
+            }
+
+            snapshot->try_emplace(std::move(path), std::move(value));
+        }
+
+        m_snapshot.store(std::move(snapshot));
     }
 } // namespace configuration
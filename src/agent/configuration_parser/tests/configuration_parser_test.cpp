@@ -3,12 +3,15 @@
 #include <config.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace configuration;
@@ -611,6 +614,97 @@ TEST(ConfigurationParser, GetTimeConfigOrDefaultTests)
     EXPECT_EQ(expectedValidTime, 39);
 }
 
+TEST(ConfigurationParser, GetConfigOrDefaultNodeIsACopy)
+{
+    const std::string strConfig = R"(
+        logcollector:
+            journald:
+              - field: _SYSTEMD_UNIT
+                value: cron.service
+    )";
+    const auto configParser = std::make_unique<configuration::ConfigurationParser>(strConfig);
+
+    auto journald = configParser->GetConfigOrDefault<YAML::Node>({}, "logcollector", "journald");
+    journald[0]["value"] = "sshd.service";
+
+    journald = configParser->GetConfigOrDefault<YAML::Node>({}, "logcollector", "journald");
+    EXPECT_EQ(journald[0]["value"].as<std::string>(), "cron.service");
+}
+
+TEST_F(ConfigurationParserFileTest, LookupsDuringReloadSeeEitherConfiguration)
+{
+    const auto parser = std::make_unique<configuration::ConfigurationParser>(m_tempConfigFilePath);
+    EXPECT_EQ(parser->GetTimeConfigOrDefault("1h", "inventory", "interval"), 7200000);
+
+    std::ofstream outFile(m_tempConfigFilePath);
+    outFile << R"(
+        inventory:
+            interval: 60
+    )";
+    outFile.close();
+
+    std::atomic<bool> reloading {true};
+    std::atomic<size_t> unexpectedValues {0};
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back(
+            [&parser, &reloading, &unexpectedValues]()
+            {
+                while (reloading)
+                {
+                    const auto interval = parser->GetConfigOrDefault(0, "inventory", "interval");
+
+                    if (interval != 7200 && interval != 60)
+                    {
+                        ++unexpectedValues;
+                    }
+                }
+            });
+    }
+
+    for (int i = 0; i < 20; ++i)
+    {
+        parser->ReloadConfiguration();
+    }
+
+    reloading = false;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(unexpectedValues, 0u);
+    EXPECT_EQ(parser->GetConfigOrDefault(0, "inventory", "interval"), 60);
+    EXPECT_EQ(parser->GetTimeConfigOrDefault("1h", "inventory", "interval"), 60000);
+    EXPECT_EQ(parser->GetConfigOrDefault(DEFAULT_STRING, "agent", "server_url"), DEFAULT_STRING);
+}
+
+TEST_F(ConfigurationParserFileTest, ReloadConfigurationReturnsChangedSections)
+{
+    const auto parser = std::make_unique<configuration::ConfigurationParser>(m_tempConfigFilePath);
+
+    EXPECT_TRUE(parser->ReloadConfiguration().empty());
+
+    std::ofstream outFile(m_tempConfigFilePath);
+    outFile << R"(
+        agent:
+            server_url: https://myserver:28000
+        inventory:
+            enabled: true
+            interval: 7200
+            scan_on_start: false
+        events:
+            batch_size: 1000
+    )";
+    outFile.close();
+
+    EXPECT_EQ(parser->ReloadConfiguration(), (std::set<std::string> {"events", "inventory", "logcollector"}));
+    EXPECT_TRUE(parser->ReloadConfiguration().empty());
+}
+
 // NOLINTEND(bugprone-unchecked-optional-access)
 
 int main(int argc, char** argv)
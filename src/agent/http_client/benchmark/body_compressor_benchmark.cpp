@@ -0,0 +1,143 @@
+#include <body_compressor.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_EVENTS = 200000;
+
+    /// @brief Default batch size, the corpus is split in batches of this many compressed bytes as
+    /// GetMessagesFromQueue does
+    constexpr size_t BATCH_SIZE = 1000000;
+
+    /// @brief Reads a recorded corpus, one event per line
+    std::vector<std::string> ReadCorpus(const std::string& path)
+    {
+        std::vector<std::string> events;
+        std::ifstream file(path);
+
+        for (std::string line; std::getline(file, line);)
+        {
+            if (!line.empty())
+            {
+                events.push_back(std::move(line));
+            }
+        }
+
+        return events;
+    }
+
+    /// @brief Builds a corpus resembling the agent traffic: package inventory and syslog events with metadata
+    std::vector<std::string> MakeCorpus(size_t count)
+    {
+        std::vector<std::string> events;
+        events.reserve(count * 2);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                events.emplace_back(R"({"collector":"packages","module":"inventory","operation":"create","id":")" +
+                                    std::to_string(i * 7919) + "\"}");
+                events.emplace_back(R"({"package":{"architecture":"amd64","description":"Library number )" +
+                                    std::to_string(i) + R"(","name":"lib)" + std::to_string(i % 977) +
+                                    R"(","size":)" + std::to_string(i * 13 % 100000) +
+                                    R"(,"type":"deb","version":"1.)" + std::to_string(i % 31) + R"(.0-1"}})");
+            }
+            else
+            {
+                events.emplace_back(R"({"module":"logcollector","type":"file"})");
+                events.emplace_back(R"({"log":{"file":{"path":"/var/log/syslog"}},"event":{"original":"Jan 1 )" +
+                                    std::to_string(i % 24) + ":" + std::to_string(i % 60) +
+                                    R"(:00 host sshd[)" + std::to_string(i % 65535) +
+                                    R"(]: Accepted publickey for user from 10.0.0.)" + std::to_string(i % 255) +
+                                    R"( port 22","offset":)" + std::to_string(i * 64) + "}}");
+            }
+        }
+
+        return events;
+    }
+
+    void Run(const std::vector<std::string>& events, const http_client::CompressionOptions& options, const char* name)
+    {
+        const auto cpuStart = std::clock();
+        const auto start = std::chrono::steady_clock::now();
+
+        auto compressor = std::make_unique<http_client::BodyCompressor>(options);
+        size_t input = 0;
+        size_t output = 0;
+        size_t batches = 1;
+
+        for (const auto& event : events)
+        {
+            if (compressor->InputSize() > 0 && compressor->MaxSize(event.size() + 1) > BATCH_SIZE)
+            {
+                compressor->Flush();
+
+                if (compressor->MaxSize(event.size() + 1) > BATCH_SIZE)
+                {
+                    input += compressor->InputSize();
+                    output += compressor->Finish().size();
+                    compressor = std::make_unique<http_client::BodyCompressor>(options);
+                    ++batches;
+                }
+            }
+
+            compressor->Write("\n");
+            compressor->Write(event);
+        }
+
+        input += compressor->InputSize();
+        output += compressor->Finish().size();
+
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const auto megabytes = static_cast<double>(input) / 1e6;
+
+        std::printf("%-6s level %2d %10.2f MB -> %10.2f MB in %5zu batches  ratio %6.2f  cpu %7.3f s  %8.1f MB/s\n",
+                    name,
+                    options.Level,
+                    megabytes,
+                    static_cast<double>(output) / 1e6,
+                    batches,
+                    static_cast<double>(input) / static_cast<double>(output),
+                    cpu,
+                    megabytes / elapsed);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> events;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        auto corpus = ReadCorpus(argv[i]);
+        events.insert(events.end(), corpus.begin(), corpus.end());
+    }
+
+    if (events.empty())
+    {
+        events = MakeCorpus(DEFAULT_EVENTS);
+    }
+
+    Run(events, {http_client::ContentEncoding::IDENTITY, 0}, "none");
+
+    for (const auto level : {1, 3, 6, 9})
+    {
+        Run(events, {http_client::ContentEncoding::GZIP, level}, "gzip");
+    }
+
+    for (const auto level : {1, 3, 6, 9})
+    {
+        Run(events, {http_client::ContentEncoding::ZSTD, level}, "zstd");
+    }
+
+    return 0;
+}
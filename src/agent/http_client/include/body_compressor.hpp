@@ -0,0 +1,88 @@
+#pragma once
+
+#include <http_request_params.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace http_client
+{
+    /// @brief Codec and level used to compress request bodies
+    struct CompressionOptions
+    {
+        ContentEncoding Encoding = ContentEncoding::IDENTITY;
+
+        /// @brief Compression level, capped to the maximum supported by the codec
+        int Level = 0;
+    };
+
+    /// @brief Parses an encoding name as used in the configuration ("none", "gzip" or "zstd")
+    /// @param name The encoding name
+    /// @return The encoding, or std::nullopt if the name is not supported
+    std::optional<ContentEncoding> ContentEncodingFromString(const std::string& name);
+
+    /// @brief Gets the value of the Content-Encoding header for an encoding
+    /// @param encoding The encoding
+    /// @return The header value, empty for ContentEncoding::IDENTITY
+    std::string ContentEncodingToString(ContentEncoding encoding);
+
+    class ICompressionCodec;
+
+    /// @brief Builds a request body by compressing data as it is written
+    ///
+    /// Data is compressed into the body in a single streaming pass, so the uncompressed batch is never
+    /// held in memory as a whole. With ContentEncoding::IDENTITY data is appended as is.
+    class BodyCompressor
+    {
+    public:
+        /// @brief Constructor
+        /// @param options The codec and level to use
+        explicit BodyCompressor(const CompressionOptions& options);
+
+        /// @brief Destructor
+        ~BodyCompressor();
+
+        BodyCompressor(const BodyCompressor&) = delete;
+        BodyCompressor& operator=(const BodyCompressor&) = delete;
+
+        /// @brief Compresses data into the body
+        /// @param data The data to append
+        void Write(std::string_view data);
+
+        /// @brief Flushes the data buffered by the codec into the body, so that Size is exact
+        /// @note Every flush ends a compressed block, flushing too often lowers the compression ratio
+        void Flush();
+
+        /// @brief Gets the size of the body built so far
+        /// @return The size in bytes, not including data buffered by the codec since the last flush
+        size_t Size() const;
+
+        /// @brief Gets the maximum size the finished body can have
+        /// @param extraInput Size of data that would be written before finishing
+        /// @return Upper bound in bytes of the body size, exact for ContentEncoding::IDENTITY
+        size_t MaxSize(size_t extraInput = 0) const;
+
+        /// @brief Gets the amount of data written
+        /// @return The uncompressed size in bytes
+        size_t InputSize() const;
+
+        /// @brief Finishes the compressed stream and returns the body
+        /// @return The body, the compressor must not be used afterwards
+        std::string Finish();
+
+    private:
+        /// @brief The codec, nullptr for ContentEncoding::IDENTITY
+        std::unique_ptr<ICompressionCodec> m_codec;
+
+        /// @brief The body being built
+        std::string m_body;
+
+        /// @brief Amount of data written
+        size_t m_inputSize = 0;
+
+        /// @brief Amount of data written since the last flush
+        size_t m_unflushedSize = 0;
+    };
+} // namespace http_client
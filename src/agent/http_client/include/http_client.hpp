@@ -11,34 +11,54 @@
 
 namespace http_client
 {
+    class HttpConnectionPool;
     class IHttpResolverFactory;
+    class IHttpSocket;
     class IHttpSocketFactory;
+    struct ConnectionKey;
 
     /// @brief HTTP client implementation
     ///
     /// This class implements the IHttpClient interface, providing
-    /// functionality for creating and performing HTTP requests.
+    /// functionality for creating and performing HTTP requests. Asynchronous
+    /// requests reuse HTTP/1.1 keep-alive connections, resolved endpoints and
+    /// TLS sessions through a connection pool.
     class HttpClient : public IHttpClient
     {
     public:
         /// @brief Constructs an HttpClient with optional factories
         /// @param resolverFactory Factory to create HTTP resolvers
         /// @param socketFactory Factory to create HTTP sockets
+        /// @param connectionPool Pool of persistent connections
         HttpClient(std::shared_ptr<IHttpResolverFactory> resolverFactory = nullptr,
-                   std::shared_ptr<IHttpSocketFactory> socketFactory = nullptr);
+                   std::shared_ptr<IHttpSocketFactory> socketFactory = nullptr,
+                   std::shared_ptr<HttpConnectionPool> connectionPool = nullptr);
+
+        /// @brief Destructor, closes the pooled connections
+        ~HttpClient() override;
 
         /// @copydoc IHttpClient::Co_PerformHttpRequest
         boost::asio::awaitable<std::tuple<int, std::string>>
-        Co_PerformHttpRequest(const HttpRequestParams params) override;
+        Co_PerformHttpRequest(HttpRequestParams params) override;
 
         /// @copydoc IHttpClient::PerformHttpRequest
         std::tuple<int, std::string> PerformHttpRequest(const HttpRequestParams& params) override;
 
     private:
+        /// @brief Resolves the host (or uses its cached endpoints) and opens a new connection
+        /// @param key The connection key
+        /// @param params The parameters for the request
+        /// @return An awaitable with the connected socket
+        boost::asio::awaitable<std::unique_ptr<IHttpSocket>> Co_Connect(const ConnectionKey& key,
+                                                                        const HttpRequestParams& params);
+
         /// @brief HTTP resolver factory
         std::shared_ptr<IHttpResolverFactory> m_resolverFactory;
 
         /// @brief HTTP socket factory
         std::shared_ptr<IHttpSocketFactory> m_socketFactory;
+
+        /// @brief Pool of persistent connections
+        std::shared_ptr<HttpConnectionPool> m_connectionPool;
     };
 } // namespace http_client
@@ -23,6 +23,14 @@ namespace http_client
         DELETE_
     };
 
+    /// @brief Supported encodings of the request body
+    enum class ContentEncoding
+    {
+        IDENTITY,
+        GZIP,
+        ZSTD
+    };
+
     /// @struct HttpRequestParams
     /// @brief Parameters for HTTP requests
     struct HttpRequestParams
@@ -38,6 +46,7 @@ namespace http_client
         std::string Body;
         bool Use_Https;
         time_t RequestTimeout;
+        ContentEncoding Content_Encoding = ContentEncoding::IDENTITY;
 
         /// @brief Constructs HttpRequestParams with specified parameters
         /// @param method The HTTP method to use
@@ -24,7 +24,7 @@ namespace http_client
         /// @param params The parameters for the request
         /// @return An awaitable tuple containing the response status code and body
         virtual boost::asio::awaitable<std::tuple<int, std::string>>
-        Co_PerformHttpRequest(const HttpRequestParams params) = 0;
+        Co_PerformHttpRequest(HttpRequestParams params) = 0;
 
         /// @brief Perform an HTTP request and receive the response
         /// @param params The parameters for the request
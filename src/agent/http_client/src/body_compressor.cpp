@@ -0,0 +1,273 @@
+#include <body_compressor.hpp>
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    /// @brief Room added to the body each time a codec needs more output space
+    constexpr size_t OUTPUT_CHUNK_SIZE = 16 * 1024;
+
+    /// @brief gzip window size (32KB) plus 16, which makes zlib write a gzip header and trailer
+    constexpr int GZIP_WINDOW_BITS = 15 + 16;
+
+    /// @brief zlib default memory level
+    constexpr int GZIP_MEM_LEVEL = 8;
+
+    /// @brief Bytes a flush and the end of the stream may add on top of the codec bounds: the gzip sync marker,
+    /// final block and trailer, or the zstd block headers
+    constexpr size_t FLUSH_AND_END_OVERHEAD = 32;
+} // namespace
+
+namespace http_client
+{
+    /// @brief Streaming compression codec
+    class ICompressionCodec
+    {
+    public:
+        /// @brief How much of the buffered data a call must write out
+        enum class Mode
+        {
+            CONTINUE,
+            FLUSH,
+            FINISH
+        };
+
+        /// @brief Destructor
+        virtual ~ICompressionCodec() = default;
+
+        /// @brief Compresses data, appending the output to a string
+        /// @param input The data to compress, may be empty
+        /// @param output The string the compressed data is appended to
+        /// @param mode Whether buffered data must be flushed or the stream finished
+        virtual void Compress(std::string_view input, std::string& output, Mode mode) = 0;
+
+        /// @brief Gets the maximum size of the compressed data
+        /// @param inputSize The size of the data to compress
+        /// @return The worst-case compressed size, for incompressible data
+        virtual size_t Bound(size_t inputSize) const = 0;
+    };
+
+    namespace
+    {
+        /// @brief gzip codec based on zlib
+        class GzipCodec : public ICompressionCodec
+        {
+        public:
+            explicit GzipCodec(const int level)
+            {
+                const auto gzipLevel = level <= 0 ? Z_DEFAULT_COMPRESSION : std::min(level, Z_BEST_COMPRESSION);
+
+                if (deflateInit2(
+                        &m_stream, gzipLevel, Z_DEFLATED, GZIP_WINDOW_BITS, GZIP_MEM_LEVEL, Z_DEFAULT_STRATEGY) !=
+                    Z_OK)
+                {
+                    throw std::runtime_error("Failed to initialize gzip compression.");
+                }
+            }
+
+            ~GzipCodec() override
+            {
+                deflateEnd(&m_stream);
+            }
+
+            GzipCodec(const GzipCodec&) = delete;
+            GzipCodec& operator=(const GzipCodec&) = delete;
+
+            void Compress(std::string_view input, std::string& output, Mode mode) override
+            {
+                const auto flush = mode == Mode::FINISH ? Z_FINISH : (mode == Mode::FLUSH ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+                m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+                m_stream.avail_in = static_cast<uInt>(input.size());
+
+                int result = Z_OK;
+
+                do
+                {
+                    const auto offset = output.size();
+                    output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+                    m_stream.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+                    m_stream.avail_out = static_cast<uInt>(OUTPUT_CHUNK_SIZE);
+
+                    result = deflate(&m_stream, flush);
+
+                    output.resize(output.size() - m_stream.avail_out);
+
+                    if (result == Z_STREAM_ERROR)
+                    {
+                        throw std::runtime_error("gzip compression failed.");
+                    }
+                } while (m_stream.avail_out == 0 || (mode == Mode::FINISH && result != Z_STREAM_END));
+            }
+
+            size_t Bound(size_t inputSize) const override
+            {
+                return compressBound(static_cast<uLong>(inputSize));
+            }
+
+        private:
+            z_stream m_stream {};
+        };
+
+        /// @brief zstd codec
+        class ZstdCodec : public ICompressionCodec
+        {
+        public:
+            explicit ZstdCodec(const int level)
+                : m_context(ZSTD_createCCtx())
+            {
+                if (m_context == nullptr)
+                {
+                    throw std::runtime_error("Failed to initialize zstd compression.");
+                }
+
+                const auto zstdLevel = level <= 0 ? ZSTD_CLEVEL_DEFAULT : std::min(level, ZSTD_maxCLevel());
+                ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, zstdLevel);
+            }
+
+            ~ZstdCodec() override
+            {
+                ZSTD_freeCCtx(m_context);
+            }
+
+            ZstdCodec(const ZstdCodec&) = delete;
+            ZstdCodec& operator=(const ZstdCodec&) = delete;
+
+            void Compress(std::string_view input, std::string& output, Mode mode) override
+            {
+                const auto directive =
+                    mode == Mode::FINISH ? ZSTD_e_end : (mode == Mode::FLUSH ? ZSTD_e_flush : ZSTD_e_continue);
+
+                ZSTD_inBuffer in {input.data(), input.size(), 0};
+                size_t remaining = 0;
+
+                do
+                {
+                    const auto offset = output.size();
+                    output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+                    ZSTD_outBuffer out {output.data() + offset, OUTPUT_CHUNK_SIZE, 0};
+                    remaining = ZSTD_compressStream2(m_context, &out, &in, directive);
+
+                    output.resize(offset + out.pos);
+
+                    if (ZSTD_isError(remaining))
+                    {
+                        throw std::runtime_error(std::string("zstd compression failed: ") +
+                                                 ZSTD_getErrorName(remaining));
+                    }
+                } while (in.pos < in.size || (mode != Mode::CONTINUE && remaining != 0));
+            }
+
+            size_t Bound(size_t inputSize) const override
+            {
+                return ZSTD_compressBound(inputSize);
+            }
+
+        private:
+            ZSTD_CCtx* m_context;
+        };
+    } // namespace
+
+    std::optional<ContentEncoding> ContentEncodingFromString(const std::string& name)
+    {
+        if (name == "none")
+        {
+            return ContentEncoding::IDENTITY;
+        }
+        if (name == "gzip")
+        {
+            return ContentEncoding::GZIP;
+        }
+        if (name == "zstd")
+        {
+            return ContentEncoding::ZSTD;
+        }
+        return std::nullopt;
+    }
+
+    std::string ContentEncodingToString(const ContentEncoding encoding)
+    {
+        switch (encoding)
+        {
+            case ContentEncoding::GZIP: return "gzip";
+            case ContentEncoding::ZSTD: return "zstd";
+            case ContentEncoding::IDENTITY: return "";
+        }
+        return "";
+    }
+
+    BodyCompressor::BodyCompressor(const CompressionOptions& options)
+    {
+        switch (options.Encoding)
+        {
+            case ContentEncoding::GZIP: m_codec = std::make_unique<GzipCodec>(options.Level); break;
+            case ContentEncoding::ZSTD: m_codec = std::make_unique<ZstdCodec>(options.Level); break;
+            case ContentEncoding::IDENTITY: break;
+        }
+    }
+
+    BodyCompressor::~BodyCompressor() = default;
+
+    void BodyCompressor::Write(std::string_view data)
+    {
+        m_inputSize += data.size();
+        m_unflushedSize += data.size();
+
+        if (m_codec)
+        {
+            m_codec->Compress(data, m_body, ICompressionCodec::Mode::CONTINUE);
+        }
+        else
+        {
+            m_body.append(data);
+        }
+    }
+
+    void BodyCompressor::Flush()
+    {
+        if (m_codec)
+        {
+            m_codec->Compress({}, m_body, ICompressionCodec::Mode::FLUSH);
+        }
+
+        m_unflushedSize = 0;
+    }
+
+    size_t BodyCompressor::Size() const
+    {
+        return m_body.size();
+    }
+
+    size_t BodyCompressor::MaxSize(size_t extraInput) const
+    {
+        if (!m_codec)
+        {
+            return m_body.size() + extraInput;
+        }
+
+        return m_body.size() + m_codec->Bound(m_unflushedSize + extraInput) + FLUSH_AND_END_OVERHEAD;
+    }
+
+    size_t BodyCompressor::InputSize() const
+    {
+        return m_inputSize;
+    }
+
+    std::string BodyCompressor::Finish()
+    {
+        if (m_codec)
+        {
+            m_codec->Compress({}, m_body, ICompressionCodec::Mode::FINISH);
+            m_codec.reset();
+        }
+
+        return std::move(m_body);
+    }
+} // namespace http_client
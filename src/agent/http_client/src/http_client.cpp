@@ -1,11 +1,15 @@
 #include <http_client.hpp>
 
+#include <body_compressor.hpp>
+
+#include "http_connection_pool.hpp"
 #include "http_resolver_factory.hpp"
 #include "http_socket_factory.hpp"
 #include "ihttp_resolver_factory.hpp"
 #include "ihttp_socket_factory.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/ssl/error.hpp>
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/detail/base64.hpp>
 #include <boost/beast/core/ostream.hpp>
@@ -29,8 +33,9 @@ namespace
         }
     }
 
+    /// @brief Builds the request, taking over the body so that large batches are not copied
     boost::beast::http::request<boost::beast::http::string_body>
-    CreateHttpRequest(const http_client::HttpRequestParams& params)
+    CreateHttpRequest(const http_client::HttpRequestParams& params, std::string body)
     {
         static constexpr int HttpVersion1_1 = 11;
 
@@ -56,17 +61,41 @@ namespace
             req.set(boost::beast::http::field::authorization, "Basic " + basicAuth);
         }
 
-        if (!params.Body.empty())
+        if (!body.empty())
         {
             req.set(boost::beast::http::field::content_type, "application/json");
             req.set(boost::beast::http::field::transfer_encoding, "chunked");
-            req.body() = params.Body;
+
+            if (params.Content_Encoding != http_client::ContentEncoding::IDENTITY)
+            {
+                req.set(boost::beast::http::field::content_encoding,
+                        http_client::ContentEncodingToString(params.Content_Encoding));
+            }
+
+            req.body() = std::move(body);
             req.prepare_payload();
         }
 
         return req;
     }
 
+    /// @brief Checks whether an error means the server closed a kept-alive connection while it was idle
+    bool IsStaleConnectionError(const boost::system::error_code& ec)
+    {
+        return ec == boost::beast::http::error::end_of_stream || ec == boost::asio::error::eof ||
+               ec == boost::asio::error::connection_reset || ec == boost::asio::error::connection_aborted ||
+               ec == boost::asio::error::broken_pipe || ec == boost::asio::ssl::error::stream_truncated;
+    }
+
+    /// @brief Checks whether the server could have handled a request that failed on a kept-alive connection
+    /// @details A request is only sent again if it is idempotent, or if it failed before any response byte
+    /// was read: on a failed write, or when the connection was closed before the response started
+    bool CanResendRequest(http_client::MethodType method, bool writeFailed, const boost::system::error_code& ec)
+    {
+        return method != http_client::MethodType::POST || writeFailed ||
+               ec == boost::beast::http::error::end_of_stream;
+    }
+
     std::string ResponseToString(const std::string& endpoint,
                                  const boost::beast::http::response<boost::beast::http::dynamic_body>& res)
     {
@@ -79,7 +108,8 @@ namespace
 namespace http_client
 {
     HttpClient::HttpClient(std::shared_ptr<IHttpResolverFactory> resolverFactory,
-                           std::shared_ptr<IHttpSocketFactory> socketFactory)
+                           std::shared_ptr<IHttpSocketFactory> socketFactory,
+                           std::shared_ptr<HttpConnectionPool> connectionPool)
     {
         if (resolverFactory != nullptr)
         {
@@ -98,65 +128,159 @@ namespace http_client
         {
             m_socketFactory = std::make_shared<HttpSocketFactory>();
         }
+
+        if (connectionPool != nullptr)
+        {
+            m_connectionPool = std::move(connectionPool);
+        }
+        else
+        {
+            m_connectionPool = std::make_shared<HttpConnectionPool>();
+        }
     }
 
-    boost::asio::awaitable<std::tuple<int, std::string>>
-    HttpClient::Co_PerformHttpRequest(const HttpRequestParams params)
+    HttpClient::~HttpClient()
     {
-        boost::beast::http::response<boost::beast::http::dynamic_body> res;
+        m_connectionPool->Clear();
+    }
 
-        try
+    // NOLINTBEGIN(cppcoreguidelines-avoid-reference-coroutine-parameters)
+    boost::asio::awaitable<std::unique_ptr<IHttpSocket>> HttpClient::Co_Connect(const ConnectionKey& key,
+                                                                                const HttpRequestParams& params)
+    {
+        auto executor = co_await boost::asio::this_coro::executor;
+
+        auto results = m_connectionPool->GetCachedEndpoints(params.Host, params.Port);
+
+        if (!results.has_value())
         {
-            auto executor = co_await boost::asio::this_coro::executor;
             auto resolver = m_resolverFactory->Create(executor);
 
-            const auto results = co_await resolver->AsyncResolve(params.Host, params.Port);
+            results = co_await resolver->AsyncResolve(params.Host, params.Port);
 
-            if (results.empty())
+            if (results->empty())
             {
                 throw std::runtime_error("Failed to resolve host.");
             }
 
-            auto socket = m_socketFactory->Create(executor, params.Use_Https);
+            m_connectionPool->CacheEndpoints(params.Host, params.Port, *results);
+        }
 
-            if (!socket)
-            {
-                throw std::runtime_error("Failed to create socket.");
-            }
+        auto socket = m_socketFactory->Create(executor, params.Use_Https);
 
-            if (params.Use_Https)
-            {
-                socket->SetVerificationMode(params.Host, params.Verification_Mode);
-            }
+        if (!socket)
+        {
+            throw std::runtime_error("Failed to create socket.");
+        }
 
-            if (params.RequestTimeout)
+        if (params.Use_Https)
+        {
+            socket->SetVerificationMode(params.Host, params.Verification_Mode);
+
+            if (auto session = m_connectionPool->GetTlsSession(key))
             {
-                socket->SetTimeout(std::chrono::milliseconds(params.RequestTimeout));
+                socket->SetTlsSession(std::move(session));
             }
+        }
+
+        if (params.RequestTimeout)
+        {
+            socket->SetTimeout(std::chrono::milliseconds(params.RequestTimeout));
+        }
+
+        boost::system::error_code ec;
+
+        co_await socket->AsyncConnect(*results, ec);
+
+        if (ec)
+        {
+            m_connectionPool->InvalidateEndpoints(params.Host, params.Port);
+            throw std::runtime_error("Error connecting to host: " + ec.message());
+        }
+
+        co_return socket;
+    }
+
+    // NOLINTEND(cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+    boost::asio::awaitable<std::tuple<int, std::string>>
+    HttpClient::Co_PerformHttpRequest(HttpRequestParams params)
+    {
+        boost::beast::http::response<boost::beast::http::dynamic_body> res;
+
+        try
+        {
+            auto executor = co_await boost::asio::this_coro::executor;
+            const ConnectionKey key {params.Host, params.Port, params.Use_Https, params.Verification_Mode};
+            const auto req = CreateHttpRequest(params, std::move(params.Body));
 
             boost::system::error_code ec;
 
-            co_await socket->AsyncConnect(results, ec);
+            auto socket = m_connectionPool->Acquire(key, executor);
 
-            if (ec)
+            if (socket)
             {
-                throw std::runtime_error("Error connecting to host: " + ec.message());
+                socket->SetTimeout(params.RequestTimeout ? std::chrono::milliseconds(params.RequestTimeout)
+                                                         : SOCKET_TIMEOUT);
+
+                co_await socket->AsyncWrite(req, ec);
+
+                const bool writeFailed = static_cast<bool>(ec);
+
+                if (!writeFailed)
+                {
+                    co_await socket->AsyncRead(res, ec);
+                }
+
+                if (IsStaleConnectionError(ec) && CanResendRequest(params.Method, writeFailed, ec))
+                {
+                    // The server closed the idle connection, the request is sent again on a new one
+                    LogDebug("Pooled connection closed by peer: {}. Reconnecting.", ec.message());
+                    socket->Close();
+                    socket.reset();
+                    res = {};
+                    ec.clear();
+                }
+                else if (ec)
+                {
+                    throw std::runtime_error((writeFailed ? "Error writing request: " : "Error handling response: ") +
+                                             ec.message());
+                }
             }
 
-            const auto req = CreateHttpRequest(params);
+            if (!socket)
+            {
+                socket = co_await Co_Connect(key, params);
 
-            co_await socket->AsyncWrite(req, ec);
+                co_await socket->AsyncWrite(req, ec);
 
-            if (ec)
-            {
-                throw std::runtime_error("Error writing request: " + ec.message());
-            }
+                if (ec)
+                {
+                    throw std::runtime_error("Error writing request: " + ec.message());
+                }
 
-            co_await socket->AsyncRead(res, ec);
+                co_await socket->AsyncRead(res, ec);
 
-            if (ec)
+                if (ec)
+                {
+                    throw std::runtime_error("Error handling response: " + ec.message());
+                }
+
+                if (params.Use_Https)
+                {
+                    // TLS 1.3 delivers session tickets after the handshake, so the session is taken once a
+                    // response has been read
+                    m_connectionPool->SetTlsSession(key, socket->GetTlsSession());
+                }
+            }
+
+            if (res.keep_alive())
             {
-                throw std::runtime_error("Error handling response: " + ec.message());
+                m_connectionPool->Release(key, executor, std::move(socket));
+            }
+            else
+            {
+                socket->Close();
             }
 
             LogDebug("Request {}: Status {}", params.Endpoint, res.result_int());
@@ -212,7 +336,7 @@ namespace http_client
                 throw std::runtime_error("Error connecting to host: " + ec.message());
             }
 
-            const auto req = CreateHttpRequest(params);
+            const auto req = CreateHttpRequest(params, params.Body);
 
             socket->Write(req, ec);
             io_context.run();
@@ -0,0 +1,141 @@
+#include <http_connection_pool.hpp>
+
+#include <logger.hpp>
+
+namespace http_client
+{
+    HttpConnectionPool::HttpConnectionPool(std::chrono::steady_clock::duration idleTimeout,
+                                           std::chrono::steady_clock::duration dnsCacheTtl,
+                                           size_t maxIdlePerKey)
+        : m_idleTimeout(idleTimeout)
+        , m_dnsCacheTtl(dnsCacheTtl)
+        , m_maxIdlePerKey(maxIdlePerKey)
+    {
+    }
+
+    std::unique_ptr<IHttpSocket> HttpConnectionPool::Acquire(const ConnectionKey& key,
+                                                             const boost::asio::any_io_executor& executor)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto it = m_idleConnections.find(key);
+
+        if (it == m_idleConnections.end())
+        {
+            return nullptr;
+        }
+
+        auto& connections = it->second;
+        const auto now = std::chrono::steady_clock::now();
+
+        // Most recently used connections are the least likely to have been closed by the server
+        while (!connections.empty())
+        {
+            auto connection = std::move(connections.back());
+            connections.pop_back();
+
+            if (now - connection.LastUsed < m_idleTimeout && connection.Executor == executor)
+            {
+                LogTrace("Reusing connection to {}:{}.", key.Host, key.Port);
+                return std::move(connection.Socket);
+            }
+
+            connection.Socket->Close();
+        }
+
+        return nullptr;
+    }
+
+    void HttpConnectionPool::Release(const ConnectionKey& key,
+                                     const boost::asio::any_io_executor& executor,
+                                     std::unique_ptr<IHttpSocket> socket)
+    {
+        if (!socket)
+        {
+            return;
+        }
+
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto& connections = m_idleConnections[key];
+
+        if (connections.size() >= m_maxIdlePerKey)
+        {
+            connections.front().Socket->Close();
+            connections.pop_front();
+        }
+
+        connections.push_back({std::move(socket), executor, std::chrono::steady_clock::now()});
+    }
+
+    std::optional<boost::asio::ip::tcp::resolver::results_type>
+    HttpConnectionPool::GetCachedEndpoints(const std::string& host, const std::string& port)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto it = m_dnsCache.find({host, port});
+
+        if (it == m_dnsCache.end())
+        {
+            return std::nullopt;
+        }
+
+        if (std::chrono::steady_clock::now() - it->second.ResolvedAt >= m_dnsCacheTtl)
+        {
+            m_dnsCache.erase(it);
+            return std::nullopt;
+        }
+
+        return it->second.Endpoints;
+    }
+
+    void HttpConnectionPool::CacheEndpoints(const std::string& host,
+                                            const std::string& port,
+                                            const boost::asio::ip::tcp::resolver::results_type& endpoints)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_dnsCache[{host, port}] = {endpoints, std::chrono::steady_clock::now()};
+    }
+
+    void HttpConnectionPool::InvalidateEndpoints(const std::string& host, const std::string& port)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_dnsCache.erase({host, port});
+    }
+
+    std::shared_ptr<SSL_SESSION> HttpConnectionPool::GetTlsSession(const ConnectionKey& key)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        const auto it = m_tlsSessions.find(key);
+        return it != m_tlsSessions.end() ? it->second : nullptr;
+    }
+
+    void HttpConnectionPool::SetTlsSession(const ConnectionKey& key, std::shared_ptr<SSL_SESSION> session)
+    {
+        if (!session)
+        {
+            return;
+        }
+
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_tlsSessions[key] = std::move(session);
+    }
+
+    void HttpConnectionPool::Clear()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto& [key, connections] : m_idleConnections)
+        {
+            for (auto& connection : connections)
+            {
+                connection.Socket->Close();
+            }
+        }
+
+        m_idleConnections.clear();
+        m_dnsCache.clear();
+        m_tlsSessions.clear();
+    }
+} // namespace http_client
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <ihttp_socket.hpp>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <openssl/ssl.h>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace http_client
+{
+    /// @brief Time an idle connection is kept in the pool before being discarded
+    constexpr auto CONNECTION_IDLE_TIMEOUT = std::chrono::seconds {15};
+
+    /// @brief Time a resolved host is kept in the DNS cache
+    constexpr auto DNS_CACHE_TTL = std::chrono::seconds {60};
+
+    /// @brief Maximum number of idle connections kept for the same key
+    constexpr size_t MAX_IDLE_CONNECTIONS_PER_KEY = 4;
+
+    /// @brief Identifies the connections that can be shared between requests
+    struct ConnectionKey
+    {
+        std::string Host;
+        std::string Port;
+        bool Use_Https;
+        std::string Verification_Mode;
+
+        /// @brief Three-way comparison, needed to use the key in ordered containers
+        auto operator<=>(const ConnectionKey& other) const = default;
+    };
+
+    /// @brief Pool of persistent (keep-alive) HTTP connections
+    ///
+    /// Keeps idle connections per (host, port, scheme, verification mode), the last TLS session
+    /// negotiated for each of them so new connections can resume it, and the resolved endpoints
+    /// of every host for a limited time. All methods are thread safe.
+    /// @note Pooled sockets are bound to the executor they were created with, so the pool must
+    /// not outlive the io_context that runs the requests.
+    class HttpConnectionPool
+    {
+    public:
+        /// @brief Constructs an HttpConnectionPool
+        /// @param idleTimeout Time an idle connection can be reused
+        /// @param dnsCacheTtl Time resolved endpoints are cached
+        /// @param maxIdlePerKey Maximum number of idle connections kept for the same key
+        HttpConnectionPool(std::chrono::steady_clock::duration idleTimeout = CONNECTION_IDLE_TIMEOUT,
+                           std::chrono::steady_clock::duration dnsCacheTtl = DNS_CACHE_TTL,
+                           size_t maxIdlePerKey = MAX_IDLE_CONNECTIONS_PER_KEY);
+
+        /// @brief Takes an idle connection out of the pool
+        /// @param key The connection key
+        /// @param executor The executor the connection will be used on
+        /// @return The connection, or nullptr if there is no reusable one
+        std::unique_ptr<IHttpSocket> Acquire(const ConnectionKey& key, const boost::asio::any_io_executor& executor);
+
+        /// @brief Returns a connection to the pool so it can be reused
+        /// @param key The connection key
+        /// @param executor The executor the connection was created with
+        /// @param socket The connection, which must be ready to send a new request
+        void Release(const ConnectionKey& key,
+                     const boost::asio::any_io_executor& executor,
+                     std::unique_ptr<IHttpSocket> socket);
+
+        /// @brief Gets the cached endpoints of a host
+        /// @param host The host name
+        /// @param port The port
+        /// @return The endpoints, or std::nullopt if they are not cached or have expired
+        std::optional<boost::asio::ip::tcp::resolver::results_type> GetCachedEndpoints(const std::string& host,
+                                                                                       const std::string& port);
+
+        /// @brief Caches the endpoints of a host
+        /// @param host The host name
+        /// @param port The port
+        /// @param endpoints The resolved endpoints
+        void CacheEndpoints(const std::string& host,
+                            const std::string& port,
+                            const boost::asio::ip::tcp::resolver::results_type& endpoints);
+
+        /// @brief Removes the cached endpoints of a host, e.g. after failing to connect to them
+        /// @param host The host name
+        /// @param port The port
+        void InvalidateEndpoints(const std::string& host, const std::string& port);
+
+        /// @brief Gets the last TLS session negotiated for a key
+        /// @param key The connection key
+        /// @return The session, or nullptr if there is none
+        std::shared_ptr<SSL_SESSION> GetTlsSession(const ConnectionKey& key);
+
+        /// @brief Stores the TLS session negotiated for a key so new connections can resume it
+        /// @param key The connection key
+        /// @param session The session
+        void SetTlsSession(const ConnectionKey& key, std::shared_ptr<SSL_SESSION> session);
+
+        /// @brief Closes all idle connections and drops cached endpoints and sessions
+        void Clear();
+
+    private:
+        /// @brief A connection waiting to be reused
+        struct IdleConnection
+        {
+            std::unique_ptr<IHttpSocket> Socket;
+            boost::asio::any_io_executor Executor;
+            std::chrono::steady_clock::time_point LastUsed;
+        };
+
+        /// @brief Resolved endpoints and the time they were resolved
+        struct CachedEndpoints
+        {
+            boost::asio::ip::tcp::resolver::results_type Endpoints;
+            std::chrono::steady_clock::time_point ResolvedAt;
+        };
+
+        /// @brief Time an idle connection can be reused
+        const std::chrono::steady_clock::duration m_idleTimeout;
+
+        /// @brief Time resolved endpoints are cached
+        const std::chrono::steady_clock::duration m_dnsCacheTtl;
+
+        /// @brief Maximum number of idle connections kept for the same key
+        const size_t m_maxIdlePerKey;
+
+        /// @brief Mutex protecting the pool state
+        std::mutex m_mutex;
+
+        /// @brief Idle connections, most recently used last
+        std::map<ConnectionKey, std::deque<IdleConnection>> m_idleConnections;
+
+        /// @brief Resolved endpoints per (host, port)
+        std::map<std::pair<std::string, std::string>, CachedEndpoints> m_dnsCache;
+
+        /// @brief Last TLS session negotiated per key
+        std::map<ConnectionKey, std::shared_ptr<SSL_SESSION>> m_tlsSessions;
+    };
+} // namespace http_client
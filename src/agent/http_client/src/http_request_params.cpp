@@ -56,6 +56,6 @@ namespace http_client
         return Method == other.Method && Host == other.Host && Port == other.Port && Endpoint == other.Endpoint &&
                User_agent == other.User_agent && Verification_Mode == other.Verification_Mode && Token == other.Token &&
                User_pass == other.User_pass && Body == other.Body && Use_Https == other.Use_Https &&
-               RequestTimeout == other.RequestTimeout;
+               RequestTimeout == other.RequestTimeout && Content_Encoding == other.Content_Encoding;
     }
 } // namespace http_client
@@ -116,6 +116,17 @@ namespace http_client
         }
     }
 
+    std::shared_ptr<SSL_SESSION> HttpSocket::GetTlsSession()
+    {
+        // No functionality for HTTP sockets
+        return nullptr;
+    }
+
+    void HttpSocket::SetTlsSession([[maybe_unused]] std::shared_ptr<SSL_SESSION> session)
+    {
+        // No functionality for HTTP sockets
+    }
+
     void HttpSocket::Close()
     {
         try
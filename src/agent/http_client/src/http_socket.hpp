@@ -52,6 +52,12 @@ namespace http_client
         boost::asio::awaitable<void> AsyncRead(boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                                                boost::system::error_code& ec) override;
 
+        /// @copydoc IHttpSocket::GetTlsSession
+        std::shared_ptr<SSL_SESSION> GetTlsSession() override;
+
+        /// @copydoc IHttpSocket::SetTlsSession
+        void SetTlsSession(std::shared_ptr<SSL_SESSION> session) override;
+
         /// @copydoc IHttpSocket::Close
         void Close() override;
 
@@ -73,6 +73,15 @@ namespace http_client
                 m_socket, buffer, res, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
         }
 
+        SSL_SESSION* get_session() override
+        { // No implementation for Http
+            return nullptr;
+        }
+
+        void set_session(SSL_SESSION*) override
+        { // No implementation for Http
+        }
+
         void close() override
         {
             m_socket.close();
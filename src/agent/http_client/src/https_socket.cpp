@@ -141,6 +141,28 @@ namespace http_client
         }
     }
 
+    std::shared_ptr<SSL_SESSION> HttpsSocket::GetTlsSession()
+    {
+        SSL_SESSION* session = m_ssl_socket->get_session();
+
+        if (session == nullptr)
+        {
+            return nullptr;
+        }
+
+        return {session, SSL_SESSION_free};
+    }
+
+    void HttpsSocket::SetTlsSession(std::shared_ptr<SSL_SESSION> session)
+    {
+        m_tlsSession = std::move(session);
+
+        if (m_tlsSession)
+        {
+            m_ssl_socket->set_session(m_tlsSession.get());
+        }
+    }
+
     void HttpsSocket::Close()
     {
         try
@@ -54,6 +54,12 @@ namespace http_client
         boost::asio::awaitable<void> AsyncRead(boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                                                boost::system::error_code& ec) override;
 
+        /// @copydoc IHttpSocket::GetTlsSession
+        std::shared_ptr<SSL_SESSION> GetTlsSession() override;
+
+        /// @copydoc IHttpSocket::SetTlsSession
+        void SetTlsSession(std::shared_ptr<SSL_SESSION> session) override;
+
         /// @copydoc IHttpSocket::Close
         void Close() override;
 
@@ -64,6 +70,9 @@ namespace http_client
         /// @brief The SSL socket to use for the connection
         std::shared_ptr<ISocketWrapper> m_ssl_socket;
 
+        /// @brief TLS session to resume, kept alive until the handshake is done
+        std::shared_ptr<SSL_SESSION> m_tlsSession;
+
         /// @brief Timeout in milliseconds used in every operation
         std::chrono::milliseconds m_timeout {http_client::SOCKET_TIMEOUT};
     };
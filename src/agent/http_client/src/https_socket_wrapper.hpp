@@ -103,15 +103,27 @@ namespace http_client
                   boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                   boost::system::error_code& ec) override
         {
-            boost::beast::http::read(m_socket, buffer, res, ec);
+            const auto bytesRead = boost::beast::http::read(m_socket, buffer, res, ec);
+            SetEndOfStream(bytesRead, buffer, ec);
         }
 
         boost::asio::awaitable<void> async_read(boost::beast::flat_buffer& buffer,
                                                 boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                                                 boost::system::error_code& ec) override
         {
-            co_await boost::beast::http::async_read(
+            const auto bytesRead = co_await boost::beast::http::async_read(
                 m_socket, buffer, res, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            SetEndOfStream(bytesRead, buffer, ec);
+        }
+
+        SSL_SESSION* get_session() override
+        {
+            return SSL_get1_session(m_socket.native_handle());
+        }
+
+        void set_session(SSL_SESSION* session) override
+        {
+            SSL_set_session(m_socket.native_handle(), session);
         }
 
         void close() override
@@ -120,6 +132,19 @@ namespace http_client
         }
 
     private:
+        /// @brief Reports a connection closed without close_notify before any response byte as end_of_stream
+        /// @details Beast does the same for plain connections, which tells an idle connection closed by the
+        /// server apart from a response cut short
+        static void SetEndOfStream(std::size_t bytesRead,
+                                   const boost::beast::flat_buffer& buffer,
+                                   boost::system::error_code& ec)
+        {
+            if (ec == boost::asio::ssl::error::stream_truncated && bytesRead == 0 && buffer.size() == 0)
+            {
+                ec = boost::beast::http::error::end_of_stream;
+            }
+        }
+
         boost::beast::ssl_stream<boost::beast::tcp_stream> m_socket;
     };
 } // namespace http_client
@@ -4,8 +4,10 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/system/error_code.hpp>
+#include <openssl/ssl.h>
 
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace http_client
@@ -71,6 +73,14 @@ namespace http_client
         AsyncRead(boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                   boost::system::error_code& ec) = 0;
 
+        /// @brief Gets the TLS session negotiated by the connection
+        /// @return The session, or nullptr if the connection is not TLS or has not negotiated one yet
+        virtual std::shared_ptr<SSL_SESSION> GetTlsSession() = 0;
+
+        /// @brief Sets a TLS session to resume on the next handshake
+        /// @param session The session, which must be set before connecting
+        virtual void SetTlsSession(std::shared_ptr<SSL_SESSION> session) = 0;
+
         /// @brief Closes the socket
         virtual void Close() = 0;
     };
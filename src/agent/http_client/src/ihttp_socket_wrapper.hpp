@@ -45,6 +45,11 @@ namespace http_client
                    boost::beast::http::response<boost::beast::http::dynamic_body>& res,
                    boost::system::error_code& ec) = 0;
 
+        /// @brief Returns a new reference to the TLS session, to be released with SSL_SESSION_free
+        virtual SSL_SESSION* get_session() = 0;
+
+        virtual void set_session(SSL_SESSION* session) = 0;
+
         virtual void close() = 0;
     };
 
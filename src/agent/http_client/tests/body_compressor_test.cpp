@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <body_compressor.hpp>
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <string>
+
+namespace
+{
+    std::string Gunzip(const std::string& input)
+    {
+        z_stream stream {};
+        // Window bits 15 + 32 enable automatic gzip header detection
+        inflateInit2(&stream, 15 + 32);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+
+        std::string output;
+        int result = Z_OK;
+
+        while (result == Z_OK)
+        {
+            char buffer[4096];
+            stream.next_out = reinterpret_cast<Bytef*>(buffer);
+            stream.avail_out = sizeof(buffer);
+            result = inflate(&stream, Z_NO_FLUSH);
+            output.append(buffer, sizeof(buffer) - stream.avail_out);
+        }
+
+        inflateEnd(&stream);
+        EXPECT_EQ(result, Z_STREAM_END);
+        return output;
+    }
+
+    std::string Unzstd(const std::string& input)
+    {
+        ZSTD_DCtx* context = ZSTD_createDCtx();
+        ZSTD_inBuffer in {input.data(), input.size(), 0};
+
+        std::string output;
+
+        while (in.pos < in.size)
+        {
+            char buffer[4096];
+            ZSTD_outBuffer out {buffer, sizeof(buffer), 0};
+            const auto result = ZSTD_decompressStream(context, &out, &in);
+            EXPECT_FALSE(ZSTD_isError(result));
+            output.append(buffer, out.pos);
+        }
+
+        ZSTD_freeDCtx(context);
+        return output;
+    }
+
+    std::string MakeEvents(const size_t count)
+    {
+        std::string events;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            events += R"({"event":{"original":"Testing message )" + std::to_string(i) + R"(!"}})" + "\n";
+        }
+
+        return events;
+    }
+
+    /// @brief Builds data that doesn't compress, the worst case for the size bounds
+    std::string MakeRandomData(const size_t size)
+    {
+        std::string data(size, '\0');
+        unsigned int seed = 1;
+
+        for (auto& byte : data)
+        {
+            seed = seed * 1103515245 + 12345;
+            byte = static_cast<char>(seed >> 16);
+        }
+
+        return data;
+    }
+} // namespace
+
+TEST(BodyCompressorTest, ContentEncodingFromString)
+{
+    EXPECT_EQ(http_client::ContentEncodingFromString("none"), http_client::ContentEncoding::IDENTITY);
+    EXPECT_EQ(http_client::ContentEncodingFromString("gzip"), http_client::ContentEncoding::GZIP);
+    EXPECT_EQ(http_client::ContentEncodingFromString("zstd"), http_client::ContentEncoding::ZSTD);
+    EXPECT_FALSE(http_client::ContentEncodingFromString("brotli").has_value());
+}
+
+TEST(BodyCompressorTest, IdentityAppendsData)
+{
+    http_client::BodyCompressor compressor({});
+
+    compressor.Write("first");
+    compressor.Write("\nsecond");
+
+    EXPECT_EQ(compressor.Size(), 12);
+    EXPECT_EQ(compressor.InputSize(), 12);
+    EXPECT_EQ(compressor.Finish(), "first\nsecond");
+}
+
+TEST(BodyCompressorTest, GzipRoundTrip)
+{
+    const auto events = MakeEvents(1000);
+
+    http_client::BodyCompressor compressor({http_client::ContentEncoding::GZIP, 6});
+    compressor.Write(events.substr(0, events.size() / 2));
+    compressor.Flush();
+    compressor.Write(events.substr(events.size() / 2));
+
+    const auto body = compressor.Finish();
+
+    EXPECT_EQ(compressor.InputSize(), events.size());
+    EXPECT_LT(body.size(), events.size() / 5);
+    EXPECT_EQ(Gunzip(body), events);
+}
+
+TEST(BodyCompressorTest, ZstdRoundTrip)
+{
+    const auto events = MakeEvents(1000);
+
+    http_client::BodyCompressor compressor({http_client::ContentEncoding::ZSTD, 3});
+    compressor.Write(events.substr(0, events.size() / 2));
+    compressor.Flush();
+    compressor.Write(events.substr(events.size() / 2));
+
+    const auto body = compressor.Finish();
+
+    EXPECT_LT(body.size(), events.size() / 5);
+    EXPECT_EQ(Unzstd(body), events);
+}
+
+TEST(BodyCompressorTest, FlushMakesSizeExact)
+{
+    const auto events = MakeEvents(100);
+
+    http_client::BodyCompressor compressor({http_client::ContentEncoding::GZIP, 6});
+    compressor.Write(events);
+    compressor.Flush();
+
+    const auto flushedSize = compressor.Size();
+    EXPECT_GT(flushedSize, 0);
+
+    const auto body = compressor.Finish();
+    EXPECT_GE(body.size(), flushedSize);
+    EXPECT_EQ(Gunzip(body), events);
+}
+
+TEST(BodyCompressorTest, MaxSizeBoundsTheFinishedBody)
+{
+    const auto data = MakeRandomData(100000);
+
+    for (const auto encoding : {http_client::ContentEncoding::GZIP, http_client::ContentEncoding::ZSTD})
+    {
+        http_client::BodyCompressor compressor({encoding, 6});
+        compressor.Write(data.substr(0, 1000));
+        compressor.Flush();
+
+        const auto maxSize = compressor.MaxSize(data.size() - 1000);
+
+        compressor.Write(data.substr(1000));
+        compressor.Flush();
+        EXPECT_LE(compressor.Size(), maxSize);
+
+        EXPECT_LE(compressor.Finish().size(), maxSize);
+    }
+
+    http_client::BodyCompressor identity({});
+    identity.Write(data);
+    EXPECT_EQ(identity.MaxSize(), data.size());
+}
+
+TEST(BodyCompressorTest, LevelsAboveCodecMaximumAreCapped)
+{
+    const auto events = MakeEvents(100);
+
+    http_client::BodyCompressor compressor({http_client::ContentEncoding::GZIP, 19});
+    compressor.Write(events);
+
+    EXPECT_EQ(Gunzip(compressor.Finish()), events);
+}
+
+TEST(BodyCompressorTest, EmptyBodyIsAValidStream)
+{
+    http_client::BodyCompressor gzip({http_client::ContentEncoding::GZIP, 6});
+    EXPECT_EQ(Gunzip(gzip.Finish()), "");
+
+    http_client::BodyCompressor zstd({http_client::ContentEncoding::ZSTD, 3});
+    EXPECT_EQ(Unzstd(zstd.Finish()), "");
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <http_client.hpp>
+#include <http_request_params.hpp>
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+namespace
+{
+    /// @brief How the server ends a connection after answering a request
+    enum class ServerBehavior
+    {
+        KEEP_ALIVE,
+        CLOSE_AFTER_RESPONSE,
+        RESET_SECOND_RESPONSE
+    };
+
+    /// @brief Plain HTTP server on the loopback interface, handling one connection at a time like an idle
+    /// keep-alive peer of the agent
+    class LoopbackServer
+    {
+    public:
+        explicit LoopbackServer(ServerBehavior behavior)
+            : m_behavior(behavior)
+            , m_acceptor(m_ioContext, {boost::asio::ip::make_address("127.0.0.1"), 0})
+            , m_thread([this]() { Run(); })
+        {
+        }
+
+        LoopbackServer(const LoopbackServer&) = delete;
+        LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+        ~LoopbackServer()
+        {
+            m_stopping = true;
+
+            // Unblocks the accept
+            boost::asio::ip::tcp::socket socket(m_ioContext);
+            boost::system::error_code ec;
+            socket.connect(m_acceptor.local_endpoint(), ec);
+
+            m_thread.join();
+        }
+
+        std::string Url() const
+        {
+            return "http://127.0.0.1:" + std::to_string(m_acceptor.local_endpoint().port());
+        }
+
+        int Connections() const
+        {
+            return m_connections;
+        }
+
+        int Requests() const
+        {
+            return m_requests;
+        }
+
+    private:
+        void Run()
+        {
+            while (true)
+            {
+                boost::asio::ip::tcp::socket socket(m_ioContext);
+                boost::system::error_code ec;
+
+                m_acceptor.accept(socket, ec);
+
+                if (m_stopping)
+                {
+                    return;
+                }
+
+                if (!ec)
+                {
+                    ++m_connections;
+                    Serve(socket);
+                }
+            }
+        }
+
+        void Serve(boost::asio::ip::tcp::socket& socket)
+        {
+            boost::beast::flat_buffer buffer;
+            boost::system::error_code ec;
+
+            while (true)
+            {
+                boost::beast::http::request<boost::beast::http::string_body> req;
+                boost::beast::http::read(socket, buffer, req, ec);
+
+                if (ec)
+                {
+                    return;
+                }
+
+                if (++m_requests == 2 && m_behavior == ServerBehavior::RESET_SECOND_RESPONSE)
+                {
+                    // Starts the response and aborts the connection, as a server that fails after handling the
+                    // request
+                    boost::asio::write(socket, boost::asio::buffer(std::string("HTTP/1.1 200 OK\r\nContent-Le")), ec);
+                    socket.set_option(boost::asio::socket_base::linger(true, 0), ec);
+                    socket.close(ec);
+                    return;
+                }
+
+                boost::beast::http::response<boost::beast::http::string_body> res {
+                    boost::beast::http::status::ok, req.version()};
+                res.keep_alive(true);
+                res.body() = "{}";
+                res.prepare_payload();
+                boost::beast::http::write(socket, res, ec);
+
+                if (ec || m_behavior == ServerBehavior::CLOSE_AFTER_RESPONSE)
+                {
+                    // Closed without a Connection: close header, as a server does once the idle timeout expires
+                    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+                    socket.close(ec);
+                    return;
+                }
+            }
+        }
+
+        ServerBehavior m_behavior;
+        boost::asio::io_context m_ioContext;
+        boost::asio::ip::tcp::acceptor m_acceptor;
+        std::atomic<bool> m_stopping {false};
+        std::atomic<int> m_connections {0};
+        std::atomic<int> m_requests {0};
+        std::thread m_thread;
+    };
+
+    /// @brief Sends the requests one after another through the same client, as the agent loops do
+    std::vector<int> PerformRequests(http_client::HttpClient& client,
+                                     const http_client::HttpRequestParams& params,
+                                     int count)
+    {
+        std::vector<int> statuses;
+
+        boost::asio::io_context ioContext;
+        boost::asio::co_spawn(
+            ioContext,
+            [&]() -> boost::asio::awaitable<void>
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    const auto [status, body] = co_await client.Co_PerformHttpRequest(params);
+                    statuses.push_back(status);
+                }
+            },
+            boost::asio::detached);
+
+        ioContext.run();
+
+        return statuses;
+    }
+} // namespace
+
+TEST(HttpClientKeepAliveTest, RequestsReuseTheConnection)
+{
+    const LoopbackServer server(ServerBehavior::KEEP_ALIVE);
+    http_client::HttpClient client;
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::GET, server.Url(), "/api/v1/commands", "Wazuh 5.0.0", "none");
+
+    EXPECT_EQ(PerformRequests(client, params, 3), std::vector<int>(3, http_client::HTTP_CODE_OK));
+    EXPECT_EQ(server.Connections(), 1);
+    EXPECT_EQ(server.Requests(), 3);
+}
+
+TEST(HttpClientKeepAliveTest, PostIsSentAgainIfTheIdleConnectionWasClosed)
+{
+    const LoopbackServer server(ServerBehavior::CLOSE_AFTER_RESPONSE);
+    http_client::HttpClient client;
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::POST, server.Url(), "/api/v1/events/stateless", "Wazuh 5.0.0", "none", "", "", "{}");
+
+    EXPECT_EQ(PerformRequests(client, params, 2), std::vector<int>(2, http_client::HTTP_CODE_OK));
+    EXPECT_EQ(server.Connections(), 2);
+    EXPECT_EQ(server.Requests(), 2);
+}
+
+TEST(HttpClientKeepAliveTest, PostIsNotSentAgainIfTheResponseWasCutShort)
+{
+    const LoopbackServer server(ServerBehavior::RESET_SECOND_RESPONSE);
+    http_client::HttpClient client;
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::POST, server.Url(), "/api/v1/events/stateless", "Wazuh 5.0.0", "none", "", "", "{}");
+
+    EXPECT_EQ(PerformRequests(client, params, 2),
+              std::vector<int>({http_client::HTTP_CODE_OK, http_client::HTTP_CODE_INTERNAL_SERVER_ERROR}));
+    EXPECT_EQ(server.Requests(), 2);
+}
+
+TEST(HttpClientKeepAliveTest, GetIsSentAgainIfTheResponseWasCutShort)
+{
+    const LoopbackServer server(ServerBehavior::RESET_SECOND_RESPONSE);
+    http_client::HttpClient client;
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::GET, server.Url(), "/api/v1/commands", "Wazuh 5.0.0", "none");
+
+    EXPECT_EQ(PerformRequests(client, params, 2), std::vector<int>(2, http_client::HTTP_CODE_OK));
+    EXPECT_EQ(server.Connections(), 2);
+    EXPECT_EQ(server.Requests(), 3);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
@@ -10,12 +10,14 @@
 #include "mocks/mock_http_socket_factory.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/ssl/error.hpp>
 #include <boost/beast/http.hpp>
 
 #include <functional>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
 
@@ -330,6 +332,120 @@ TEST_F(HttpClientTest, Co_PerformHttpRequest_OnSuccessNotCalledIfAsyncReadFails)
     EXPECT_EQ(std::get<1>(res), "Internal server error: Error handling response: Bad address");
 }
 
+TEST_F(HttpClientTest, Co_PerformHttpRequest_ReusesKeepAliveConnection)
+{
+    SetupMockResolverFactory();
+    SetupMockSocketFactory();
+    SetupMockResolverExpectations();
+    SetupMockSocketConnectExpectations();
+    EXPECT_CALL(*mockSocket, SetVerificationMode("localhost", "full")).Times(1);
+    EXPECT_CALL(*mockSocket, AsyncWrite(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([](const boost::beast::http::request<boost::beast::http::string_body>&,
+                                  boost::system::error_code&) -> boost::asio::awaitable<void> { co_return; }));
+    EXPECT_CALL(*mockSocket, AsyncRead(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [](auto& res, boost::system::error_code&) -> boost::asio::awaitable<void>
+            {
+                res.result(boost::beast::http::status::ok);
+                co_return;
+            }));
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::GET, "https://localhost:8080", "/test", "Wazuh 5.0.0", "full");
+
+    std::vector<std::tuple<int, std::string>> responses;
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(
+        ioContext,
+        [&]() -> boost::asio::awaitable<void>
+        {
+            responses.push_back(co_await client->Co_PerformHttpRequest(params));
+            responses.push_back(co_await client->Co_PerformHttpRequest(params));
+        },
+        boost::asio::detached);
+
+    ioContext.run();
+
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(std::get<0>(responses[0]), http_client::HTTP_CODE_OK);
+    EXPECT_EQ(std::get<0>(responses[1]), http_client::HTTP_CODE_OK);
+}
+
+TEST_F(HttpClientTest, Co_PerformHttpRequest_ReconnectsIfPooledConnectionWasClosed)
+{
+    auto secondSocket = std::make_unique<MockHttpSocket>();
+    auto* const secondSocketPtr = secondSocket.get();
+
+    SetupMockResolverFactory();
+    SetupMockResolverExpectations();
+    EXPECT_CALL(*mockSocketFactory, Create(_, _))
+        .WillOnce(Invoke([&](const auto&, const bool) -> std::unique_ptr<http_client::IHttpSocket>
+                         { return std::move(mockSocket); }))
+        .WillOnce(Invoke([&](const auto&, const bool) -> std::unique_ptr<http_client::IHttpSocket>
+                         { return std::move(secondSocket); }));
+
+    SetupMockSocketConnectExpectations();
+    EXPECT_CALL(*mockSocket, SetVerificationMode("localhost", "full")).Times(1);
+    EXPECT_CALL(*mockSocket, AsyncWrite(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([](const boost::beast::http::request<boost::beast::http::string_body>&,
+                                  boost::system::error_code&) -> boost::asio::awaitable<void> { co_return; }));
+    EXPECT_CALL(*mockSocket, AsyncRead(_, _))
+        .WillOnce(Invoke(
+            [](auto& res, boost::system::error_code&) -> boost::asio::awaitable<void>
+            {
+                res.result(boost::beast::http::status::ok);
+                co_return;
+            }))
+        .WillOnce(Invoke(
+            [](auto&, boost::system::error_code& ec) -> boost::asio::awaitable<void>
+            {
+                // An HTTPS server closing an idle connection without close_notify
+                ec = boost::asio::ssl::error::stream_truncated;
+                co_return;
+            }));
+    EXPECT_CALL(*mockSocket, Close()).Times(1);
+
+    EXPECT_CALL(*secondSocketPtr, SetVerificationMode("localhost", "full")).Times(1);
+    EXPECT_CALL(*secondSocketPtr, AsyncConnect(_, _))
+        .WillOnce(Invoke([](const boost::asio::ip::tcp::resolver::results_type&,
+                            boost::system::error_code&) -> boost::asio::awaitable<void> { co_return; }));
+    EXPECT_CALL(*secondSocketPtr, AsyncWrite(_, _))
+        .WillOnce(Invoke([](const boost::beast::http::request<boost::beast::http::string_body>&,
+                            boost::system::error_code&) -> boost::asio::awaitable<void> { co_return; }));
+    EXPECT_CALL(*secondSocketPtr, AsyncRead(_, _))
+        .WillOnce(Invoke(
+            [](auto& res, boost::system::error_code&) -> boost::asio::awaitable<void>
+            {
+                res.result(boost::beast::http::status::created);
+                co_return;
+            }));
+
+    const http_client::HttpRequestParams params(
+        http_client::MethodType::GET, "https://localhost:8080", "/test", "Wazuh 5.0.0", "full");
+
+    std::vector<std::tuple<int, std::string>> responses;
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(
+        ioContext,
+        [&]() -> boost::asio::awaitable<void>
+        {
+            responses.push_back(co_await client->Co_PerformHttpRequest(params));
+            responses.push_back(co_await client->Co_PerformHttpRequest(params));
+        },
+        boost::asio::detached);
+
+    ioContext.run();
+
+    ASSERT_EQ(responses.size(), 2);
+    EXPECT_EQ(std::get<0>(responses[0]), http_client::HTTP_CODE_OK);
+    EXPECT_EQ(std::get<0>(responses[1]), http_client::HTTP_CODE_CREATED);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
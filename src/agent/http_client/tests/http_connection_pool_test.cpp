@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <http_connection_pool.hpp>
+
+#include "mocks/mock_http_socket.hpp"
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <memory>
+
+using namespace testing;
+
+class HttpConnectionPoolTest : public ::testing::Test
+{
+protected:
+    HttpConnectionPoolTest()
+    {
+        const auto port = 80;
+        dummyResults = boost::asio::ip::tcp::resolver::results_type::create(
+            boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port),
+            "127.0.0.1",
+            "80");
+    }
+
+    boost::asio::io_context ioContext;
+    const http_client::ConnectionKey key {"localhost", "8080", true, "full"};
+    boost::asio::ip::tcp::resolver::results_type dummyResults;
+};
+
+TEST_F(HttpConnectionPoolTest, AcquireReturnsNullWhenEmpty)
+{
+    http_client::HttpConnectionPool pool;
+
+    EXPECT_EQ(pool.Acquire(key, ioContext.get_executor()), nullptr);
+}
+
+TEST_F(HttpConnectionPoolTest, AcquireReturnsReleasedConnection)
+{
+    http_client::HttpConnectionPool pool;
+
+    auto socket = std::make_unique<MockHttpSocket>();
+    auto* const socketPtr = socket.get();
+    EXPECT_CALL(*socketPtr, Close()).Times(0);
+
+    pool.Release(key, ioContext.get_executor(), std::move(socket));
+
+    const auto acquired = pool.Acquire(key, ioContext.get_executor());
+    EXPECT_EQ(acquired.get(), socketPtr);
+    EXPECT_EQ(pool.Acquire(key, ioContext.get_executor()), nullptr);
+}
+
+TEST_F(HttpConnectionPoolTest, AcquireDoesNotReturnConnectionOfAnotherKey)
+{
+    http_client::HttpConnectionPool pool;
+
+    pool.Release(key, ioContext.get_executor(), std::make_unique<MockHttpSocket>());
+
+    const http_client::ConnectionKey otherKey {"localhost", "8080", true, "none"};
+    EXPECT_EQ(pool.Acquire(otherKey, ioContext.get_executor()), nullptr);
+}
+
+TEST_F(HttpConnectionPoolTest, AcquireClosesExpiredConnections)
+{
+    http_client::HttpConnectionPool pool(std::chrono::milliseconds(0));
+
+    auto socket = std::make_unique<MockHttpSocket>();
+    EXPECT_CALL(*socket, Close()).Times(1);
+
+    pool.Release(key, ioContext.get_executor(), std::move(socket));
+
+    EXPECT_EQ(pool.Acquire(key, ioContext.get_executor()), nullptr);
+}
+
+TEST_F(HttpConnectionPoolTest, ReleaseClosesOldestConnectionWhenFull)
+{
+    http_client::HttpConnectionPool pool(http_client::CONNECTION_IDLE_TIMEOUT, http_client::DNS_CACHE_TTL, 1);
+
+    auto oldSocket = std::make_unique<MockHttpSocket>();
+    EXPECT_CALL(*oldSocket, Close()).Times(1);
+    auto newSocket = std::make_unique<MockHttpSocket>();
+    auto* const newSocketPtr = newSocket.get();
+
+    pool.Release(key, ioContext.get_executor(), std::move(oldSocket));
+    pool.Release(key, ioContext.get_executor(), std::move(newSocket));
+
+    EXPECT_EQ(pool.Acquire(key, ioContext.get_executor()).get(), newSocketPtr);
+}
+
+TEST_F(HttpConnectionPoolTest, ClearClosesIdleConnections)
+{
+    http_client::HttpConnectionPool pool;
+
+    auto socket = std::make_unique<MockHttpSocket>();
+    EXPECT_CALL(*socket, Close()).Times(1);
+
+    pool.Release(key, ioContext.get_executor(), std::move(socket));
+    pool.Clear();
+
+    EXPECT_EQ(pool.Acquire(key, ioContext.get_executor()), nullptr);
+}
+
+TEST_F(HttpConnectionPoolTest, CachedEndpointsAreReturnedUntilInvalidated)
+{
+    http_client::HttpConnectionPool pool;
+
+    EXPECT_FALSE(pool.GetCachedEndpoints("localhost", "8080").has_value());
+
+    pool.CacheEndpoints("localhost", "8080", dummyResults);
+
+    const auto cached = pool.GetCachedEndpoints("localhost", "8080");
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->size(), dummyResults.size());
+    EXPECT_FALSE(pool.GetCachedEndpoints("localhost", "8081").has_value());
+
+    pool.InvalidateEndpoints("localhost", "8080");
+
+    EXPECT_FALSE(pool.GetCachedEndpoints("localhost", "8080").has_value());
+}
+
+TEST_F(HttpConnectionPoolTest, CachedEndpointsExpire)
+{
+    http_client::HttpConnectionPool pool(http_client::CONNECTION_IDLE_TIMEOUT, std::chrono::milliseconds(0));
+
+    pool.CacheEndpoints("localhost", "8080", dummyResults);
+
+    EXPECT_FALSE(pool.GetCachedEndpoints("localhost", "8080").has_value());
+}
+
+TEST_F(HttpConnectionPoolTest, TlsSessionIsStoredPerKey)
+{
+    http_client::HttpConnectionPool pool;
+
+    EXPECT_EQ(pool.GetTlsSession(key), nullptr);
+
+    const std::shared_ptr<SSL_SESSION> session(SSL_SESSION_new(), SSL_SESSION_free);
+    pool.SetTlsSession(key, session);
+
+    EXPECT_EQ(pool.GetTlsSession(key), session);
+
+    const http_client::ConnectionKey otherKey {"localhost", "8081", true, "full"};
+    EXPECT_EQ(pool.GetTlsSession(otherKey), nullptr);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
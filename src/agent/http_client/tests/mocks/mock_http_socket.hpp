@@ -39,5 +39,9 @@ public:
                 (boost::beast::http::response<boost::beast::http::dynamic_body> & res, boost::system::error_code& ec),
                 (override));
 
+    MOCK_METHOD(std::shared_ptr<SSL_SESSION>, GetTlsSession, (), (override));
+
+    MOCK_METHOD(void, SetTlsSession, (std::shared_ptr<SSL_SESSION> session), (override));
+
     MOCK_METHOD(void, Close, (), (override));
 };
@@ -38,5 +38,7 @@ public:
                  boost::beast::http::response<boost::beast::http::dynamic_body>&,
                  boost::system::error_code&),
                 (override));
+    MOCK_METHOD(SSL_SESSION*, get_session, (), (override));
+    MOCK_METHOD(void, set_session, (SSL_SESSION*), (override));
     MOCK_METHOD(void, close, (), (override));
 };
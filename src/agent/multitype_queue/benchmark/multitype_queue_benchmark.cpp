@@ -0,0 +1,159 @@
+#include <multitype_queue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_EVENTS = 50000;
+    constexpr size_t BATCH_SIZE = 1000000;
+    constexpr double P99 = 0.99;
+    constexpr double EVENTS_PER_REPORT = 10000;
+
+    /// @brief Builds the configuration of a queue holding every event, stored in its own folder.
+    std::shared_ptr<configuration::ConfigurationParser>
+    MakeConfig(const std::string& durability, const std::filesystem::path& dataPath, size_t events)
+    {
+        std::filesystem::remove_all(dataPath);
+        std::filesystem::create_directories(dataPath);
+
+        return std::make_shared<configuration::ConfigurationParser>("agent:\n  path.data: \"" + dataPath.string() +
+                                                                    "\"\n  queue_size: " + std::to_string(events) +
+                                                                    "\n  queue_durability: " + durability + "\n");
+    }
+
+    /// @brief Builds a batch body from the queue, as GetMessagesFromQueue does, and returns the CPU seconds taken
+    double BuildBatch(MultiTypeQueue& queue, bool rawData, std::string& body)
+    {
+        const auto start = std::clock();
+
+        for (const auto& message : queue.getNextBytes(MessageType::STATELESS, 0, "", "", rawData))
+        {
+            body += '\n';
+            body += message.metaData;
+            body += '\n';
+            body += rawData ? message.rawData : message.data.dump();
+        }
+
+        return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    }
+
+    /// @brief Compares the CPU time of building a batch with parsed and with raw stored data
+    void RunBatchBuild(const std::string& durability, size_t events)
+    {
+        const auto dataPath = std::filesystem::temp_directory_path() / ("benchmark_batch_" + durability);
+
+        double parsedSeconds = 0;
+        double rawSeconds = 0;
+
+        {
+            MultiTypeQueue queue(MakeConfig(durability, dataPath, events));
+
+            for (size_t i = 0; i < events; ++i)
+            {
+                const nlohmann::json data = {
+                    {"log", {{"file", {{"path", "/var/log/syslog"}}}}},
+                    {"event", {{"original", "it's line " + std::to_string(i)}, {"offset", i * 64}}}};
+
+                queue.push({MessageType::STATELESS, data, "logcollector", "file", ""});
+            }
+
+            std::string parsedBody;
+            std::string rawBody;
+            parsedSeconds = BuildBatch(queue, false, parsedBody);
+            rawSeconds = BuildBatch(queue, true, rawBody);
+
+            if (parsedBody != rawBody)
+            {
+                std::printf("%-8s batch bodies differ\n", durability.c_str());
+            }
+        }
+
+        std::filesystem::remove_all(dataPath);
+
+        const auto scale = 1000 * EVENTS_PER_REPORT / static_cast<double>(events);
+
+        std::printf("%-8s %10zu events %10.2f ms parsed %10.2f ms raw per 10k events batched\n",
+                    durability.c_str(),
+                    events,
+                    parsedSeconds * scale,
+                    rawSeconds * scale);
+    }
+
+    /// @brief Pushes the events one by one, as the modules do, then drains the queue in batches.
+    void Run(const std::string& durability, size_t events)
+    {
+        const auto dataPath = std::filesystem::temp_directory_path() / ("benchmark_queue_" + durability);
+        std::vector<double> latencies;
+        latencies.reserve(events);
+
+        double pushSeconds = 0;
+        double drainSeconds = 0;
+
+        {
+            MultiTypeQueue queue(MakeConfig(durability, dataPath, events));
+
+            const auto pushStart = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < events; ++i)
+            {
+                const nlohmann::json data = {
+                    {"log", {{"file", {{"path", "/var/log/syslog"}}}}},
+                    {"event", {{"original", "it's line " + std::to_string(i)}, {"offset", i * 64}}}};
+
+                const auto start = std::chrono::steady_clock::now();
+                queue.push({MessageType::STATELESS, data, "logcollector", "file", ""});
+                latencies.push_back(
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            pushSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - pushStart).count();
+
+            const auto drainStart = std::chrono::steady_clock::now();
+
+            while (!queue.isEmpty(MessageType::STATELESS))
+            {
+                const auto batch = queue.getNextBytes(MessageType::STATELESS, BATCH_SIZE);
+                queue.popN(MessageType::STATELESS, static_cast<int>(batch.size()));
+            }
+
+            drainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - drainStart).count();
+        }
+
+        std::filesystem::remove_all(dataPath);
+
+        const auto p99Index = static_cast<size_t>(static_cast<double>(latencies.size() - 1) * P99);
+        std::nth_element(latencies.begin(),
+                         latencies.begin() + static_cast<std::ptrdiff_t>(p99Index),
+                         latencies.end());
+
+        std::printf("%-8s %10zu events %14.0f push/s %10.1f us p99 push %14.0f drain/s\n",
+                    durability.c_str(),
+                    events,
+                    static_cast<double>(events) / pushSeconds,
+                    latencies[p99Index],
+                    static_cast<double>(events) / drainSeconds);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t events = argc > 1 ? std::stoul(argv[1]) : DEFAULT_EVENTS;
+
+    for (const auto& durability : {"persist", "spill", "memory"})
+    {
+        Run(durability, events);
+    }
+
+    for (const auto& durability : {"persist", "memory"})
+    {
+        RunBatchBuild(durability, events);
+    }
+
+    return 0;
+}
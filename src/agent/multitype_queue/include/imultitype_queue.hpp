@@ -46,22 +46,26 @@ public:
     /// @param messageQuantity In bytes of messages.
     /// @param moduleName The name of the module requesting the message.
     /// @param moduleType The type of the module requesting the messages.
+    /// @param rawData If true, the data of the messages is not parsed and is returned in Message::rawData.
     /// @return boost::asio::awaitable<std::vector<Message>> Awaitable object representing the next N messages.
     virtual boost::asio::awaitable<std::vector<Message>> getNextBytesAwaitable(MessageType type,
                                                                                const size_t messageQuantity,
                                                                                const std::string moduleName = "",
-                                                                               const std::string moduleType = "") = 0;
+                                                                               const std::string moduleType = "",
+                                                                               const bool rawData = false) = 0;
 
     /// @brief Retrieves the next N messages from the queue.
     /// @param type The type of the queue to use as the source.
     /// @param messageQuantity The quantity of bytes of messages to return.
     /// @param moduleName The name of the module requesting the messages.
     /// @param moduleType The type of the module requesting the messages.
+    /// @param rawData If true, the data of the messages is not parsed and is returned in Message::rawData.
     /// @return std::vector<Message> A vector of messages fetched from the queue.
     virtual std::vector<Message> getNextBytes(MessageType type,
                                               const size_t messageQuantity,
                                               const std::string moduleName = "",
-                                              const std::string moduleType = "") = 0;
+                                              const std::string moduleType = "",
+                                              const bool rawData = false) = 0;
 
     /// @brief Deletes a message from the queue.
     /// @param type The type of the queue from which to pop the message.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <message.hpp>
 #include <nlohmann/json.hpp>
 
 #include <memory>
@@ -19,7 +20,7 @@ public:
     virtual bool Clear(const std::vector<std::string>& tableNames) = 0;
 
     /// @brief Store a JSON message in the storage.
-    /// @param message The JSON message to store.
+    /// @param message The JSON message to store. If it is an array, each item is stored in a single transaction.
     /// @param tableName The name of the table to store the message in.
     /// @param moduleName The name of the module that created the message.
     /// @param moduleType The type of the module that created the message.
@@ -31,6 +32,13 @@ public:
                       const std::string& moduleType = "",
                       const std::string& metadata = "") = 0;
 
+    /// @brief Store multiple messages in the storage, in a single transaction.
+    /// @param messages The messages to store, in order. Array data is stored as one element per item, raw data is
+    /// stored as is.
+    /// @param tableName The name of the table to store the messages in.
+    /// @return The number of stored elements.
+    virtual int StoreMultiple(const std::vector<Message>& messages, const std::string& tableName) = 0;
+
     /// @brief Remove multiple JSON messages.
     /// @param n The number of messages to remove.
     /// @param tableName The name of the table to remove the message from.
@@ -58,11 +66,14 @@ public:
     /// @param tableName The name of the table to retrieve the message from.
     /// @param moduleName The name of the module.
     /// @param moduleType The type of the module.
+    /// @param rawData If true, the data of the messages is not parsed and is returned as a string in "rawData"
+    /// instead of "data".
     /// @return nlohmann::json The retrieved JSON messages.
     virtual nlohmann::json RetrieveBySize(size_t n,
                                           const std::string& tableName,
                                           const std::string& moduleName = "",
-                                          const std::string& moduleType = "") = 0;
+                                          const std::string& moduleType = "",
+                                          bool rawData = false) = 0;
 
     /// @brief Get the number of elements in the table.
     /// @param tableName The name of the table to retrieve the message from.
@@ -23,6 +23,10 @@ public:
     std::string moduleType;
     std::string metaData;
 
+    /// @brief The data serialized as JSON. When set, the message carries its data in this form and data is null,
+    /// so that it can be stored or sent without serializing or parsing it again
+    std::string rawData;
+
     /// @brief Constructor
     /// @param t The type of the message
     /// @param d The json data
@@ -22,6 +22,19 @@ namespace
     const std::string COMMAND_TABLE_NAME = "COMMAND";
 } // namespace
 
+class MessageRing;
+
+/// @brief Where the messages of the types with an in-memory tier are kept
+enum class QueueDurability
+{
+    /// @brief Messages are only kept in memory and lost on shutdown
+    MEMORY,
+    /// @brief Messages are kept in memory and moved to the storage when the memory tier is full or on shutdown
+    SPILL,
+    /// @brief Every message is written to the storage
+    PERSIST
+};
+
 /// @brief MultiTypeQueue implementation that handles multiple types of messages.
 ///
 /// This class implements the IMultiTypeQueue interface to provide a queue
@@ -55,6 +68,34 @@ private:
     /// @brief Time between batch requests
     std::time_t m_batchInterval;
 
+    /// @brief Durability of the message types with an in-memory tier
+    QueueDurability m_durability = QueueDurability::PERSIST;
+
+    /// @brief In-memory tier of each message type not always persisted, its messages are newer than the stored ones
+    std::map<MessageType, std::unique_ptr<MessageRing>> m_memoryTiers;
+
+    /// @brief Number of messages of each in-memory tier type that are in the storage
+    std::map<MessageType, size_t> m_spilledItems;
+
+    /// @brief mutex for protecting the in-memory tiers and keeping them in order with the storage
+    std::mutex m_memoryMutex;
+
+    /// @brief Pushes a message into the in-memory tier of its type, spilling the tier to the storage if needed
+    /// @param message The message, its array data is pushed as one message per item
+    /// @return The number of messages pushed
+    int PushToMemoryTier(const Message& message);
+
+    /// @brief Moves the messages of an in-memory tier to the storage
+    /// @param type The message type
+    void SpillMemoryTier(MessageType type);
+
+    /// @brief Counts the messages of a type, in memory and in the storage
+    /// @param type The message type
+    /// @param moduleName The module name, empty for any
+    /// @param moduleType The module type, empty for any
+    /// @return The number of messages
+    size_t CountItems(MessageType type, const std::string& moduleName = "", const std::string& moduleType = "");
+
 public:
     /// @brief Constructor
     /// @param configurationParser Pointer to the configuration parser
@@ -93,13 +134,15 @@ public:
     boost::asio::awaitable<std::vector<Message>> getNextBytesAwaitable(MessageType type,
                                                                        const size_t messageQuantity,
                                                                        const std::string moduleName = "",
-                                                                       const std::string moduleType = "") override;
+                                                                       const std::string moduleType = "",
+                                                                       const bool rawData = false) override;
 
     /// @copydoc IMultiTypeQueue::getNextBytes
     std::vector<Message> getNextBytes(MessageType type,
                                       const size_t messageQuantity,
                                       const std::string moduleName = "",
-                                      const std::string moduleType = "") override;
+                                      const std::string moduleType = "",
+                                      const bool rawData = false) override;
 
     /// @copydoc IMultiTypeQueue::pop
     bool pop(MessageType type, const std::string moduleName = "", const std::string moduleType = "") override;
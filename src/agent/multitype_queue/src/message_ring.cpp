@@ -0,0 +1,182 @@
+#include <message_ring.hpp>
+
+#include <utility>
+
+MessageRing::MessageRing(size_t capacity)
+    : m_capacity(capacity)
+{
+}
+
+bool MessageRing::Push(Message message)
+{
+    if (Full())
+    {
+        return false;
+    }
+
+    if (message.rawData.empty())
+    {
+        message.rawData = message.data.dump();
+        message.data = nullptr;
+    }
+
+    const auto bytes = MessageSize(message);
+    m_entries.push_back({std::move(message), bytes});
+    m_bytes += bytes;
+    return true;
+}
+
+size_t MessageRing::Size() const
+{
+    return m_entries.size();
+}
+
+size_t MessageRing::Capacity() const
+{
+    return m_capacity;
+}
+
+bool MessageRing::Full() const
+{
+    return m_entries.size() >= m_capacity;
+}
+
+size_t MessageRing::Bytes() const
+{
+    return m_bytes;
+}
+
+size_t MessageRing::Count(const std::string& moduleName, const std::string& moduleType) const
+{
+    if (moduleName.empty() && moduleType.empty())
+    {
+        return m_entries.size();
+    }
+
+    size_t count = 0;
+
+    for (const auto& entry : m_entries)
+    {
+        if (Matches(entry, moduleName, moduleType))
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+std::vector<Message> MessageRing::Front(size_t n, const std::string& moduleName, const std::string& moduleType) const
+{
+    std::vector<Message> result;
+
+    for (auto it = m_entries.begin(); it != m_entries.end() && result.size() < n; ++it)
+    {
+        if (Matches(*it, moduleName, moduleType))
+        {
+            result.push_back(Materialize(it->Msg, false));
+        }
+    }
+
+    return result;
+}
+
+std::vector<Message> MessageRing::FrontBySize(size_t maxSize,
+                                              size_t& accumulated,
+                                              const std::string& moduleName,
+                                              const std::string& moduleType,
+                                              bool rawData) const
+{
+    std::vector<Message> result;
+
+    for (const auto& entry : m_entries)
+    {
+        if (!Matches(entry, moduleName, moduleType))
+        {
+            continue;
+        }
+
+        result.push_back(Materialize(entry.Msg, rawData));
+        accumulated += entry.Bytes;
+
+        if (maxSize && accumulated >= maxSize)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+size_t MessageRing::Pop(size_t n, const std::string& moduleName, const std::string& moduleType)
+{
+    size_t removed = 0;
+
+    if (moduleName.empty() && moduleType.empty())
+    {
+        while (removed < n && !m_entries.empty())
+        {
+            m_bytes -= m_entries.front().Bytes;
+            m_entries.pop_front();
+            ++removed;
+        }
+        return removed;
+    }
+
+    for (auto it = m_entries.begin(); it != m_entries.end() && removed < n;)
+    {
+        if (Matches(*it, moduleName, moduleType))
+        {
+            m_bytes -= it->Bytes;
+            it = m_entries.erase(it);
+            ++removed;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removed;
+}
+
+std::vector<Message> MessageRing::TakeAll()
+{
+    std::vector<Message> result;
+    result.reserve(m_entries.size());
+
+    for (auto& entry : m_entries)
+    {
+        result.push_back(std::move(entry.Msg));
+    }
+
+    m_entries.clear();
+    m_bytes = 0;
+    return result;
+}
+
+size_t MessageRing::MessageSize(const Message& message)
+{
+    return message.moduleName.size() + message.moduleType.size() + message.metaData.size() +
+           (message.rawData.empty() ? message.data.dump().size() : message.rawData.size());
+}
+
+Message MessageRing::Materialize(const Message& message, bool rawData)
+{
+    if (rawData)
+    {
+        return message;
+    }
+
+    return {message.type,
+            nlohmann::json::parse(message.rawData),
+            message.moduleName,
+            message.moduleType,
+            message.metaData};
+}
+
+bool MessageRing::Matches(const Entry& entry, const std::string& moduleName, const std::string& moduleType)
+{
+    return (moduleName.empty() || entry.Msg.moduleName == moduleName) &&
+           (moduleType.empty() || entry.Msg.moduleType == moduleType);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <message.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+/// @brief Bounded FIFO of messages kept in memory in front of the storage
+///
+/// Messages are held serialized, as they would be stored, so that batches can be sized and sent
+/// without serializing them again. This class is not thread safe.
+class MessageRing
+{
+public:
+    /// @brief Constructor
+    /// @param capacity Maximum number of messages held
+    explicit MessageRing(size_t capacity);
+
+    /// @brief Appends a message
+    /// @param message The message, its data must not be an array. It is serialized unless it already has raw data
+    /// @return True if the message was added, false if the ring is full
+    bool Push(Message message);
+
+    /// @brief Gets the number of messages held
+    size_t Size() const;
+
+    /// @brief Gets the maximum number of messages held
+    size_t Capacity() const;
+
+    /// @brief Checks whether the ring is full
+    bool Full() const;
+
+    /// @brief Gets the bytes occupied by the messages, as Storage measures them
+    size_t Bytes() const;
+
+    /// @brief Counts the messages of a module
+    /// @param moduleName The module name, empty for any
+    /// @param moduleType The module type, empty for any
+    /// @return The number of matching messages
+    size_t Count(const std::string& moduleName = "", const std::string& moduleType = "") const;
+
+    /// @brief Gets the oldest messages without removing them
+    /// @param n Maximum number of messages
+    /// @param moduleName The module name, empty for any
+    /// @param moduleType The module type, empty for any
+    /// @return The matching messages with their data parsed, oldest first
+    std::vector<Message> Front(size_t n, const std::string& moduleName = "", const std::string& moduleType = "") const;
+
+    /// @brief Gets the oldest messages up to a size, without removing them
+    ///
+    /// Follows the Storage::RetrieveBySize rule: the message that reaches the size is included.
+    /// @param maxSize Size to reach, 0 for no limit
+    /// @param accumulated Size already taken by messages read from the storage, updated on return
+    /// @param moduleName The module name, empty for any
+    /// @param moduleType The module type, empty for any
+    /// @param rawData If true, the data of the messages is returned in Message::rawData instead of parsed
+    /// @return The matching messages, oldest first
+    std::vector<Message> FrontBySize(size_t maxSize,
+                                     size_t& accumulated,
+                                     const std::string& moduleName = "",
+                                     const std::string& moduleType = "",
+                                     bool rawData = false) const;
+
+    /// @brief Removes the oldest messages
+    /// @param n Maximum number of messages to remove
+    /// @param moduleName The module name, empty for any
+    /// @param moduleType The module type, empty for any
+    /// @return The number of removed messages
+    size_t Pop(size_t n, const std::string& moduleName = "", const std::string& moduleType = "");
+
+    /// @brief Removes all the messages
+    /// @return The messages with their raw data, oldest first
+    std::vector<Message> TakeAll();
+
+    /// @brief Computes the size of a message the way Storage does
+    /// @param message The message
+    /// @return The size in bytes
+    static size_t MessageSize(const Message& message);
+
+private:
+    /// @brief Message held with its precomputed size
+    struct Entry
+    {
+        Message Msg;
+        size_t Bytes;
+    };
+
+    /// @brief Copies a held message, parsing its data unless the raw data is requested
+    static Message Materialize(const Message& message, bool rawData);
+
+    /// @brief Checks whether an entry belongs to a module
+    static bool Matches(const Entry& entry, const std::string& moduleName, const std::string& moduleType);
+
+    /// @brief Maximum number of messages held
+    size_t m_capacity;
+
+    /// @brief Messages held, oldest first
+    std::deque<Entry> m_entries;
+
+    /// @brief Sum of the sizes of the messages held
+    size_t m_bytes = 0;
+};
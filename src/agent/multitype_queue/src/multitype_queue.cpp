@@ -1,9 +1,14 @@
 #include <config.h>
+#include <message_ring.hpp>
 #include <multitype_queue.hpp>
 #include <storage.hpp>
 
 #include <boost/asio.hpp>
 #include <logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <optional>
 #include <utility>
 
 namespace
@@ -12,6 +17,28 @@ namespace
     constexpr auto MAX_BATCH_INTERVAL = 60 * 60 * 1000;
     constexpr auto MIN_QUEUE_SIZE = 1000;
     constexpr auto MAX_QUEUE_SIZE = 60 * 60 * 1000;
+    constexpr auto MIN_QUEUE_MEMORY_SIZE = 100;
+
+    /// @brief Message types that may be kept in memory. Stateful deltas and commands are not regenerated if lost,
+    /// so they are always persisted.
+    constexpr std::array MEMORY_TIER_TYPES = {MessageType::STATELESS};
+
+    std::optional<QueueDurability> QueueDurabilityFromString(const std::string& durability)
+    {
+        if (durability == "memory")
+        {
+            return QueueDurability::MEMORY;
+        }
+        if (durability == "spill")
+        {
+            return QueueDurability::SPILL;
+        }
+        if (durability == "persist")
+        {
+            return QueueDurability::PERSIST;
+        }
+        return std::nullopt;
+    }
 } // namespace
 
 MultiTypeQueue::MultiTypeQueue(std::shared_ptr<configuration::ConfigurationParser> configurationParser,
@@ -46,9 +73,150 @@ MultiTypeQueue::MultiTypeQueue(std::shared_ptr<configuration::ConfigurationParse
     {
         LogError("Error creating persistence: {}.", e.what());
     }
+
+    const auto durability =
+        configurationParser->GetConfigOrDefault(config::agent::DEFAULT_QUEUE_DURABILITY, "agent", "queue_durability");
+
+    if (const auto parsedDurability = QueueDurabilityFromString(durability); parsedDurability.has_value())
+    {
+        m_durability = parsedDurability.value();
+    }
+    else
+    {
+        LogWarn("Incorrect value for 'queue_durability', the default value '{}' is used.",
+                config::agent::DEFAULT_QUEUE_DURABILITY);
+        m_durability =
+            QueueDurabilityFromString(config::agent::DEFAULT_QUEUE_DURABILITY).value_or(QueueDurability::PERSIST);
+    }
+
+    if (m_durability != QueueDurability::PERSIST && m_persistenceDest)
+    {
+        // Memory-only queues hold up to the queue size, spilling queues keep room in the storage for the tier
+        const auto memoryItems =
+            m_durability == QueueDurability::MEMORY
+                ? m_maxItems
+                : std::min(m_maxItems,
+                           static_cast<size_t>(configurationParser->GetConfigInRangeOrDefault(
+                               config::agent::DEFAULT_QUEUE_MEMORY_SIZE,
+                               std::optional<int>(MIN_QUEUE_MEMORY_SIZE),
+                               std::optional<int>(MAX_QUEUE_SIZE),
+                               "agent",
+                               "queue_memory_size")));
+
+        for (const auto type : MEMORY_TIER_TYPES)
+        {
+            m_memoryTiers[type] = std::make_unique<MessageRing>(memoryItems);
+
+            // Messages left in the storage by a previous run are sent first
+            m_spilledItems[type] =
+                static_cast<size_t>(m_persistenceDest->GetElementCount(m_mapMessageTypeName.at(type)));
+        }
+    }
 }
 
-MultiTypeQueue::~MultiTypeQueue() = default;
+MultiTypeQueue::~MultiTypeQueue()
+{
+    for (const auto& [type, ring] : m_memoryTiers)
+    {
+        if (ring->Size() == 0)
+        {
+            continue;
+        }
+
+        if (m_durability == QueueDurability::SPILL)
+        {
+            SpillMemoryTier(type);
+        }
+        else
+        {
+            LogWarn("Discarding {} in-memory messages from queue {}.", ring->Size(), m_mapMessageTypeName.at(type));
+        }
+    }
+}
+
+int MultiTypeQueue::PushToMemoryTier(const Message& message)
+{
+    auto& ring = *m_memoryTiers.at(message.type);
+    const auto& data = message.data;
+    const size_t items = data.is_array() ? data.size() : 1;
+
+    const std::lock_guard<std::mutex> lock(m_memoryMutex);
+
+    const auto storedItems = m_spilledItems[message.type] + ring.Size();
+    const auto spaceAvailable = (m_maxItems > storedItems) ? m_maxItems - storedItems : 0;
+
+    if (!spaceAvailable || items > spaceAvailable)
+    {
+        return 0;
+    }
+
+    int result = 0;
+
+    const auto pushItem = [&](Message item)
+    {
+        if (ring.Full() && m_durability == QueueDurability::SPILL)
+        {
+            SpillMemoryTier(message.type);
+        }
+
+        if (ring.Push(std::move(item)))
+        {
+            ++result;
+        }
+    };
+
+    if (data.is_array())
+    {
+        for (const auto& singleMessageData : data)
+        {
+            pushItem({message.type, singleMessageData, message.moduleName, message.moduleType, message.metaData});
+        }
+    }
+    else
+    {
+        // The whole message is kept, with its raw data if it has any
+        pushItem(message);
+    }
+
+    return result;
+}
+
+void MultiTypeQueue::SpillMemoryTier(MessageType type)
+{
+    auto messages = m_memoryTiers.at(type)->TakeAll();
+    const auto stored =
+        static_cast<size_t>(m_persistenceDest->StoreMultiple(messages, m_mapMessageTypeName.at(type)));
+
+    if (stored < messages.size())
+    {
+        LogError("Error spilling queue {}, {} messages lost.", m_mapMessageTypeName.at(type), messages.size() - stored);
+    }
+
+    m_spilledItems[type] += stored;
+}
+
+size_t MultiTypeQueue::CountItems(MessageType type, const std::string& moduleName, const std::string& moduleType)
+{
+    if (!m_memoryTiers.contains(type))
+    {
+        return static_cast<size_t>(
+            m_persistenceDest->GetElementCount(m_mapMessageTypeName.at(type), moduleName, moduleType));
+    }
+
+    const std::lock_guard<std::mutex> lock(m_memoryMutex);
+
+    size_t count = m_memoryTiers.at(type)->Count(moduleName, moduleType);
+
+    if (m_spilledItems[type] > 0)
+    {
+        count += (moduleName.empty() && moduleType.empty())
+                     ? m_spilledItems[type]
+                     : static_cast<size_t>(
+                           m_persistenceDest->GetElementCount(m_mapMessageTypeName.at(type), moduleName, moduleType));
+    }
+
+    return count;
+}
 
 int MultiTypeQueue::push(Message message, bool shouldWait)
 {
@@ -62,30 +230,36 @@ int MultiTypeQueue::push(Message message, bool shouldWait)
         if (shouldWait)
         {
             std::unique_lock<std::mutex> lock(m_mtx);
-            m_cv.wait_for(lock,
-                          m_timeout,
-                          [&, this] {
-                              return static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType)) < m_maxItems;
-                          });
+            m_cv.wait_for(lock, m_timeout, [&, this] { return CountItems(message.type) < m_maxItems; });
+        }
+
+        if (m_memoryTiers.contains(message.type))
+        {
+            result = PushToMemoryTier(message);
+            m_cv.notify_all();
+            return result;
         }
 
         const auto storedMessages = static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType));
         const auto spaceAvailable = (m_maxItems > storedMessages) ? m_maxItems - storedMessages : 0;
         if (spaceAvailable)
         {
-            auto messageData = message.data;
+            const auto& messageData = message.data;
             if (messageData.is_array())
             {
                 if (messageData.size() <= spaceAvailable)
                 {
-                    for (const auto& singleMessageData : messageData)
-                    {
-                        result += m_persistenceDest->Store(
-                            singleMessageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
-                        m_cv.notify_all();
-                    }
+                    // The items are stored in a single transaction
+                    result = m_persistenceDest->Store(
+                        messageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
+                    m_cv.notify_all();
                 }
             }
+            else if (!message.rawData.empty())
+            {
+                result = m_persistenceDest->StoreMultiple({message}, sMessageType);
+                m_cv.notify_all();
+            }
             else
             {
                 result = m_persistenceDest->Store(message.data,
@@ -113,29 +287,39 @@ boost::asio::awaitable<int> MultiTypeQueue::pushAwaitable(Message message)
     {
         auto sMessageType = m_mapMessageTypeName.at(message.type);
 
-        while (static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType)) >= m_maxItems)
+        while (CountItems(message.type) >= m_maxItems)
         {
             timer.expires_after(std::chrono::milliseconds(m_timeout));
             co_await timer.async_wait(boost::asio::use_awaitable);
         }
 
+        if (m_memoryTiers.contains(message.type))
+        {
+            result = PushToMemoryTier(message);
+            m_cv.notify_all();
+            co_return result;
+        }
+
         const auto storedItems = static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType));
         const auto availableItems = (m_maxItems > storedItems) ? m_maxItems - storedItems : 0;
         if (availableItems)
         {
-            auto messageData = message.data;
+            const auto& messageData = message.data;
             if (messageData.is_array())
             {
                 if (messageData.size() <= availableItems)
                 {
-                    for (const auto& singleMessageData : messageData)
-                    {
-                        result += m_persistenceDest->Store(
-                            singleMessageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
-                        m_cv.notify_all();
-                    }
+                    // The items are stored in a single transaction
+                    result = m_persistenceDest->Store(
+                        messageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
+                    m_cv.notify_all();
                 }
             }
+            else if (!message.rawData.empty())
+            {
+                result = m_persistenceDest->StoreMultiple({message}, sMessageType);
+                m_cv.notify_all();
+            }
             else
             {
                 result = m_persistenceDest->Store(message.data,
@@ -169,7 +353,19 @@ Message MultiTypeQueue::getNext(MessageType type, const std::string moduleName,
     Message result(type, "{}"_json, moduleName, moduleType, "");
     if (m_mapMessageTypeName.contains(type))
     {
-        auto resultData = m_persistenceDest->RetrieveMultiple(1, m_mapMessageTypeName.at(type), moduleName, moduleType);
+        const auto hasMemoryTier = m_memoryTiers.contains(type);
+        std::unique_lock<std::mutex> lock(m_memoryMutex, std::defer_lock);
+        if (hasMemoryTier)
+        {
+            lock.lock();
+        }
+
+        nlohmann::json resultData;
+        if (!hasMemoryTier || m_spilledItems[type] > 0)
+        {
+            resultData = m_persistenceDest->RetrieveMultiple(1, m_mapMessageTypeName.at(type), moduleName, moduleType);
+        }
+
         if (!resultData.empty())
         {
             result.data = resultData[0]["data"];
@@ -177,6 +373,13 @@ Message MultiTypeQueue::getNext(MessageType type, const std::string moduleName,
             result.moduleName = resultData[0]["moduleName"];
             result.moduleType = resultData[0]["moduleType"];
         }
+        else if (hasMemoryTier)
+        {
+            if (const auto front = m_memoryTiers.at(type)->Front(1, moduleName, moduleType); !front.empty())
+            {
+                result = front.front();
+            }
+        }
     }
     else
     {
@@ -188,7 +391,8 @@ Message MultiTypeQueue::getNext(MessageType type, const std::string moduleName,
 boost::asio::awaitable<std::vector<Message>> MultiTypeQueue::getNextBytesAwaitable(MessageType type,
                                                                                    const size_t messageQuantity,
                                                                                    const std::string moduleName,
-                                                                                   const std::string moduleType)
+                                                                                   const std::string moduleType,
+                                                                                   const bool rawData)
 {
     boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
 
@@ -214,7 +418,7 @@ boost::asio::awaitable<std::vector<Message>> MultiTypeQueue::getNextBytesAwaitab
             LogDebug("Timeout reached after {}ms", m_batchInterval);
         }
 
-        result = getNextBytes(type, messageQuantity, moduleName, moduleType);
+        result = getNextBytes(type, messageQuantity, moduleName, moduleType, rawData);
     }
     else
     {
@@ -226,18 +430,54 @@ boost::asio::awaitable<std::vector<Message>> MultiTypeQueue::getNextBytesAwaitab
 std::vector<Message> MultiTypeQueue::getNextBytes(MessageType type,
                                                   const size_t messageQuantity,
                                                   const std::string moduleName,
-                                                  const std::string moduleType)
+                                                  const std::string moduleType,
+                                                  const bool rawData)
 {
     std::vector<Message> result;
     if (m_mapMessageTypeName.contains(type))
     {
-        auto arrayData =
-            m_persistenceDest->RetrieveBySize(messageQuantity, m_mapMessageTypeName.at(type), moduleName, moduleType);
+        const auto hasMemoryTier = m_memoryTiers.contains(type);
+        std::unique_lock<std::mutex> lock(m_memoryMutex, std::defer_lock);
+        if (hasMemoryTier)
+        {
+            lock.lock();
+        }
 
-        for (auto singleJson : arrayData)
+        size_t accumulated = 0;
+
+        if (!hasMemoryTier || m_spilledItems[type] > 0)
+        {
+            auto arrayData = m_persistenceDest->RetrieveBySize(
+                messageQuantity, m_mapMessageTypeName.at(type), moduleName, moduleType, rawData);
+
+            result.reserve(arrayData.size());
+
+            for (auto& singleJson : arrayData)
+            {
+                result.emplace_back(type,
+                                    rawData ? nlohmann::json() : std::move(singleJson["data"]),
+                                    singleJson["moduleName"],
+                                    singleJson["moduleType"],
+                                    singleJson["metadata"]);
+
+                if (rawData)
+                {
+                    result.back().rawData = std::move(singleJson["rawData"].get_ref<std::string&>());
+                }
+
+                if (hasMemoryTier)
+                {
+                    accumulated += MessageRing::MessageSize(result.back());
+                }
+            }
+        }
+
+        // The stored messages are older, the batch continues in memory if they did not fill it
+        if (hasMemoryTier && (messageQuantity == 0 || accumulated < messageQuantity))
         {
-            result.emplace_back(
-                type, singleJson["data"], singleJson["moduleName"], singleJson["moduleType"], singleJson["metadata"]);
+            auto memoryMessages =
+                m_memoryTiers.at(type)->FrontBySize(messageQuantity, accumulated, moduleName, moduleType, rawData);
+            std::move(memoryMessages.begin(), memoryMessages.end(), std::back_inserter(result));
         }
     }
     else
@@ -249,16 +489,7 @@ std::vector<Message> MultiTypeQueue::getNextBytes(MessageType type,
 
 bool MultiTypeQueue::pop(MessageType type, const std::string moduleName, const std::string moduleType)
 {
-    bool result = false;
-    if (m_mapMessageTypeName.contains(type))
-    {
-        result = m_persistenceDest->RemoveMultiple(1, m_mapMessageTypeName.at(type), moduleName, moduleType);
-    }
-    else
-    {
-        LogError("Error didn't find the queue.");
-    }
-    return result;
+    return popN(type, 1, moduleName, moduleType) > 0;
 }
 
 int MultiTypeQueue::popN(MessageType type,
@@ -267,7 +498,25 @@ int MultiTypeQueue::popN(MessageType type,
                          const std::string moduleType)
 {
     int result = 0;
-    if (m_mapMessageTypeName.contains(type))
+    if (m_memoryTiers.contains(type))
+    {
+        const std::lock_guard<std::mutex> lock(m_memoryMutex);
+
+        // The stored messages are older, so they are removed first
+        if (m_spilledItems[type] > 0)
+        {
+            result = m_persistenceDest->RemoveMultiple(
+                messageQuantity, m_mapMessageTypeName.at(type), moduleName, moduleType);
+            m_spilledItems[type] -= std::min(m_spilledItems[type], static_cast<size_t>(result));
+        }
+
+        if (result < messageQuantity)
+        {
+            result += static_cast<int>(m_memoryTiers.at(type)->Pop(
+                static_cast<size_t>(messageQuantity - result), moduleName, moduleType));
+        }
+    }
+    else if (m_mapMessageTypeName.contains(type))
     {
         result =
             m_persistenceDest->RemoveMultiple(messageQuantity, m_mapMessageTypeName.at(type), moduleName, moduleType);
@@ -283,7 +532,7 @@ bool MultiTypeQueue::isEmpty(MessageType type, const std::string moduleName, con
 {
     if (m_mapMessageTypeName.contains(type))
     {
-        return m_persistenceDest->GetElementCount(m_mapMessageTypeName.at(type), moduleName, moduleType) == 0;
+        return CountItems(type, moduleName, moduleType) == 0;
     }
     else
     {
@@ -296,8 +545,7 @@ bool MultiTypeQueue::isFull(MessageType type, const std::string moduleName, cons
 {
     if (m_mapMessageTypeName.contains(type))
     {
-        return static_cast<size_t>(m_persistenceDest->GetElementCount(
-                   m_mapMessageTypeName.at(type), moduleName, moduleType)) == m_maxItems;
+        return CountItems(type, moduleName, moduleType) == m_maxItems;
     }
     else
     {
@@ -310,7 +558,7 @@ int MultiTypeQueue::storedItems(MessageType type, const std::string moduleName,
 {
     if (m_mapMessageTypeName.contains(type))
     {
-        return m_persistenceDest->GetElementCount(m_mapMessageTypeName.at(type), moduleName, moduleType);
+        return static_cast<int>(CountItems(type, moduleName, moduleType));
     }
     else
     {
@@ -321,7 +569,15 @@ int MultiTypeQueue::storedItems(MessageType type, const std::string moduleName,
 
 size_t MultiTypeQueue::sizePerType(MessageType type)
 {
-    if (m_mapMessageTypeName.contains(type))
+    if (m_memoryTiers.contains(type))
+    {
+        const std::lock_guard<std::mutex> lock(m_memoryMutex);
+
+        const auto storedSize =
+            m_spilledItems[type] > 0 ? m_persistenceDest->GetElementsStoredSize(m_mapMessageTypeName.at(type)) : 0;
+        return storedSize + m_memoryTiers.at(type)->Bytes();
+    }
+    else if (m_mapMessageTypeName.contains(type))
     {
         return m_persistenceDest->GetElementsStoredSize(m_mapMessageTypeName.at(type));
     }
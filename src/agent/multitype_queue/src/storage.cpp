@@ -6,6 +6,10 @@
 #include <persistence.hpp>
 #include <persistence_factory.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
 using namespace column;
 
 namespace
@@ -20,23 +24,27 @@ namespace
     const std::string METADATA_COLUMN_NAME = "metadata";
     const std::string MESSAGE_COLUMN_NAME = "message";
 
-    nlohmann::json ProcessRequest(const std::vector<Row>& rows, size_t maxSize = 0)
+    nlohmann::json ProcessRequest(const std::vector<Row>& rows, size_t maxSize = 0, bool rawData = false)
     {
         nlohmann::json messages = nlohmann::json::array();
         size_t sizeAccum = 0;
 
         for (const auto& row : rows)
         {
-            const std::string moduleNameString = row[0].Value;
-            const std::string moduleTypeString = row[1].Value;
-            const std::string metadataString = row[2].Value;
-            const std::string dataString = row[3].Value;
+            const auto& moduleNameString = row[0].Value;
+            const auto& moduleTypeString = row[1].Value;
+            const auto& metadataString = row[2].Value;
+            const auto& dataString = row[3].Value;
 
-            nlohmann::json outputJson = {{"moduleName", ""}, {"moduleType", ""}, {"metadata", ""}, {"data", {}}};
+            nlohmann::json outputJson = {{"moduleName", ""}, {"moduleType", ""}, {"metadata", ""}};
 
-            if (!dataString.empty())
+            if (rawData)
+            {
+                outputJson["rawData"] = dataString;
+            }
+            else
             {
-                outputJson["data"] = nlohmann::json::parse(dataString);
+                outputJson["data"] = dataString.empty() ? nlohmann::json() : nlohmann::json::parse(dataString);
             }
 
             if (!metadataString.empty())
@@ -54,11 +62,12 @@ namespace
                 outputJson["moduleType"] = moduleTypeString;
             }
 
-            messages.push_back(outputJson);
+            messages.push_back(std::move(outputJson));
             if (maxSize)
             {
-                const size_t messageSize = moduleNameString.size() + moduleTypeString.size() + metadataString.size() +
-                                           outputJson["data"].dump().size();
+                // The stored data is the serialized message, so its length is the size of the message
+                const size_t messageSize =
+                    moduleNameString.size() + moduleTypeString.size() + metadataString.size() + dataString.size();
                 if (sizeAccum + messageSize >= maxSize)
                 {
                     break;
@@ -69,6 +78,69 @@ namespace
 
         return messages;
     }
+
+    /// @brief Columns whose length is the size of a message
+    Names SizeColumns()
+    {
+        Names columns;
+        columns.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT);
+        columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
+        columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
+        columns.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT);
+        return columns;
+    }
+
+    /// @brief Size of a row holding the module name, module type, metadata and message, in this order
+    size_t RowSize(const Row& row)
+    {
+        size_t size = 0;
+        for (const auto& field : row)
+        {
+            size += field.Value.size();
+        }
+        return size;
+    }
+
+    /// @brief Parses a count or size read from the database, where an empty value is zero
+    size_t ParseSize(const std::string& value)
+    {
+        return static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+    }
+
+    /// @brief Builds the row storing a serialized message
+    Row MakeRow(const std::string& moduleName,
+                const std::string& moduleType,
+                const std::string& metadata,
+                std::string serializedData)
+    {
+        Row fields;
+        fields.reserve(4);
+        fields.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT, moduleName);
+        fields.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT, moduleType);
+        fields.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT, metadata);
+        fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, std::move(serializedData));
+        return fields;
+    }
+
+    /// @brief Appends the rows storing a message, one per item if its data is an array
+    void AppendRows(std::vector<Row>& rows,
+                    const nlohmann::json& message,
+                    const std::string& moduleName,
+                    const std::string& moduleType,
+                    const std::string& metadata)
+    {
+        if (message.is_array())
+        {
+            for (const auto& singleMessageData : message)
+            {
+                rows.push_back(MakeRow(moduleName, moduleType, metadata, singleMessageData.dump()));
+            }
+        }
+        else
+        {
+            rows.push_back(MakeRow(moduleName, moduleType, metadata, message.dump()));
+        }
+    }
 } // namespace
 
 Storage::Storage(const std::string& dbFolderPath,
@@ -93,6 +165,11 @@ Storage::Storage(const std::string& dbFolderPath,
             if (!m_db->TableExists(table))
             {
                 CreateTable(table);
+                m_counters[table] = {};
+            }
+            else if (auto counters = LoadCounters(table); counters.has_value())
+            {
+                m_counters[table] = std::move(counters.value());
             }
         }
     }
@@ -130,6 +207,12 @@ bool Storage::Clear(const std::vector<std::string>& tableNames)
         for (const auto& table : tableNames)
         {
             m_db->Remove(table, {});
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            if (const auto it = m_counters.find(table); it != m_counters.end())
+            {
+                it->second.clear();
+            }
         }
     }
     catch (const std::exception& e)
@@ -146,10 +229,38 @@ int Storage::Store(const nlohmann::json& message,
                    const std::string& moduleType,
                    const std::string& metadata)
 {
-    Row fields;
-    fields.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT, moduleName);
-    fields.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT, moduleType);
-    fields.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT, metadata);
+    std::vector<Row> rows;
+    AppendRows(rows, message, moduleName, moduleType, metadata);
+
+    return InsertRows(rows, tableName);
+}
+
+int Storage::StoreMultiple(const std::vector<Message>& messages, const std::string& tableName)
+{
+    std::vector<Row> rows;
+    rows.reserve(messages.size());
+
+    for (const auto& message : messages)
+    {
+        if (!message.rawData.empty())
+        {
+            rows.push_back(MakeRow(message.moduleName, message.moduleType, message.metaData, message.rawData));
+        }
+        else
+        {
+            AppendRows(rows, message.data, message.moduleName, message.moduleType, message.metaData);
+        }
+    }
+
+    return InsertRows(rows, tableName);
+}
+
+int Storage::InsertRows(const std::vector<Row>& rows, const std::string& tableName)
+{
+    if (rows.empty())
+    {
+        return 0;
+    }
 
     int result = 0;
 
@@ -157,41 +268,48 @@ int Storage::Store(const nlohmann::json& message,
 
     auto transaction = m_db->BeginTransaction();
 
-    if (message.is_array())
+    try
     {
-        for (const auto& singleMessageData : message)
-        {
-            fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, singleMessageData.dump());
+        result = m_db->InsertMany(tableName, rows);
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error during Store operation: {}.", e.what());
+    }
 
-            try
-            {
-                m_db->Insert(tableName, fields);
-                result++;
-            }
-            catch (const std::exception& e)
-            {
-                LogError("Error during Store operation: {}.", e.what());
-            }
-            fields.pop_back();
-        }
+    try
+    {
+        m_db->CommitTransaction(transaction);
     }
-    else
+    catch (const std::exception& e)
     {
-        fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, message.dump());
+        // The counters are reloaded below, as the rows were rolled back
+        LogError("Error committing Store operation: {}.", e.what());
+        result = 0;
+    }
 
-        try
+    if (const auto it = m_counters.find(tableName); it != m_counters.end())
+    {
+        if (static_cast<size_t>(result) == rows.size())
         {
-            m_db->Insert(tableName, fields);
-            result++;
+            for (const auto& row : rows)
+            {
+                auto& counter = it->second[{row[0].Value, row[1].Value}];
+                ++counter.Count;
+                counter.Bytes += RowSize(row);
+            }
         }
-        catch (const std::exception& e)
+        else if (auto counters = LoadCounters(tableName); counters.has_value())
+        {
+            // Some rows failed, count them again from the database
+            it->second = std::move(counters.value());
+        }
+        else
         {
-            LogError("Error during Store operation: {}.", e.what());
+            m_counters.erase(it);
         }
     }
 
-    m_db->CommitTransaction(transaction);
-
     return result;
 }
 
@@ -212,8 +330,13 @@ int Storage::RemoveMultiple(int n,
 
     int result = 0;
 
+    // Messages removed by module, subtracted from the counters once the transaction is committed
+    TableCounters removed;
+
     const std::unique_lock<std::mutex> lock(m_mutex);
 
+    const auto counters = m_counters.find(tableName);
+
     auto transaction = m_db->BeginTransaction();
 
     try
@@ -221,9 +344,21 @@ int Storage::RemoveMultiple(int n,
         Names columns;
         columns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
 
-        // Select first n messages
-        const auto results =
-            m_db->Select(tableName, columns, filters, LogicalOperator::AND, columns, OrderType::ASC, n);
+        const Names orderColumns = columns;
+
+        // Select first n messages, with their module and size if they are needed to update the counters
+        std::vector<Row> results;
+        if (counters != m_counters.end())
+        {
+            columns.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT);
+            columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
+            results = m_db->SelectWithSize(
+                tableName, columns, SizeColumns(), filters, LogicalOperator::AND, orderColumns, OrderType::ASC, n);
+        }
+        else
+        {
+            results = m_db->Select(tableName, columns, filters, LogicalOperator::AND, orderColumns, OrderType::ASC, n);
+        }
 
         if (!results.empty())
         {
@@ -238,6 +373,13 @@ int Storage::RemoveMultiple(int n,
                     // Remove selected message
                     m_db->Remove(tableName, filters, LogicalOperator::AND);
                     result++;
+
+                    if (row.size() > 3)
+                    {
+                        auto& counter = removed[{row[1].Value, row[2].Value}];
+                        ++counter.Count;
+                        counter.Bytes += ParseSize(row[3].Value);
+                    }
                 }
                 catch (const std::exception& e)
                 {
@@ -252,7 +394,36 @@ int Storage::RemoveMultiple(int n,
         LogError("Error during RemoveMultiple operation: {}.", e.what());
     }
 
-    m_db->CommitTransaction(transaction);
+    try
+    {
+        m_db->CommitTransaction(transaction);
+    }
+    catch (const std::exception& e)
+    {
+        // The rows were rolled back, so the counters are left as they are
+        LogError("Error committing RemoveMultiple operation: {}.", e.what());
+        return 0;
+    }
+
+    if (counters != m_counters.end())
+    {
+        for (const auto& [module, removedCounter] : removed)
+        {
+            const auto it = counters->second.find(module);
+            if (it == counters->second.end())
+            {
+                continue;
+            }
+
+            auto& counter = it->second;
+            counter.Bytes -= std::min(counter.Bytes, removedCounter.Bytes);
+            counter.Count -= std::min(counter.Count, removedCounter.Count);
+            if (counter.Count == 0)
+            {
+                counters->second.erase(it);
+            }
+        }
+    }
 
     return result;
 }
@@ -298,7 +469,8 @@ nlohmann::json Storage::RetrieveMultiple(int n,
 nlohmann::json Storage::RetrieveBySize(size_t n,
                                        const std::string& tableName,
                                        const std::string& moduleName,
-                                       const std::string& moduleType)
+                                       const std::string& moduleType,
+                                       bool rawData)
 {
     Names columns;
     columns.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT);
@@ -324,7 +496,7 @@ nlohmann::json Storage::RetrieveBySize(size_t n,
         const auto results =
             m_db->Select(tableName, columns, filters, LogicalOperator::AND, orderColumns, OrderType::ASC);
 
-        return ProcessRequest(results, n);
+        return ProcessRequest(results, n, rawData);
     }
     catch (const std::exception& e)
     {
@@ -335,6 +507,14 @@ nlohmann::json Storage::RetrieveBySize(size_t n,
 
 int Storage::GetElementCount(const std::string& tableName, const std::string& moduleName, const std::string& moduleType)
 {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (const auto it = m_counters.find(tableName); it != m_counters.end())
+        {
+            return static_cast<int>(SumCounters(it->second, moduleName, moduleType).Count);
+        }
+    }
+
     Criteria filters;
     if (!moduleName.empty())
     {
@@ -363,6 +543,14 @@ size_t Storage::GetElementsStoredSize(const std::string& tableName,
                                       const std::string& moduleName,
                                       const std::string& moduleType)
 {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (const auto it = m_counters.find(tableName); it != m_counters.end())
+        {
+            return SumCounters(it->second, moduleName, moduleType).Bytes;
+        }
+    }
+
     Criteria filters;
     if (!moduleName.empty())
     {
@@ -377,13 +565,7 @@ size_t Storage::GetElementsStoredSize(const std::string& tableName,
 
     try
     {
-        Names columns;
-        columns.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT);
-        columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
-        columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
-        columns.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT);
-
-        count = m_db->GetSize(tableName, columns, filters, LogicalOperator::AND);
+        count = m_db->GetSize(tableName, SizeColumns(), filters, LogicalOperator::AND);
     }
     catch (const std::exception& e)
     {
@@ -392,3 +574,46 @@ size_t Storage::GetElementsStoredSize(const std::string& tableName,
 
     return count;
 }
+
+std::optional<Storage::TableCounters> Storage::LoadCounters(const std::string& tableName)
+{
+    try
+    {
+        Names groupBy;
+        groupBy.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT);
+        groupBy.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
+
+        TableCounters counters;
+
+        for (const auto& row : m_db->GetCountAndSizeGroupedBy(tableName, groupBy, SizeColumns()))
+        {
+            auto& counter = counters[{row[0].Value, row[1].Value}];
+            counter.Count += ParseSize(row[2].Value);
+            counter.Bytes += ParseSize(row[3].Value);
+        }
+
+        return counters;
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error counting the elements of {}: {}.", tableName, e.what());
+        return std::nullopt;
+    }
+}
+
+Storage::ElementCounter
+Storage::SumCounters(const TableCounters& counters, const std::string& moduleName, const std::string& moduleType)
+{
+    ElementCounter sum;
+
+    for (const auto& [module, counter] : counters)
+    {
+        if ((moduleName.empty() || module.first == moduleName) && (moduleType.empty() || module.second == moduleType))
+        {
+            sum.Count += counter.Count;
+            sum.Bytes += counter.Bytes;
+        }
+    }
+
+    return sum;
+}
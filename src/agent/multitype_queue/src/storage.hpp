@@ -5,14 +5,19 @@
 
 #include <nlohmann/json.hpp>
 
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 
 /// @brief Storage class.
 ///
 /// This class provides methods to store, retrieve, and remove JSON messages
-/// in a database.
+/// in a database. The number of messages and bytes stored by each module is
+/// counted once on startup and kept up to date, so that counting does not
+/// query the database.
 class Storage : public IStorage
 {
 public:
@@ -49,6 +54,9 @@ public:
               const std::string& moduleType = "",
               const std::string& metadata = "") override;
 
+    /// @copydoc IStorage::StoreMultiple
+    int StoreMultiple(const std::vector<Message>& messages, const std::string& tableName) override;
+
     /// @copydoc IStorage::RemoveMultiple
     int RemoveMultiple(int n,
                        const std::string& tableName,
@@ -65,7 +73,8 @@ public:
     nlohmann::json RetrieveBySize(size_t n,
                                   const std::string& tableName,
                                   const std::string& moduleName = "",
-                                  const std::string& moduleType = "") override;
+                                  const std::string& moduleType = "",
+                                  bool rawData = false) override;
 
     /// @copydoc IStorage::GetElementCount
     int GetElementCount(const std::string& tableName,
@@ -82,9 +91,43 @@ private:
     /// @param tableName The name of the table to create.
     void CreateTable(const std::string& tableName);
 
+    /// @brief Number of messages and bytes stored
+    struct ElementCounter
+    {
+        size_t Count = 0;
+        size_t Bytes = 0;
+    };
+
+    /// @brief Counters of a table, by module name and type
+    using TableCounters = std::map<std::pair<std::string, std::string>, ElementCounter>;
+
+    /// @brief Counts the messages stored in a table, by module.
+    /// @param tableName The name of the table.
+    /// @return The counters of the table, or std::nullopt if the database could not be queried.
+    std::optional<TableCounters> LoadCounters(const std::string& tableName);
+
+    /// @brief Adds up the counters of the modules matching a filter.
+    /// @param counters The counters of a table.
+    /// @param moduleName The module name, empty for any.
+    /// @param moduleType The module type, empty for any.
+    /// @return The sum of the matching counters.
+    static ElementCounter SumCounters(const TableCounters& counters,
+                                      const std::string& moduleName,
+                                      const std::string& moduleType);
+
+    /// @brief Insert rows in a single transaction.
+    /// @param rows The rows to insert.
+    /// @param tableName The name of the table.
+    /// @return The number of inserted rows.
+    int InsertRows(const std::vector<column::Row>& rows, const std::string& tableName);
+
     /// @brief Pointer to the database connection.
     std::unique_ptr<Persistence> m_db;
 
     /// @brief Mutex to ensure thread-safe operations.
     std::mutex m_mutex;
+
+    /// @brief Counters of each table, protected by m_mutex. Tables whose counters could not be loaded are
+    /// counted by querying the database.
+    std::map<std::string, TableCounters> m_counters;
 };
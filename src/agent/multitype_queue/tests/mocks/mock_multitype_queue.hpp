@@ -20,16 +20,22 @@ public:
                 getNext,
                 (MessageType type, const std::string moduleName, const std::string moduleType),
                 (override));
-    MOCK_METHOD(
-        boost::asio::awaitable<std::vector<Message>>,
-        getNextBytesAwaitable,
-        (MessageType type, const size_t messageQuantity, const std::string moduleName, const std::string moduleType),
-        (override));
-    MOCK_METHOD(
-        std::vector<Message>,
-        getNextBytes,
-        (MessageType type, const size_t messageQuantity, const std::string moduleName, const std::string moduleType),
-        (override));
+    MOCK_METHOD(boost::asio::awaitable<std::vector<Message>>,
+                getNextBytesAwaitable,
+                (MessageType type,
+                 const size_t messageQuantity,
+                 const std::string moduleName,
+                 const std::string moduleType,
+                 const bool rawData),
+                (override));
+    MOCK_METHOD(std::vector<Message>,
+                getNextBytes,
+                (MessageType type,
+                 const size_t messageQuantity,
+                 const std::string moduleName,
+                 const std::string moduleType,
+                 const bool rawData),
+                (override));
     MOCK_METHOD(bool, pop, (MessageType type, const std::string moduleName, const std::string moduleType), (override));
     MOCK_METHOD(int,
                 popN,
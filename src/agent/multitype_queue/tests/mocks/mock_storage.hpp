@@ -23,6 +23,8 @@ public:
                  const std::string& metadata),
                 (override));
 
+    MOCK_METHOD(int, StoreMultiple, (const std::vector<Message>& messages, const std::string& tableName), (override));
+
     MOCK_METHOD(int,
                 RemoveMultiple,
                 (int n, const std::string& tableName, const std::string& moduleName, const std::string& moduleType),
@@ -35,7 +37,11 @@ public:
 
     MOCK_METHOD(nlohmann::json,
                 RetrieveBySize,
-                (size_t n, const std::string& tableName, const std::string& moduleName, const std::string& moduleType),
+                (size_t n,
+                 const std::string& tableName,
+                 const std::string& moduleName,
+                 const std::string& moduleType,
+                 bool rawData),
                 (override));
 
     MOCK_METHOD(int,
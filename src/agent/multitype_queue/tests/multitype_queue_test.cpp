@@ -59,6 +59,21 @@ namespace
         agent:
           path.data: "."
     )"));
+
+    const auto MEMORY_CONFIG_PARSER = std::make_shared<configuration::ConfigurationParser>(std::string(R"(
+        agent:
+          path.data: "."
+          queue_durability: memory
+    )"));
+
+    const auto SPILL_CONFIG_PARSER = std::make_shared<configuration::ConfigurationParser>(std::string(R"(
+        agent:
+          path.data: "."
+          queue_durability: spill
+          queue_memory_size: 100
+    )"));
+
+    constexpr size_t SPILL_MEMORY_SIZE = 100;
 } // namespace
 
 /// Test Methods
@@ -186,9 +201,8 @@ TEST_F(MultiTypeQueueTest, PushStoreArray)
 
     EXPECT_CALL(*m_mockStorage, GetElementCount(testing::_, testing::_, testing::_)).WillOnce(testing::Return(0));
 
-    EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_))
-        .Times(2)
-        .WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*m_mockStorage, Store(arrayData, testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(2));
 
     EXPECT_EQ(multiTypeQueue.push(messageToSend), 2);
 }
@@ -205,10 +219,7 @@ TEST_F(MultiTypeQueueTest, PushStoreArrayFailFirst)
 
     EXPECT_CALL(*m_mockStorage, GetElementCount(testing::_, testing::_, testing::_)).WillOnce(testing::Return(0));
 
-    const testing::Sequence seq;
-    EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_))
-        .InSequence(seq)
-        .WillOnce(testing::Return(0))
+    EXPECT_CALL(*m_mockStorage, Store(arrayData, testing::_, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(1));
 
     EXPECT_EQ(multiTypeQueue.push(messageToSend), 1);
@@ -327,9 +338,8 @@ TEST_F(MultiTypeQueueTest, PushAwaitableStoreArray)
         .Times(2)
         .WillRepeatedly(testing::Return(0));
 
-    EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_))
-        .Times(2)
-        .WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*m_mockStorage, Store(arrayData, testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(2));
 
     testing::MockFunction<void(int)> checkResult;
     EXPECT_CALL(checkResult, Call(2));
@@ -361,10 +371,7 @@ TEST_F(MultiTypeQueueTest, PushAwaitableStoreArrayFailFirst)
         .Times(2)
         .WillRepeatedly(testing::Return(0));
 
-    const testing::Sequence seq;
-    EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_))
-        .InSequence(seq)
-        .WillOnce(testing::Return(0))
+    EXPECT_CALL(*m_mockStorage, Store(arrayData, testing::_, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(1));
 
     testing::MockFunction<void(int)> checkResult;
@@ -435,8 +442,8 @@ TEST_F(MultiTypeQueueTest, PushVector)
         .WillRepeatedly(testing::Return(0));
 
     EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_))
-        .Times(4)
-        .WillRepeatedly(testing::Return(1));
+        .Times(2)
+        .WillRepeatedly(testing::Return(2));
 
     EXPECT_EQ(multiTypeQueue.push(messages), 4);
 }
@@ -540,7 +547,7 @@ TEST_F(MultiTypeQueueTest, GetNextBytesAwaitableSuccess)
     EXPECT_CALL(*m_mockStorage, GetElementsStoredSize(testing::_, testing::_, testing::_))
         .WillRepeatedly(testing::Return(messageQuantity));
 
-    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_))
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(retrievedMessages));
 
     testing::MockFunction<void(const std::vector<Message>&)> checkResult;
@@ -575,7 +582,7 @@ TEST_F(MultiTypeQueueTest, GetNextBytesEmpty)
     const MessageType messageType {MessageType::STATELESS};
 
     const nlohmann::json retrieveResult = nlohmann::json::array();
-    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_))
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(retrieveResult));
 
     const size_t contentSize = 1;
@@ -596,7 +603,7 @@ TEST_F(MultiTypeQueueTest, GetNextBytesMessage)
          {{"data", "msg2"}, {"moduleName", moduleName}, {"moduleType", moduleType}, {"metadata", "meta2"}},
          {{"data", "msg3"}, {"moduleName", moduleName}, {"moduleType", moduleType}, {"metadata", "meta3"}}});
 
-    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_))
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(retrievedMessages));
 
     const size_t contentSize = 3;
@@ -791,4 +798,184 @@ TEST_F(MultiTypeQueueTest, SizePerTypeNotEmpty)
     EXPECT_EQ(multiTypeQueue.sizePerType(messageType), 2);
 }
 
+TEST_F(MultiTypeQueueTest, MemoryDurabilityKeepsStatelessMessagesInMemory)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage, Store(testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+    EXPECT_CALL(*m_mockStorage, StoreMultiple(testing::_, testing::_)).Times(0);
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+    EXPECT_CALL(*m_mockStorage, RemoveMultiple(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+    MultiTypeQueue multiTypeQueue(MEMORY_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, "msg1", "moduleA"}), 1);
+    EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, nlohmann::json::array({"msg2", "msg3"}), "moduleB"}), 2);
+
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS), 3);
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS, "moduleB"), 2);
+    // Module name plus serialized data of each message
+    EXPECT_EQ(multiTypeQueue.sizePerType(MessageType::STATELESS), 3 * (7 + 6));
+    EXPECT_EQ(multiTypeQueue.getNext(MessageType::STATELESS, "moduleB").data, "msg2");
+
+    const auto messages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 1000);
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[0].data, "msg1");
+    EXPECT_EQ(messages[1].data, "msg2");
+    EXPECT_EQ(messages[2].data, "msg3");
+    EXPECT_EQ(messages[2].moduleName, "moduleB");
+
+    EXPECT_EQ(multiTypeQueue.popN(MessageType::STATELESS, 2), 2);
+    EXPECT_EQ(multiTypeQueue.getNext(MessageType::STATELESS).data, "msg3");
+    EXPECT_TRUE(multiTypeQueue.pop(MessageType::STATELESS));
+    EXPECT_TRUE(multiTypeQueue.isEmpty(MessageType::STATELESS));
+}
+
+TEST_F(MultiTypeQueueTest, MemoryDurabilityPersistsStatefulMessages)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATEFUL_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage, Store(testing::_, STATEFUL_TABLE_NAME, testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(1));
+
+    MultiTypeQueue multiTypeQueue(MEMORY_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    EXPECT_EQ(multiTypeQueue.push({MessageType::STATEFUL, BASE_DATA_CONTENT}), 1);
+}
+
+TEST_F(MultiTypeQueueTest, SpillDurabilityMovesMemoryTierToStorageWhenFull)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage, StoreMultiple(testing::SizeIs(SPILL_MEMORY_SIZE), STATELESS_TABLE_NAME))
+        .WillOnce(testing::Return(static_cast<int>(SPILL_MEMORY_SIZE)));
+
+    MultiTypeQueue multiTypeQueue(SPILL_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    for (size_t i = 0; i <= SPILL_MEMORY_SIZE; ++i)
+    {
+        EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, "msg" + std::to_string(i)}), 1);
+    }
+
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS), SPILL_MEMORY_SIZE + 1);
+
+    // Spilled messages are older, so they come first and are removed first
+    const nlohmann::json storedMessages = nlohmann::json::array(
+        {{{"data", "msg0"}, {"moduleName", ""}, {"moduleType", ""}, {"metadata", ""}}});
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(0, STATELESS_TABLE_NAME, "", "", false))
+        .WillOnce(testing::Return(storedMessages));
+
+    const auto messages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].data, "msg0");
+    EXPECT_EQ(messages[1].data, "msg" + std::to_string(SPILL_MEMORY_SIZE));
+
+    EXPECT_CALL(*m_mockStorage, RemoveMultiple(static_cast<int>(SPILL_MEMORY_SIZE + 1), STATELESS_TABLE_NAME, "", ""))
+        .WillOnce(testing::Return(static_cast<int>(SPILL_MEMORY_SIZE)));
+
+    EXPECT_EQ(multiTypeQueue.popN(MessageType::STATELESS, static_cast<int>(SPILL_MEMORY_SIZE + 1)),
+              SPILL_MEMORY_SIZE + 1);
+    EXPECT_TRUE(multiTypeQueue.isEmpty(MessageType::STATELESS));
+}
+
+TEST_F(MultiTypeQueueTest, SpillDurabilityStoresMemoryTierOnDestruction)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage,
+                StoreMultiple(testing::ElementsAre(testing::Field(&Message::rawData, R"("msg1")"),
+                                                   testing::Field(&Message::rawData, R"("msg2")")),
+                              STATELESS_TABLE_NAME))
+        .WillOnce(testing::Return(2));
+
+    {
+        MultiTypeQueue multiTypeQueue(SPILL_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+        EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, "msg1"}), 1);
+        EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, "msg2"}), 1);
+    }
+}
+
+TEST_F(MultiTypeQueueTest, GetNextBytesRawDataSkipsParsing)
+{
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    const nlohmann::json storedMessages = nlohmann::json::array(
+        {{{"rawData", R"({"key":"value"})"}, {"moduleName", "module"}, {"moduleType", ""}, {"metadata", ""}}});
+    EXPECT_CALL(*m_mockStorage, RetrieveBySize(0, STATELESS_TABLE_NAME, "", "", true))
+        .WillOnce(testing::Return(storedMessages));
+
+    const auto messages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0, "", "", true);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_TRUE(messages[0].data.is_null());
+    EXPECT_EQ(messages[0].rawData, R"({"key":"value"})");
+    EXPECT_EQ(messages[0].moduleName, "module");
+}
+
+TEST_F(MultiTypeQueueTest, MemoryTierReturnsRawData)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+
+    MultiTypeQueue multiTypeQueue(MEMORY_CONFIG_PARSER, std::move(m_mockStoragePtr));
+    EXPECT_EQ(multiTypeQueue.push({MessageType::STATELESS, "msg1"}), 1);
+
+    const auto rawMessages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0, "", "", true);
+    ASSERT_EQ(rawMessages.size(), 1);
+    EXPECT_TRUE(rawMessages[0].data.is_null());
+    EXPECT_EQ(rawMessages[0].rawData, R"("msg1")");
+
+    const auto parsedMessages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0);
+    ASSERT_EQ(parsedMessages.size(), 1);
+    EXPECT_EQ(parsedMessages[0].data, "msg1");
+    EXPECT_TRUE(parsedMessages[0].rawData.empty());
+}
+
+TEST_F(MultiTypeQueueTest, PushRawDataStoresItVerbatim)
+{
+    EXPECT_CALL(*m_mockStorage,
+                StoreMultiple(testing::ElementsAre(testing::Field(&Message::rawData, R"({"key":"value"})")),
+                              STATEFUL_TABLE_NAME))
+        .WillOnce(testing::Return(1));
+
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    Message message(MessageType::STATEFUL, nullptr);
+    message.rawData = R"({"key":"value"})";
+    EXPECT_EQ(multiTypeQueue.push(message), 1);
+}
+
+TEST_F(MultiTypeQueueTest, MemoryTierKeepsPushedRawData)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+
+    MultiTypeQueue multiTypeQueue(MEMORY_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+    Message message(MessageType::STATELESS, nullptr, "module");
+    message.rawData = R"({"key":"value"})";
+    EXPECT_EQ(multiTypeQueue.push(message), 1);
+
+    const auto rawMessages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0, "", "", true);
+    ASSERT_EQ(rawMessages.size(), 1);
+    EXPECT_EQ(rawMessages[0].rawData, R"({"key":"value"})");
+    EXPECT_EQ(rawMessages[0].moduleName, "module");
+
+    const auto parsedMessages = multiTypeQueue.getNextBytes(MessageType::STATELESS, 0);
+    ASSERT_EQ(parsedMessages.size(), 1);
+    EXPECT_EQ(parsedMessages[0].data, nlohmann::json({{"key", "value"}}));
+}
+
+TEST_F(MultiTypeQueueTest, SpillDurabilityKeepsPushedRawData)
+{
+    EXPECT_CALL(*m_mockStorage, GetElementCount(STATELESS_TABLE_NAME, "", "")).WillOnce(testing::Return(0));
+    EXPECT_CALL(*m_mockStorage,
+                StoreMultiple(testing::ElementsAre(testing::Field(&Message::rawData, R"({"key":"value"})")),
+                              STATELESS_TABLE_NAME))
+        .WillOnce(testing::Return(1));
+
+    {
+        MultiTypeQueue multiTypeQueue(SPILL_CONFIG_PARSER, std::move(m_mockStoragePtr));
+
+        Message message(MessageType::STATELESS, nullptr);
+        message.rawData = R"({"key":"value"})";
+        EXPECT_EQ(multiTypeQueue.push(message), 1);
+    }
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
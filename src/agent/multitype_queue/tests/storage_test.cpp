@@ -87,6 +87,7 @@ class StorageTest : public ::testing::Test
 protected:
     const std::string tableName = "test_table";
     const std::string moduleName = "moduleX";
+    const std::string uncachedTableName = "uncached_table";
     const std::vector<std::string> m_vMessageTypeStrings {"test_table", "test_table2"};
     std::unique_ptr<Storage> m_storage;
     MockPersistence* m_mockPersistence = nullptr;
@@ -137,7 +138,7 @@ TEST_F(StorageTest, StoreSingleMessageArray)
     const nlohmann::json message = {{"key", "value"}};
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_)).Times(1);
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(1))).WillOnce(testing::Return(1));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
     EXPECT_EQ(m_storage->Store(message, tableName), 1);
@@ -148,7 +149,7 @@ TEST_F(StorageTest, StoreSingleMessageNoArray)
     const nlohmann::json message = "message-no-array";
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_)).Times(1);
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(1))).WillOnce(testing::Return(1));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
     EXPECT_EQ(m_storage->Store(message, tableName), 1);
@@ -161,21 +162,22 @@ TEST_F(StorageTest, StoreSingleMessageWithModule)
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
     EXPECT_CALL(
         *m_mockPersistence,
-        Insert(testing::Eq(tableName),
-               testing::AllOf(testing::SizeIs(4),
-                              testing::Contains(testing::AllOf(
-                                  testing::Field(&column::ColumnValue::Name, testing::Eq(MODULE_NAME_COLUMN_NAME)),
-                                  testing::Field(&column::ColumnValue::Value, testing::Eq(moduleName)))),
-                              testing::Contains(testing::AllOf(
-                                  testing::Field(&column::ColumnValue::Name, testing::Eq(MODULE_TYPE_COLUMN_NAME)),
-                                  testing::Field(&column::ColumnValue::Value, testing::Eq("")))),
-                              testing::Contains(testing::AllOf(
-                                  testing::Field(&column::ColumnValue::Name, testing::Eq(METADATA_COLUMN_NAME)),
-                                  testing::Field(&column::ColumnValue::Value, testing::Eq("")))),
-                              testing::Contains(testing::AllOf(
-                                  testing::Field(&column::ColumnValue::Name, testing::Eq(MESSAGE_COLUMN_NAME)),
-                                  testing::Field(&column::ColumnValue::Value, testing::Eq("{\"key\":\"value\"}")))))))
-        .Times(1);
+        InsertMany(testing::Eq(tableName),
+                   testing::ElementsAre(testing::AllOf(
+                       testing::SizeIs(4),
+                       testing::Contains(testing::AllOf(
+                           testing::Field(&column::ColumnValue::Name, testing::Eq(MODULE_NAME_COLUMN_NAME)),
+                           testing::Field(&column::ColumnValue::Value, testing::Eq(moduleName)))),
+                       testing::Contains(testing::AllOf(
+                           testing::Field(&column::ColumnValue::Name, testing::Eq(MODULE_TYPE_COLUMN_NAME)),
+                           testing::Field(&column::ColumnValue::Value, testing::Eq("")))),
+                       testing::Contains(testing::AllOf(
+                           testing::Field(&column::ColumnValue::Name, testing::Eq(METADATA_COLUMN_NAME)),
+                           testing::Field(&column::ColumnValue::Value, testing::Eq("")))),
+                       testing::Contains(testing::AllOf(
+                           testing::Field(&column::ColumnValue::Name, testing::Eq(MESSAGE_COLUMN_NAME)),
+                           testing::Field(&column::ColumnValue::Value, testing::Eq("{\"key\":\"value\"}"))))))))
+        .WillOnce(testing::Return(1));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
     EXPECT_EQ(m_storage->Store(message, tableName, moduleName), 1);
@@ -188,64 +190,57 @@ TEST_F(StorageTest, StoreMultipleMessages)
     messages.push_back({{"key", "value2"}});
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_)).Times(2);
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(2))).WillOnce(testing::Return(2));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
     EXPECT_EQ(m_storage->Store(messages, tableName), 2);
 }
 
-TEST_F(StorageTest, StoreMultipleMessagesFailFirst)
+TEST_F(StorageTest, StoreMultipleMessagesFailOne)
 {
     auto messages = nlohmann::json::array();
     messages.push_back({{"key", "value1"}});
     messages.push_back({{"key", "value2"}});
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-
-    const testing::Sequence seq;
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_))
-        .InSequence(seq)
-        .WillOnce(testing::Throw(std::runtime_error("Error Insert")))
-        .WillOnce(testing::Return());
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(2))).WillOnce(testing::Return(1));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
     EXPECT_EQ(m_storage->Store(messages, tableName), 1);
 }
 
-TEST_F(StorageTest, StoreMultipleMessagesFailSecond)
+TEST_F(StorageTest, StoreMultipleMessagesFailAll)
 {
     auto messages = nlohmann::json::array();
     messages.push_back({{"key", "value1"}});
     messages.push_back({{"key", "value2"}});
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-
-    const testing::Sequence seq;
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_))
-        .InSequence(seq)
-        .WillOnce(testing::Return())
-        .WillOnce(testing::Throw(std::runtime_error("Error Insert")));
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(2)))
+        .WillOnce(testing::Throw(std::runtime_error("Error InsertMany")));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
-    EXPECT_EQ(m_storage->Store(messages, tableName), 1);
+    EXPECT_EQ(m_storage->Store(messages, tableName), 0);
 }
 
-TEST_F(StorageTest, StoreMultipleMessagesFailAll)
+TEST_F(StorageTest, StoreMultipleMessageEntries)
 {
-    auto messages = nlohmann::json::array();
-    messages.push_back({{"key", "value1"}});
-    messages.push_back({{"key", "value2"}});
+    const std::vector<Message> messages {{MessageType::STATELESS, {{"key", "value1"}}, moduleName},
+                                         {MessageType::STATELESS, nlohmann::json::array({"value2", "value3"})}};
 
     EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(1);
-
-    const testing::Sequence seq;
-    EXPECT_CALL(*m_mockPersistence, Insert(tableName, testing::_))
-        .InSequence(seq)
-        .WillOnce(testing::Throw(std::runtime_error("Error Insert")))
-        .WillOnce(testing::Throw(std::runtime_error("Error Insert")));
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::SizeIs(3))).WillOnce(testing::Return(3));
     EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_)).Times(1);
 
-    EXPECT_EQ(m_storage->Store(messages, tableName), 0);
+    EXPECT_EQ(m_storage->StoreMultiple(messages, tableName), 3);
+}
+
+TEST_F(StorageTest, StoreMultipleMessageEntriesEmpty)
+{
+    EXPECT_CALL(*m_mockPersistence, BeginTransaction()).Times(0);
+    EXPECT_CALL(*m_mockPersistence, InsertMany(testing::_, testing::_)).Times(0);
+
+    EXPECT_EQ(m_storage->StoreMultiple({}, tableName), 0);
 }
 
 TEST_F(StorageTest, RetrieveMultipleMessages)
@@ -411,6 +406,28 @@ TEST_F(StorageTest, RetrieveBySizeMessage1HalfMessage2)
     EXPECT_EQ(retrievedMessages.size(), 2);
 }
 
+TEST_F(StorageTest, RetrieveBySizeRawData)
+{
+    const std::string dataString = R"({"key":"value1"})";
+
+    const std::vector<column::Row> mockRows = {
+        {column::ColumnValue(MODULE_NAME_COLUMN_NAME, column::ColumnType::TEXT, moduleName),
+         column::ColumnValue(MODULE_TYPE_COLUMN_NAME, column::ColumnType::TEXT, "type1"),
+         column::ColumnValue(METADATA_COLUMN_NAME, column::ColumnType::TEXT, "metadata1"),
+         column::ColumnValue(MESSAGE_COLUMN_NAME, column::ColumnType::TEXT, dataString)}};
+
+    EXPECT_CALL(*m_mockPersistence,
+                Select(tableName, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::Return(mockRows));
+
+    const auto retrievedMessages = m_storage->RetrieveBySize(0, tableName, moduleName, "", true);
+    ASSERT_EQ(retrievedMessages.size(), 1);
+    EXPECT_FALSE(retrievedMessages[0].contains("data"));
+    EXPECT_EQ(retrievedMessages[0]["rawData"], dataString);
+    EXPECT_EQ(retrievedMessages[0]["moduleType"], "type1");
+    EXPECT_EQ(retrievedMessages[0]["metadata"], "metadata1");
+}
+
 TEST_F(StorageTest, RetrieveBySizeSelectFail)
 {
     EXPECT_CALL(*m_mockPersistence,
@@ -423,29 +440,151 @@ TEST_F(StorageTest, RetrieveBySizeSelectFail)
 
 TEST_F(StorageTest, GetElementCount)
 {
-    EXPECT_CALL(*m_mockPersistence, GetCount(tableName, testing::_, testing::_)).WillOnce(testing::Return(1));
-    EXPECT_EQ(m_storage->GetElementCount(tableName), 1);
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::_))
+        .WillOnce(testing::Return(2))
+        .WillOnce(testing::Return(1));
+    EXPECT_CALL(*m_mockPersistence, GetCount(testing::_, testing::_, testing::_)).Times(0);
+
+    m_storage->Store(nlohmann::json::array({"value1", "value2"}), tableName, moduleName);
+    m_storage->Store("value3", tableName);
+
+    EXPECT_EQ(m_storage->GetElementCount(tableName), 3);
+    EXPECT_EQ(m_storage->GetElementCount(tableName, moduleName), 2);
+    EXPECT_EQ(m_storage->GetElementCount(tableName, "moduleY"), 0);
+    EXPECT_EQ(m_storage->GetElementCount("test_table2"), 0);
+}
+
+TEST_F(StorageTest, GetElementCountAfterRemove)
+{
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::_)).WillOnce(testing::Return(2));
+    m_storage->Store(nlohmann::json::array({"value1", "value2"}), tableName, moduleName);
+
+    const auto removedSize = moduleName.size() + std::string("\"value1\"").size();
+    const std::vector<column::Row> selectedRows {
+        {column::ColumnValue("rowid", column::ColumnType::INTEGER, "1"),
+         column::ColumnValue(MODULE_NAME_COLUMN_NAME, column::ColumnType::TEXT, moduleName),
+         column::ColumnValue(MODULE_TYPE_COLUMN_NAME, column::ColumnType::TEXT, ""),
+         column::ColumnValue("size", column::ColumnType::INTEGER, std::to_string(removedSize))}};
+    EXPECT_CALL(*m_mockPersistence,
+                SelectWithSize(tableName,
+                               testing::SizeIs(3),
+                               testing::SizeIs(4),
+                               testing::_,
+                               testing::_,
+                               testing::_,
+                               testing::_,
+                               1))
+        .WillOnce(testing::Return(selectedRows));
+    EXPECT_CALL(*m_mockPersistence, Remove(tableName, testing::_, testing::_)).Times(1);
+
+    EXPECT_EQ(m_storage->RemoveMultiple(1, tableName), 1);
+    EXPECT_EQ(m_storage->GetElementCount(tableName, moduleName), 1);
+    EXPECT_EQ(m_storage->GetElementsStoredSize(tableName), moduleName.size() + std::string("\"value2\"").size());
+}
+
+TEST_F(StorageTest, GetElementCountAfterFailedRemove)
+{
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::_)).WillOnce(testing::Return(2));
+    m_storage->Store(nlohmann::json::array({"value1", "value2"}), tableName, moduleName);
+
+    const std::vector<column::Row> selectedRows {
+        {column::ColumnValue("rowid", column::ColumnType::INTEGER, "1"),
+         column::ColumnValue(MODULE_NAME_COLUMN_NAME, column::ColumnType::TEXT, moduleName),
+         column::ColumnValue(MODULE_TYPE_COLUMN_NAME, column::ColumnType::TEXT, ""),
+         column::ColumnValue("size", column::ColumnType::INTEGER, "15")}};
+    EXPECT_CALL(*m_mockPersistence,
+                SelectWithSize(tableName, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, 1))
+        .WillOnce(testing::Return(selectedRows));
+    EXPECT_CALL(*m_mockPersistence, Remove(tableName, testing::_, testing::_)).Times(1);
+    EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_))
+        .WillOnce(testing::Throw(std::runtime_error("Error CommitTransaction")));
+
+    EXPECT_EQ(m_storage->RemoveMultiple(1, tableName), 0);
+    EXPECT_EQ(m_storage->GetElementCount(tableName, moduleName), 2);
+}
+
+TEST_F(StorageTest, GetElementCountAfterFailedStore)
+{
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::_)).WillOnce(testing::Return(2));
+    EXPECT_CALL(*m_mockPersistence, CommitTransaction(testing::_))
+        .WillOnce(testing::Throw(std::runtime_error("Error CommitTransaction")));
+
+    // The counters are loaded again, as the rolled back rows are not in the database
+    EXPECT_CALL(*m_mockPersistence, GetCountAndSizeGroupedBy(tableName, testing::_, testing::_))
+        .WillOnce(testing::Return(std::vector<column::Row> {}));
+
+    EXPECT_EQ(m_storage->Store(nlohmann::json::array({"value1", "value2"}), tableName, moduleName), 0);
+    EXPECT_EQ(m_storage->GetElementCount(tableName, moduleName), 0);
+}
+
+TEST_F(StorageTest, GetElementCountLoadedOnStartup)
+{
+    auto mockPersistencePtr = std::make_unique<MockPersistence>();
+    auto mockPersistence = mockPersistencePtr.get();
+
+    const std::vector<column::Row> modules {
+        {column::ColumnValue(MODULE_NAME_COLUMN_NAME, column::ColumnType::TEXT, moduleName),
+         column::ColumnValue(MODULE_TYPE_COLUMN_NAME, column::ColumnType::TEXT, ""),
+         column::ColumnValue("count", column::ColumnType::INTEGER, "2"),
+         column::ColumnValue("size", column::ColumnType::INTEGER, "20")},
+        {column::ColumnValue(MODULE_NAME_COLUMN_NAME, column::ColumnType::TEXT, "moduleY"),
+         column::ColumnValue(MODULE_TYPE_COLUMN_NAME, column::ColumnType::TEXT, ""),
+         column::ColumnValue("count", column::ColumnType::INTEGER, "1"),
+         column::ColumnValue("size", column::ColumnType::INTEGER, "5")},
+    };
+
+    EXPECT_CALL(*mockPersistence, TableExists(tableName)).WillOnce(testing::Return(true));
+    EXPECT_CALL(*mockPersistence, GetCountAndSizeGroupedBy(tableName, testing::SizeIs(2), testing::SizeIs(4)))
+        .WillOnce(testing::Return(modules));
+    EXPECT_CALL(*mockPersistence,
+                Select(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+        .Times(0);
+    EXPECT_CALL(*mockPersistence, GetSize(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+    Storage storage(".", {tableName}, std::move(mockPersistencePtr));
+
+    EXPECT_EQ(storage.GetElementCount(tableName), 3);
+    EXPECT_EQ(storage.GetElementCount(tableName, moduleName), 2);
+    EXPECT_EQ(storage.GetElementsStoredSize(tableName), 25);
+    EXPECT_EQ(storage.GetElementsStoredSize(tableName, "moduleY"), 5);
+}
+
+TEST_F(StorageTest, GetElementCountUncachedTable)
+{
+    EXPECT_CALL(*m_mockPersistence, GetCount(uncachedTableName, testing::_, testing::_)).WillOnce(testing::Return(1));
+    EXPECT_EQ(m_storage->GetElementCount(uncachedTableName), 1);
 }
 
 TEST_F(StorageTest, GetElementCountGetCountFail)
 {
-    EXPECT_CALL(*m_mockPersistence, GetCount(tableName, testing::_, testing::_))
+    EXPECT_CALL(*m_mockPersistence, GetCount(uncachedTableName, testing::_, testing::_))
         .WillOnce(testing::Throw(std::runtime_error("Error GetCount")));
-    EXPECT_EQ(m_storage->GetElementCount(tableName), 0);
+    EXPECT_EQ(m_storage->GetElementCount(uncachedTableName), 0);
 }
 
 TEST_F(StorageTest, GetElementsStoredSize)
 {
-    EXPECT_CALL(*m_mockPersistence, GetSize(tableName, testing::_, testing::_, testing::_))
+    EXPECT_CALL(*m_mockPersistence, InsertMany(tableName, testing::_)).WillOnce(testing::Return(1));
+    EXPECT_CALL(*m_mockPersistence, GetSize(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+    m_storage->Store({{"key", "value"}}, tableName, moduleName, "", "meta");
+
+    EXPECT_EQ(m_storage->GetElementsStoredSize(tableName),
+              moduleName.size() + std::string("meta").size() + std::string(R"({"key":"value"})").size());
+}
+
+TEST_F(StorageTest, GetElementsStoredSizeUncachedTable)
+{
+    EXPECT_CALL(*m_mockPersistence, GetSize(uncachedTableName, testing::_, testing::_, testing::_))
         .WillOnce(testing::Return(1));
-    EXPECT_EQ(m_storage->GetElementsStoredSize(tableName), 1);
+    EXPECT_EQ(m_storage->GetElementsStoredSize(uncachedTableName), 1);
 }
 
 TEST_F(StorageTest, GetElementsStoredSizeGetSizeFail)
 {
-    EXPECT_CALL(*m_mockPersistence, GetSize(tableName, testing::_, testing::_, testing::_))
+    EXPECT_CALL(*m_mockPersistence, GetSize(uncachedTableName, testing::_, testing::_, testing::_))
         .WillOnce(testing::Throw(std::runtime_error("Error GetSize")));
-    EXPECT_EQ(m_storage->GetElementsStoredSize(tableName), 0);
+    EXPECT_EQ(m_storage->GetElementsStoredSize(uncachedTableName), 0);
 }
 
 int main(int argc, char** argv)
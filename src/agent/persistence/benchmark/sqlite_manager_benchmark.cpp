@@ -0,0 +1,157 @@
+#include <sqlite_manager.hpp>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace column;
+
+namespace
+{
+    const std::string TABLE_NAME = "BenchmarkTable";
+    const std::string LEGACY_DB_NAME = "benchmark_legacy.db";
+    const std::string INSERT_DB_NAME = "benchmark_insert.db";
+    const std::string INSERT_MANY_DB_NAME = "benchmark_insert_many.db";
+    constexpr size_t DEFAULT_ROWS = 100000;
+
+    /// @brief Builds the rows inserted by every benchmark, resembling the queue table layout.
+    std::vector<Row> MakeRows(size_t count)
+    {
+        std::vector<Row> rows;
+        rows.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            rows.push_back({ColumnValue("module_name", ColumnType::TEXT, "logcollector"),
+                            ColumnValue("module_type", ColumnType::TEXT, "file"),
+                            ColumnValue("metadata", ColumnType::TEXT, R"({"module":"logcollector","type":"file"})"),
+                            ColumnValue("message",
+                                        ColumnType::TEXT,
+                                        fmt::format(R"({{"log":{{"file":{{"path":"/var/log/syslog"}}}},)"
+                                                    R"("event":{{"original":"it's line {}","offset":{}}}}})",
+                                                    i,
+                                                    i * 64))});
+        }
+
+        return rows;
+    }
+
+    Keys MakeKeys()
+    {
+        return {ColumnKey("module_name", ColumnType::TEXT),
+                ColumnKey("module_type", ColumnType::TEXT),
+                ColumnKey("metadata", ColumnType::TEXT),
+                ColumnKey("message", ColumnType::TEXT, NOT_NULL)};
+    }
+
+    /// @brief Reproduces the former string-built insert: regex escaping and a freshly parsed statement per row.
+    void LegacyInsert(SQLite::Database& db, const Row& cols)
+    {
+        std::vector<std::string> names;
+        std::vector<std::string> values;
+
+        for (const auto& col : cols)
+        {
+            names.push_back(col.Name);
+            if (col.Type == ColumnType::TEXT)
+            {
+                values.push_back(fmt::format("'{}'", std::regex_replace(col.Value, std::regex("'"), "''")));
+            }
+            else
+            {
+                values.push_back(col.Value);
+            }
+        }
+
+        db.exec(fmt::format(
+            "INSERT INTO {} ({}) VALUES ({})", TABLE_NAME, fmt::join(names, ", "), fmt::join(values, ", ")));
+    }
+
+    void Report(const std::string& name, size_t rows, const std::function<void()>& run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%-28s %10zu rows %10.3f s %14.0f rows/s\n",
+                    name.c_str(),
+                    rows,
+                    elapsed,
+                    static_cast<double>(rows) / elapsed);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::stoul(argv[1]) : DEFAULT_ROWS;
+    const auto rows = MakeRows(count);
+
+    for (const auto& dbName : {LEGACY_DB_NAME, INSERT_DB_NAME, INSERT_MANY_DB_NAME})
+    {
+        std::filesystem::remove(dbName);
+        std::filesystem::remove(dbName + "-wal");
+        std::filesystem::remove(dbName + "-shm");
+    }
+
+    {
+        SQLiteManager manager(LEGACY_DB_NAME);
+        manager.CreateTable(TABLE_NAME, MakeKeys());
+    }
+
+    {
+        SQLite::Database db(LEGACY_DB_NAME, SQLite::OPEN_READWRITE);
+        db.exec("PRAGMA journal_mode=WAL;");
+
+        Report("string-built Insert",
+               count,
+               [&]()
+               {
+                   SQLite::Transaction transaction(db);
+                   for (const auto& row : rows)
+                   {
+                       LegacyInsert(db, row);
+                   }
+                   transaction.commit();
+               });
+    }
+
+    {
+        SQLiteManager manager(INSERT_DB_NAME);
+        manager.CreateTable(TABLE_NAME, MakeKeys());
+
+        Report("prepared Insert",
+               count,
+               [&]()
+               {
+                   const auto transaction = manager.BeginTransaction();
+                   for (const auto& row : rows)
+                   {
+                       manager.Insert(TABLE_NAME, row);
+                   }
+                   manager.CommitTransaction(transaction);
+               });
+    }
+
+    {
+        SQLiteManager manager(INSERT_MANY_DB_NAME);
+        manager.CreateTable(TABLE_NAME, MakeKeys());
+
+        Report("prepared InsertMany",
+               count,
+               [&]()
+               {
+                   const auto transaction = manager.BeginTransaction();
+                   manager.InsertMany(TABLE_NAME, rows);
+                   manager.CommitTransaction(transaction);
+               });
+    }
+
+    return 0;
+}
@@ -29,6 +29,13 @@ public:
     /// @param cols Row with values to insert.
     virtual void Insert(const std::string& tableName, const column::Row& cols) = 0;
 
+    /// @brief Inserts multiple rows into a specified table reusing a single compiled statement.
+    /// @details Rows that fail to insert are logged and skipped.
+    /// @param tableName The name of the table where data is inserted.
+    /// @param rows Rows with values to insert.
+    /// @return The number of rows inserted.
+    virtual int InsertMany(const std::string& tableName, const std::vector<column::Row>& rows) = 0;
+
     /// @brief Updates rows in a specified table with optional criteria.
     /// @param tableName The name of the table to update.
     /// @param fields Row with new values to set.
@@ -88,6 +95,34 @@ public:
                            const column::Criteria& selCriteria = {},
                            column::LogicalOperator logOp = column::LogicalOperator::AND) = 0;
 
+    /// @brief Selects rows like Select, adding a last column with the size in bytes of some of their fields.
+    /// @param tableName The name of the table to select from.
+    /// @param fields Names to retrieve.
+    /// @param sizeFields Names whose size is added up in the last column.
+    /// @param selCriteria Optional selection criteria to filter rows.
+    /// @param logOp Logical operator to combine selection criteria (AND/OR).
+    /// @param orderBy Names to order the results by.
+    /// @param orderType The order type (ASC or DESC).
+    /// @param limit The maximum number of rows to retrieve.
+    /// @return A vector of rows matching the criteria.
+    virtual std::vector<column::Row> SelectWithSize(const std::string& tableName,
+                                                    const column::Names& fields,
+                                                    const column::Names& sizeFields,
+                                                    const column::Criteria& selCriteria = {},
+                                                    column::LogicalOperator logOp = column::LogicalOperator::AND,
+                                                    const column::Names& orderBy = {},
+                                                    column::OrderType orderType = column::OrderType::ASC,
+                                                    int limit = 0) = 0;
+
+    /// @brief Retrieves the number of rows and their size in bytes for each group of rows with the same values.
+    /// @param tableName The name of the table to count rows in.
+    /// @param groupBy Names to group the rows by.
+    /// @param sizeFields Names whose size is added up.
+    /// @return A row per group with the groupBy values, the number of rows and their size, in this order.
+    virtual std::vector<column::Row> GetCountAndSizeGroupedBy(const std::string& tableName,
+                                                              const column::Names& groupBy,
+                                                              const column::Names& sizeFields) = 0;
+
     /// @brief Begins a transaction in the database.
     /// @return The transaction ID.
     virtual TransactionId BeginTransaction() = 0;
@@ -4,8 +4,10 @@
 
 #include <SQLiteCpp/SQLiteCpp.h>
 #include <fmt/format.h>
+#include <cstdint>
 #include <map>
 #include <regex>
+#include <stdexcept>
 
 using namespace column;
 
@@ -27,6 +29,21 @@ namespace
     {
         return std::regex_replace(str, std::regex(TO_SEARCH), TO_REPLACE);
     }
+
+    /// @brief Builds the expression adding up the size in bytes of some fields.
+    std::string SizeExpression(const Names& fields)
+    {
+        std::vector<std::string> fieldNames;
+        fieldNames.reserve(fields.size());
+
+        for (const auto& col : fields)
+        {
+            // Casting to BLOB makes LENGTH count bytes instead of UTF-8 characters
+            fieldNames.push_back("LENGTH(CAST(" + col.Name + " AS BLOB))");
+        }
+
+        return fmt::format("{}", fmt::join(fieldNames, " + "));
+    }
 } // namespace
 
 ColumnType SQLiteManager::ColumnTypeFromSQLiteType(const int type) const
@@ -90,27 +107,92 @@ void SQLiteManager::CreateTable(const std::string& tableName, const Keys& cols)
 
 void SQLiteManager::Insert(const std::string& tableName, const Row& cols)
 {
-    std::vector<std::string> names;
-    std::vector<std::string> values;
+    try
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        BindAndExecute(GetInsertStatement(tableName, cols), cols);
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error during database operation: {}.", e.what());
+        throw;
+    }
+}
 
-    for (const auto& col : cols)
+int SQLiteManager::InsertMany(const std::string& tableName, const std::vector<Row>& rows)
+{
+    int inserted = 0;
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& row : rows)
     {
-        names.push_back(col.Name);
-        if (col.Type == ColumnType::TEXT)
+        try
         {
-            auto escapedValue = EscapeSingleQuotes(col.Value);
-            values.push_back(fmt::format("'{}'", escapedValue));
+            BindAndExecute(GetInsertStatement(tableName, row), row);
+            inserted++;
         }
-        else
+        catch (const std::exception& e)
         {
-            values.push_back(col.Value);
+            LogError("Error during InsertMany operation: {}.", e.what());
         }
     }
 
-    const std::string queryString =
-        fmt::format("INSERT INTO {} ({}) VALUES ({})", tableName, fmt::join(names, ", "), fmt::join(values, ", "));
+    return inserted;
+}
 
-    Execute(queryString);
+SQLite::Statement& SQLiteManager::GetInsertStatement(const std::string& tableName, const Row& cols)
+{
+    std::string key = tableName;
+    key += '(';
+    for (const auto& col : cols)
+    {
+        key += col.Name;
+        key += ',';
+    }
+
+    auto it = m_insertStatements.find(key);
+
+    if (it == m_insertStatements.end())
+    {
+        std::vector<std::string> names;
+        names.reserve(cols.size());
+
+        for (const auto& col : cols)
+        {
+            names.push_back(col.Name);
+        }
+
+        const std::vector<std::string> placeholders(cols.size(), "?");
+        const std::string queryString = fmt::format(
+            "INSERT INTO {} ({}) VALUES ({})", tableName, fmt::join(names, ", "), fmt::join(placeholders, ", "));
+
+        it = m_insertStatements.emplace(std::move(key), std::make_unique<SQLite::Statement>(*m_db, queryString)).first;
+    }
+
+    return *it->second;
+}
+
+void SQLiteManager::BindAndExecute(SQLite::Statement& stmt, const Row& cols)
+{
+    // A previous execution may have failed, leaving the statement unreset
+    stmt.reset();
+    stmt.clearBindings();
+
+    int index = 1;
+    for (const auto& col : cols)
+    {
+        switch (col.Type)
+        {
+            case ColumnType::INTEGER: stmt.bind(index, static_cast<int64_t>(std::stoll(col.Value))); break;
+            case ColumnType::REAL: stmt.bind(index, std::stod(col.Value)); break;
+            case ColumnType::TEXT: stmt.bindNoCopy(index, col.Value); break;
+        }
+        index++;
+    }
+
+    stmt.exec();
+    stmt.reset();
 }
 
 void SQLiteManager::Update(const std::string& tableName,
@@ -191,6 +273,12 @@ void SQLiteManager::Remove(const std::string& tableName, const Criteria& selCrit
 
 void SQLiteManager::DropTable(const std::string& tableName)
 {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        const std::string prefix = tableName + "(";
+        std::erase_if(m_insertStatements, [&prefix](const auto& item) { return item.first.starts_with(prefix); });
+    }
+
     const std::string queryString = fmt::format("DROP TABLE {}", tableName);
 
     Execute(queryString);
@@ -273,31 +361,91 @@ std::vector<Row> SQLiteManager::Select(const std::string& tableName,
 
     const std::string queryString = fmt::format("SELECT {} FROM {} {}", selectedFields, tableName, condition);
 
-    std::vector<Row> results;
     try
     {
-        const std::lock_guard<std::mutex> lock(m_mutex);
-        SQLite::Statement query(*m_db, queryString);
-
-        while (query.executeStep())
-        {
-            const int nColumns = query.getColumnCount();
-            Row queryFields;
-            queryFields.reserve(static_cast<size_t>(nColumns));
-            for (int i = 0; i < nColumns; i++)
-            {
-                queryFields.emplace_back(query.getColumn(i).getName(),
-                                         ColumnTypeFromSQLiteType(query.getColumn(i).getType()),
-                                         query.getColumn(i).getString());
-            }
-            results.push_back(queryFields);
-        }
+        return QueryRows(queryString);
     }
     catch (const std::exception& e)
     {
         LogError("Error during Select operation: {}.", e.what());
         throw;
     }
+}
+
+std::vector<Row> SQLiteManager::SelectWithSize(const std::string& tableName,
+                                               const Names& fields,
+                                               const Names& sizeFields,
+                                               const Criteria& selCriteria,
+                                               LogicalOperator logOp,
+                                               const Names& orderBy,
+                                               OrderType orderType,
+                                               int limit)
+{
+    if (sizeFields.empty())
+    {
+        LogError("Error: Missing size fields.");
+        throw std::invalid_argument("Missing size fields");
+    }
+
+    Names selectedFields = fields;
+    selectedFields.emplace_back(SizeExpression(sizeFields) + " AS size", ColumnType::INTEGER);
+
+    return Select(tableName, selectedFields, selCriteria, logOp, orderBy, orderType, limit);
+}
+
+std::vector<Row>
+SQLiteManager::GetCountAndSizeGroupedBy(const std::string& tableName, const Names& groupBy, const Names& sizeFields)
+{
+    if (groupBy.empty() || sizeFields.empty())
+    {
+        LogError("Error: Missing group or size fields.");
+        throw std::invalid_argument("Missing group or size fields");
+    }
+
+    std::vector<std::string> groupFields;
+    groupFields.reserve(groupBy.size());
+    for (const auto& col : groupBy)
+    {
+        groupFields.push_back(col.Name);
+    }
+
+    const std::string queryString = fmt::format("SELECT {0}, COUNT(*) AS count, SUM({1}) AS size FROM {2} GROUP BY {0}",
+                                                fmt::join(groupFields, ", "),
+                                                SizeExpression(sizeFields),
+                                                tableName);
+
+    try
+    {
+        return QueryRows(queryString);
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Error during GetCountAndSizeGroupedBy operation: {}.", e.what());
+        throw;
+    }
+}
+
+std::vector<Row> SQLiteManager::QueryRows(const std::string& queryString)
+{
+    std::vector<Row> results;
+
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    SQLite::Statement query(*m_db, queryString);
+
+    while (query.executeStep())
+    {
+        const int nColumns = query.getColumnCount();
+        Row queryFields;
+        queryFields.reserve(static_cast<size_t>(nColumns));
+        for (int i = 0; i < nColumns; i++)
+        {
+            queryFields.emplace_back(query.getColumn(i).getName(),
+                                     ColumnTypeFromSQLiteType(query.getColumn(i).getType()),
+                                     query.getColumn(i).getString());
+        }
+        results.push_back(std::move(queryFields));
+    }
+
     return results;
 }
 
@@ -358,15 +506,7 @@ size_t SQLiteManager::GetSize(const std::string& tableName,
         throw;
     }
 
-    std::string selectedFields;
-    std::vector<std::string> fieldNames;
-    fieldNames.reserve(fields.size());
-
-    for (const auto& col : fields)
-    {
-        fieldNames.push_back("LENGTH(" + col.Name + ")");
-    }
-    selectedFields = fmt::format("{}", fmt::join(fieldNames, " + "));
+    const std::string selectedFields = SizeExpression(fields);
 
     std::string condition;
     if (!selCriteria.empty())
@@ -422,8 +562,10 @@ TransactionId SQLiteManager::BeginTransaction()
 
 void SQLiteManager::CommitTransaction(TransactionId transactionId)
 {
-    m_transactions.at(transactionId)->commit();
+    // Taken out of the map first, so that a failed commit is rolled back when the transaction is destroyed
+    const auto transaction = std::move(m_transactions.at(transactionId));
     m_transactions.erase(transactionId);
+    transaction->commit();
 }
 
 void SQLiteManager::RollbackTransaction(TransactionId transactionId)
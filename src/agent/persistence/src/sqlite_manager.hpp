@@ -8,11 +8,13 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace SQLite
 {
     class Database;
+    class Statement;
     class Transaction;
 } // namespace SQLite
 
@@ -48,6 +50,9 @@ public:
     /// @copydoc Persistence::Insert
     void Insert(const std::string& tableName, const column::Row& cols) override;
 
+    /// @copydoc Persistence::InsertMany
+    int InsertMany(const std::string& tableName, const std::vector<column::Row>& rows) override;
+
     /// @copydoc Persistence::Update
     void Update(const std::string& tableName,
                 const column::Row& fields,
@@ -82,6 +87,21 @@ public:
                    const column::Criteria& selCriteria = {},
                    column::LogicalOperator logOp = column::LogicalOperator::AND) override;
 
+    /// @copydoc Persistence::SelectWithSize
+    std::vector<column::Row> SelectWithSize(const std::string& tableName,
+                                            const column::Names& fields,
+                                            const column::Names& sizeFields,
+                                            const column::Criteria& selCriteria = {},
+                                            column::LogicalOperator logOp = column::LogicalOperator::AND,
+                                            const column::Names& orderBy = {},
+                                            column::OrderType orderType = column::OrderType::ASC,
+                                            int limit = 0) override;
+
+    /// @copydoc Persistence::GetCountAndSizeGroupedBy
+    std::vector<column::Row> GetCountAndSizeGroupedBy(const std::string& tableName,
+                                                      const column::Names& groupBy,
+                                                      const column::Names& sizeFields) override;
+
     /// @copydoc Persistence::BeginTransaction
     TransactionId BeginTransaction() override;
 
@@ -97,10 +117,28 @@ private:
     /// @return Corresponding ColumnType enum.
     column::ColumnType ColumnTypeFromSQLiteType(const int type) const;
 
+    /// @brief Runs a query and returns the rows it yields.
+    /// @param queryString The SQL query string to run.
+    /// @return A vector with the resulting rows.
+    std::vector<column::Row> QueryRows(const std::string& queryString);
+
     /// @brief Executes a raw SQL query on the database.
     /// @param query The SQL query string to execute.
     void Execute(const std::string& query);
 
+    /// @brief Returns the cached insert statement for a table and column set, preparing it if needed.
+    /// @note Must be called with m_mutex held.
+    /// @param tableName The name of the table where data is inserted.
+    /// @param cols Row whose column names define the statement.
+    /// @return Reference to the prepared statement, reset and ready to be bound.
+    SQLite::Statement& GetInsertStatement(const std::string& tableName, const column::Row& cols);
+
+    /// @brief Binds the values of a row to a prepared statement and executes it.
+    /// @note Must be called with m_mutex held.
+    /// @param stmt The prepared insert statement.
+    /// @param cols Row with values to bind.
+    void BindAndExecute(SQLite::Statement& stmt, const column::Row& cols);
+
     /// @brief Mutex for thread-safe operations.
     std::mutex m_mutex;
 
@@ -110,6 +148,10 @@ private:
     /// @brief Pointer to the SQLite database connection.
     std::unique_ptr<SQLite::Database> m_db;
 
+    /// @brief Prepared insert statements, keyed by table name and column set.
+    /// @details Declared after m_db so the statements are finalized before the connection is closed.
+    std::unordered_map<std::string, std::unique_ptr<SQLite::Statement>> m_insertStatements;
+
     /// @brief Map of open transactions.
     std::map<TransactionId, std::unique_ptr<SQLite::Transaction>> m_transactions;
 
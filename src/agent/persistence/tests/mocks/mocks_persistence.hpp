@@ -11,6 +11,7 @@ public:
     MOCK_METHOD(bool, TableExists, (const std::string& tableName), (override));
     MOCK_METHOD(void, CreateTable, (const std::string& tableName, const column::Keys& cols), (override));
     MOCK_METHOD(void, Insert, (const std::string& tableName, const column::Row& cols), (override));
+    MOCK_METHOD(int, InsertMany, (const std::string& tableName, const std::vector<column::Row>& rows), (override));
     MOCK_METHOD(void,
                 Update,
                 (const std::string& tableName,
@@ -44,6 +45,21 @@ public:
                  const column::Criteria& selCriteria,
                  column::LogicalOperator logOp),
                 (override));
+    MOCK_METHOD(std::vector<column::Row>,
+                SelectWithSize,
+                (const std::string& tableName,
+                 const column::Names& fields,
+                 const column::Names& sizeFields,
+                 const column::Criteria& selCriteria,
+                 column::LogicalOperator logOp,
+                 const column::Names& orderBy,
+                 column::OrderType orderType,
+                 int limit),
+                (override));
+    MOCK_METHOD(std::vector<column::Row>,
+                GetCountAndSizeGroupedBy,
+                (const std::string& tableName, const column::Names& groupBy, const column::Names& sizeFields),
+                (override));
     MOCK_METHOD(TransactionId, BeginTransaction, (), (override));
     MOCK_METHOD(void, CommitTransaction, (TransactionId transactionId), (override));
     MOCK_METHOD(void, RollbackTransaction, (TransactionId transactionId), (override));
@@ -104,6 +104,64 @@ TEST_F(SQLiteManagerTest, InsertTest)
                                   ColumnValue("Amount", ColumnType::REAL, "4.5")}));
 }
 
+TEST_F(SQLiteManagerTest, InsertQuotedTextTest)
+{
+    EXPECT_NO_THROW(m_db->Remove(m_tableName));
+    EXPECT_NO_THROW(m_db->Insert(m_tableName,
+                                 {ColumnValue("Name", ColumnType::TEXT, "It's a 'quoted' name"),
+                                  ColumnValue("Status", ColumnType::TEXT, "ItemStatus1")}));
+
+    auto ret = m_db->Select(m_tableName,
+                            {ColumnName("Name", ColumnType::TEXT)},
+                            {ColumnValue("Name", ColumnType::TEXT, "It's a 'quoted' name")});
+    ASSERT_EQ(ret.size(), 1);
+    EXPECT_EQ(ret[0][0].Value, "It's a 'quoted' name");
+}
+
+TEST_F(SQLiteManagerTest, InsertManyTest)
+{
+    EXPECT_NO_THROW(m_db->Remove(m_tableName));
+
+    std::vector<Row> rows;
+    for (int i = 0; i < 10; i++)
+    {
+        rows.push_back({ColumnValue("Name", ColumnType::TEXT, "ItemName" + std::to_string(i)),
+                        ColumnValue("Status", ColumnType::TEXT, "ItemStatus"),
+                        ColumnValue("Orden", ColumnType::INTEGER, std::to_string(i))});
+    }
+    rows.push_back({ColumnValue("Name", ColumnType::TEXT, "OtherColumns"),
+                    ColumnValue("Status", ColumnType::TEXT, "ItemStatus"),
+                    ColumnValue("Amount", ColumnType::REAL, "1.5")});
+
+    EXPECT_EQ(m_db->InsertMany(m_tableName, rows), 11);
+    EXPECT_EQ(m_db->GetCount(m_tableName), 11);
+
+    auto ret = m_db->Select(m_tableName,
+                            {ColumnName("Orden", ColumnType::INTEGER)},
+                            {ColumnValue("Name", ColumnType::TEXT, "ItemName7")});
+    ASSERT_EQ(ret.size(), 1);
+    EXPECT_EQ(ret[0][0].Value, "7");
+
+    ret = m_db->Select(m_tableName,
+                       {ColumnName("Amount", ColumnType::REAL)},
+                       {ColumnValue("Name", ColumnType::TEXT, "OtherColumns")});
+    ASSERT_EQ(ret.size(), 1);
+    EXPECT_EQ(ret[0][0].Value, "1.5");
+}
+
+TEST_F(SQLiteManagerTest, InsertManySkipsInvalidRowsTest)
+{
+    EXPECT_NO_THROW(m_db->Remove(m_tableName));
+
+    const std::vector<Row> rows {
+        {ColumnValue("Name", ColumnType::TEXT, "ItemName1"), ColumnValue("Status", ColumnType::TEXT, "ItemStatus1")},
+        {ColumnValue("Name", ColumnType::TEXT, "ItemName2"), ColumnValue("Unknown", ColumnType::TEXT, "Value")},
+        {ColumnValue("Name", ColumnType::TEXT, "ItemName3"), ColumnValue("Status", ColumnType::TEXT, "ItemStatus3")}};
+
+    EXPECT_EQ(m_db->InsertMany(m_tableName, rows), 2);
+    EXPECT_EQ(m_db->GetCount(m_tableName), 2);
+}
+
 TEST_F(SQLiteManagerTest, GetCountTest)
 {
     EXPECT_NO_THROW(m_db->Remove(m_tableName));
@@ -143,6 +201,63 @@ TEST_F(SQLiteManagerTest, GetSizeTest)
     EXPECT_EQ(size, 20);
 }
 
+TEST_F(SQLiteManagerTest, GetSizeCountsBytes)
+{
+    EXPECT_NO_THROW(m_db->Remove(m_tableName));
+
+    const ColumnValue col1 {"Name", ColumnType::TEXT, "Ñandú"};
+    const ColumnValue col2 {"Status", ColumnType::TEXT, "ItemStatus1"};
+    EXPECT_NO_THROW(m_db->Insert(m_tableName, {col1, col2}));
+
+    EXPECT_EQ(m_db->GetSize(m_tableName, {ColumnName("Name", ColumnType::TEXT)}), std::string("Ñandú").size());
+}
+
+TEST_F(SQLiteManagerTest, SelectWithSizeTest)
+{
+    AddTestData();
+
+    const Names sizeFields {ColumnName("Name", ColumnType::TEXT), ColumnName("Status", ColumnType::TEXT)};
+    const auto rows = m_db->SelectWithSize(m_tableName,
+                                           {ColumnName("Name", ColumnType::TEXT)},
+                                           sizeFields,
+                                           {},
+                                           LogicalOperator::AND,
+                                           {ColumnName("Name", ColumnType::TEXT)},
+                                           OrderType::ASC,
+                                           2);
+
+    ASSERT_EQ(rows.size(), 2);
+    ASSERT_EQ(rows[0].size(), 2);
+    EXPECT_EQ(rows[0][0].Value, "ItemName");
+    EXPECT_EQ(rows[0][1].Value, "18");
+    EXPECT_EQ(rows[1][0].Value, "ItemName2");
+    EXPECT_EQ(rows[1][1].Value, "20");
+}
+
+TEST_F(SQLiteManagerTest, GetCountAndSizeGroupedByTest)
+{
+    EXPECT_NO_THROW(m_db->Remove(m_tableName));
+
+    EXPECT_NO_THROW(m_db->Insert(
+        m_tableName, {ColumnValue("Name", ColumnType::TEXT, "a"), ColumnValue("Status", ColumnType::TEXT, "Ñandú")}));
+    EXPECT_NO_THROW(m_db->Insert(
+        m_tableName, {ColumnValue("Name", ColumnType::TEXT, "a"), ColumnValue("Status", ColumnType::TEXT, "xy")}));
+    EXPECT_NO_THROW(m_db->Insert(
+        m_tableName, {ColumnValue("Name", ColumnType::TEXT, "b"), ColumnValue("Status", ColumnType::TEXT, "xyz")}));
+
+    const auto rows = m_db->GetCountAndSizeGroupedBy(
+        m_tableName, {ColumnName("Name", ColumnType::TEXT)}, {ColumnName("Status", ColumnType::TEXT)});
+
+    ASSERT_EQ(rows.size(), 2);
+    ASSERT_EQ(rows[0].size(), 3);
+    EXPECT_EQ(rows[0][0].Value, "a");
+    EXPECT_EQ(rows[0][1].Value, "2");
+    EXPECT_EQ(rows[0][2].Value, std::to_string(std::string("Ñandú").size() + 2));
+    EXPECT_EQ(rows[1][0].Value, "b");
+    EXPECT_EQ(rows[1][1].Value, "1");
+    EXPECT_EQ(rows[1][2].Value, "3");
+}
+
 TEST_F(SQLiteManagerTest, SelectTest)
 {
     AddTestData();
@@ -13,6 +13,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <memory>
 
 Agent::Agent(std::unique_ptr<configuration::ConfigurationParser> configurationParser,
@@ -87,10 +88,15 @@ void Agent::ReloadModules()
         try
         {
             LogInfo("Reloading Modules");
-            m_configurationParser->ReloadConfiguration();
-            m_moduleManager.Stop();
-            m_moduleManager.Setup();
-            m_moduleManager.Start();
+            const auto start = std::chrono::steady_clock::now();
+            const auto changedSections = m_configurationParser->ReloadConfiguration();
+            const auto reloadTime = std::chrono::steady_clock::now() - start;
+
+            LogInfo("Configuration reloaded in {} ms, {} sections changed",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(reloadTime).count(),
+                    changedSections.size());
+
+            m_moduleManager.Reload(changedSections);
             LogInfo("Modules reloaded");
         }
         catch (const std::exception& e)
@@ -113,29 +119,38 @@ void Agent::Run()
 
     m_taskManager.EnqueueTask(m_communicator.WaitForTokenExpirationAndAuthenticate(), "Authenticate");
 
-    m_taskManager.EnqueueTask(m_communicator.GetCommandsFromManager([this](const int, const std::string& response)
-                                                                    { PushCommandsToQueue(m_messageQueue, response); }),
+    m_taskManager.EnqueueTask(m_communicator.GetCommandsFromManager(
+                                  [this](const int, const std::string& response)
+                                  {
+                                      PushCommandsToQueue(m_messageQueue,
+                                                          response,
+                                                          [this]() { m_commandHandler->NotifyCommandsQueued(); });
+                                  }),
                               "FetchCommands");
 
     m_taskManager.EnqueueTask(m_communicator.StatefulMessageProcessingTask(
-                                  [this](const size_t numMessages)
+                                  [this](const size_t numMessages, const http_client::CompressionOptions compression)
                                   {
-                                      return GetMessagesFromQueue(m_messageQueue,
-                                                                  MessageType::STATEFUL,
-                                                                  numMessages,
-                                                                  [this]() { return m_agentInfo->GetMetadataInfo(); });
+                                      return GetMessagesFromQueue(
+                                          m_messageQueue,
+                                          MessageType::STATEFUL,
+                                          numMessages,
+                                          [this]() { return m_agentInfo->GetMetadataInfo(); },
+                                          compression);
                                   },
                                   [this]([[maybe_unused]] const int messageCount, const std::string&)
                                   { PopMessagesFromQueue(m_messageQueue, MessageType::STATEFUL, messageCount); }),
                               "Stateful");
 
     m_taskManager.EnqueueTask(m_communicator.StatelessMessageProcessingTask(
-                                  [this](const size_t numMessages)
+                                  [this](const size_t numMessages, const http_client::CompressionOptions compression)
                                   {
-                                      return GetMessagesFromQueue(m_messageQueue,
-                                                                  MessageType::STATELESS,
-                                                                  numMessages,
-                                                                  [this]() { return m_agentInfo->GetMetadataInfo(); });
+                                      return GetMessagesFromQueue(
+                                          m_messageQueue,
+                                          MessageType::STATELESS,
+                                          numMessages,
+                                          [this]() { return m_agentInfo->GetMetadataInfo(); },
+                                          compression);
                                   },
                                   [this]([[maybe_unused]] const int messageCount, const std::string&)
                                   { PopMessagesFromQueue(m_messageQueue, MessageType::STATELESS, messageCount); }),
@@ -146,8 +161,8 @@ void Agent::Run()
 
     m_taskManager.EnqueueTask(
         m_commandHandler->CommandsProcessingTask(
-            [this]() { return GetCommandFromQueue(m_messageQueue); },
-            [this]() { return PopCommandFromQueue(m_messageQueue); },
+            [this]() { return GetCommandsFromQueue(m_messageQueue); },
+            [this](const size_t numCommands) { PopCommandsFromQueue(m_messageQueue, numCommands); },
             [this](const module_command::CommandEntry& cmd) { return ReportCommandResult(cmd, m_messageQueue); },
             [this](module_command::CommandEntry& cmd)
             {
@@ -1,29 +1,84 @@
 #include <imultitype_queue.hpp>
 #include <message_queue_utils.hpp>
 
+#include <chrono>
+#include <string>
+#include <string_view>
 #include <vector>
 
+namespace
+{
+    /// @brief How many times the batch size is read from the queue when compressing, so that a compressed batch
+    /// can reach the batch size
+    constexpr size_t COMPRESSED_BATCH_READ_FACTOR = 10;
+
+    /// @brief Metadata key of the queued commands with the time they were received, in milliseconds since epoch
+    constexpr auto RECEIVED_METADATA_KEY = "received";
+} // namespace
+
 boost::asio::awaitable<std::tuple<int, std::string>>
 GetMessagesFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
                      MessageType messageType,
                      const size_t messagesSize,
-                     std::function<std::string()> getMetadataInfo)
+                     std::function<std::string()> getMetadataInfo,
+                     const http_client::CompressionOptions compression)
 {
-    std::string output;
+    const auto compressed = compression.Encoding != http_client::ContentEncoding::IDENTITY;
+    http_client::BodyCompressor body(compression);
 
     if (getMetadataInfo != nullptr)
     {
-        output = getMetadataInfo();
+        body.Write(getMetadataInfo());
     }
 
-    const auto messages = co_await multiTypeQueue->getNextBytesAwaitable(messageType, messagesSize, "", "");
+    const auto bytesToRead = compressed ? messagesSize * COMPRESSED_BATCH_READ_FACTOR : messagesSize;
+    const auto messages = co_await multiTypeQueue->getNextBytesAwaitable(messageType, bytesToRead, "", "", true);
+
+    int messagesCount = 0;
+
     for (const auto& message : messages)
     {
-        output += (message.metaData.empty() ? "" : "\n" + message.metaData) +
-                  (message.data.dump() == "{}" ? "" : "\n" + message.data.dump());
+        // Stored payloads are already serialized, they are spliced into the body without being parsed
+        std::string data;
+        std::string_view serialized = message.rawData;
+
+        if (serialized.empty())
+        {
+            data = message.data.dump();
+            serialized = data;
+        }
+
+        const auto metadataSize = message.metaData.empty() ? 0 : message.metaData.size() + 1;
+        const auto dataSize = serialized != "{}" ? serialized.size() + 1 : 0;
+
+        // The compressed size is only exact after a flush, so the body is flushed only when the message could
+        // make it exceed the batch size. Flushes happen close to the limit and barely affect the ratio.
+        if (compressed && messagesCount > 0 && body.MaxSize(metadataSize + dataSize) > messagesSize)
+        {
+            body.Flush();
+
+            if (body.MaxSize(metadataSize + dataSize) > messagesSize)
+            {
+                break;
+            }
+        }
+
+        if (metadataSize > 0)
+        {
+            body.Write("\n");
+            body.Write(message.metaData);
+        }
+
+        if (dataSize > 0)
+        {
+            body.Write("\n");
+            body.Write(serialized);
+        }
+
+        ++messagesCount;
     }
 
-    co_return std::tuple<int, std::string> {static_cast<int>(messages.size()), output};
+    co_return std::tuple<int, std::string> {messagesCount, body.Finish()};
 }
 
 void PopMessagesFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, MessageType messageType, int numMessages)
@@ -31,68 +86,86 @@ void PopMessagesFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, Messa
     multiTypeQueue->popN(messageType, numMessages);
 }
 
-void PushCommandsToQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, const std::string& commands)
+void PushCommandsToQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
+                         const std::string& commands,
+                         const std::function<void()>& onCommandsPushed)
 {
     const auto jsonObj = nlohmann::json::parse(commands);
 
     if (jsonObj.contains("commands") && jsonObj["commands"].is_array())
     {
+        // The reception time goes with the queued commands, to measure how long they wait to be dispatched
+        nlohmann::json metadata;
+        metadata[RECEIVED_METADATA_KEY] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                              std::chrono::system_clock::now().time_since_epoch())
+                                              .count();
+
         std::vector<Message> messages;
 
         for (const auto& command : jsonObj["commands"])
         {
-            messages.emplace_back(MessageType::COMMAND, command);
+            messages.emplace_back(MessageType::COMMAND, command, "", "", metadata.dump());
         }
 
-        if (!messages.empty())
+        if (!messages.empty() && multiTypeQueue->push(messages) > 0 && onCommandsPushed)
         {
-            multiTypeQueue->push(messages);
+            onCommandsPushed();
         }
     }
 }
 
-std::optional<module_command::CommandEntry> GetCommandFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue)
+std::vector<module_command::CommandEntry> GetCommandsFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
+                                                               size_t batchSize)
 {
-    if (multiTypeQueue->isEmpty(MessageType::COMMAND))
-    {
-        return std::nullopt;
-    }
+    std::vector<module_command::CommandEntry> commands;
 
-    const Message m = multiTypeQueue->getNext(MessageType::COMMAND);
-    nlohmann::json jsonData = m.data;
+    for (const auto& message : multiTypeQueue->getNextBytes(MessageType::COMMAND, batchSize))
+    {
+        const nlohmann::json& jsonData = message.data;
 
-    std::string id;
-    std::string command;
-    nlohmann::json parameters = nlohmann::json::object();
+        std::string id;
+        std::string command;
+        nlohmann::json parameters = nlohmann::json::object();
 
-    if (jsonData.contains("document_id") && jsonData["document_id"].is_string())
-    {
-        id = jsonData["document_id"].get<std::string>();
-    }
+        if (jsonData.contains("document_id") && jsonData["document_id"].is_string())
+        {
+            id = jsonData["document_id"].get<std::string>();
+        }
 
-    if (jsonData.contains("action") && jsonData["action"].is_object())
-    {
-        if (jsonData["action"].contains("name") && jsonData["action"]["name"].is_string())
+        if (jsonData.contains("action") && jsonData["action"].is_object())
         {
-            command = jsonData["action"]["name"].get<std::string>();
+            if (jsonData["action"].contains("name") && jsonData["action"]["name"].is_string())
+            {
+                command = jsonData["action"]["name"].get<std::string>();
+            }
+            if (jsonData["action"].contains("args") && jsonData["action"]["args"].is_object())
+            {
+                parameters = jsonData["action"]["args"];
+            }
         }
-        if (jsonData["action"].contains("args") && jsonData["action"]["args"].is_object())
+
+        module_command::CommandEntry& cmd = commands.emplace_back(id,
+                                                                  "",
+                                                                  command,
+                                                                  parameters,
+                                                                  module_command::CommandExecutionMode::ASYNC,
+                                                                  "",
+                                                                  module_command::Status::IN_PROGRESS);
+
+        const auto metadata = nlohmann::json::parse(message.metaData, nullptr, false);
+
+        if (metadata.is_object() && metadata.contains(RECEIVED_METADATA_KEY) &&
+            metadata[RECEIVED_METADATA_KEY].is_number_integer())
         {
-            parameters = jsonData["action"]["args"];
+            cmd.ReceivedTime = std::chrono::system_clock::time_point(
+                std::chrono::milliseconds(metadata[RECEIVED_METADATA_KEY].get<int64_t>()));
         }
     }
 
-    module_command::CommandEntry cmd(id,
-                                     "",
-                                     command,
-                                     parameters,
-                                     module_command::CommandExecutionMode::ASYNC,
-                                     "",
-                                     module_command::Status::IN_PROGRESS);
-    return cmd;
+    return commands;
 }
 
-void PopCommandFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue)
+void PopCommandsFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, size_t numCommands)
 {
-    multiTypeQueue->pop(MessageType::COMMAND);
+    multiTypeQueue->popN(MessageType::COMMAND, static_cast<int>(numCommands));
 }
@@ -1,29 +1,39 @@
 #pragma once
 
+#include <body_compressor.hpp>
 #include <command_entry.hpp>
 #include <message.hpp>
 
 #include <boost/asio/awaitable.hpp>
 #include <nlohmann/json.hpp>
 
+#include <functional>
 #include <memory>
-#include <optional>
 #include <string>
 #include <tuple>
+#include <vector>
 
 class IMultiTypeQueue;
 
-/// @brief Gets messages from a queue and returns them as a JSON string
+/// @brief Default size in bytes of the batches of commands retrieved from the queue
+constexpr size_t COMMANDS_BATCH_SIZE = 65536;
+
+/// @brief Gets messages from a queue and returns them as a newline-delimited JSON body
+/// @details When the body is compressed, messagesSize is the size of the compressed body, so more messages are read
+/// from the queue and only the ones that fit in the batch are included. The body only exceeds messagesSize if its
+/// first message does on its own
 /// @param multiTypeQueue The queue to get messages from
 /// @param messageType The type of messages to get from the queue
 /// @param messagesSize Minimum size of messages in bytes to get from the queue
 /// @param getMetadataInfo Function to get the agent metadata
-/// @return A string containing the messages from the queue
+/// @param compression How the body is compressed
+/// @return The number of messages included and the body
 boost::asio::awaitable<std::tuple<int, std::string>>
 GetMessagesFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
                      MessageType messageType,
                      const size_t messagesSize,
-                     std::function<std::string()> getMetadataInfo);
+                     std::function<std::string()> getMetadataInfo,
+                     const http_client::CompressionOptions compression = {});
 
 /// @brief Removes a fixed number of messages from the specified queue
 /// @param multiTypeQueue The queue from which to remove messages
@@ -34,13 +44,19 @@ void PopMessagesFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, Messa
 /// @brief Pushes a batch of commands to the specified queue
 /// @param multiTypeQueue The queue to push commands to
 /// @param commands A JSON string containing the commands to push
-void PushCommandsToQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, const std::string& commands);
-
-/// @brief Retrieves the next command from the queue, if available
-/// @param multiTypeQueue The queue to retrieve the command from
-/// @return An optional containing the next command entry, or nullopt if the queue is empty
-std::optional<module_command::CommandEntry> GetCommandFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue);
-
-/// @brief Removes the next command from the specified queue
-/// @param multiTypeQueue The queue from which to remove the command
-void PopCommandFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue);
+/// @param onCommandsPushed Function called when commands were pushed, to signal their arrival
+void PushCommandsToQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
+                         const std::string& commands,
+                         const std::function<void()>& onCommandsPushed = nullptr);
+
+/// @brief Retrieves the next commands from the queue, without removing them
+/// @param multiTypeQueue The queue to retrieve the commands from
+/// @param batchSize Size in bytes of the commands to retrieve, at least one command is retrieved if available
+/// @return The next command entries, empty if the queue is empty
+std::vector<module_command::CommandEntry> GetCommandsFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue,
+                                                               size_t batchSize = COMMANDS_BATCH_SIZE);
+
+/// @brief Removes the next commands from the specified queue
+/// @param multiTypeQueue The queue from which to remove the commands
+/// @param numCommands The number of commands to remove
+void PopCommandsFromQueue(std::shared_ptr<IMultiTypeQueue> multiTypeQueue, size_t numCommands);
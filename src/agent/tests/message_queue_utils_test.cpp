@@ -34,7 +34,7 @@ TEST_F(MessageQueueUtilsTest, GetMessagesFromQueueTestBySize)
     testMessages.emplace_back(MessageType::STATELESS, data, "", "", metadata);
 
     // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
-    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, "", ""))
+    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, "", "", true))
         .WillOnce([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
     // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
 
@@ -68,7 +68,7 @@ TEST_F(MessageQueueUtilsTest, GetMessagesFromQueueMetadataTest)
     metadata["agent"] = "test";
 
     // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
-    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, "", ""))
+    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, "", "", true))
         .WillOnce([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
     // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
 
@@ -106,7 +106,7 @@ TEST_F(MessageQueueUtilsTest, GetEmptyMessagesFromQueueTest)
     metadata["agent"] = "test";
 
     // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
-    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATEFUL, MIN_SIZE_OF_MESSAGES, "", ""))
+    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATEFUL, MIN_SIZE_OF_MESSAGES, "", "", true))
         .WillOnce([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
     // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
 
@@ -131,6 +131,128 @@ TEST_F(MessageQueueUtilsTest, GetEmptyMessagesFromQueueTest)
     ASSERT_EQ(jsonResult, expectedString);
 }
 
+TEST_F(MessageQueueUtilsTest, GetRawMessagesFromQueueTest)
+{
+    const std::string rawData {R"({"event":{"original":"Testing message!"}})"};
+    const std::string moduleMetadata {R"({"module":"logcollector","type":"file"})"};
+    std::vector<Message> testMessages;
+    testMessages.emplace_back(MessageType::STATELESS, nullptr, "", "", moduleMetadata);
+    testMessages.back().rawData = rawData;
+    testMessages.emplace_back(MessageType::STATELESS, nullptr, "", "", "");
+    testMessages.back().rawData = "{}";
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, "", "", true))
+        .WillOnce([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
+    // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+
+    io_context.restart();
+
+    auto awaitableResult =
+        boost::asio::co_spawn(io_context,
+                              GetMessagesFromQueue(mockQueue, MessageType::STATELESS, MIN_SIZE_OF_MESSAGES, nullptr),
+                              boost::asio::use_future);
+
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+    io_context.run_until(timeout);
+
+    ASSERT_TRUE(awaitableResult.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready);
+
+    const auto [count, body] = awaitableResult.get();
+
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(body, "\n" + moduleMetadata + "\n" + rawData);
+}
+
+TEST_F(MessageQueueUtilsTest, GetCompressedMessagesFromQueueTest)
+{
+    const std::string moduleMetadata {R"({"module":"logcollector","type":"file"})"};
+    std::vector<Message> testMessages;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        const nlohmann::json data = {{"event", {{"original", "Testing message " + std::to_string(i)}}}};
+        testMessages.emplace_back(MessageType::STATELESS, data, "", "", moduleMetadata);
+    }
+
+    // The batch size counts compressed bytes, so more messages than the batch size are read from the queue
+    // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+    EXPECT_CALL(*mockQueue,
+                getNextBytesAwaitable(MessageType::STATELESS, ::testing::Gt(MIN_SIZE_OF_MESSAGES), "", "", true))
+        .WillOnce([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
+    // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+
+    io_context.restart();
+
+    auto awaitableResult = boost::asio::co_spawn(io_context,
+                                                 GetMessagesFromQueue(mockQueue,
+                                                                      MessageType::STATELESS,
+                                                                      MIN_SIZE_OF_MESSAGES,
+                                                                      nullptr,
+                                                                      {http_client::ContentEncoding::GZIP, 6}),
+                                                 boost::asio::use_future);
+
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+    io_context.run_until(timeout);
+
+    ASSERT_TRUE(awaitableResult.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready);
+
+    const auto [count, body] = awaitableResult.get();
+
+    // Only the first message goes in a batch this small, the remaining messages are left for the next batch
+    EXPECT_EQ(count, 1);
+    ASSERT_GE(body.size(), 2U);
+    EXPECT_EQ(static_cast<unsigned char>(body[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(body[1]), 0x8b);
+}
+
+TEST_F(MessageQueueUtilsTest, GetCompressedMessagesFromQueueDoesNotExceedBatchSize)
+{
+    constexpr size_t BATCH_SIZE = 4096;
+    const std::string moduleMetadata {R"({"module":"logcollector","type":"file"})"};
+    std::vector<Message> testMessages;
+    unsigned int seed = 1;
+
+    // Random hex strings barely compress, so the batch holds only a few messages
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string original;
+
+        for (int j = 0; j < 200; ++j)
+        {
+            seed = seed * 1103515245 + 12345;
+            original += "0123456789abcdef"[(seed >> 16) % 16];
+        }
+
+        const nlohmann::json data = {{"event", {{"original", original}}}};
+        testMessages.emplace_back(MessageType::STATELESS, data, "", "", moduleMetadata);
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+    EXPECT_CALL(*mockQueue, getNextBytesAwaitable(MessageType::STATELESS, ::testing::Gt(BATCH_SIZE), "", "", true))
+        .Times(2)
+        .WillRepeatedly([&testMessages]() -> boost::asio::awaitable<std::vector<Message>> { co_return testMessages; });
+    // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+
+    for (const auto encoding : {http_client::ContentEncoding::GZIP, http_client::ContentEncoding::ZSTD})
+    {
+        io_context.restart();
+
+        auto awaitableResult = boost::asio::co_spawn(
+            io_context,
+            GetMessagesFromQueue(mockQueue, MessageType::STATELESS, BATCH_SIZE, nullptr, {encoding, 6}),
+            boost::asio::use_future);
+
+        io_context.run();
+
+        const auto [count, body] = awaitableResult.get();
+
+        EXPECT_GT(count, 1);
+        EXPECT_LT(count, 100);
+        EXPECT_LE(body.size(), BATCH_SIZE);
+    }
+}
+
 TEST_F(MessageQueueUtilsTest, PopMessagesFromQueueTest)
 {
     EXPECT_CALL(*mockQueue, popN(MessageType::STATEFUL, 1, "", "")).Times(1);
@@ -144,13 +266,24 @@ TEST_F(MessageQueueUtilsTest, PushCommandsToQueueTest)
     commandsJson["commands"].push_back("command_1");
     commandsJson["commands"].push_back("command_2");
 
-    std::vector<Message> expectedMessages;
-    expectedMessages.emplace_back(MessageType::COMMAND, "command_1");
-    expectedMessages.emplace_back(MessageType::COMMAND, "command_2");
-
-    EXPECT_CALL(*mockQueue, push(::testing::ContainerEq(expectedMessages))).Times(1);
-
-    PushCommandsToQueue(mockQueue, commandsJson.dump());
+    std::vector<Message> pushedMessages;
+    EXPECT_CALL(*mockQueue, push(::testing::An<std::vector<Message>>()))
+        .WillOnce(
+            [&pushedMessages](std::vector<Message> messages)
+            {
+                pushedMessages = std::move(messages);
+                return static_cast<int>(pushedMessages.size());
+            });
+
+    size_t notifications = 0;
+    PushCommandsToQueue(mockQueue, commandsJson.dump(), [&notifications]() { ++notifications; });
+
+    ASSERT_EQ(pushedMessages.size(), 2U);
+    EXPECT_EQ(pushedMessages[0].type, MessageType::COMMAND);
+    EXPECT_EQ(pushedMessages[0].data, "command_1");
+    EXPECT_EQ(pushedMessages[1].data, "command_2");
+    EXPECT_TRUE(nlohmann::json::parse(pushedMessages[0].metaData)["received"].is_number_integer());
+    EXPECT_EQ(notifications, 1U);
 }
 
 TEST_F(MessageQueueUtilsTest, NoCommandsToPushTest)
@@ -160,32 +293,50 @@ TEST_F(MessageQueueUtilsTest, NoCommandsToPushTest)
 
     EXPECT_CALL(*mockQueue, push(::testing::_)).Times(0);
 
-    PushCommandsToQueue(mockQueue, commandsJson.dump());
+    size_t notifications = 0;
+    PushCommandsToQueue(mockQueue, commandsJson.dump(), [&notifications]() { ++notifications; });
+
+    EXPECT_EQ(notifications, 0U);
 }
 
-TEST_F(MessageQueueUtilsTest, GetCommandFromQueueEmptyTest)
+TEST_F(MessageQueueUtilsTest, GetCommandsFromQueueEmptyTest)
 {
-    EXPECT_CALL(*mockQueue, isEmpty(MessageType::COMMAND, "", "")).WillOnce(testing::Return(true));
+    EXPECT_CALL(*mockQueue, getNextBytes(MessageType::COMMAND, COMMANDS_BATCH_SIZE, "", "", false))
+        .WillOnce(testing::Return(std::vector<Message> {}));
 
-    ASSERT_EQ(std::nullopt, GetCommandFromQueue(mockQueue));
+    ASSERT_TRUE(GetCommandsFromQueue(mockQueue).empty());
 }
 
-TEST_F(MessageQueueUtilsTest, GetCommandFromQueueTest)
+TEST_F(MessageQueueUtilsTest, GetCommandsFromQueueTest)
 {
-    const Message testMessage {MessageType::COMMAND, BASE_DATA_CONTENT};
-
-    EXPECT_CALL(*mockQueue, isEmpty(MessageType::COMMAND, "", "")).WillOnce(testing::Return(false));
+    const auto received = std::chrono::system_clock::now() - std::chrono::seconds(1);
+    const auto receivedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(received.time_since_epoch()).count();
 
-    EXPECT_CALL(*mockQueue, getNext(MessageType::COMMAND, "", "")).WillOnce(testing::Return(testMessage));
-
-    auto cmd = GetCommandFromQueue(mockQueue);
+    std::vector<Message> testMessages;
+    testMessages.emplace_back(
+        MessageType::COMMAND, BASE_DATA_CONTENT, "", "", nlohmann::json {{"received", receivedMs}}.dump());
+    testMessages.emplace_back(MessageType::COMMAND, BASE_DATA_CONTENT);
+
+    EXPECT_CALL(*mockQueue, getNextBytes(MessageType::COMMAND, COMMANDS_BATCH_SIZE, "", "", false))
+        .WillOnce(testing::Return(testMessages));
+
+    const auto cmds = GetCommandsFromQueue(mockQueue);
+
+    ASSERT_EQ(cmds.size(), 2U);
+    ASSERT_EQ(cmds[0].Id, "112233");
+    ASSERT_EQ(cmds[0].Command, "command_test");
+    ASSERT_EQ(cmds[0].Parameters, R"({"parameters":["parameters_test"]})"_json);
+    ASSERT_EQ(cmds[0].ExecutionResult.ErrorCode, module_command::Status::IN_PROGRESS);
+    ASSERT_EQ(std::chrono::duration_cast<std::chrono::milliseconds>(cmds[0].ReceivedTime.time_since_epoch()).count(),
+              receivedMs);
+    ASSERT_EQ(cmds[1].ReceivedTime, std::chrono::system_clock::time_point {});
+}
 
-    ASSERT_EQ(cmd.has_value() ? cmd.value().Id : "", "112233");
-    ASSERT_EQ(cmd.has_value() ? cmd.value().Command : "", "command_test");
-    ASSERT_EQ(cmd.has_value() ? cmd.value().Parameters : nlohmann::json::object({"{}"}),
-              R"({"parameters":["parameters_test"]})"_json);
-    ASSERT_EQ(cmd.has_value() ? cmd.value().ExecutionResult.ErrorCode : module_command::Status::UNKNOWN,
-              module_command::Status::IN_PROGRESS);
+TEST_F(MessageQueueUtilsTest, PopCommandsFromQueueTest)
+{
+    EXPECT_CALL(*mockQueue, popN(MessageType::COMMAND, 3, "", "")).Times(1);
+    PopCommandsFromQueue(mockQueue, 3);
 }
 
 int main(int argc, char** argv)
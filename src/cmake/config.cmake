@@ -39,16 +39,26 @@ set(DEFAULT_BATCH_INTERVAL "\"10000ms\"" CACHE STRING "Default Agent batch inter
 
 set(DEFAULT_BATCH_SIZE "\"1000000B\"" CACHE STRING "Default Agent batch size limit (1MB)")
 
+set(DEFAULT_COMPRESSION "none" CACHE STRING "Default Agent events compression (none)")
+
+set(DEFAULT_COMPRESSION_LEVEL 3 CACHE STRING "Default Agent events compression level (3)")
+
 set(DEFAULT_VERIFICATION_MODE "none" CACHE STRING "Default Agent verification mode")
 
 set(DEFAULT_LOGCOLLECTOR_ENABLED true CACHE BOOL "Default Logcollector enabled")
 
-set(BUFFER_SIZE 4096 CACHE STRING "Default Logcollector reading buffer size")
+set(BUFFER_SIZE 65536 CACHE STRING "Default Logcollector read block size (64KB)")
+
+set(MAX_LOG_SIZE 1048576 CACHE STRING "Default Logcollector maximum log size, longer lines are split (1MB)")
 
 set(DEFAULT_FILE_WAIT "\"500ms\"" CACHE STRING "Default Logcollector file reading interval (500ms)")
 
 set(DEFAULT_RELOAD_INTERVAL "\"60000ms\"" CACHE STRING "Default Logcollector reload interval (1m)")
 
+set(DEFAULT_LOGCOLLECTOR_BATCH_SIZE "\"65536B\"" CACHE STRING "Default Logcollector batch size limit (64KB)")
+
+set(DEFAULT_LOGCOLLECTOR_BATCH_INTERVAL "\"1000ms\"" CACHE STRING "Default Logcollector batch interval (1s)")
+
 set(DEFAULT_INVENTORY_ENABLED true CACHE BOOL "Default inventory enabled")
 
 set(DEFAULT_INTERVAL "\"3600000ms\"" CACHE STRING "Default inventory interval (1h)")
@@ -75,4 +85,10 @@ set(QUEUE_STATUS_REFRESH_TIMER 100 CACHE STRING "Default Agent's queue refresh t
 
 set(QUEUE_DEFAULT_SIZE "\"10000B\"" CACHE STRING "Default Agent's queue size (10000)")
 
+set(DEFAULT_QUEUE_DURABILITY "persist" CACHE STRING "Default Agent's stateless queue durability (persist)")
+
+set(DEFAULT_QUEUE_MEMORY_SIZE 5000 CACHE STRING "Default Agent's in-memory queue size when spilling (5000)")
+
 set(DEFAULT_COMMANDS_REQUEST_TIMEOUT "\"11m\"" CACHE STRING "Default Agent's command request timeout (11m)")
+
+set(DEFAULT_MAX_ASYNC_COMMANDS 4 CACHE STRING "Default Agent's asynchronous commands executed concurrently (4)")
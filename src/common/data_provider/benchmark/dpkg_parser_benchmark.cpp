@@ -0,0 +1,196 @@
+#include "packages/packageLinuxDataRetriever.h"
+#include "sharedDefs.h"
+#include "stringHelper.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_PACKAGES = 5000;
+    constexpr size_t ROUNDS = 5;
+
+    /// @brief Parser as it was before mapping the file: a line vector for each package and a map of its fields
+    nlohmann::json LegacyParseDpkg(const std::vector<std::string>& entries)
+    {
+        std::map<std::string, std::string> info;
+        nlohmann::json ret;
+
+        for (const auto& entry : entries)
+        {
+            const auto pos {entry.find(":")};
+
+            if (pos != std::string::npos)
+            {
+                info[Utils::Trim(entry.substr(0, pos))] = Utils::Trim(entry.substr(pos + 1), " \n");
+            }
+        }
+
+        if (!info.empty() && info.at("Status").find("ok installed") != std::string::npos)
+        {
+            const auto valueOr {[&info](const std::string& key, const nlohmann::json& defaultValue)
+                                {
+                                    const auto it {info.find(key)};
+                                    return it != info.end() ? nlohmann::json(it->second) : defaultValue;
+                                }};
+
+            ret["name"] = info.at("Package");
+            ret["priority"] = valueOr("Priority", UNKNOWN_VALUE);
+            ret["groups"] = valueOr("Section", UNKNOWN_VALUE);
+            ret["size"] = info.contains("Installed-Size") ? stoll(info.at("Installed-Size")) * 1024 : 0;
+            ret["multiarch"] = valueOr("Multi-Arch", UNKNOWN_VALUE);
+            ret["architecture"] = valueOr("Architecture", EMPTY_VALUE);
+            ret["source"] = valueOr("Source", UNKNOWN_VALUE);
+            ret["version"] = valueOr("Version", EMPTY_VALUE);
+            ret["format"] = "deb";
+            ret["location"] = EMPTY_VALUE;
+            ret["vendor"] = valueOr("Maintainer", UNKNOWN_VALUE);
+            ret["install_time"] = UNKNOWN_VALUE;
+            ret["description"] = info.contains("Description")
+                                     ? nlohmann::json(Utils::substrOnFirstOccurrence(info.at("Description"), "\n"))
+                                     : nlohmann::json(UNKNOWN_VALUE);
+        }
+
+        return ret;
+    }
+
+    void LegacyGetDpkgInfo(const std::string& fileName, const std::function<void(nlohmann::json&)>& callback)
+    {
+        std::fstream file {fileName, std::ios_base::in};
+
+        while (file.good())
+        {
+            std::string line;
+            std::vector<std::string> data;
+
+            do
+            {
+                std::getline(file, line);
+
+                if (line.front() == ' ')
+                {
+                    data.back() = data.back() + line + "\n";
+                }
+                else
+                {
+                    data.push_back(line + "\n");
+                }
+            } while (!line.empty());
+
+            auto packageInfo = LegacyParseDpkg(data);
+
+            if (!packageInfo.empty())
+            {
+                callback(packageInfo);
+            }
+        }
+    }
+
+    /// @brief Writes a status file with the packages of \p source repeated up to at least \p packages entries
+    size_t MakeStatusFile(const std::string& source, const std::string& target, size_t packages)
+    {
+        std::ifstream input {source};
+        std::stringstream content;
+        content << input.rdbuf();
+
+        auto entries {content.str()};
+
+        while (!entries.empty() && entries.back() == '\n')
+        {
+            entries.pop_back();
+        }
+        entries += "\n\n";
+
+        size_t entriesCount {0};
+
+        for (size_t pos = 0; (pos = entries.find("Package:", pos)) != std::string::npos; ++pos)
+        {
+            if (pos == 0 || entries[pos - 1] == '\n')
+            {
+                ++entriesCount;
+            }
+        }
+
+        if (entriesCount == 0)
+        {
+            return 0;
+        }
+
+        std::ofstream output {target};
+        size_t written {0};
+
+        while (written < packages)
+        {
+            output << entries;
+            written += entriesCount;
+        }
+
+        return written;
+    }
+
+    /// @brief Compares the results, the streaming parser no longer keeps the trailing blanks of descriptions
+    bool SameResult(std::vector<nlohmann::json> legacyResult, const std::vector<nlohmann::json>& mappedResult)
+    {
+        for (auto& package : legacyResult)
+        {
+            if (package["description"].is_string())
+            {
+                package["description"] = Utils::RightTrim(package["description"].get<std::string>());
+            }
+        }
+
+        return legacyResult == mappedResult;
+    }
+
+    double Run(void (*getDpkgInfo)(const std::string&, const std::function<void(nlohmann::json&)>&),
+               const std::string& fileName,
+               std::vector<nlohmann::json>& result)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t round = 0; round < ROUNDS; ++round)
+        {
+            result.clear();
+            getDpkgInfo(fileName, [&result](nlohmann::json& package) { result.push_back(std::move(package)); });
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string source = argc > 1 ? argv[1] : DPKG_STATUS_PATH;
+    const size_t packages = argc > 2 ? std::stoul(argv[2]) : DEFAULT_PACKAGES;
+    const auto statusFile = (std::filesystem::temp_directory_path() / "dpkg_parser_benchmark_status").string();
+
+    const auto entries = MakeStatusFile(source, statusFile, packages);
+
+    if (entries == 0)
+    {
+        std::fprintf(stderr, "No packages found in %s\n", source.c_str());
+        return 1;
+    }
+
+    std::vector<nlohmann::json> legacyResult;
+    std::vector<nlohmann::json> mappedResult;
+
+    const auto legacyMs = Run(LegacyGetDpkgInfo, statusFile, legacyResult);
+    const auto mappedMs = Run(GetDpkgInfo, statusFile, mappedResult);
+    std::filesystem::remove(statusFile);
+
+    std::printf("%-16s %8zu entries %10.2f ms\n", "getline", entries, legacyMs);
+    std::printf("%-16s %8zu entries %10.2f ms %8.1fx speedup %s\n",
+                "mapped",
+                entries,
+                mappedMs,
+                legacyMs / mappedMs,
+                SameResult(legacyResult, mappedResult) ? "same result" : "DIFFERENT RESULT");
+    return 0;
+}
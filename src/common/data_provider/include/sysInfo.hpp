@@ -40,6 +40,12 @@ public:
     /// @brief Fills the processes information using a callback
     void processes(std::function<void(nlohmann::json&)>) override;
 
+    /// @copydoc ISysInfo::packageSources
+    nlohmann::json packageSources() override;
+
+    /// @copydoc ISysInfo::sourcePackages
+    void sourcePackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback) override;
+
 private:
     /// @brief Returns the hardware information
     /// @return Hardware information
@@ -74,4 +80,12 @@ private:
 
     /// @brief Fills the processes information using a callback
     virtual void getProcessesInfo(const std::function<void(nlohmann::json&)>&) const;
+
+    /// @brief Returns the signature of each package source, by the format of its packages
+    /// @return Package sources signatures, empty if not supported
+    virtual nlohmann::json getPackageSources() const;
+
+    /// @brief Fills the information of the packages of some formats using a callback
+    virtual void getPackages(const std::set<std::string>& formats,
+                             const std::function<void(nlohmann::json&)>& callback) const;
 };
@@ -2,6 +2,10 @@
 
 #include <nlohmann/json.hpp>
 
+#include <functional>
+#include <set>
+#include <string>
+
 class ISysInfo
 {
 public:
@@ -44,4 +48,26 @@ public:
 
     /// @brief Fills the processes information using a callback
     virtual void processes(std::function<void(nlohmann::json&)>) = 0;
+
+    /// @brief Returns the state of the sources the packages are read from, to tell which ones changed
+    /// @return Signature of each package source, by the format of its packages, or nothing if not supported
+    virtual nlohmann::json packageSources()
+    {
+        return {};
+    }
+
+    /// @brief Fills the information of the packages of some sources using a callback
+    /// @param formats Formats of the packages to read, as keyed by \ref packageSources
+    /// @param callback Callback to be called for every package read
+    virtual void sourcePackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback)
+    {
+        packages(
+            [&formats, &callback](nlohmann::json& package)
+            {
+                if (formats.contains(package.value("format", "")))
+                {
+                    callback(package);
+                }
+            });
+    }
 };
@@ -12,12 +12,19 @@ class ModernFactoryPackagesCreator final
 {
 public:
     /// @brief  Retrieves the modern packages information
-    /// @param paths Paths to search for packages
+    /// @param paths Paths to search for packages, by package manager ("PYPI" and/or "NPM")
     /// @param callback Callback function
     static void getPackages(const std::map<std::string, std::set<std::string>>& paths,
                             std::function<void(nlohmann::json&)> callback)
     {
-        PYPI().getPackages(paths.at("PYPI"), callback);
-        NPM().getPackages(paths.at("NPM"), callback);
+        if (const auto it = paths.find("PYPI"); it != paths.end())
+        {
+            PYPI().getPackages(it->second, callback);
+        }
+
+        if (const auto it = paths.find("NPM"); it != paths.end())
+        {
+            NPM().getPackages(it->second, callback);
+        }
     }
 };
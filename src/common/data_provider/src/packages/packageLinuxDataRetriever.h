@@ -6,6 +6,8 @@
 #include "utilsWrapper.hpp"
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <set>
+#include <string>
 
 /// @brief Fills a JSON object with all available dpkg-related information
 /// @param fileName Path to dpkg's database directory
@@ -22,20 +24,22 @@ class FactoryPackagesCreator final
 public:
     /// @brief Retrieves the Linux package information
     /// @param callback Callback function
-    static void getPackages(std::function<void(nlohmann::json&)> callback)
+    /// @param formats Formats of the packages to retrieve
+    static void getPackages(std::function<void(nlohmann::json&)> callback,
+                            const std::set<std::string>& formats = {"deb", "rpm", "snap"})
     {
         const auto fsWrapper = std::make_unique<file_system::FileSystemWrapper>();
-        if (fsWrapper->exists(DPKG_PATH) && fsWrapper->is_directory(DPKG_PATH))
+        if (formats.contains("deb") && fsWrapper->exists(DPKG_PATH) && fsWrapper->is_directory(DPKG_PATH))
         {
             GetDpkgInfo(DPKG_STATUS_PATH, callback);
         }
 
-        if (fsWrapper->exists(RPM_PATH) && fsWrapper->is_directory(RPM_PATH))
+        if (formats.contains("rpm") && fsWrapper->exists(RPM_PATH) && fsWrapper->is_directory(RPM_PATH))
         {
             RPM<>().getRpmInfo(callback);
         }
 
-        if (fsWrapper->exists(SNAP_PATH) && fsWrapper->is_directory(SNAP_PATH))
+        if (formats.contains("snap") && fsWrapper->exists(SNAP_PATH) && fsWrapper->is_directory(SNAP_PATH))
         {
             GetSnapInfo(callback);
         }
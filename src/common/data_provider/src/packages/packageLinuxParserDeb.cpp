@@ -1,39 +1,86 @@
 #include "packageLinuxDataRetriever.h"
 #include "packageLinuxParserHelper.h"
 #include "sharedDefs.h"
-#include <fstream>
 
-void GetDpkgInfo(const std::string& fileName, const std::function<void(nlohmann::json&)>& callback)
-{
-    std::fstream file {fileName, std::ios_base::in};
+#include <fcntl.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-    if (file.is_open())
+namespace
+{
+    /// @brief Read-only memory mapping of a whole file, empty if the file can't be mapped
+    class MappedFile final
     {
-        while (file.good())
+    public:
+        explicit MappedFile(const std::string& fileName)
         {
-            std::string line;
-            std::vector<std::string> data;
+            const auto fd {open(fileName.c_str(), O_RDONLY | O_CLOEXEC)};
 
-            do
+            if (fd < 0)
             {
-                std::getline(file, line);
+                return;
+            }
 
-                if (line.front() == ' ') // additional info
-                {
-                    data.back() = data.back() + line + "\n";
-                }
-                else
+            struct stat fileStat {};
+
+            if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+            {
+                const auto size {static_cast<size_t>(fileStat.st_size)};
+                auto* data {mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+                if (data != MAP_FAILED)
                 {
-                    data.push_back(line + "\n");
+                    madvise(data, size, MADV_SEQUENTIAL);
+                    m_data = data;
+                    m_size = size;
                 }
-            } while (!line.empty()); // end of package item info
+            }
 
-            auto packageInfo = PackageLinuxHelper::parseDpkg(data);
+            close(fd);
+        }
 
-            if (!packageInfo.empty())
+        ~MappedFile()
+        {
+            if (m_data)
             {
-                callback(packageInfo);
+                munmap(m_data, m_size);
             }
         }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        std::string_view View() const
+        {
+            return m_data ? std::string_view {static_cast<const char*>(m_data), m_size} : std::string_view {};
+        }
+
+    private:
+        void* m_data {nullptr};
+        size_t m_size {0};
+    };
+} // namespace
+
+void GetDpkgInfo(const std::string& fileName, const std::function<void(nlohmann::json&)>& callback)
+{
+    // dpkg replaces the status file instead of rewriting it, the mapping keeps the one opened consistent
+    const MappedFile file {fileName};
+    auto content {file.View()};
+
+    while (!content.empty())
+    {
+        // Packages are paragraphs separated by blank lines
+        const auto end {content.find("\n\n")};
+        auto packageInfo = PackageLinuxHelper::parseDpkg(content.substr(0, end));
+        content.remove_prefix(end == std::string_view::npos ? content.size() : end + 2);
+
+        if (!packageInfo.empty())
+        {
+            callback(packageInfo);
+        }
     }
 }
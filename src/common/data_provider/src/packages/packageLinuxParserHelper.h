@@ -3,29 +3,97 @@
 #include "sharedDefs.h"
 #include "stringHelper.hpp"
 #include "timeHelper.hpp"
+#include <array>
+#include <charconv>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <sstream>
+#include <string_view>
 
 // Parse helpers for standard Linux packaging systems (rpm, dpkg, ...)
 namespace PackageLinuxHelper
 {
     /// @brief Parse a dpkg database entry
-    /// @param entries Vector of entries to parse
+    /// @param entry Paragraph of the dpkg status file describing a package, without the blank line that ends it
     /// @return Parsed information
-    [[maybe_unused]] static nlohmann::json parseDpkg(const std::vector<std::string>& entries)
+    [[maybe_unused]] static nlohmann::json parseDpkg(std::string_view entry)
     {
-        std::map<std::string, std::string> info;
-        nlohmann::json ret;
-
-        for (const auto& entry : entries)
+        const auto trim {[](std::string_view value)
+                         {
+                             const auto begin {value.find_first_not_of(" \t")};
+
+                             if (begin == std::string_view::npos)
+                             {
+                                 return std::string_view {};
+                             }
+
+                             return value.substr(begin, value.find_last_not_of(" \t") - begin + 1);
+                         }};
+
+        // Values of the fields used, viewing into the entry
+        std::optional<std::string_view> package;
+        std::optional<std::string_view> status;
+        std::optional<std::string_view> priority;
+        std::optional<std::string_view> section;
+        std::optional<std::string_view> installedSize;
+        std::optional<std::string_view> multiarch;
+        std::optional<std::string_view> architecture;
+        std::optional<std::string_view> source;
+        std::optional<std::string_view> version;
+        std::optional<std::string_view> maintainer;
+        std::optional<std::string_view> description;
+
+        const std::array<std::pair<std::string_view, std::optional<std::string_view>*>, 11> fields {
+            {{"Package", &package},
+             {"Status", &status},
+             {"Priority", &priority},
+             {"Section", &section},
+             {"Installed-Size", &installedSize},
+             {"Multi-Arch", &multiarch},
+             {"Architecture", &architecture},
+             {"Source", &source},
+             {"Version", &version},
+             {"Maintainer", &maintainer},
+             {"Description", &description}}};
+        std::optional<std::string_view>* field {nullptr};
+
+        while (!entry.empty())
         {
-            const auto pos {entry.find(":")};
+            const auto lineEnd {entry.find('\n')};
+            const auto line {entry.substr(0, lineEnd)};
+            entry.remove_prefix(lineEnd == std::string_view::npos ? entry.size() : lineEnd + 1);
 
-            if (pos != std::string::npos)
+            if (line.empty())
             {
-                const auto key {Utils::Trim(entry.substr(0, pos))};
-                const auto value {Utils::Trim(entry.substr(pos + 1), " \n")};
-                info[key] = value;
+                continue;
+            }
+
+            if (line.front() == ' ' || line.front() == '\t')
+            {
+                // Continuation of the previous field, only its first line is kept
+                if (field && (*field)->empty())
+                {
+                    *field = trim(line);
+                }
+                continue;
+            }
+
+            field = nullptr;
+            const auto pos {line.find(':')};
+
+            if (pos != std::string_view::npos)
+            {
+                const auto key {trim(line.substr(0, pos))};
+
+                for (const auto& [name, value] : fields)
+                {
+                    if (name == key)
+                    {
+                        *value = trim(line.substr(pos + 1));
+                        field = value;
+                        break;
+                    }
+                }
             }
         }
 
@@ -43,97 +111,39 @@ namespace PackageLinuxHelper
 
            We'll collect packages in any selection state, with 'ok' FLAG and 'installed' PACKAGE_STATE.
          */
-        if (!info.empty() && info.at("Status").find("ok installed") != std::string::npos)
+        if (!package || !status || status->find("ok installed") == std::string_view::npos)
         {
-            ret["name"] = info.at("Package");
-
-            nlohmann::json priority = UNKNOWN_VALUE;
-            nlohmann::json groups = UNKNOWN_VALUE;
-            // The multiarch field won't have a default value
-            nlohmann::json multiarch = UNKNOWN_VALUE;
-            nlohmann::json architecture = EMPTY_VALUE;
-            nlohmann::json source = UNKNOWN_VALUE;
-            nlohmann::json version = EMPTY_VALUE;
-            nlohmann::json vendor = UNKNOWN_VALUE;
-            nlohmann::json description = UNKNOWN_VALUE;
-            int64_t size {0};
-
-            auto it {info.find("Priority")};
-
-            if (it != info.end())
-            {
-                priority = it->second;
-            }
-
-            it = info.find("Section");
-
-            if (it != info.end())
-            {
-                groups = it->second;
-            }
-
-            it = info.find("Installed-Size");
-
-            if (it != info.end())
-            {
-                size = stoll(it->second) * 1024;
-            }
-
-            it = info.find("Multi-Arch");
-
-            if (it != info.end())
-            {
-                multiarch = it->second;
-            }
-
-            it = info.find("Architecture");
-
-            if (it != info.end())
-            {
-                architecture = it->second;
-            }
-
-            it = info.find("Source");
-
-            if (it != info.end())
-            {
-                source = it->second;
-            }
-
-            it = info.find("Version");
-
-            if (it != info.end())
-            {
-                version = it->second;
-            }
-
-            it = info.find("Maintainer");
+            return {};
+        }
 
-            if (it != info.end())
-            {
-                vendor = it->second;
-            }
+        const auto valueOr {[](const std::optional<std::string_view>& value, const nlohmann::json& defaultValue)
+                            {
+                                return value ? nlohmann::json(std::string {*value}) : defaultValue;
+                            }};
+        int64_t size {0};
 
-            it = info.find("Description");
+        if (installedSize)
+        {
+            std::from_chars(installedSize->data(), installedSize->data() + installedSize->size(), size);
+            size *= 1024;
+        }
 
-            if (it != info.end())
-            {
-                description = Utils::substrOnFirstOccurrence(it->second, "\n");
-            }
+        nlohmann::json ret;
 
-            ret["priority"] = priority;
-            ret["groups"] = groups;
-            ret["size"] = size;
-            ret["multiarch"] = multiarch;
-            ret["architecture"] = architecture;
-            ret["source"] = source;
-            ret["version"] = version;
-            ret["format"] = "deb";
-            ret["location"] = EMPTY_VALUE;
-            ret["vendor"] = vendor;
-            ret["install_time"] = UNKNOWN_VALUE;
-            ret["description"] = description;
-        }
+        ret["name"] = std::string {*package};
+        ret["priority"] = valueOr(priority, UNKNOWN_VALUE);
+        ret["groups"] = valueOr(section, UNKNOWN_VALUE);
+        ret["size"] = size;
+        // The multiarch field won't have a default value
+        ret["multiarch"] = valueOr(multiarch, UNKNOWN_VALUE);
+        ret["architecture"] = valueOr(architecture, EMPTY_VALUE);
+        ret["source"] = valueOr(source, UNKNOWN_VALUE);
+        ret["version"] = valueOr(version, EMPTY_VALUE);
+        ret["format"] = "deb";
+        ret["location"] = EMPTY_VALUE;
+        ret["vendor"] = valueOr(maintainer, UNKNOWN_VALUE);
+        ret["install_time"] = UNKNOWN_VALUE;
+        ret["description"] = valueOr(description, UNKNOWN_VALUE);
 
         return ret;
     }
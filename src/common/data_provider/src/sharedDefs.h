@@ -20,6 +20,7 @@ constexpr auto DPKG_STATUS_PATH {"/var/lib/dpkg/status"};
 constexpr auto RPM_PATH {"/var/lib/rpm/"};
 
 constexpr auto SNAP_PATH {"/var/lib/snapd"};
+constexpr auto SNAP_STATE_PATH {"/var/lib/snapd/state.json"};
 
 constexpr auto UNKNOWN_VALUE {nullptr};
 constexpr auto EMPTY_VALUE {""};
@@ -47,6 +47,16 @@ nlohmann::json SysInfo::hotfixes()
     return getHotfixes();
 }
 
+nlohmann::json SysInfo::packageSources()
+{
+    return getPackageSources();
+}
+
+void SysInfo::sourcePackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback)
+{
+    getPackages(formats, callback);
+}
+
 #ifdef __cplusplus
 extern "C"
 {
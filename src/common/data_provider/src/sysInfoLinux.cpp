@@ -14,6 +14,7 @@
 #include "sysInfo.hpp"
 #include <cstring>
 #include <file_io_utils.hpp>
+#include <filesystem_utils.hpp>
 #include <filesystem_wrapper.hpp>
 #include <fstream>
 #include <iostream>
@@ -21,6 +22,7 @@
 #include <regex>
 #include <span>
 #include <string>
+#include <sys/stat.h>
 #include <sys/utsname.h>
 
 using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
@@ -610,6 +612,102 @@ void SysInfo::getPackages(const std::function<void(nlohmann::json&)>& callback)
     ModernFactoryPackagesCreator::getPackages(searchPaths, callback);
 }
 
+/// @brief Appends the inode, size and modification time of a path to the signature of a package source
+static void SignPath(const std::string& path, std::string& signature)
+{
+    struct stat pathStat {};
+
+    if (stat(path.c_str(), &pathStat) == 0)
+    {
+        signature += path + ":" + std::to_string(pathStat.st_ino) + ":" + std::to_string(pathStat.st_size) + ":" +
+                     std::to_string(pathStat.st_mtim.tv_sec) + "." + std::to_string(pathStat.st_mtim.tv_nsec) + ";";
+    }
+}
+
+/// @brief Signs the directories a package manager installs its packages in, which change when a package is added,
+/// removed or upgraded
+static std::string SignPackageDirectories(const std::set<std::string>& baseDirectories, const std::string& subdirectory)
+{
+    const file_system::FileSystemUtils fsUtils;
+    std::set<std::string> directories;
+    std::string signature;
+
+    for (const auto& baseDirectory : baseDirectories)
+    {
+        std::deque<std::string> expandedPaths;
+
+        try
+        {
+            fsUtils.expand_absolute_path(baseDirectory, expandedPaths);
+        }
+        catch (const std::exception&) // NOLINT(bugprone-empty-catch)
+        {
+            // Do nothing, continue with the next path
+        }
+
+        for (const auto& expandedPath : expandedPaths)
+        {
+            directories.insert(expandedPath + subdirectory);
+        }
+    }
+
+    for (const auto& directory : directories)
+    {
+        SignPath(directory, signature);
+    }
+
+    return signature;
+}
+
+nlohmann::json SysInfo::getPackageSources() const
+{
+    std::string dpkgSignature;
+    std::string rpmSignature;
+    std::string snapSignature;
+    std::set<std::string> rpmFiles;
+    std::error_code ec;
+
+    SignPath(DPKG_STATUS_PATH, dpkgSignature);
+
+    // The rpm database is made of several files, depending on its backend
+    for (const auto& entry : std::filesystem::directory_iterator(RPM_PATH, ec))
+    {
+        rpmFiles.insert(entry.path().string());
+    }
+
+    for (const auto& rpmFile : rpmFiles)
+    {
+        SignPath(rpmFile, rpmSignature);
+    }
+
+    SignPath(SNAP_STATE_PATH, snapSignature);
+
+    return {{"deb", dpkgSignature},
+            {"rpm", rpmSignature},
+            {"snap", snapSignature},
+            {"pypi", SignPackageDirectories(UNIX_PYPI_DEFAULT_BASE_DIRS, "")},
+            {"npm", SignPackageDirectories(UNIX_NPM_DEFAULT_BASE_DIRS, "/node_modules")}};
+}
+
+void SysInfo::getPackages(const std::set<std::string>& formats,
+                          const std::function<void(nlohmann::json&)>& callback) const
+{
+    std::map<std::string, std::set<std::string>> searchPaths;
+
+    if (formats.contains("pypi"))
+    {
+        searchPaths.emplace("PYPI", UNIX_PYPI_DEFAULT_BASE_DIRS);
+    }
+
+    if (formats.contains("npm"))
+    {
+        searchPaths.emplace("NPM", UNIX_NPM_DEFAULT_BASE_DIRS);
+    }
+
+    FactoryPackagesCreator::getPackages(callback, formats);
+    ModernFactoryPackagesCreator::getPackages(searchPaths, callback);
+}
+
 nlohmann::json SysInfo::getHotfixes() const
 {
     // Currently not supported for this OS.
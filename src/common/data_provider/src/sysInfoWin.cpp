@@ -903,6 +903,25 @@ void SysInfo::getPackages(const std::function<void(nlohmann::json&)>& callback)
     ModernFactoryPackagesCreator::getPackages(searchPaths, callback);
 }
 
+nlohmann::json SysInfo::getPackageSources() const
+{
+    // Package sources are not tracked for this OS, packages are always read from all of them.
+    return {};
+}
+
+void SysInfo::getPackages(const std::set<std::string>& formats,
+                          const std::function<void(nlohmann::json&)>& callback) const
+{
+    getPackages(
+        [&formats, &callback](nlohmann::json& package)
+        {
+            if (formats.contains(package.value("format", "")))
+            {
+                callback(package);
+            }
+        });
+}
+
 nlohmann::json SysInfo::getHotfixes() const
 {
     std::set<std::string> hotfixes;
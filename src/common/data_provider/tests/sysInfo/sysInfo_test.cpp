@@ -63,6 +63,16 @@ void SysInfo::getProcessesInfo(const std::function<void(nlohmann::json&)>& callb
     std::invoke(callback, PROCESSES_EXPECTED);
 }
 
+nlohmann::json SysInfo::getPackageSources() const
+{
+    return {};
+}
+
+void SysInfo::getPackages(const std::set<std::string>&, const std::function<void(nlohmann::json&)>& callback) const
+{
+    std::invoke(callback, PACKAGES_EXPECTED);
+}
+
 class CallbackMock
 {
 public:
@@ -1,9 +1,12 @@
 #include "sysInfoPackagesLinuxHelper_test.hpp"
+#include "packages/packageLinuxDataRetriever.h"
 #include "packages/packageLinuxParserHelper.h"
 #include "packages/packageLinuxRpmParserHelper.h"
 #include "packages/packageLinuxRpmParserHelperLegacy.h"
 #include "packages/rpmPackageManager.h"
 #include "sharedDefs.h"
+#include <cstdio>
+#include <fstream>
 
 using ::testing::_; // NOLINT(bugprone-reserved-identifier)
 using ::testing::Return;
@@ -271,19 +274,10 @@ TEST_F(SysInfoPackagesLinuxHelperTest, parseDpkgInformation)
          zlib is a library implementing the deflate compression method found\n\
          in gzip and PKZIP.  This package includes the development support\n\
          files."};
-    std::vector<std::string> packagesList;
-    packagesList.emplace_back(PACKAGE_INFO);
-    packagesList.emplace_back(STATUS_INFO);
-    packagesList.emplace_back(PRIORITY_INFO);
-    packagesList.emplace_back(SECTION_INFO);
-    packagesList.emplace_back(SIZE_INFO);
-    packagesList.emplace_back(VENDOR_INFO);
-    packagesList.emplace_back(ARCH_INFO);
-    packagesList.emplace_back(MULTIARCH_INFO);
-    packagesList.emplace_back(SOURCE_INFO);
-    packagesList.emplace_back(VERSION_INFO);
-    packagesList.emplace_back(DESCRIPTION_INFO);
-    const auto& jsPackageInfo {PackageLinuxHelper::parseDpkg(packagesList)};
+    const auto packageEntry {std::string {PACKAGE_INFO} + "\n" + STATUS_INFO + "\n" + PRIORITY_INFO + "\n" +
+                             SECTION_INFO + "\n" + SIZE_INFO + "\n" + VENDOR_INFO + "\n" + ARCH_INFO + "\n" +
+                             MULTIARCH_INFO + "\n" + SOURCE_INFO + "\n" + VERSION_INFO + "\n" + DESCRIPTION_INFO};
+    const auto& jsPackageInfo {PackageLinuxHelper::parseDpkg(packageEntry)};
     EXPECT_FALSE(jsPackageInfo.empty());
     EXPECT_EQ("zlib1g-dev", jsPackageInfo["name"]);
     EXPECT_EQ("optional", jsPackageInfo["priority"]);
@@ -298,6 +292,52 @@ TEST_F(SysInfoPackagesLinuxHelperTest, parseDpkgInformation)
     EXPECT_EQ("zlib", jsPackageInfo["source"]);
 }
 
+TEST_F(SysInfoPackagesLinuxHelperTest, parseDpkgNotInstalled)
+{
+    constexpr auto PACKAGE_ENTRY {"Package: zlib1g-dev\n"
+                                  "Status: deinstall ok config-files\n"
+                                  "Version: 1:1.2.11.dfsg-2ubuntu1.2"};
+
+    EXPECT_TRUE(PackageLinuxHelper::parseDpkg(PACKAGE_ENTRY).empty());
+    EXPECT_TRUE(PackageLinuxHelper::parseDpkg("Package: zlib1g-dev").empty());
+}
+
+TEST_F(SysInfoPackagesLinuxHelperTest, getDpkgInfoStatusFile)
+{
+    constexpr auto STATUS_PATH {"dpkg_status"};
+    {
+        std::ofstream status {STATUS_PATH};
+        status << "Package: zlib1g-dev\n"
+                  "Status: install ok installed\n"
+                  "Installed-Size: 4014865\n"
+                  "Version: 1:1.2.11.dfsg-2ubuntu1.2\n"
+                  "Description:\n"
+                  " compression library - development\n"
+                  " zlib is a library implementing the deflate compression method.\n"
+                  "\n"
+                  "Package: removed\n"
+                  "Status: deinstall ok config-files\n"
+                  "\n"
+                  "Package: mktemp\n"
+                  "Status: install ok installed\n"
+                  "Conffiles:\n"
+                  " /etc/mktemp.conf 0123456789abcdef\n";
+    }
+
+    std::vector<nlohmann::json> packages;
+    GetDpkgInfo(STATUS_PATH, [&packages](nlohmann::json& package) { packages.push_back(package); });
+    std::remove(STATUS_PATH);
+
+    ASSERT_EQ(2u, packages.size());
+    EXPECT_EQ("zlib1g-dev", packages[0]["name"]);
+    EXPECT_EQ(TEST_SIZE_2, packages[0]["size"]);
+    EXPECT_EQ("1:1.2.11.dfsg-2ubuntu1.2", packages[0]["version"]);
+    EXPECT_EQ("compression library - development", packages[0]["description"]);
+    EXPECT_EQ("mktemp", packages[1]["name"]);
+    EXPECT_EQ("", packages[1]["version"]);
+    EXPECT_EQ(nullptr, packages[1]["description"]);
+}
+
 TEST_F(SysInfoPackagesLinuxHelperTest, ParseSnapCorrectMapping)
 {
     const auto& jsPackageInfo {PackageLinuxHelper::ParseSnap(R"(
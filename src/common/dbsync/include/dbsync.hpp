@@ -74,6 +74,11 @@ public:
     /// @param callbackData  Result callback(std::function) will be called for each result.
     virtual void updateWithSnapshot(const nlohmann::json& jsInput, ResultCallbackData& callbackData);
 
+    /// @brief Gets the counters of the prepared statement cache, to check how well it fits the queries run.
+    /// @return JSON with the number of "hits", "misses" and "evictions", and the number of statements cached
+    ///         ("size").
+    virtual nlohmann::json statementCacheStats();
+
     /// @brief Turns off the services provided by the shared library.
     static void teardown();
 
@@ -15,12 +15,44 @@ public:
 
     /// @brief Unlocks the mutex
     virtual void unlock() = 0;
+
+    /// @brief Holds the mutex exclusively until downgrade is called
+    /// @details A shared lock is released before the exclusive one is taken, so other writers may run in between.
+    virtual void upgrade() = 0;
+
+    /// @brief Holds the mutex as it was before upgrade was called
+    virtual void downgrade() = 0;
+};
+
+/// @brief Holds a lock exclusively during its lifetime
+class ExclusiveSection final
+{
+    ILocking& m_lock;
+
+public:
+    /// @brief Constructor
+    /// @param lock Lock to upgrade
+    explicit ExclusiveSection(ILocking& lock)
+        : m_lock(lock)
+    {
+        m_lock.upgrade();
+    }
+
+    ExclusiveSection(const ExclusiveSection&) = delete;
+    ExclusiveSection& operator=(const ExclusiveSection&) = delete;
+
+    /// @brief Destructor
+    ~ExclusiveSection()
+    {
+        m_lock.downgrade();
+    }
 };
 
 /// @brief Shared locking
 class SharedLocking final : public ILocking
 {
     std::shared_lock<std::shared_timed_mutex> m_lock;
+    std::unique_lock<std::shared_timed_mutex> m_exclusiveLock;
 
 public:
     /// @brief Constructor
@@ -42,6 +74,20 @@ public:
     {
         m_lock.unlock();
     }
+
+    /// @copydoc ILocking::upgrade
+    virtual void upgrade() override
+    {
+        m_lock.unlock();
+        m_exclusiveLock = std::unique_lock<std::shared_timed_mutex>(*m_lock.mutex());
+    }
+
+    /// @copydoc ILocking::downgrade
+    virtual void downgrade() override
+    {
+        m_exclusiveLock.unlock();
+        m_lock.lock();
+    }
 };
 
 /// @brief Exclusive locking
@@ -69,4 +115,10 @@ public:
     {
         m_lock.unlock();
     }
+
+    /// @copydoc ILocking::upgrade
+    virtual void upgrade() override {}
+
+    /// @copydoc ILocking::downgrade
+    virtual void downgrade() override {}
 };
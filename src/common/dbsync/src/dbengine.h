@@ -83,6 +83,10 @@ namespace DbSync
         /// @param data JSON data
         virtual void addTableRelationship(const nlohmann::json& data) = 0;
 
+        /// @brief Gets the prepared statement cache counters
+        /// @return JSON with the number of hits, misses and evictions, and the number of statements cached
+        virtual nlohmann::json statementCacheStats() = 0;
+
     protected:
         /// @brief Default constructor
         IDbEngine() = default;
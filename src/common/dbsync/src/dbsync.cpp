@@ -679,6 +679,11 @@ void DBSync::updateWithSnapshot(const nlohmann::json& jsInput, ResultCallbackDat
     DBSyncImplementation::instance().updateSnapshotData(m_dbsyncHandle, jsInput, callbackWrapper);
 }
 
+nlohmann::json DBSync::statementCacheStats()
+{
+    return DBSyncImplementation::instance().statementCacheStats(m_dbsyncHandle);
+}
+
 DBSyncTxn::DBSyncTxn(const DBSYNC_HANDLE handle,
                      const nlohmann::json& tables,
                      const unsigned int threadNumber,
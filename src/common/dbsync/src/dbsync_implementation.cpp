@@ -153,3 +153,11 @@ void DBSyncImplementation::addTableRelationship(const DBSYNC_HANDLE handle, cons
     const std::lock_guard<std::shared_timed_mutex> lock {ctx->m_syncMutex};
     ctx->m_dbEngine->addTableRelationship(json);
 }
+
+nlohmann::json DBSyncImplementation::statementCacheStats(const DBSYNC_HANDLE handle)
+{
+    const auto ctx {dbEngineContext(handle)};
+
+    // The engine guards its statement cache by itself
+    return ctx->m_dbEngine->statementCacheStats();
+}
@@ -102,6 +102,11 @@ namespace DbSync
         /// @param json JSON information with values to be inserted.
         void addTableRelationship(const DBSYNC_HANDLE handle, const nlohmann::json& json);
 
+        /// @brief Gets the prepared statement cache counters.
+        /// @param handle Handle assigned as part of the \ref dbsync_create method().
+        /// @return JSON with the number of hits, misses and evictions, and the number of statements cached.
+        nlohmann::json statementCacheStats(const DBSYNC_HANDLE handle);
+
         /// @brief Release the DBSync instance.
         void release();
 
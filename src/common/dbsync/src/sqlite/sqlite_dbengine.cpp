@@ -6,6 +6,8 @@
 #include "stringHelper.hpp"
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <set>
 #include <sqlite3.h>
 #include <thread>
 
@@ -26,6 +28,7 @@ SQLiteDBEngine::SQLiteDBEngine(const std::shared_ptr<SQLiteLegacy::ISQLiteFactor
 SQLiteDBEngine::~SQLiteDBEngine()
 {
     const std::lock_guard<std::mutex> lock(m_stmtMutex);
+    m_statementsIndex.clear();
     m_statementsCache.clear();
 
     if (m_transaction)
@@ -198,6 +201,13 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
     {
         if (getPrimaryKeysFromTable(table, primaryKeyList))
         {
+            if (BULK_SYNC_MIN_ROWS <= data.size() &&
+                syncTableRowDataBulk(
+                    table, data, primaryKeyList, ignoredColumns, inTransaction, returnOldData, callback, lock))
+            {
+                return;
+            }
+
             for (const auto& entry : data)
             {
                 nlohmann::json updated;
@@ -257,6 +267,404 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
     }
 }
 
+bool SQLiteDBEngine::syncTableRowDataBulk(const std::string& table,
+                                          const nlohmann::json& data,
+                                          const std::vector<std::string>& primaryKeyList,
+                                          const nlohmann::json& ignoredColumns,
+                                          const bool inTransaction,
+                                          const bool returnOldData,
+                                          const DbSync::ResultCallback& callback,
+                                          ILocking& lock)
+{
+    const auto tableFields {m_tableFields[table]};
+
+    {
+        // The row limit is enforced while inserting the rows one by one
+        const std::lock_guard<std::mutex> maxRowsLock(m_maxRowsMutex);
+
+        if (m_maxRows.end() != m_maxRows.find(table))
+        {
+            return false;
+        }
+    }
+
+    const auto hasPrimaryKey {[&primaryKeyList](const nlohmann::json& entry)
+                              {
+                                  return entry.is_object() &&
+                                         std::all_of(primaryKeyList.begin(),
+                                                     primaryKeyList.end(),
+                                                     [&entry](const std::string& pKey)
+                                                     {
+                                                         const auto it {entry.find(pKey)};
+                                                         return entry.end() != it && !it->is_null();
+                                                     });
+                              }};
+
+    if (!data.is_array() || primaryKeyList.empty() || BULK_SYNC_MAX_COLUMNS < tableFields.size() ||
+        !std::all_of(data.begin(), data.end(), hasPrimaryKey))
+    {
+        return false;
+    }
+
+    const auto syncTable {table + SYNC_TABLE_SUBFIX};
+    const auto isPrimaryKey {
+        [&primaryKeyList](const std::string& name)
+        { return primaryKeyList.end() != std::find(primaryKeyList.begin(), primaryKeyList.end(), name); }};
+
+    // Bit i of a column mask stands for the column i of the table, in the mask of the columns a row has and in the
+    // mask of the columns whose value changed.
+    int64_t modifiedMask {0};
+
+    for (size_t i = 0; i < tableFields.size(); ++i)
+    {
+        const auto& name {std::get<TableHeader::Name>(tableFields[i])};
+
+        if (!isPrimaryKey(name) &&
+            ignoredColumns.end() == std::find(ignoredColumns.begin(), ignoredColumns.end(), name))
+        {
+            modifiedMask |= int64_t {1} << i;
+        }
+    }
+
+    const auto modified {std::string("s.db_sync_changed_dm<>0")};
+    std::string placeholders;
+    std::string pkMatch;
+    std::string changedMask {"0"};
+    std::string changedAny {"0"};
+    std::string oldFields;
+    std::string updateFields;
+
+    for (size_t i = 0; i < tableFields.size(); ++i)
+    {
+        const auto& name {std::get<TableHeader::Name>(tableFields[i])};
+        const auto bit {std::to_string(i)};
+
+        placeholders.append(",?");
+        oldFields.append(",d." + name);
+
+        if (isPrimaryKey(name))
+        {
+            pkMatch.append("s." + name + "=d." + name + " AND ");
+            continue;
+        }
+
+        const auto changed {"(((s.db_sync_present_dm>>" + bit + ")&1) AND s." + name + " IS NOT d." + name + ")"};
+        changedMask.append("|(" + changed + "<<" + bit + ")");
+        changedAny.append(" OR " + changed);
+
+        if (!inTransaction || 0 != name.compare(STATUS_FIELD_NAME))
+        {
+            updateFields.append(name + "=CASE WHEN " + modified + " AND (s.db_sync_present_dm>>" + bit +
+                                ")&1 THEN s." + name + " ELSE d." + name + " END,");
+        }
+    }
+
+    pkMatch = pkMatch.substr(0, pkMatch.size() - COND_AND_SIZE); // Remove the last " AND "
+
+    if (inTransaction)
+    {
+        updateFields.append(std::string(STATUS_FIELD_NAME) + "=1");
+    }
+    else if (!updateFields.empty())
+    {
+        updateFields.pop_back();
+    }
+
+    std::vector<std::tuple<ReturnTypeCallback, size_t, nlohmann::json>> events;
+
+    const auto sync {
+        [&]()
+        {
+            const auto stageStmt {
+                getStatement("INSERT OR IGNORE INTO " + syncTable + " VALUES (?,?,0" + placeholders + ");")};
+            std::vector<int64_t> presentMasks(data.size());
+
+            for (size_t row = 0; row < data.size(); ++row)
+            {
+                const auto& entry {data[row]};
+                int64_t present {0};
+
+                for (size_t i = 0; i < tableFields.size(); ++i)
+                {
+                    const auto index {static_cast<int32_t>(i + 3)};
+
+                    if (bindJsonData(stageStmt, tableFields[i], entry, index))
+                    {
+                        present |= int64_t {1} << i;
+                    }
+                    else
+                    {
+                        stageStmt->bind(index);
+                    }
+                }
+
+                stageStmt->bind(1, static_cast<int64_t>(row));
+                stageStmt->bind(2, present);
+
+                // A repeated primary key must see the row written by its previous occurrence
+                if (SQLITE_DONE != stageStmt->step() || 0 == m_sqliteConnection->changes())
+                {
+                    stageStmt->reset();
+                    return false;
+                }
+
+                stageStmt->reset();
+                presentMasks[row] = present;
+            }
+
+            // A single join finds the new rows and the changed ones, the unchanged rows are not even read
+            std::vector<std::pair<size_t, std::optional<int64_t>>> diffs;
+            const auto diffStmt {getStatement("SELECT s.db_sync_row_dm,d." + primaryKeyList.front() + " IS NULL," +
+                                              changedMask + oldFields + " FROM " + syncTable + " AS s LEFT JOIN " +
+                                              table + " AS d ON " + pkMatch + " WHERE d." + primaryKeyList.front() +
+                                              " IS NULL OR " + changedAny + " ORDER BY s.db_sync_row_dm;")};
+
+            while (SQLITE_ROW == diffStmt->step())
+            {
+                const auto row {static_cast<size_t>(diffStmt->column(0)->value(int64_t {}))};
+
+                if (0 != diffStmt->column(1)->value(int32_t {}))
+                {
+                    diffs.emplace_back(row, std::nullopt);
+
+                    if (callback)
+                    {
+                        events.emplace_back(INSERTED, row, nullptr);
+                    }
+                    continue;
+                }
+
+                // Changes limited to ignored columns leave the row unchanged
+                const auto changed {diffStmt->column(2)->value(int64_t {})};
+
+                if (0 == (changed & modifiedMask))
+                {
+                    continue;
+                }
+
+                diffs.emplace_back(row, changed);
+
+                if (!callback)
+                {
+                    continue;
+                }
+
+                nlohmann::json oldData;
+
+                if (returnOldData)
+                {
+                    for (const auto& pKey : primaryKeyList)
+                    {
+                        oldData[pKey] = data[row].at(pKey);
+                    }
+
+                    for (size_t i = 0; i < tableFields.size(); ++i)
+                    {
+                        if (0 != ((changed >> i) & 1))
+                        {
+                            Row oldField;
+                            getTableData(diffStmt,
+                                         static_cast<int32_t>(i + 3),
+                                         std::get<TableHeader::Type>(tableFields[i]),
+                                         std::get<TableHeader::Name>(tableFields[i]),
+                                         oldField);
+                            getFieldValueFromTuple(*oldField.begin(), oldData);
+                        }
+                    }
+                }
+
+                events.emplace_back(MODIFIED, row, std::move(oldData));
+            }
+
+            diffStmt->reset();
+
+            // The staged rows keep an empty mask when unchanged, no mask when new, and the changed columns otherwise
+            const auto markStmt {getStatement("UPDATE " + syncTable +
+                                              " SET db_sync_changed_dm=? WHERE db_sync_row_dm=?;")};
+            std::set<int64_t> newMasks;
+            auto anyModified {false};
+
+            for (const auto& [row, changed] : diffs)
+            {
+                if (changed.has_value())
+                {
+                    markStmt->bind(1, changed.value());
+                    anyModified = true;
+                }
+                else
+                {
+                    markStmt->bind(1);
+                    newMasks.insert(presentMasks[row]);
+                }
+
+                markStmt->bind(2, static_cast<int64_t>(row));
+
+                if (SQLITE_DONE != markStmt->step())
+                {
+                    markStmt->reset();
+                    return false;
+                }
+
+                markStmt->reset();
+            }
+
+            // New rows are inserted grouped by the columns they have, so the missing ones get their default value
+            for (const auto present : newMasks)
+            {
+                std::string fields;
+
+                for (size_t i = 0; i < tableFields.size(); ++i)
+                {
+                    if (0 != ((present >> i) & 1))
+                    {
+                        fields.append(std::get<TableHeader::Name>(tableFields[i]) + ",");
+                    }
+                }
+
+                fields.pop_back();
+                m_sqliteConnection->execute("INSERT INTO " + table + " (" + fields + ") SELECT " + fields + " FROM " +
+                                            syncTable + " WHERE db_sync_changed_dm IS NULL AND db_sync_present_dm=" +
+                                            std::to_string(present) + " ORDER BY db_sync_row_dm;");
+            }
+
+            // Unchanged rows are only flagged as present for the transaction
+            if (!updateFields.empty() && (inTransaction || anyModified))
+            {
+                m_sqliteConnection->execute("UPDATE " + table + " AS d SET " + updateFields + " FROM " + syncTable +
+                                            " AS s WHERE " + pkMatch + " AND " +
+                                            (inTransaction ? "s.db_sync_changed_dm IS NOT NULL" : modified) + ";");
+            }
+
+            return true;
+        }};
+
+    {
+        // Savepoints and the count of changed rows belong to the whole connection, so the rows synced by other
+        // transactions must not be written meanwhile
+        const ExclusiveSection exclusiveSection(lock);
+        const std::lock_guard<std::mutex> syncTableLock(m_syncTableMutex);
+        auto synced {false};
+
+        try
+        {
+            createSyncTable(table);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        m_sqliteConnection->execute("SAVEPOINT " + syncTable + ";");
+
+        // Failures are left to the per-row sync to reproduce and report, as it writes the rows before the failing one
+        try
+        {
+            synced = sync();
+        }
+        catch (const std::exception&)
+        {
+            synced = false;
+        }
+
+        if (!synced)
+        {
+            m_sqliteConnection->execute("ROLLBACK TO " + syncTable + ";");
+            m_sqliteConnection->execute("RELEASE " + syncTable + ";");
+            return false;
+        }
+
+        m_sqliteConnection->execute("DELETE FROM " + syncTable + ";");
+        m_sqliteConnection->execute("RELEASE " + syncTable + ";");
+    }
+
+    if (callback && !events.empty())
+    {
+        lock.unlock();
+
+        for (const auto& [type, row, oldData] : events)
+        {
+            const auto& entry {data[row]};
+
+            if (INSERTED == type)
+            {
+                callback(INSERTED, entry);
+                continue;
+            }
+
+            nlohmann::json updated;
+
+            for (const auto& field : tableFields)
+            {
+                const auto& name {std::get<TableHeader::Name>(field)};
+                const auto it {entry.find(name)};
+
+                if (entry.end() != it)
+                {
+                    updated[name] = *it;
+                }
+            }
+
+            if (returnOldData)
+            {
+                nlohmann::json diff;
+                diff["old"] = oldData;
+                diff["new"] = updated;
+                callback(MODIFIED, diff);
+            }
+            else
+            {
+                callback(MODIFIED, updated);
+            }
+        }
+
+        lock.lock();
+    }
+
+    return true;
+}
+
+void SQLiteDBEngine::createSyncTable(const std::string& table)
+{
+    const auto tableFields {m_tableFields[table]};
+    const auto it {m_syncTables.find(table)};
+
+    // The table gets a new column when the status field is initialized
+    if (m_syncTables.end() != it && tableFields.size() == it->second)
+    {
+        return;
+    }
+
+    const auto syncTable {table + SYNC_TABLE_SUBFIX};
+    std::string fields;
+    std::string primaryKeys;
+
+    for (const auto& field : tableFields)
+    {
+        const auto& name {std::get<TableHeader::Name>(field)};
+        const auto type {std::find_if(ColumnTypeNames.begin(),
+                                      ColumnTypeNames.end(),
+                                      [&field](const std::pair<const std::string, ColumnType>& columnType)
+                                      { return std::get<TableHeader::Type>(field) == columnType.second; })};
+
+        // Same types as the table, so the staged values get the same affinity and compare equal
+        fields.append("," + name + " " + type->first);
+
+        if (std::get<TableHeader::PK>(field))
+        {
+            primaryKeys.append(name + ",");
+        }
+    }
+
+    primaryKeys.pop_back();
+
+    m_sqliteConnection->execute("DROP TABLE IF EXISTS " + syncTable + ";");
+    m_sqliteConnection->execute("CREATE TEMP TABLE " + syncTable +
+                                " (db_sync_row_dm INTEGER PRIMARY KEY,db_sync_present_dm INTEGER,db_sync_changed_dm "
+                                "INTEGER" +
+                                fields + ",UNIQUE(" + primaryKeys + "));");
+    m_syncTables[table] = tableFields.size();
+}
+
 void SQLiteDBEngine::initializeStatusField(const nlohmann::json& tableNames)
 {
     for (const auto& tableValue : tableNames)
@@ -274,6 +682,13 @@ void SQLiteDBEngine::initializeStatusField(const nlohmann::json& tableNames)
             if (fields.end() == it)
             {
                 m_tableFields.erase(table);
+
+                {
+                    // The queries were built for the columns the table had
+                    const std::lock_guard<std::mutex> lock(m_queriesMutex);
+                    m_queries.clear();
+                }
+
                 const auto stmtAdd {getStatement("ALTER TABLE " + table + " ADD COLUMN " + STATUS_FIELD_NAME + " " +
                                                  STATUS_FIELD_TYPE + " DEFAULT 1;")};
 
@@ -602,7 +1017,15 @@ void SQLiteDBEngine::InsertElement(const std::string& table,
                                    const nlohmann::json& element,
                                    const std::function<void()>& callback)
 {
-    const auto stmt {getStatement(buildInsertDataSqlQuery(table, element))};
+    // The query depends on the columns the element has
+    std::string shape {"insert:" + table + ":"};
+
+    for (const auto& field : tableColumns)
+    {
+        shape.push_back(element.empty() || element.contains(std::get<TableHeader::Name>(field)) ? '1' : '0');
+    }
+
+    const auto stmt {getStatement(getQuery(shape, [&]() { return buildInsertDataSqlQuery(table, element); }))};
     int32_t index {1l};
 
     for (const auto& field : tableColumns)
@@ -738,7 +1161,7 @@ bool SQLiteDBEngine::bindJsonData(const std::shared_ptr<SQLiteLegacy::IStatement
 {
     bool retVal {true};
     const auto type {std::get<TableHeader::Type>(cd)};
-    const auto name {std::get<TableHeader::Name>(cd)};
+    const auto& name {std::get<TableHeader::Name>(cd)};
     const auto isPrimaryKey {std::get<TableHeader::PK>(cd)};
     const auto& it {valueType.find(name)};
 
@@ -1313,7 +1736,8 @@ bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
 {
     bool diffExist {false};
     bool isModified {false};
-    const auto stmt {getStatement(buildSelectMatchingPKsSqlQuery(table, primaryKeyList))};
+    const auto stmt {getStatement(getQuery("select_pks:" + table,
+                                           [&]() { return buildSelectMatchingPKsSqlQuery(table, primaryKeyList); }))};
 
     const auto& tableFields {m_tableFields[table]};
     int32_t index {1l};
@@ -1766,7 +2190,16 @@ void SQLiteDBEngine::updateSingleRow(const std::string& table, const nlohmann::j
     if (getPrimaryKeysFromTable(table, primaryKeyList))
     {
         const auto& tableFields {m_tableFields[table]};
-        const auto stmt {getStatement(buildUpdatePartialDataSqlQuery(table, jsData, primaryKeyList))};
+        // The query depends on the columns the data has
+        std::string shape {"update:" + table + ":"};
+
+        for (auto it = jsData.begin(); it != jsData.end(); ++it)
+        {
+            shape.append(it.key() + ",");
+        }
+
+        const auto stmt {getStatement(
+            getQuery(shape, [&]() { return buildUpdatePartialDataSqlQuery(table, jsData, primaryKeyList); }))};
         int32_t index {1l};
 
         for (auto it = jsData.begin(); it != jsData.end(); ++it)
@@ -1923,27 +2356,61 @@ void SQLiteDBEngine::getFieldValueFromTuple(const Field& value, std::string& res
 std::shared_ptr<SQLiteLegacy::IStatement> SQLiteDBEngine::getStatement(const std::string& sql)
 {
     const std::lock_guard<std::mutex> lock(m_stmtMutex);
-    const auto it {std::find_if(m_statementsCache.begin(),
-                                m_statementsCache.end(),
-                                [sql](const std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>& pair)
-                                { return 0 == pair.first.compare(sql); })};
+    const auto it {m_statementsIndex.find(sql)};
 
-    if (m_statementsCache.end() != it)
+    if (m_statementsIndex.end() != it)
     {
-        it->second->reset();
-        return it->second;
+        ++m_statementsHits;
+        // Most recently used first
+        m_statementsCache.splice(m_statementsCache.begin(), m_statementsCache, it->second);
+        it->second->second->reset();
+        return it->second->second;
     }
-    else
+
+    ++m_statementsMisses;
+    m_statementsCache.emplace_front(sql, m_sqliteFactory->createStatement(m_sqliteConnection, sql));
+    m_statementsIndex.emplace(sql, m_statementsCache.begin());
+
+    if (CACHE_STMT_LIMIT < m_statementsCache.size())
+    {
+        ++m_statementsEvictions;
+        m_statementsIndex.erase(m_statementsCache.back().first);
+        m_statementsCache.pop_back();
+    }
+
+    return m_statementsCache.front().second;
+}
+
+nlohmann::json SQLiteDBEngine::statementCacheStats()
+{
+    const std::lock_guard<std::mutex> lock(m_stmtMutex);
+    nlohmann::json stats;
+
+    stats["hits"] = m_statementsHits;
+    stats["misses"] = m_statementsMisses;
+    stats["evictions"] = m_statementsEvictions;
+    stats["size"] = m_statementsCache.size();
+
+    return stats;
+}
+
+std::string SQLiteDBEngine::getQuery(const std::string& shape, const std::function<std::string()>& build)
+{
     {
-        m_statementsCache.emplace_back(sql, m_sqliteFactory->createStatement(m_sqliteConnection, sql));
+        const std::lock_guard<std::mutex> lock(m_queriesMutex);
+        const auto it {m_queries.find(shape)};
 
-        if (CACHE_STMT_LIMIT <= m_statementsCache.size())
+        if (m_queries.end() != it)
         {
-            m_statementsCache.pop_front();
+            return it->second;
         }
-
-        return m_statementsCache.back().second;
     }
+
+    auto query {build()};
+    const std::lock_guard<std::mutex> lock(m_queriesMutex);
+    m_queries.emplace(shape, query);
+
+    return query;
 }
 
 std::string SQLiteDBEngine::getSelectAllQuery(const std::string& table, const TableColumns& tableFields) const
@@ -5,17 +5,26 @@
 #include "isqliteWrapper.hpp"
 #include "mapWrapperSafe.hpp"
 #include "sqliteWrapperFactory.hpp"
+#include <list>
 #include <mutex>
 #include <queue>
 #include <tuple>
+#include <unordered_map>
 
 constexpr auto TEMP_TABLE_SUBFIX {"_TEMP"};
+constexpr auto SYNC_TABLE_SUBFIX {"_SYNC"};
 
 constexpr auto STATUS_FIELD_NAME {"db_status_field_dm"};
 constexpr auto STATUS_FIELD_TYPE {"INTEGER"};
 
 constexpr auto CACHE_STMT_LIMIT {30ull};
 
+/// @brief Minimum number of rows in a sync for the set-based diff to be used instead of the per-row one
+constexpr auto BULK_SYNC_MIN_ROWS {16ull};
+
+/// @brief Maximum number of columns of a table synced with the set-based diff, as column masks are 63-bit integers
+constexpr auto BULK_SYNC_MAX_COLUMNS {63ull};
+
 const std::vector<std::string> InternalColumnNames = {{STATUS_FIELD_NAME}};
 
 /// @brief Column types
@@ -184,6 +193,10 @@ public:
     /// @param data JSON data
     void addTableRelationship(const nlohmann::json& data) override;
 
+    /// @brief Gets the statement cache counters
+    /// @return JSON with the number of hits, misses and evictions, and the number of statements cached
+    nlohmann::json statementCacheStats() override;
+
 private:
     /// @brief Delete copy constructor
     SQLiteDBEngine(const SQLiteDBEngine&) = delete;
@@ -297,6 +310,34 @@ private:
                     nlohmann::json& updatedData,
                     nlohmann::json& oldData);
 
+    /// @brief Syncs the rows with a few set-based statements instead of one diff and one write per row
+    ///
+    /// The rows are staged in a temp table and joined to the table on the primary key to find the new, modified
+    /// and unchanged ones, then written and notified in input order. It has the same result as the per-row
+    /// sync, and gives up (writing nothing) when it cannot guarantee it: the table has a row limit, has too many
+    /// columns, or the rows lack a primary key, repeat one or fail to be written.
+    /// @param table table name
+    /// @param data rows to sync
+    /// @param primaryKeyList primary key list
+    /// @param ignoredColumns columns whose changes do not make a row modified
+    /// @param inTransaction whether the rows must be flagged as present for the transaction
+    /// @param returnOldData whether the modified rows callback gets the old values too
+    /// @param callback callback
+    /// @param lock lock, held exclusively while the rows are written and released while the callback runs
+    /// @return false if the rows must be synced one by one
+    bool syncTableRowDataBulk(const std::string& table,
+                              const nlohmann::json& data,
+                              const std::vector<std::string>& primaryKeyList,
+                              const nlohmann::json& ignoredColumns,
+                              const bool inTransaction,
+                              const bool returnOldData,
+                              const DbSync::ResultCallback& callback,
+                              ILocking& lock);
+
+    /// @brief Creates the temp table the rows of a bulk sync are staged in
+    /// @param table table name
+    void createSyncTable(const std::string& table);
+
     /// @brief Inserts the new rows
     /// @param table table name
     /// @param primaryKeyList primary key list
@@ -473,10 +514,20 @@ private:
     void getFieldValueFromTuple(const Field& value, nlohmann::json& object);
 
     /// @brief Get a statement
+    ///
+    /// Statements are cached by SQL sentence, the least recently used one being finalized when the cache is full.
     /// @param sql SQL sentence
     /// @return statement
     std::shared_ptr<SQLiteLegacy::IStatement> getStatement(const std::string& sql);
 
+    /// @brief Gets a query from the queries already built, building it the first time
+    ///
+    /// The shape must identify everything the query depends on, as the table and the columns it names.
+    /// @param shape query shape
+    /// @param build function building the query
+    /// @return query
+    std::string getQuery(const std::string& shape, const std::function<std::string()>& build);
+
     /// @brief Gets the select all query
     /// @param table table name
     /// @param tableFields table fields
@@ -514,11 +565,19 @@ private:
                        const std::function<void()>& callback = {});
 
     Utils::MapWrapperSafe<std::string, TableColumns> m_tableFields;
-    std::deque<std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>> m_statementsCache;
+    std::list<std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>> m_statementsCache;
+    std::unordered_map<std::string, decltype(m_statementsCache)::iterator> m_statementsIndex;
+    size_t m_statementsHits {0};
+    size_t m_statementsMisses {0};
+    size_t m_statementsEvictions {0};
     const std::shared_ptr<SQLiteLegacy::ISQLiteFactory> m_sqliteFactory;
     std::shared_ptr<SQLiteLegacy::IConnection> m_sqliteConnection;
     std::mutex m_stmtMutex;
+    std::unordered_map<std::string, std::string> m_queries;
+    std::mutex m_queriesMutex;
     std::unique_ptr<SQLiteLegacy::ITransaction> m_transaction;
     std::mutex m_maxRowsMutex;
     std::map<std::string, MaxRows> m_maxRows;
+    std::mutex m_syncTableMutex;
+    std::map<std::string, size_t> m_syncTables;
 };
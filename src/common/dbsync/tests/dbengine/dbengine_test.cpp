@@ -488,6 +488,34 @@ TEST_F(DBEngineTest, syncTableRowDataWithoutMetadataShouldThrow)
     EXPECT_THROW(spEngine->syncTableRowData({{"table", "dummy"}, {"data", {}}}, nullptr, false, lock), dbengine_error);
 }
 
+TEST_F(DBEngineTest, ExclusiveSectionUpgradesSharedLocking)
+{
+    std::shared_timed_mutex mutex;
+    SharedLocking lock(mutex);
+
+    {
+        const ExclusiveSection section(lock);
+        EXPECT_FALSE(mutex.try_lock_shared());
+    }
+
+    EXPECT_FALSE(mutex.try_lock());
+    ASSERT_TRUE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+}
+
+TEST_F(DBEngineTest, ExclusiveSectionKeepsExclusiveLocking)
+{
+    std::shared_timed_mutex mutex;
+    ExclusiveLocking lock(mutex);
+
+    {
+        const ExclusiveSection section(lock);
+        EXPECT_FALSE(mutex.try_lock_shared());
+    }
+
+    EXPECT_FALSE(mutex.try_lock_shared());
+}
+
 TEST_F(DBEngineTest, deleteTableRowsDataWithoutMetadataShouldThrow)
 {
     std::unique_ptr<SQLiteDBEngine> spEngine;
@@ -864,6 +864,107 @@ TEST_F(DBSyncTest, syncRowInvalidData)
     EXPECT_NE(0, dbsync_sync_row(nullptr, jsInputNoTable.get(), callbackData));
 }
 
+TEST_F(DBSyncTest, syncRowBulkInsertAndModifiedWithOldData)
+{
+    const auto sql {
+        "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    auto insertionQuery = SyncRowQuery::builder().table("processes");
+    auto updateQuery = SyncRowQuery::builder().table("processes").returnOldData();
+
+    // Enough rows for the set-based sync to be used
+    for (auto pid = 0; pid < 20; ++pid)
+    {
+        insertionQuery.data(nlohmann::json {{"pid", pid}, {"name", "System"}, {"tid", 100}});
+        updateQuery.data(nlohmann::json {{"pid", pid}, {"name", "System"}, {"tid", pid == 7 ? 101 : 100}});
+    }
+
+    updateQuery.data(nlohmann::json {{"pid", 20}, {"name", "Guake"}});
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, testing::_)).Times(20);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":20,"name":"Guake"})"))).Times(1);
+    EXPECT_CALL(
+        wrapper,
+        callbackMock(MODIFIED,
+                     nlohmann::json::parse(R"({"new":{"name":"System","pid":7,"tid":101},"old":{"pid":7,"tid":100}})")))
+        .Times(1);
+
+    ResultCallbackData callbackData {[&wrapper](ReturnTypeCallback type, const nlohmann::json& jsonResult)
+                                     {
+                                         wrapper.callbackMock(type, jsonResult);
+                                     }};
+
+    EXPECT_NO_THROW(dbSync->syncRow(insertionQuery.query(), callbackData)); // Expect 20 insert events
+    EXPECT_NO_THROW(dbSync->syncRow(updateQuery.query(), callbackData));    // Expect an insert and a modified event
+}
+
+TEST_F(DBSyncTest, syncRowBulkIgnoreFields)
+{
+    const auto sql {
+        "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    auto insertionQuery = SyncRowQuery::builder().table("processes");
+    auto updateQuery = SyncRowQuery::builder().table("processes").ignoreColumn("tid");
+
+    for (auto pid = 0; pid < 20; ++pid)
+    {
+        insertionQuery.data(nlohmann::json {{"pid", pid}, {"name", "System"}, {"tid", 100}});
+        updateQuery.data(nlohmann::json {{"pid", pid}, {"name", pid == 3 ? "SystemIsDown" : "System"}, {"tid", 105}});
+    }
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, testing::_)).Times(20);
+    EXPECT_CALL(wrapper,
+                callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":3, "name":"SystemIsDown", "tid":105})")))
+        .Times(1);
+
+    ResultCallbackData callbackData {[&wrapper](ReturnTypeCallback type, const nlohmann::json& jsonResult)
+                                     {
+                                         wrapper.callbackMock(type, jsonResult);
+                                     }};
+
+    EXPECT_NO_THROW(dbSync->syncRow(insertionQuery.query(), callbackData)); // Expect 20 insert events
+    EXPECT_NO_THROW(dbSync->syncRow(updateQuery.query(), callbackData));    // Expect a single modified event
+}
+
+TEST_F(DBSyncTest, syncRowBulkRepeatedPrimaryKey)
+{
+    const auto sql {
+        "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    auto insertionQuery = SyncRowQuery::builder().table("processes");
+
+    for (auto pid = 0; pid < 20; ++pid)
+    {
+        insertionQuery.data(nlohmann::json {{"pid", pid}, {"name", "System"}, {"tid", 100}});
+    }
+
+    // A repeated row is synced against the one before it, as when the rows are synced one by one
+    insertionQuery.data(nlohmann::json {{"pid", 0}, {"name", "System"}, {"tid", 101}});
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, testing::_)).Times(20);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":0, "name":"System", "tid":101})")))
+        .Times(1);
+
+    ResultCallbackData callbackData {[&wrapper](ReturnTypeCallback type, const nlohmann::json& jsonResult)
+                                     {
+                                         wrapper.callbackMock(type, jsonResult);
+                                     }};
+
+    EXPECT_NO_THROW(dbSync->syncRow(insertionQuery.query(), callbackData));
+}
+
 TEST_F(DBSyncTest, selectRowsDataAllNoFilter)
 {
     CallbackMock wrapper;
@@ -2479,3 +2580,71 @@ TEST_F(DBSyncTest, TestUpgrade)
 
     EXPECT_NO_THROW(dbSync->selectRows(selectQuery.query(), selectCallbackData));
 }
+
+TEST_F(DBSyncTest, statementCacheStatsCPP)
+{
+    const auto sql {
+        "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    ResultCallbackData callbackData {[](ReturnTypeCallback, const nlohmann::json&) {}};
+    auto syncQuery {
+        SyncRowQuery::builder().table("processes").data({{"pid", 4}, {"name", "System"}, {"tid", 100}}).build()};
+
+    EXPECT_NO_THROW(dbSync->syncRow(syncQuery.query(), callbackData));
+    const auto before = dbSync->statementCacheStats();
+
+    // The same row again runs the same statements
+    EXPECT_NO_THROW(dbSync->syncRow(syncQuery.query(), callbackData));
+    const auto after = dbSync->statementCacheStats();
+
+    EXPECT_GT(after.at("hits").get<size_t>(), before.at("hits").get<size_t>());
+    EXPECT_EQ(after.at("misses").get<size_t>(), before.at("misses").get<size_t>());
+    EXPECT_EQ(after.at("evictions").get<size_t>(), 0);
+}
+
+TEST_F(DBSyncTest, statementCacheKeepsRecentlyUsedCPP)
+{
+    const auto sql {"CREATE TABLE processes(`pid` BIGINT, `c0` TEXT, `c1` TEXT, `c2` TEXT, `c3` TEXT, `c4` TEXT, "
+                    "`c5` TEXT, `c6` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    std::unique_ptr<DBSync> dbSync;
+
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    ResultCallbackData callbackData {[](ReturnTypeCallback, const nlohmann::json&) {}};
+
+    // Each row has a different set of columns, so it is inserted with a different statement
+    const auto sync {[&dbSync, &callbackData](const int pid)
+                     {
+                         nlohmann::json row {{"pid", pid}};
+
+                         for (auto column = 0; column < 7; ++column)
+                         {
+                             if (0 != (pid & (1 << column)))
+                             {
+                                 row["c" + std::to_string(column)] = "value";
+                             }
+                         }
+
+                         auto syncQuery {SyncRowQuery::builder().table("processes").data(row).build()};
+                         EXPECT_NO_THROW(dbSync->syncRow(syncQuery.query(), callbackData));
+                     }};
+
+    sync(0);
+    const auto before = dbSync->statementCacheStats();
+
+    // Far more statements than the cache holds, the row lookup used by all of them must never be evicted
+    for (auto pid = 1; pid <= 100; ++pid)
+    {
+        sync(pid);
+    }
+
+    const auto after = dbSync->statementCacheStats();
+
+    EXPECT_EQ(after.at("misses").get<size_t>() - before.at("misses").get<size_t>(), 100);
+    EXPECT_GE(after.at("hits").get<size_t>() - before.at("hits").get<size_t>(), 100);
+    EXPECT_GT(after.at("evictions").get<size_t>(), 0);
+    EXPECT_LE(after.at("size").get<size_t>(), 30);
+}
@@ -0,0 +1,117 @@
+#include "dbsync.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::vector<size_t> DEFAULT_SNAPSHOTS = {10000, 100000, 1000000};
+    constexpr size_t BULK_CHUNK_ROWS = 10000;
+    constexpr size_t MODIFIED_EVERY = 100;
+
+    constexpr auto CREATE_TABLE {
+        R"(CREATE TABLE file_entry (
+        path TEXT,
+        size BIGINT,
+        inode BIGINT,
+        mtime BIGINT,
+        perm TEXT,
+        uid TEXT,
+        gid TEXT,
+        hash_sha256 TEXT,
+        PRIMARY KEY (path)) WITHOUT ROWID;)"};
+
+    /// @brief Builds the row of a file, as a FIM scan reports it
+    nlohmann::json MakeRow(size_t index, size_t version)
+    {
+        return {{"path", "/usr/lib/benchmark/file_" + std::to_string(index)},
+                {"size", index * 512},
+                {"inode", index + 1000000},
+                {"mtime", 1700000000 + version},
+                {"perm", "rw-r--r--"},
+                {"uid", "0"},
+                {"gid", "0"},
+                {"hash_sha256", std::to_string(index) + ":" + std::to_string(version)}};
+    }
+
+    /// @brief Syncs a snapshot in chunks of rows, and returns the rows synced per second
+    /// @param dbSync DBSync instance
+    /// @param rows Rows in the snapshot
+    /// @param chunkRows Rows in each sync, one to sync them one by one
+    /// @param version Version of the snapshot: rows multiple of MODIFIED_EVERY change between versions
+    /// @param events Callback events received
+    double Sync(DBSync& dbSync, size_t rows, size_t chunkRows, size_t version, size_t& events)
+    {
+        ResultCallbackData callback {[&events](ReturnTypeCallback, const nlohmann::json&) { ++events; }};
+        double seconds {0};
+
+        for (size_t first = 0; first < rows; first += chunkRows)
+        {
+            nlohmann::json input {{"table", "file_entry"}, {"data", nlohmann::json::array()}};
+
+            for (size_t i = first; i < std::min(rows, first + chunkRows); ++i)
+            {
+                input["data"].push_back(MakeRow(i, i % MODIFIED_EVERY == 0 ? version : 0));
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            dbSync.syncRow(input, callback);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        return static_cast<double>(rows) / seconds;
+    }
+
+    /// @brief Syncs the first snapshot, the same snapshot again, and one with a row in every MODIFIED_EVERY changed
+    void Run(const char* label, const std::filesystem::path& path, size_t rows, size_t chunkRows)
+    {
+        std::filesystem::remove(path);
+
+        size_t events {0};
+        DBSync dbSync(HostType::AGENT, DbEngineType::SQLITE3, path.string(), CREATE_TABLE);
+
+        const auto inserted = Sync(dbSync, rows, chunkRows, 0, events);
+        const auto unchanged = Sync(dbSync, rows, chunkRows, 0, events);
+        const auto modified = Sync(dbSync, rows, chunkRows, 1, events);
+
+        std::printf("%-8s %8zu rows %12.0f rows/s inserted %12.0f rows/s unchanged %12.0f rows/s modified "
+                    "%8zu events\n",
+                    label,
+                    rows,
+                    inserted,
+                    unchanged,
+                    modified,
+                    events);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto snapshots = DEFAULT_SNAPSHOTS;
+
+    if (argc > 1)
+    {
+        snapshots.clear();
+
+        for (int i = 1; i < argc; ++i)
+        {
+            snapshots.push_back(std::stoul(argv[i]));
+        }
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "benchmark_dbsync.db";
+
+    for (const auto rows : snapshots)
+    {
+        Run("per-row", path, rows, 1);
+        Run("bulk", path, rows, BULK_CHUNK_ROWS);
+    }
+
+    DBSync::teardown();
+    std::filesystem::remove(path);
+    return 0;
+}
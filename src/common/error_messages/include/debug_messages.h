@@ -188,6 +188,11 @@
 #define FIM_WILDCARDS_ADD_REGISTER          "(6373): Expanding entry '%s' to '%s' to monitor FIM events."
 #define FIM_WILDCARDS_REGISTERS_FINALIZE    "(6374): Wildcard configuration successfully completed."
 #define FIM_REG_VAL_INVALID_TYPE            "(6375): Invalid registry value type for report_changes. Registry key: '%s'. Registry value: '%s'."
+#define FIM_SCAN_THREADS                    "(6376): Scanning the monitored directories with %d threads."
+#define FIM_DIFF_BINARY_CONTENT             "(6377): Binary content, don't compute differences for '%s'"
+#define FIM_FANOTIFY_MARK                   "(6378): Monitoring the filesystem of '%s' with fanotify."
+#define FIM_FANOTIFY_MARK_FAILED            "(6379): Unable to add fanotify mark for '%s' (%d) '%s'. Its directories will be monitored with inotify."
+#define FIM_NUM_FANOTIFY_MARKS              "(6380): Filesystems monitored with real-time fanotify engine: %u"
 
 /* Modules messages */
 #define WM_UPGRADE_RESULT_AGENT_INFO         "(8151): Agent Information obtained: '%s'"
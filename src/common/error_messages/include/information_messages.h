@@ -62,6 +62,7 @@
 #define FIM_NO_DIFF_REGISTRY                "(6044): Option nodiff enabled for %s '%s'."
 #define FIM_AUDIT_CREATED_RULE_FILE         "(6045): Created audit rules file, due to audit immutable mode rules will be loaded in the next reboot."
 #define FIM_AUDIT_QUEUE_SIZE                "(6046): Internal audit queue size set to '%d'."
+#define FIM_SCAN_HASHES_SUMMARY             "(6047): Hashed %llu files (%llu bytes), reused the stored hashes of %llu unchanged files (%llu bytes)."
 
 /* wazuh-logtest information messages */
 #define LOGTEST_INITIALIZED                 "(7200): Logtest started"
@@ -403,6 +403,16 @@ int w_compress_gzfile(const char *filesrc, const char *filedst);
 int w_uncompress_gzfile(const char *gzfilesrc, const char *gzfiledst);
 
 
+/**
+ * @brief Read the uncompressed content of a GZIP file into memory.
+ *
+ * @param gzfilesrc GZIP file path.
+ * @param size Size of the uncompressed content.
+ * @return Null-terminated content, which may also contain null bytes. NULL on error.
+ */
+char *w_get_gzfile_content(const char *gzfilesrc, size_t *size);
+
+
 /**
  * @brief Check if a file is ASSCI or UTF8.
  *
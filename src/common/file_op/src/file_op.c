@@ -2291,6 +2291,64 @@ int w_uncompress_gzfile(const char *gzfilesrc, const char *gzfiledst) {
 }
 
 
+char *w_get_gzfile_content(const char *gzfilesrc, size_t *size) {
+    gzFile gz_fd;
+    char *content;
+    size_t capacity = OS_SIZE_8192;
+    size_t length = 0;
+    int len;
+    int err;
+    struct stat statbuf;
+
+#ifdef WIN32
+    /* Win32 does not have lstat */
+    if (stat(gzfilesrc, &statbuf) < 0)
+#else
+    if (lstat(gzfilesrc, &statbuf) < 0)
+#endif
+    {
+        return NULL;
+    }
+
+    /* Open compressed file */
+    gz_fd = gzopen(gzfilesrc, "rb");
+    if (!gz_fd) {
+        LogError("in w_get_gzfile_content(): gzopen error %s (%d):'%s'",
+                gzfilesrc,
+                errno,
+                strerror(errno));
+        return NULL;
+    }
+
+    /* Keep room for the terminating null byte */
+    os_malloc(capacity + 1, content);
+
+    while (len = gzread(gz_fd, content + length, (unsigned int)(capacity - length)), len > 0) {
+        length += len;
+
+        if (length == capacity) {
+            capacity *= 2;
+            os_realloc(content, capacity + 1, content);
+        }
+    }
+
+    if (len < 0) {
+        const char * gzerr = gzerror(gz_fd, &err);
+        LogError("in w_get_gzfile_content(): gzread error: '%s'", gzerr);
+        gzclose(gz_fd);
+        os_free(content);
+        return NULL;
+    }
+
+    gzclose(gz_fd);
+
+    content[length] = '\0';
+    *size = length;
+
+    return content;
+}
+
+
 int is_ascii_utf8(const char * file, unsigned int max_lines_ascii, unsigned int max_chars_utf8) {
     int is_ascii = 1;
     int retval = 0;
@@ -541,6 +541,108 @@ void test_w_uncompress_gzfile_success(void **state) {
     assert_int_equal(ret, 0);
 }
 
+// w_get_gzfile_content
+
+void test_w_get_gzfile_content_lstat_fail(void **state) {
+    struct stat buf = { .st_mode = S_IFREG };
+    char *srcfile = "testfile.gz";
+    size_t size = 0;
+
+    expect_string(__wrap_lstat, filename, srcfile);
+    will_return(__wrap_lstat, &buf);
+    will_return(__wrap_lstat, -1);
+
+    assert_null(w_get_gzfile_content(srcfile, &size));
+}
+
+void test_w_get_gzfile_content_gzopen_fail(void **state) {
+    struct stat buf = { .st_mode = S_IFREG };
+    char *srcfile = "testfile.gz";
+    size_t size = 0;
+
+    expect_string(__wrap_lstat, filename, srcfile);
+    will_return(__wrap_lstat, &buf);
+    will_return(__wrap_lstat, 0);
+
+    expect_string(__wrap_gzopen, path, srcfile);
+    expect_string(__wrap_gzopen, mode, "rb");
+    will_return(__wrap_gzopen, NULL);
+
+    expect_string(__wrap__merror, formatted_msg, "in w_get_gzfile_content(): gzopen error testfile.gz (0):'Success'");
+
+    assert_null(w_get_gzfile_content(srcfile, &size));
+}
+
+void test_w_get_gzfile_content_read_fail(void **state) {
+    struct stat buf = { .st_mode = S_IFREG };
+    char *srcfile = "testfile.gz";
+    size_t size = 0;
+
+    expect_string(__wrap_lstat, filename, srcfile);
+    will_return(__wrap_lstat, &buf);
+    will_return(__wrap_lstat, 0);
+
+    expect_string(__wrap_gzopen, path, srcfile);
+    expect_string(__wrap_gzopen, mode, "rb");
+    will_return(__wrap_gzopen, 2);
+
+    expect_value(__wrap_gzread, gz_fd, 2);
+    will_return(__wrap_gzread, -1);
+
+    expect_value(__wrap_gzerror, file, 2);
+    will_return(__wrap_gzerror, Z_DATA_ERROR);
+    will_return(__wrap_gzerror, "Test error");
+
+    expect_string(__wrap__merror, formatted_msg, "in w_get_gzfile_content(): gzread error: 'Test error'");
+
+    expect_value(__wrap_gzclose, file, 2);
+    will_return(__wrap_gzclose, 1);
+
+    assert_null(w_get_gzfile_content(srcfile, &size));
+}
+
+void test_w_get_gzfile_content_success(void **state) {
+    struct stat buf = { .st_mode = S_IFREG };
+    char *srcfile = "testfile.gz";
+    char buffer[OS_SIZE_8192];
+    char *content;
+    size_t size = 0;
+
+    memset(buffer, 'a', sizeof(buffer));
+
+    expect_string(__wrap_lstat, filename, srcfile);
+    will_return(__wrap_lstat, &buf);
+    will_return(__wrap_lstat, 0);
+
+    expect_string(__wrap_gzopen, path, srcfile);
+    expect_string(__wrap_gzopen, mode, "rb");
+    will_return(__wrap_gzopen, 2);
+
+    // The first read fills the buffer, so it has to grow for the second one
+    expect_value(__wrap_gzread, gz_fd, 2);
+    will_return(__wrap_gzread, OS_SIZE_8192);
+    will_return(__wrap_gzread, buffer);
+
+    expect_value(__wrap_gzread, gz_fd, 2);
+    will_return(__wrap_gzread, 10);
+    will_return(__wrap_gzread, "teststring");
+
+    expect_value(__wrap_gzread, gz_fd, 2);
+    will_return(__wrap_gzread, 0);
+
+    expect_value(__wrap_gzclose, file, 2);
+    will_return(__wrap_gzclose, 1);
+
+    content = w_get_gzfile_content(srcfile, &size);
+
+    assert_non_null(content);
+    assert_int_equal(size, OS_SIZE_8192 + 10);
+    assert_memory_equal(content, buffer, OS_SIZE_8192);
+    assert_string_equal(content + OS_SIZE_8192, "teststring");
+
+    free(content);
+}
+
 // w_homedir
 
 void test_w_homedir_first_attempt(void **state)
@@ -948,6 +1050,11 @@ int main(void) {
         cmocka_unit_test(test_w_uncompress_gzfile_first_read_fail),
         cmocka_unit_test(test_w_uncompress_gzfile_first_read_success),
         cmocka_unit_test(test_w_uncompress_gzfile_success),
+        // w_get_gzfile_content
+        cmocka_unit_test(test_w_get_gzfile_content_lstat_fail),
+        cmocka_unit_test(test_w_get_gzfile_content_gzopen_fail),
+        cmocka_unit_test(test_w_get_gzfile_content_read_fail),
+        cmocka_unit_test(test_w_get_gzfile_content_success),
         // w_homedir
         cmocka_unit_test(test_w_homedir_first_attempt),
         cmocka_unit_test(test_w_homedir_second_attempt),
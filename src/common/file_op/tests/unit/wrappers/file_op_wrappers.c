@@ -12,6 +12,7 @@
 #include <stdarg.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include "file_op.h"
@@ -99,6 +100,28 @@ void expect_w_uncompress_gzfile(const char * gzfilesrc, const char * gzfiledst,
     will_return(__wrap_w_uncompress_gzfile, ret);
 }
 
+char *__wrap_w_get_gzfile_content(const char *gzfilesrc, size_t *size) {
+    char *content = NULL;
+    const char *mock_content;
+
+    check_expected(gzfilesrc);
+    mock_content = mock_type(const char *);
+    *size = mock_type(size_t);
+
+    if (mock_content != NULL) {
+        content = calloc(*size + 1, sizeof(char));
+        memcpy(content, mock_content, *size);
+    }
+
+    return content;
+}
+
+void expect_w_get_gzfile_content(const char *gzfilesrc, const char *content, size_t size) {
+    expect_string(__wrap_w_get_gzfile_content, gzfilesrc, gzfilesrc);
+    will_return(__wrap_w_get_gzfile_content, content);
+    will_return(__wrap_w_get_gzfile_content, size);
+}
+
 FILE *__real_wfopen(const char * path, const char * mode);
 FILE *__wrap_wfopen(const char * path, const char * mode) {
     if(test_mode) {
@@ -46,6 +46,9 @@ int __wrap_w_compress_gzfile(const char *filesrc, const char *filedst);
 int __wrap_w_uncompress_gzfile(const char *gzfilesrc, const char *gzfiledst);
 void expect_w_uncompress_gzfile(const char * gzfilesrc, const char * gzfiledst, FILE *ret);
 
+char *__wrap_w_get_gzfile_content(const char *gzfilesrc, size_t *size);
+void expect_w_get_gzfile_content(const char *gzfilesrc, const char *content, size_t size);
+
 FILE *__wrap_wfopen(const char * __filename, const char * __modes);
 void expect_wfopen(const char * __filename, const char * __modes, FILE *ret);
 
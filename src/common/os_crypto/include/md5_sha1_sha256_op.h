@@ -15,6 +15,35 @@
 #include "../sha1/sha1_op.h"
 #include "../sha256/sha256_op.h"
 
+/* Digests calculated by OS_Hash_File */
+#define OS_HASH_MD5     0x1
+#define OS_HASH_SHA1    0x2
+#define OS_HASH_SHA256  0x4
+#define OS_HASH_ALL     (OS_HASH_MD5 | OS_HASH_SHA1 | OS_HASH_SHA256)
+
+/**
+ * @brief Calculate a set of digests of a file in a single read of its content
+ *
+ * The digest contexts and the read buffer are allocated once per thread and reused for every file.
+ *
+ * @param fname Path of the file
+ * @param prefilter_cmd Command whose output is hashed instead of the file, NULL to read the file
+ * @param digests Digests to calculate, a combination of OS_HASH_MD5, OS_HASH_SHA1 and OS_HASH_SHA256
+ * @param md5output MD5 of the file, empty if not calculated. Can be NULL if not in digests
+ * @param sha1output SHA-1 of the file, empty if not calculated. Can be NULL if not in digests
+ * @param sha256output SHA-256 of the file, empty if not calculated. Can be NULL if not in digests
+ * @param mode OS_BINARY or OS_TEXT
+ * @param max_size Maximum size of the file in bytes, 0 for no limit
+ * @return 0 on success, -1 on error or if the file reaches max_size
+ */
+int OS_Hash_File(const char *fname,
+                 char **prefilter_cmd,
+                 int digests,
+                 os_md5 md5output,
+                 os_sha1 sha1output,
+                 os_sha256 sha256output,
+                 int mode,
+                 size_t max_size) __attribute((nonnull(1)));
 
 int OS_MD5_SHA1_SHA256_File(const char *fname,
                             char **prefilter_cmd,
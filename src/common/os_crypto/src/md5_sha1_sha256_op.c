@@ -18,31 +18,105 @@
 #include "headers/defs.h"
 
 
-int OS_MD5_SHA1_SHA256_File(const char *fname,
-                            char **prefilter_cmd,
-                            os_md5 md5output,
-                            os_sha1 sha1output,
-                            os_sha256 sha256output,
-                            int mode,
-                            size_t max_size)
+/* Size of the reads done when hashing a file */
+#define OS_HASH_BUFFER_SIZE (256 * 1024)
+
+/* Digest contexts and read buffer reused by the files hashed in a thread */
+typedef struct os_hash_state_t {
+    EVP_MD_CTX *md5_ctx;
+    EVP_MD_CTX *sha1_ctx;
+    EVP_MD_CTX *sha256_ctx;
+    unsigned char *buffer;
+} os_hash_state_t;
+
+static pthread_key_t os_hash_key;
+static pthread_once_t os_hash_once = PTHREAD_ONCE_INIT;
+
+// Callback
+static void os_hash_state_free(void *data) {
+    os_hash_state_t *state = data;
+
+    EVP_MD_CTX_free(state->md5_ctx);
+    EVP_MD_CTX_free(state->sha1_ctx);
+    EVP_MD_CTX_free(state->sha256_ctx);
+    os_free(state->buffer);
+    os_free(state);
+}
+
+// Callback
+static void os_hash_key_create(void) {
+    int error = pthread_key_create(&os_hash_key, os_hash_state_free);
+
+    if (error) {
+        LogCritical("At pthread_key_create(): %s", strerror(error));
+    }
+}
+
+/* Returns the state of the calling thread, which is created on its first call */
+static os_hash_state_t *os_hash_state_get(void) {
+    os_hash_state_t *state;
+
+    pthread_once(&os_hash_once, os_hash_key_create);
+
+    if (state = pthread_getspecific(os_hash_key), state == NULL) {
+        os_calloc(1, sizeof(os_hash_state_t), state);
+        os_malloc(OS_HASH_BUFFER_SIZE, state->buffer);
+        state->md5_ctx = EVP_MD_CTX_new();
+        state->sha1_ctx = EVP_MD_CTX_new();
+        state->sha256_ctx = EVP_MD_CTX_new();
+        pthread_setspecific(os_hash_key, state);
+    }
+
+    return state;
+}
+
+static void os_hash_hex(char *output, const unsigned char *digest, size_t length) {
+    size_t n;
+
+    for (n = 0; n < length; n++) {
+        snprintf(output, 3, "%02x", digest[n]);
+        output += 2;
+    }
+}
+
+int OS_Hash_File(const char *fname,
+                 char **prefilter_cmd,
+                 int digests,
+                 os_md5 md5output,
+                 os_sha1 sha1output,
+                 os_sha256 sha256output,
+                 int mode,
+                 size_t max_size)
 {
     size_t n, read = 0;
     FILE *fp;
-    wfd_t *wfd;
-    unsigned char buf[OS_BUFFER_SIZE + 2];
+    wfd_t *wfd = NULL;
     unsigned char sha1_digest[SHA_DIGEST_LENGTH];
     unsigned char md5_digest[16];
     unsigned char sha256_digest[SHA256_DIGEST_LENGTH];
-
-    EVP_MD_CTX *sha1_ctx = NULL;
-    EVP_MD_CTX *md5_ctx = NULL;
-    EVP_MD_CTX *sha256_ctx = NULL;
+    os_hash_state_t *state;
 
     /* Clear the memory */
-    md5output[0] = '\0';
-    sha1output[0] = '\0';
-    sha256output[0] = '\0';
-    buf[OS_BUFFER_SIZE + 1] = '\0';
+    if (md5output != NULL) {
+        md5output[0] = '\0';
+    }
+    if (sha1output != NULL) {
+        sha1output[0] = '\0';
+    }
+    if (sha256output != NULL) {
+        sha256output[0] = '\0';
+    }
+
+    /* Only calculate the digests that have somewhere to be written */
+    if (md5output == NULL) {
+        digests &= ~OS_HASH_MD5;
+    }
+    if (sha1output == NULL) {
+        digests &= ~OS_HASH_SHA1;
+    }
+    if (sha256output == NULL) {
+        digests &= ~OS_HASH_SHA256;
+    }
 
     /* Use prefilter_cmd if set */
     if (prefilter_cmd == NULL) {
@@ -50,6 +124,11 @@ int OS_MD5_SHA1_SHA256_File(const char *fname,
         if (!fp) {
             return (-1);
         }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+        /* The file is read once from start to end, let the kernel read ahead more aggressively */
+        posix_fadvise(fileno(fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
     } else {
         char **command = NULL;
         int cnt = 0;
@@ -73,16 +152,21 @@ int OS_MD5_SHA1_SHA256_File(const char *fname,
         fp = wfd->file_out;
     }
 
-    /* Initialize all hashes */
-    sha1_ctx = EVP_MD_CTX_new();
-    md5_ctx = EVP_MD_CTX_new();
-    sha256_ctx = EVP_MD_CTX_new();
-    EVP_DigestInit(sha1_ctx, EVP_sha1());
-    EVP_DigestInit(md5_ctx, EVP_md5());
-    EVP_DigestInit(sha256_ctx, EVP_sha256());
+    state = os_hash_state_get();
+
+    /* Reset the contexts of the selected digests */
+    if (digests & OS_HASH_MD5) {
+        EVP_DigestInit_ex(state->md5_ctx, EVP_md5(), NULL);
+    }
+    if (digests & OS_HASH_SHA1) {
+        EVP_DigestInit_ex(state->sha1_ctx, EVP_sha1(), NULL);
+    }
+    if (digests & OS_HASH_SHA256) {
+        EVP_DigestInit_ex(state->sha256_ctx, EVP_sha256(), NULL);
+    }
 
-    /* Update for each one */
-    while ((n = fread(buf, 1, OS_BUFFER_SIZE, fp)) > 0) {
+    /* Update each digest with every block read */
+    while ((n = fread(state->buffer, 1, OS_HASH_BUFFER_SIZE, fp)) > 0) {
 
         if (max_size > 0) {
             read = read + n;
@@ -93,44 +177,33 @@ int OS_MD5_SHA1_SHA256_File(const char *fname,
                 } else {
                     wpclose(wfd);
                 }
-                EVP_MD_CTX_free(sha1_ctx);
-                EVP_MD_CTX_free(md5_ctx);
-                EVP_MD_CTX_free(sha256_ctx);
                 return (-1);
             }
         }
 
-        buf[n] = '\0';
-
-        EVP_DigestUpdate(sha1_ctx, buf, n);
-        EVP_DigestUpdate(md5_ctx, buf, n);
-        EVP_DigestUpdate(sha256_ctx, buf, n);
+        if (digests & OS_HASH_MD5) {
+            EVP_DigestUpdate(state->md5_ctx, state->buffer, n);
+        }
+        if (digests & OS_HASH_SHA1) {
+            EVP_DigestUpdate(state->sha1_ctx, state->buffer, n);
+        }
+        if (digests & OS_HASH_SHA256) {
+            EVP_DigestUpdate(state->sha256_ctx, state->buffer, n);
+        }
     }
 
-    EVP_DigestFinal(sha1_ctx, sha1_digest, NULL);
-    EVP_DigestFinal(md5_ctx, md5_digest, NULL);
-    EVP_DigestFinal(sha256_ctx, sha256_digest, NULL);
-
-    EVP_MD_CTX_free(sha1_ctx);
-    EVP_MD_CTX_free(md5_ctx);
-    EVP_MD_CTX_free(sha256_ctx);
-
-    /* Set output for MD5 */
-    for (n = 0; n < 16; n++) {
-        snprintf(md5output, 3, "%02x", md5_digest[n]);
-        md5output += 2;
+    /* Set the output of each digest */
+    if (digests & OS_HASH_MD5) {
+        EVP_DigestFinal_ex(state->md5_ctx, md5_digest, NULL);
+        os_hash_hex(md5output, md5_digest, sizeof(md5_digest));
     }
-
-    /* Set output for SHA-1 */
-    for (n = 0; n < SHA_DIGEST_LENGTH; n++) {
-        snprintf(sha1output, 3, "%02x", sha1_digest[n]);
-        sha1output += 2;
+    if (digests & OS_HASH_SHA1) {
+        EVP_DigestFinal_ex(state->sha1_ctx, sha1_digest, NULL);
+        os_hash_hex(sha1output, sha1_digest, sizeof(sha1_digest));
     }
-
-    /* Set output for SHA-256 */
-    for (n = 0; n < SHA256_DIGEST_LENGTH; n++) {
-        snprintf(sha256output, 3, "%02x", sha256_digest[n]);
-        sha256output += 2;
+    if (digests & OS_HASH_SHA256) {
+        EVP_DigestFinal_ex(state->sha256_ctx, sha256_digest, NULL);
+        os_hash_hex(sha256output, sha256_digest, sizeof(sha256_digest));
     }
 
     /* Close it */
@@ -142,3 +215,14 @@ int OS_MD5_SHA1_SHA256_File(const char *fname,
 
     return (0);
 }
+
+int OS_MD5_SHA1_SHA256_File(const char *fname,
+                            char **prefilter_cmd,
+                            os_md5 md5output,
+                            os_sha1 sha1output,
+                            os_sha256 sha256output,
+                            int mode,
+                            size_t max_size)
+{
+    return OS_Hash_File(fname, prefilter_cmd, OS_HASH_ALL, md5output, sha1output, sha256output, mode, max_size);
+}
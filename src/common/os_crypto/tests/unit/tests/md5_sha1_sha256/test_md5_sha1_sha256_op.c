@@ -20,6 +20,22 @@
 #include "../../wrappers/libc/stdio_wrappers.h"
 #include "../../wrappers/wazuh/shared/file_op_wrappers.h"
 
+/* redefinitons/wrapping */
+
+int __wrap_posix_fadvise(int fd, off_t offset, off_t len, int advice) {
+    check_expected(fd);
+    check_expected(advice);
+    return 0;
+}
+
+static void expect_hash_file_open(const char *file_name, FILE *fp) {
+    expect_wfopen(file_name, "r", fp);
+    expect_value(__wrap_fileno, __stream, fp);
+    will_return(__wrap_fileno, 3);
+    expect_value(__wrap_posix_fadvise, fd, 3);
+    expect_value(__wrap_posix_fadvise, advice, POSIX_FADV_SEQUENTIAL);
+}
+
 static int setup_group(void ** state) {
     test_mode = 1;
     return 0;
@@ -43,7 +59,7 @@ void test_md5_sha1_sha256_file(void **state)
     char file_name[256] = "/tmp/tmp_file-XXXXXX";
 
     FILE * fp = 0x1;
-    expect_wfopen(file_name, "r", fp);
+    expect_hash_file_open(file_name, fp);
     expect_fread(string, strlen(string));
     expect_fread(string, 0);
     expect_fclose(fp, 0);
@@ -56,6 +72,48 @@ void test_md5_sha1_sha256_file(void **state)
 
     assert_string_equal(md5buffer, string_md5);
     assert_string_equal(sha1buffer, string_sha1);
+    assert_string_equal(sha256buffer, string_sha256);
+}
+
+void test_hash_file_sha256_only(void **state)
+{
+    char *string = "teststring";
+    const char *string_sha256 = "3c8727e019a42b444667a587b6001251becadabbb36bfed8087a92c18882d111";
+    char file_name[256] = "/tmp/tmp_file-XXXXXX";
+    FILE * fp = 0x1;
+    os_md5 md5buffer = "previous";
+    os_sha256 sha256buffer;
+
+    expect_hash_file_open(file_name, fp);
+    expect_fread(string, strlen(string));
+    expect_fread(string, 0);
+    expect_fclose(fp, 0);
+
+    assert_int_equal(OS_Hash_File(file_name, NULL, OS_HASH_SHA256, md5buffer, NULL, sha256buffer, OS_TEXT, 20), 0);
+
+    assert_string_equal(md5buffer, "");
+    assert_string_equal(sha256buffer, string_sha256);
+}
+
+void test_hash_file_reuses_state(void **state)
+{
+    char *string = "teststring";
+    const char *string_md5 = "d67c5cbf5b01c9f91932e3b8def5e5f8";
+    char *command [] = {"cat", NULL};
+    wfd_t wfd = { NULL, NULL, 0 };
+    os_md5 md5buffer;
+    int i;
+
+    // The digests of a file don't depend on the files hashed before in the same thread
+    for (i = 0; i < 2; i++) {
+        will_return(__wrap_wpopenv, &wfd);
+        expect_fread(string, strlen(string));
+        expect_fread(string, 0);
+        will_return(__wrap_wpclose, 0);
+
+        assert_int_equal(OS_Hash_File("file_name", command, OS_HASH_MD5, md5buffer, NULL, NULL, OS_TEXT, 20), 0);
+        assert_string_equal(md5buffer, string_md5);
+    }
 }
 
 void test_md5_sha1_sha256_cmd_file(void **state)
@@ -149,7 +207,7 @@ void test_md5_sha1_sha256_file_max_size_fail(void **state)
     char file_name[256] = "/tmp/tmp_file-XXXXXX";
 
     FILE * fp = 0x1;
-    expect_wfopen(file_name, "r", fp);
+    expect_hash_file_open(file_name, fp);
     expect_fread(string, strlen(string));
     expect_fclose(fp, 0);
 
@@ -170,6 +228,8 @@ int main(void) {
         cmocka_unit_test(test_md5_sha1_sha256_file_fail),
         cmocka_unit_test(test_md5_sha1_sha256_cmd_file_max_size_fail),
         cmocka_unit_test(test_md5_sha1_sha256_file_max_size_fail),
+        cmocka_unit_test(test_hash_file_sha256_only),
+        cmocka_unit_test(test_hash_file_reuses_state),
     };
     return cmocka_run_group_tests(tests, setup_group, teardown_group);
 }
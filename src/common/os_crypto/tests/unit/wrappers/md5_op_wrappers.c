@@ -71,3 +71,38 @@ void expect_OS_MD5_SHA1_SHA256_File_call(char *file,
     expect_value(__wrap_OS_MD5_SHA1_SHA256_File, max_size, max_size);
     will_return(__wrap_OS_MD5_SHA1_SHA256_File, ret);
 }
+
+int __wrap_OS_Hash_File(const char *fname, const char **prefilter_cmd, int digests, os_md5 md5output,
+                        os_sha1 sha1output, os_sha256 sha256output, int mode, size_t max_size) {
+    check_expected(fname);
+    check_expected_ptr(prefilter_cmd);
+    check_expected(digests);
+    check_expected(md5output);
+    check_expected(sha1output);
+    check_expected(sha256output);
+    check_expected(mode);
+    check_expected(max_size);
+
+    return mock();
+}
+
+void expect_OS_Hash_File_call(char *file,
+                              char **prefilter_cmd,
+                              int digests,
+                              char *md5,
+                              char *sha1,
+                              char *sha256,
+                              int mode,
+                              int max_size,
+                              int ret) {
+
+    expect_string(__wrap_OS_Hash_File, fname, file);
+    expect_value(__wrap_OS_Hash_File, prefilter_cmd, prefilter_cmd);
+    expect_value(__wrap_OS_Hash_File, digests, digests);
+    expect_string(__wrap_OS_Hash_File, md5output, md5);
+    expect_string(__wrap_OS_Hash_File, sha1output, sha1);
+    expect_string(__wrap_OS_Hash_File, sha256output, sha256);
+    expect_value(__wrap_OS_Hash_File, mode, mode);
+    expect_value(__wrap_OS_Hash_File, max_size, max_size);
+    will_return(__wrap_OS_Hash_File, ret);
+}
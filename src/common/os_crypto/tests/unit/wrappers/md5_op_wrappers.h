@@ -36,4 +36,20 @@ void expect_OS_MD5_SHA1_SHA256_File_call(char *file,
                                          int mode,
                                          int max_size,
                                          int ret);
+
+int __wrap_OS_Hash_File(const char *fname, const char **prefilter_cmd, int digests, os_md5 md5output,
+                        os_sha1 sha1output, os_sha256 sha256output, int mode, size_t max_size);
+
+/**
+ * @brief This function loads the expect and will return of the function OS_Hash_File
+ */
+void expect_OS_Hash_File_call(char *file,
+                              char **prefilter_cmd,
+                              int digests,
+                              char *md5,
+                              char *sha1,
+                              char *sha256,
+                              int mode,
+                              int max_size,
+                              int ret);
 #endif
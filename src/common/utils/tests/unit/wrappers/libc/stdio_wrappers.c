@@ -205,6 +205,20 @@ int __wrap_fileno (FILE *__stream) {
     return mock();
 }
 
+extern int __real_ferror(FILE *__stream);
+int __wrap_ferror(FILE *__stream) {
+    if (test_mode) {
+        check_expected(__stream);
+        return mock();
+    }
+    return __real_ferror(__stream);
+}
+
+void expect_ferror(FILE *__stream, int ret) {
+    expect_value(__wrap_ferror, __stream, __stream);
+    will_return(__wrap_ferror, ret);
+}
+
 extern int __real_fgetc(FILE * stream);
 int __wrap_fgetc(FILE * stream) {
     if(test_mode) {
@@ -51,6 +51,9 @@ void __wrap_clearerr (FILE *__stream);
 
 int __wrap_fileno (FILE *__stream);
 
+int __wrap_ferror(FILE *__stream);
+void expect_ferror(FILE *__stream, int ret);
+
 int __wrap_fgetc(FILE * stream);
 
 int __wrap__fseeki64(FILE *stream, long offset, int whence);
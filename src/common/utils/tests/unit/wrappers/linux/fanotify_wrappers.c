@@ -0,0 +1,50 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "fanotify_wrappers.h"
+#include <stddef.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+
+int __wrap_fanotify_init(unsigned int flags, __attribute__((unused)) unsigned int event_f_flags) {
+    check_expected(flags);
+    return mock();
+}
+
+int __wrap_fanotify_mark(__attribute__((unused)) int fanotify_fd,
+                         unsigned int flags,
+                         __attribute__((unused)) uint64_t mask,
+                         __attribute__((unused)) int dirfd,
+                         const char *pathname) {
+    check_expected(flags);
+    check_expected(pathname);
+    return mock();
+}
+
+int __wrap_open_by_handle_at(int mount_fd,
+                             __attribute__((unused)) struct file_handle *handle,
+                             __attribute__((unused)) int flags) {
+    check_expected(mount_fd);
+    return mock();
+}
+
+int __wrap_statfs(const char *path, struct statfs *buf) {
+    struct statfs *mock_buf;
+    check_expected(path);
+
+    mock_buf = mock_type(struct statfs *);
+    if (mock_buf != NULL) {
+        memcpy(buf, mock_buf, sizeof(struct statfs));
+    }
+    return mock();
+}
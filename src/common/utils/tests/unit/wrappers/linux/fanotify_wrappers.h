@@ -0,0 +1,30 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+
+#ifndef FANOTIFY_WRAPPERS_H
+#define FANOTIFY_WRAPPERS_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/statfs.h>
+
+int __wrap_fanotify_init(unsigned int flags, unsigned int event_f_flags);
+
+int __wrap_fanotify_mark(int fanotify_fd, unsigned int flags, uint64_t mask, int dirfd, const char *pathname);
+
+int __wrap_open_by_handle_at(int mount_fd, struct file_handle *handle, int flags);
+
+int __wrap_statfs(const char *path, struct statfs *buf);
+
+#endif
@@ -0,0 +1,236 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "syscheck.h"
+#include "time_op.h"
+#include "file_op.h"
+#include "md5_op.h"
+
+#define DEFAULT_FILES 10000
+#define LINES_PER_FILE 200
+#define CHANGED_LINES 3
+#define MAX_DIFF_LENGTH (OS_MAXSTR - OS_SK_HEADER - 1)
+
+/* Writes the stored copy (gzipped, as report_changes keeps it) and the changed file, unless a previous run left them */
+static int make_burst(const char *root, size_t files) {
+    char ready[PATH_MAX];
+    char path[PATH_MAX];
+    char stored[PATH_MAX];
+    unsigned int seed = 1;
+    size_t file;
+    size_t line;
+    FILE *old_fp;
+    FILE *new_fp;
+
+    snprintf(ready, sizeof(ready), "%s.%zu", root, files);
+
+    if (access(ready, F_OK) == 0) {
+        return 0;
+    }
+
+    snprintf(path, sizeof(path), "%s/tmp", root);
+
+    if (mkdir_ex(path) != 0) {
+        return -1;
+    }
+
+    printf("Writing %zu changed files under %s\n", files, root);
+
+    for (file = 0; file < files; file++) {
+        snprintf(stored, sizeof(stored), "%s/f%05zu.old", root, file);
+        snprintf(path, sizeof(path), "%s/f%05zu", root, file);
+
+        if (old_fp = fopen(stored, "w"), old_fp == NULL) {
+            return -1;
+        }
+
+        if (new_fp = fopen(path, "w"), new_fp == NULL) {
+            fclose(old_fp);
+            return -1;
+        }
+
+        // A configuration file where a deployment changes a few settings
+        for (line = 0; line < LINES_PER_FILE; line++) {
+            fprintf(old_fp, "setting_%zu = %u\n", line, rand_r(&seed) % 1000);
+
+            if (line % (LINES_PER_FILE / CHANGED_LINES) == file % 7) {
+                fprintf(new_fp, "setting_%zu = %u\n", line, rand_r(&seed) % 1000 + 1000);
+            } else {
+                fprintf(new_fp, "setting_%zu = %u\n", line, rand_r(&seed) % 1000);
+            }
+        }
+
+        fclose(old_fp);
+        fclose(new_fp);
+
+        snprintf(path, sizeof(path), "%s/f%05zu.gz", root, file);
+
+        if (w_compress_gzfile(stored, path) != 0) {
+            return -1;
+        }
+
+        unlink(stored);
+    }
+
+    if (old_fp = fopen(ready, "w"), old_fp != NULL) {
+        fclose(old_fp);
+    }
+
+    return 0;
+}
+
+/* Computes the diff as it was done before fim_line_diff: uncompress, compare MD5 and run diff */
+static char *previous_diff(const char *root, const char *stored, const char *path) {
+    char uncompressed[PATH_MAX];
+    char diff_file[PATH_MAX];
+    char command[PATH_MAX * 3 + OS_SIZE_1024];
+    char buffer[OS_MAXSTR + 1];
+    os_md5 md5_old;
+    os_md5 md5_new;
+    size_t n;
+    FILE *fp;
+
+    snprintf(uncompressed, sizeof(uncompressed), "%s/tmp/tmp-entry", root);
+    snprintf(diff_file, sizeof(diff_file), "%s/tmp/diff-file", root);
+
+    if (w_uncompress_gzfile(stored, uncompressed) != 0) {
+        return NULL;
+    }
+
+    if (OS_MD5_File(uncompressed, md5_old, OS_BINARY) != 0 || OS_MD5_File(path, md5_new, OS_BINARY) != 0 ||
+        strcmp(md5_old, md5_new) == 0) {
+        return NULL;
+    }
+
+    snprintf(command, sizeof(command), "diff \"%s\" \"%s\" > \"%s\" 2> /dev/null", uncompressed, path, diff_file);
+
+    if (system(command) != 256) {
+        return NULL;
+    }
+
+    if (fp = fopen(diff_file, "rb"), fp == NULL) {
+        return NULL;
+    }
+
+    n = fread(buffer, 1, MAX_DIFF_LENGTH, fp);
+    fclose(fp);
+    unlink(diff_file);
+    unlink(uncompressed);
+
+    buffer[n] = '\0';
+    return strdup(buffer);
+}
+
+/* Computes the diff in memory, as fim_diff_compare and fim_diff_generate do */
+static char *current_diff(const char *stored, const char *path) {
+    char *baseline;
+    char *content;
+    char *diff = NULL;
+    size_t baseline_size;
+    size_t content_size = 0;
+    size_t capacity = OS_SIZE_8192;
+    size_t n;
+    FILE *fp;
+
+    if (baseline = w_get_gzfile_content(stored, &baseline_size), baseline == NULL) {
+        return NULL;
+    }
+
+    if (fp = fopen(path, "rb"), fp == NULL) {
+        os_free(baseline);
+        return NULL;
+    }
+
+    os_malloc(capacity, content);
+
+    while (n = fread(content + content_size, 1, capacity - content_size, fp), n > 0) {
+        content_size += n;
+
+        if (content_size == capacity) {
+            capacity *= 2;
+            os_realloc(content, capacity, content);
+        }
+    }
+
+    fclose(fp);
+
+    if (content_size != baseline_size || memcmp(content, baseline, content_size) != 0) {
+        diff = fim_line_diff(baseline, baseline_size, content, content_size, MAX_DIFF_LENGTH);
+    }
+
+    os_free(baseline);
+    os_free(content);
+
+    return diff;
+}
+
+static double elapsed_ms(const struct timespec *start) {
+    struct timespec end;
+
+    gettime(&end);
+    return (end.tv_sec - start->tv_sec) * 1000.0 + (end.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+int main(int argc, char **argv) {
+    const size_t files = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_FILES;
+    const char *root = argc > 2 ? argv[2] : "/tmp/fim_diff_benchmark";
+    char **previous;
+    char stored[PATH_MAX];
+    char path[PATH_MAX];
+    struct timespec start;
+    double previous_ms;
+    double current_ms;
+    size_t different = 0;
+    size_t file;
+
+    if (make_burst(root, files) != 0) {
+        fprintf(stderr, "Couldn't write the files under %s: %s\n", root, strerror(errno));
+        return 1;
+    }
+
+    os_calloc(files, sizeof(char *), previous);
+
+    gettime(&start);
+    for (file = 0; file < files; file++) {
+        snprintf(stored, sizeof(stored), "%s/f%05zu.gz", root, file);
+        snprintf(path, sizeof(path), "%s/f%05zu", root, file);
+        previous[file] = previous_diff(root, stored, path);
+    }
+    previous_ms = elapsed_ms(&start);
+
+    gettime(&start);
+    for (file = 0; file < files; file++) {
+        char *diff;
+
+        snprintf(stored, sizeof(stored), "%s/f%05zu.gz", root, file);
+        snprintf(path, sizeof(path), "%s/f%05zu", root, file);
+        diff = current_diff(stored, path);
+
+        if (diff == NULL || previous[file] == NULL || strcmp(diff, previous[file]) != 0) {
+            different++;
+        }
+
+        os_free(diff);
+    }
+    current_ms = elapsed_ms(&start);
+
+    printf("%-16s %8zu files %10.2f ms %10.0f files/s\n", "diff command", files, previous_ms,
+           files * 1000.0 / previous_ms);
+    printf("%-16s %8zu files %10.2f ms %10.0f files/s %6.1fx speedup\n", "in-process", files, current_ms,
+           files * 1000.0 / current_ms, previous_ms / current_ms);
+    printf("%zu files with a different diff\n", different);
+
+    for (file = 0; file < files; file++) {
+        os_free(previous[file]);
+    }
+    os_free(previous);
+
+    return different != 0;
+}
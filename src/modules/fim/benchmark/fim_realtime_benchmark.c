@@ -0,0 +1,168 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "syscheck.h"
+#include "time_op.h"
+#include "file_op.h"
+
+#define DEFAULT_DIRECTORIES 40000
+#define DIRECTORIES_PER_PARENT 100
+
+/* Writes the directories as root/dNNNN/dNN, unless a previous run left them */
+static int make_tree(const char *root, size_t directories) {
+    char ready[PATH_MAX];
+    char path[PATH_MAX];
+    size_t directory;
+    FILE *fp;
+
+    snprintf(ready, sizeof(ready), "%s.%zu", root, directories);
+
+    if (access(ready, F_OK) == 0) {
+        return 0;
+    }
+
+    printf("Writing %zu directories under %s\n", directories, root);
+
+    for (directory = 0; directory < directories; directory++) {
+        snprintf(path, sizeof(path), "%s/d%04zu/d%02zu", root, directory / DIRECTORIES_PER_PARENT,
+                 directory % DIRECTORIES_PER_PARENT);
+
+        if (mkdir_ex(path) != 0) {
+            return -1;
+        }
+    }
+
+    if (fp = fopen(ready, "w"), fp != NULL) {
+        fclose(fp);
+    }
+
+    return 0;
+}
+
+/* Adds the realtime watch of every directory under path, as a scan does when it enters them */
+static void watch_tree(const char *path, const directory_t *configuration) {
+    char child[PATH_MAX];
+    struct dirent *entry;
+    DIR *dp;
+
+    fim_add_inotify_watch(path, configuration);
+
+    if (dp = opendir(path), dp == NULL) {
+        return;
+    }
+
+    while (entry = readdir(dp), entry != NULL) {
+        if (entry->d_type == DT_DIR && strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+            watch_tree(child, configuration);
+        }
+    }
+
+    closedir(dp);
+}
+
+/* Reads the number after field in a /proc file, in kB for /proc/meminfo and /proc/self/status */
+static long read_kb(const char *file, const char *field) {
+    char line[OS_SIZE_256];
+    long value = -1;
+    FILE *fp;
+
+    if (fp = fopen(file, "r"), fp == NULL) {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, field, strlen(field)) == 0) {
+            value = strtol(line + strlen(field), NULL, 10);
+            break;
+        }
+    }
+
+    fclose(fp);
+    return value;
+}
+
+/* Sets the watches of the tree with one backend, in a child process so the watches go away with it */
+static int run_backend(const char *name, int fanotify, directory_t *configuration) {
+    struct timespec start;
+    struct timespec end;
+    long rss_kb;
+    long slab_kb;
+    pid_t pid;
+    int status;
+
+    if (pid = fork(), pid < 0) {
+        return -1;
+    } else if (pid > 0) {
+        waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    fim_realtime_fanotify = fanotify;
+
+    if (realtime_start() != 0) {
+        _exit(1);
+    }
+
+    if (fanotify && fim_fanotify_get_fd() < 0) {
+        printf("%-10s unavailable\n", name);
+        _exit(0);
+    }
+
+    rss_kb = read_kb("/proc/self/status", "VmRSS:");
+    slab_kb = read_kb("/proc/meminfo", "Slab:");
+    gettime(&start);
+
+    watch_tree(configuration->path, configuration);
+
+    gettime(&end);
+
+    printf("%-10s %10.2f ms %10u %8u %12ld %12ld\n",
+           name,
+           time_diff(&start, &end) * 1000,
+           OSHash_Get_Elem_ex(syscheck.realtime->dirtb),
+           fanotify ? fim_fanotify_get_marks() : 0,
+           read_kb("/proc/self/status", "VmRSS:") - rss_kb,
+           read_kb("/proc/meminfo", "Slab:") - slab_kb);
+
+    _exit(0);
+}
+
+int main(int argc, char **argv) {
+    const size_t directories = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_DIRECTORIES;
+    const char *root = argc > 2 ? argv[2] : "/tmp/fim_realtime_benchmark";
+    directory_t *configuration;
+
+    if (make_tree(root, directories) != 0) {
+        fprintf(stderr, "Couldn't write the directories under %s: %s\n", root, strerror(errno));
+        return 1;
+    }
+
+    os_calloc(1, sizeof(directory_t), configuration);
+    os_strdup(root, configuration->path);
+    configuration->options = REALTIME_ACTIVE;
+    configuration->recursion_level = 256;
+
+    syscheck.directories = OSList_Create();
+    OSList_AddData(syscheck.directories, configuration);
+    w_mutex_init(&syscheck.fim_realtime_mutex, NULL);
+    w_rwlock_init(&syscheck.directories_lock, NULL);
+
+    printf("%zu directories, max_user_watches %ld\n", directories + directories / DIRECTORIES_PER_PARENT + 1,
+           read_kb("/proc/sys/fs/inotify/max_user_watches", ""));
+    printf("%-10s %13s %10s %8s %12s %12s\n", "backend", "setup", "watches", "marks", "user kB", "slab kB");
+
+    if (run_backend("inotify", 0, configuration) != 0 || run_backend("fanotify", 1, configuration) != 0) {
+        fprintf(stderr, "Couldn't start real-time monitoring\n");
+        return 1;
+    }
+
+    return 0;
+}
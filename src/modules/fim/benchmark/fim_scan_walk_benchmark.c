@@ -0,0 +1,169 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "syscheck.h"
+#include "time_op.h"
+#include "db/include/db.h"
+
+#define DEFAULT_FILES 1000000
+#define FILES_PER_DIRECTORY 1000
+#define DIRECTORIES_PER_PARENT 100
+#define FILE_SIZE 512
+
+static unsigned long long _inserted = 0;
+
+static void benchmark_sync(__attribute__((unused)) const char *tag, __attribute__((unused)) const char *buffer) {
+}
+
+static void benchmark_log(__attribute__((unused)) const modules_log_level_t level,
+                          __attribute__((unused)) const char *log) {
+}
+
+static void count_inserted(ReturnTypeCallback result_type,
+                           __attribute__((unused)) const cJSON *result_json,
+                           __attribute__((unused)) void *user_data) {
+    if (result_type == INSERTED) {
+        _inserted++;
+    }
+}
+
+/* Writes the files as root/dNN/dNNN/fNNN, unless a previous run left them */
+static int make_tree(const char *root, size_t files) {
+    char ready[PATH_MAX];
+    char path[PATH_MAX];
+    char content[FILE_SIZE];
+    size_t directory;
+    size_t file;
+    FILE *fp;
+
+    snprintf(ready, sizeof(ready), "%s.%zu", root, files);
+
+    if (access(ready, F_OK) == 0) {
+        return 0;
+    }
+
+    printf("Writing %zu files under %s\n", files, root);
+
+    for (directory = 0; directory * FILES_PER_DIRECTORY < files; directory++) {
+        snprintf(path, sizeof(path), "%s/d%02zu/d%03zu", root, directory / DIRECTORIES_PER_PARENT,
+                 directory % DIRECTORIES_PER_PARENT);
+
+        if (mkdir_ex(path) != 0) {
+            return -1;
+        }
+
+        for (file = 0; file < FILES_PER_DIRECTORY && directory * FILES_PER_DIRECTORY + file < files; file++) {
+            snprintf(path, sizeof(path), "%s/d%02zu/d%03zu/f%03zu", root, directory / DIRECTORIES_PER_PARENT,
+                     directory % DIRECTORIES_PER_PARENT, file);
+
+            if (fp = fopen(path, "w"), fp == NULL) {
+                return -1;
+            }
+
+            memset(content, 'a' + (directory + file) % 26, sizeof(content));
+            fwrite(content, 1, sizeof(content), fp);
+            fclose(fp);
+        }
+    }
+
+    if (fp = fopen(ready, "w"), fp != NULL) {
+        fclose(fp);
+    }
+
+    return 0;
+}
+
+/* Scans the monitored directories into an empty DB, as a scheduled scan does */
+static double scan(int threads, fim_scan_hashes_t *hashes) {
+    event_data_t evt_data = { .report_event = true, .mode = FIM_SCHEDULED, .w_evt = NULL };
+    fim_txn_context_t txn_ctx = { .evt_data = &evt_data, .latest_entry = NULL, .hashes = hashes };
+    struct timespec start;
+    struct timespec end;
+    OSListNode *node_it;
+    TXN_HANDLE txn;
+
+    // A transaction without rows deletes the ones inserted by the previous run
+    txn = fim_db_transaction_start(FIMDB_FILE_TXN_TABLE, count_inserted, &txn_ctx);
+    fim_db_transaction_deleted_rows(txn, count_inserted, &txn_ctx);
+    _inserted = 0;
+
+    fim_scan_threads = threads;
+    gettime(&start);
+
+    txn = fim_db_transaction_start(FIMDB_FILE_TXN_TABLE, count_inserted, &txn_ctx);
+
+    if (threads <= 1 || fim_scan_walk(syscheck.directories, txn, &txn_ctx) != 0) {
+        OSList_foreach(node_it, syscheck.directories) {
+            char *path = fim_get_real_path(node_it->data);
+
+            fim_checker(path, &evt_data, node_it->data, txn, &txn_ctx);
+            os_free(path);
+        }
+    }
+
+    fim_db_transaction_deleted_rows(txn, count_inserted, &txn_ctx);
+
+    gettime(&end);
+
+    return (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+}
+
+int main(int argc, char **argv) {
+    const size_t files = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_FILES;
+    const int threads = argc > 2 ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char *root = argc > 3 ? argv[3] : "/tmp/fim_scan_walk_benchmark";
+    fim_scan_hashes_t sequential_hashes = { .reuse = false };
+    fim_scan_hashes_t parallel_hashes = { .reuse = false };
+    unsigned long long sequential_rows;
+    directory_t *configuration;
+    double sequential_ms;
+    double parallel_ms;
+
+    if (make_tree(root, files) != 0) {
+        fprintf(stderr, "Couldn't write the files under %s: %s\n", root, strerror(errno));
+        return 1;
+    }
+
+    os_calloc(1, sizeof(directory_t), configuration);
+    os_strdup(root, configuration->path);
+    configuration->options = CHECK_SIZE | CHECK_PERM | CHECK_OWNER | CHECK_GROUP | CHECK_MTIME | CHECK_INODE |
+                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM | SCHEDULED_ACTIVE;
+    configuration->recursion_level = 256;
+
+    syscheck.directories = OSList_Create();
+    OSList_AddData(syscheck.directories, configuration);
+    syscheck.file_max_size = 1024 * 1024 * 1024;
+    syscheck.max_files_per_second = 0;
+    w_mutex_init(&syscheck.fim_symlink_mutex, NULL);
+
+    if (fim_db_init(FIM_DB_MEMORY, 300, 600, 10, benchmark_sync, benchmark_log, 0, 0, false, 1, 0, NULL, NULL) !=
+        FIMDB_OK) {
+        fprintf(stderr, "Couldn't create the FIM DB\n");
+        return 1;
+    }
+
+    sequential_ms = scan(1, &sequential_hashes);
+    sequential_rows = _inserted;
+    parallel_ms = scan(threads, &parallel_hashes);
+
+    printf("%-16s %8llu files %10.2f ms\n", "sequential", sequential_rows, sequential_ms);
+    printf("%-16s %8llu files %10.2f ms %8.1fx speedup %s\n",
+           "parallel",
+           _inserted,
+           parallel_ms,
+           sequential_ms / parallel_ms,
+           sequential_rows == _inserted && sequential_hashes.bytes_hashed == parallel_hashes.bytes_hashed
+               ? "same result"
+               : "DIFFERENT RESULT");
+    printf("%d threads, %llu bytes hashed per scan\n", threads, parallel_hashes.bytes_hashed);
+
+    fim_db_teardown();
+    return 0;
+}
@@ -0,0 +1,154 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "time_op.h"
+#include <openssl/evp.h>
+
+#define MIN_SIZE 1024ULL
+#define DEFAULT_MAX_SIZE (4ULL * 1024 * 1024 * 1024)
+#define BYTES_PER_SIZE (256ULL * 1024 * 1024)
+
+/* Hashes the file as it was done before OS_Hash_File: new contexts for each file and 2 KiB reads */
+static int previous_hash_file(const char *fname, os_md5 md5output, os_sha1 sha1output, os_sha256 sha256output) {
+    const EVP_MD *types[] = { EVP_md5(), EVP_sha1(), EVP_sha256() };
+    char *outputs[] = { md5output, sha1output, sha256output };
+    unsigned char buf[OS_BUFFER_SIZE];
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    EVP_MD_CTX *ctx[3];
+    unsigned int length;
+    unsigned int n;
+    size_t read;
+    FILE *fp;
+    int i;
+
+    if (fp = fopen(fname, "rb"), fp == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < 3; i++) {
+        ctx[i] = EVP_MD_CTX_new();
+        EVP_DigestInit(ctx[i], types[i]);
+    }
+
+    while ((read = fread(buf, 1, OS_BUFFER_SIZE, fp)) > 0) {
+        for (i = 0; i < 3; i++) {
+            EVP_DigestUpdate(ctx[i], buf, read);
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        EVP_DigestFinal(ctx[i], digest, &length);
+        EVP_MD_CTX_free(ctx[i]);
+
+        for (n = 0; n < length; n++) {
+            snprintf(outputs[i] + n * 2, 3, "%02x", digest[n]);
+        }
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+/* Writes a file of the given size with pseudo-random content, unless a previous run left it */
+static int make_file(const char *path, unsigned long long size) {
+    unsigned char block[64 * 1024];
+    unsigned long long written;
+    struct stat statbuf;
+    unsigned int seed = 1;
+    FILE *fp;
+    size_t i;
+
+    if (stat(path, &statbuf) == 0 && (unsigned long long)statbuf.st_size == size) {
+        return 0;
+    }
+
+    if (fp = fopen(path, "wb"), fp == NULL) {
+        return -1;
+    }
+
+    for (written = 0; written < size; written += i) {
+        for (i = 0; i < sizeof(block) && written + i < size; i++) {
+            block[i] = (unsigned char)(rand_r(&seed) >> 7);
+        }
+
+        if (fwrite(block, 1, i, fp) != i) {
+            fclose(fp);
+            return -1;
+        }
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static double elapsed_ms(const struct timespec *start) {
+    struct timespec end;
+
+    gettime(&end);
+    return (end.tv_sec - start->tv_sec) * 1000.0 + (end.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+int main(int argc, char **argv) {
+    const unsigned long long max_size = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_MAX_SIZE;
+    const char *directory = argc > 2 ? argv[2] : "/tmp";
+    unsigned long long size;
+    struct timespec start;
+    char path[PATH_MAX];
+
+    printf("%-12s %8s %14s %14s %14s %s\n", "size", "files", "previous ms", "all ms", "sha256 ms", "digests");
+
+    for (size = MIN_SIZE; size <= max_size; size *= 4) {
+        // Hash small files many times so every size reads about the same amount of data
+        const unsigned long long files = size < BYTES_PER_SIZE ? BYTES_PER_SIZE / size : 1;
+        os_md5 previous_md5, md5;
+        os_sha1 previous_sha1, sha1;
+        os_sha256 previous_sha256, sha256;
+        double previous_ms, all_ms, sha256_ms;
+        unsigned long long i;
+
+        snprintf(path, sizeof(path), "%s/hash_file_benchmark.%llu", directory, size);
+
+        if (make_file(path, size) != 0) {
+            fprintf(stderr, "Couldn't write %s: %s\n", path, strerror(errno));
+            return 1;
+        }
+
+        gettime(&start);
+        for (i = 0; i < files; i++) {
+            previous_hash_file(path, previous_md5, previous_sha1, previous_sha256);
+        }
+        previous_ms = elapsed_ms(&start);
+
+        gettime(&start);
+        for (i = 0; i < files; i++) {
+            OS_Hash_File(path, NULL, OS_HASH_ALL, md5, sha1, sha256, OS_BINARY, 0);
+        }
+        all_ms = elapsed_ms(&start);
+
+        gettime(&start);
+        for (i = 0; i < files; i++) {
+            OS_Hash_File(path, NULL, OS_HASH_SHA256, NULL, NULL, sha256, OS_BINARY, 0);
+        }
+        sha256_ms = elapsed_ms(&start);
+
+        printf("%-12llu %8llu %14.2f %14.2f %14.2f %s\n",
+               size,
+               files,
+               previous_ms,
+               all_ms,
+               sha256_ms,
+               strcmp(md5, previous_md5) == 0 && strcmp(sha1, previous_sha1) == 0 &&
+                       strcmp(sha256, previous_sha256) == 0
+                   ? "same"
+                   : "DIFFERENT");
+    }
+
+    return 0;
+}
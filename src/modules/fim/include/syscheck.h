@@ -50,6 +50,9 @@
 extern syscheck_config syscheck;
 extern int sys_debug_level;
 extern int audit_queue_full_reported;
+extern int fim_hash_reuse_scans;
+extern int fim_scan_threads;
+extern int fim_realtime_fanotify;
 
 typedef enum fim_event_type {
     FIM_ADD,
@@ -96,9 +99,12 @@ typedef struct diff_data {
 
     char *tmp_folder;
     char *file_origin;
-    char *uncompress_file;
     char *compress_tmp_file;
-    char *diff_file;
+
+    char *baseline;
+    size_t baseline_size;
+    char *content;
+    size_t content_size;
 } diff_data;
 
 typedef struct get_data_ctx {
@@ -112,11 +118,39 @@ typedef struct create_json_event_ctx {
     const directory_t* config;
 } create_json_event_ctx;
 
+/* Hashing of the files of a scheduled scan */
+typedef struct fim_scan_hashes_s {
+    bool reuse;                         // The stored hashes of unchanged files can be reused
+    unsigned long long files_hashed;
+    unsigned long long bytes_hashed;
+    unsigned long long files_reused;
+    unsigned long long bytes_reused;
+} fim_scan_hashes_t;
+
 typedef struct fim_txn_context_s {
     event_data_t* evt_data;
     fim_entry* latest_entry;
+    fim_scan_hashes_t* hashes;
 } fim_txn_context_t;
 
+#ifndef WIN32
+/* Path queued to a scan thread */
+typedef struct fim_walk_item_s {
+    char *path;
+    const directory_t *configuration;
+    bool monitored;                     // Monitored path to check, otherwise a directory to enumerate
+} fim_walk_item_t;
+
+/* Paths queued to a scan thread, the thread takes the latest one and the others steal the oldest one */
+typedef struct fim_walk_deque_s {
+    pthread_mutex_t mutex;
+    fim_walk_item_t *items;
+    size_t head;
+    size_t count;
+    size_t capacity;
+} fim_walk_deque_t;
+#endif
+
 #ifdef WIN32
 /* Flags to know if a directory/file's watcher has been removed */
 #define FIM_RT_HANDLE_CLOSED 0
@@ -192,6 +226,62 @@ void fim_checker(const char *path,
                  TXN_HANDLE dbsync_txn,
                  fim_txn_context_t *ctx);
 
+#ifndef WIN32
+/**
+ * @brief Scan the monitored directories with fim_scan_threads threads, applying the same checks as fim_checker.
+ * The threads enumerate and hash, this thread syncs the files into the DB transaction.
+ *
+ * @param [in] directories Monitored directories, the caller must hold the directories lock.
+ * @param [in] dbsync_txn Handle to an active dbsync transaction.
+ * @param [in] txn_context fim_txn_context_t transaction context.
+ *
+ * @return 0 on success, -1 if the threads couldn't be started and nothing was scanned
+ */
+int fim_scan_walk(OSList *directories, TXN_HANDLE dbsync_txn, fim_txn_context_t *txn_context);
+
+/**
+ * @brief Initialize an empty deque of paths
+ *
+ * @param [out] deque The deque to initialize
+ */
+void fim_walk_deque_init(fim_walk_deque_t *deque);
+
+/**
+ * @brief Free a deque of paths and the paths left in it
+ *
+ * @param [in] deque The deque to free
+ */
+void fim_walk_deque_destroy(fim_walk_deque_t *deque);
+
+/**
+ * @brief Queue a path at the back of a deque
+ *
+ * @param [in] deque The deque
+ * @param [in] item The path, the deque takes ownership of it
+ */
+void fim_walk_deque_push(fim_walk_deque_t *deque, const fim_walk_item_t *item);
+
+/**
+ * @brief Take the latest path queued in a deque, used by its own scan thread
+ *
+ * @param [in] deque The deque
+ * @param [out] item The path taken
+ *
+ * @return true if a path was taken, false if the deque was empty
+ */
+bool fim_walk_deque_pop(fim_walk_deque_t *deque, fim_walk_item_t *item);
+
+/**
+ * @brief Take the oldest path queued in a deque, used by the other scan threads
+ *
+ * @param [in] deque The deque
+ * @param [out] item The path taken
+ *
+ * @return true if a path was taken, false if the deque was empty
+ */
+bool fim_walk_deque_steal(fim_walk_deque_t *deque, fim_walk_item_t *item);
+#endif
+
 /**
  * @brief Check file integrity monitoring on a specific folder
  *
@@ -278,10 +368,28 @@ int fim_check_depth(const char *path, const directory_t *configuration);
  * @param file Name of the file to get the data from
  * @param [in] configuration Configuration block associated with a previous event.
  * @param [in] statbuf Buffer acquired from a stat command with information linked to 'path'
+ * @param [in,out] hashes Hashing of the scheduled scan in progress, NULL to always hash the file.
  *
  * @return A fim_file_data structure with the data from the file
  */
-fim_file_data *fim_get_data(const char *file, const directory_t *configuration, const struct stat *statbuf);
+fim_file_data *fim_get_data(const char *file,
+                            const directory_t *configuration,
+                            const struct stat *statbuf,
+                            fim_scan_hashes_t *hashes);
+
+/**
+ * @brief Copy the hashes stored for a file if it didn't change since they were calculated
+ *
+ * The file is considered unchanged if its size, modification time, inode and device match the stored ones, the
+ * same hashes are configured and it wasn't modified in the same second its hashes were calculated.
+ *
+ * @param file Name of the file
+ * @param [in] configuration Configuration block associated with the file.
+ * @param [in,out] data Data of the file, its size, modification time, inode and device must already be filled in
+ *
+ * @return true if the stored hashes were copied, false if the file has to be hashed
+ */
+bool fim_reuse_stored_hashes(const char *file, const directory_t *configuration, fim_file_data *data);
 
 /**
  * @brief Initialize a fim_file_data structure
@@ -375,6 +483,43 @@ int realtime_adddir(const char *dir, directory_t *configuration);
  * @return 1 on success, -1 on failure
  */
 int fim_add_inotify_watch(const char *dir, const directory_t *configuration);
+
+/**
+ * @brief Start the fanotify real time engine, which monitors whole filesystems next to inotify
+ *
+ * @return 0 on success, -1 if the kernel doesn't support it or the agent lacks privileges
+ */
+int fim_fanotify_start(void);
+
+/**
+ * @brief Get the fanotify file descriptor
+ *
+ * @return The file descriptor, -1 if fanotify isn't in use
+ */
+int fim_fanotify_get_fd(void);
+
+/**
+ * @brief Get the number of filesystems marked with fanotify
+ *
+ * @return Number of fanotify marks
+ */
+unsigned int fim_fanotify_get_marks(void);
+
+/**
+ * @brief Mark the filesystem of a path with fanotify, unless it's already marked
+ *
+ * Must be called with fim_realtime_mutex locked.
+ *
+ * @param path Path to file or directory
+ * @param configuration Configuration associated with the file or directory
+ * @return 1 if the filesystem is monitored by fanotify, 0 if the path needs an inotify watch
+ */
+int fim_fanotify_watch(const char *path, const directory_t *configuration);
+
+/**
+ * @brief Process the events in the fanotify queue that belong to realtime directories
+ */
+void fim_fanotify_process(void);
 #endif
 
 /**
@@ -667,6 +812,18 @@ char *fim_registry_value_diff(const char *key_name,
 
 char *fim_file_diff(const char *filename, const directory_t *configuration);
 
+/**
+ * @brief Computes the line differences between two contents, in the format of the diff command
+ *
+ * @param old_data Previous content
+ * @param old_size Size of the previous content
+ * @param new_data Current content
+ * @param new_size Size of the current content
+ * @param max_length Maximum length of the result, which is truncated with "More changes..." beyond it
+ * @return String with the differences, NULL if any of the contents is binary
+ */
+char *fim_line_diff(const char *old_data, size_t old_size, const char *new_data, size_t new_size, size_t max_length);
+
 /**
  * @brief Deletes the filename diff folder and modify diff_folder_size if disk_quota enabled
  *
@@ -513,10 +513,13 @@ cJSON *getSyscheckInternalOptions(void) {
     cJSON_AddNumberToObject(syscheckd,"symlink_scan_interval",syscheck.sym_checker_interval);
     cJSON_AddNumberToObject(syscheckd,"debug",sys_debug_level);
     cJSON_AddNumberToObject(syscheckd,"file_max_size",syscheck.file_max_size);
+    cJSON_AddNumberToObject(syscheckd,"hash_reuse_scans",fim_hash_reuse_scans);
 #ifdef WIN32
     cJSON_AddNumberToObject(syscheckd,"max_fd_win_rt",syscheck.max_fd_win_rt);
 #else
     cJSON_AddNumberToObject(syscheckd,"max_audit_entries",syscheck.max_audit_entries);
+    cJSON_AddNumberToObject(syscheckd,"scan_threads",fim_scan_threads);
+    cJSON_AddNumberToObject(syscheckd,"realtime_fanotify",fim_realtime_fanotify);
 #endif
 
     cJSON_AddItemToObject(internals,"syscheck",syscheckd);
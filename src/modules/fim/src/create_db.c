@@ -482,12 +482,15 @@ time_t fim_scan() {
     time_t end_of_scan;
     clock_t cputime_start;
     int nodes_count = 0;
+    bool walked = false;
     OSListNode *node_it;
     directory_t *dir_it;
     event_data_t evt_data = { .report_event = true, .mode = FIM_SCHEDULED, .w_evt = NULL };
-    fim_txn_context_t txn_ctx = { .evt_data = &evt_data, .latest_entry = NULL };
+    fim_scan_hashes_t scan_hashes = { .reuse = false };
+    fim_txn_context_t txn_ctx = { .evt_data = &evt_data, .latest_entry = NULL, .hashes = &scan_hashes };
 
     static fim_state_db _files_db_state = FIM_STATE_DB_EMPTY;
+    static int _scans_reusing_hashes = 0;
 #ifdef WIN32
     static fim_state_db _registry_key_state = FIM_STATE_DB_EMPTY;
     static fim_state_db _registry_value_state = FIM_STATE_DB_EMPTY;
@@ -512,16 +515,29 @@ time_t fim_scan() {
 
     LogDebug(FIM_DIFF_FOLDER_SIZE, DIFF_DIR, syscheck.diff_folder_size);
 
+    // After hash_reuse_scans scans reusing the stored hashes of unchanged files, every file is hashed again
+    if (fim_hash_reuse_scans > 0 && _scans_reusing_hashes < fim_hash_reuse_scans) {
+        scan_hashes.reuse = true;
+        _scans_reusing_hashes++;
+    } else {
+        _scans_reusing_hashes = 0;
+    }
+
     w_mutex_lock(&syscheck.fim_scan_mutex);
 
     update_wildcards_config();
 
     w_rwlock_rdlock(&syscheck.directories_lock);
+#ifndef WIN32
+    walked = fim_scan_threads > 1 && fim_scan_walk(syscheck.directories, db_transaction_handle, &txn_ctx) == 0;
+#endif
     OSList_foreach(node_it, syscheck.directories) {
         dir_it = node_it->data;
         char *path = fim_get_real_path(dir_it);
 
-        fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+        if (!walked) {
+            fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+        }
 
 #ifndef WIN32
         realtime_adddir(path, dir_it);
@@ -549,6 +565,9 @@ time_t fim_scan() {
         db_transaction_handle = fim_db_transaction_start(FIMDB_FILE_TXN_TABLE, transaction_callback, &txn_ctx);
 
         w_rwlock_rdlock(&syscheck.directories_lock);
+#ifndef WIN32
+        walked = fim_scan_threads > 1 && fim_scan_walk(syscheck.directories, db_transaction_handle, &txn_ctx) == 0;
+#endif
         OSList_foreach(node_it, syscheck.directories) {
             dir_it = node_it->data;
             char *path;
@@ -556,7 +575,9 @@ time_t fim_scan() {
 
             path = fim_get_real_path(dir_it);
 
-            fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+            if (!walked) {
+                fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+            }
 
             // Verify the directory is being monitored correctly
 #ifndef WIN32
@@ -614,6 +635,11 @@ time_t fim_scan() {
     }
 
     LogInfo(FIM_FREQUENCY_ENDED);
+    LogInfo(FIM_SCAN_HASHES_SUMMARY,
+            scan_hashes.files_hashed,
+            scan_hashes.bytes_hashed,
+            scan_hashes.files_reused,
+            scan_hashes.bytes_reused);
     fim_send_scan_info(FIM_SCAN_END);
 
     // if (isDebug()) {
@@ -888,7 +914,10 @@ void fim_file(const char *path,
 
     new_entry.type = FIM_TYPE_FILE;
     new_entry.file_entry.path = (char *)path;
-    new_entry.file_entry.data = fim_get_data(path, configuration, &(evt_data->statbuf));
+    new_entry.file_entry.data = fim_get_data(path,
+                                             configuration,
+                                             &(evt_data->statbuf),
+                                             txn_context != NULL ? txn_context->hashes : NULL);
 
     if (new_entry.file_entry.data == NULL) {
         LogDebug(FIM_GET_ATTRIBUTES, path);
@@ -1243,8 +1272,66 @@ int fim_check_depth(const char *path, const directory_t *configuration) {
 }
 
 
+// Callback
+void fim_db_copy_stored_hashes(void * data, void * ctx)
+{
+    const fim_file_data *stored = ((fim_entry *)data)->file_entry.data;
+    fim_file_data *copy = (fim_file_data *)ctx;
+
+    copy->size = stored->size;
+    copy->mtime = stored->mtime;
+    copy->inode = stored->inode;
+    copy->dev = stored->dev;
+    copy->options = stored->options;
+    copy->last_event = stored->last_event;
+    snprintf(copy->hash_md5, sizeof(os_md5), "%s", stored->hash_md5);
+    snprintf(copy->hash_sha1, sizeof(os_sha1), "%s", stored->hash_sha1);
+    snprintf(copy->hash_sha256, sizeof(os_sha256), "%s", stored->hash_sha256);
+}
+
+bool fim_reuse_stored_hashes(const char *file, const directory_t *configuration, fim_file_data *data) {
+    const int hash_options = CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM;
+    const int stat_options = CHECK_SIZE | CHECK_MTIME;
+    fim_file_data stored = { .options = 0 };
+    callback_context_t callback_data = { .callback = fim_db_copy_stored_hashes, .context = &stored };
+
+    // Size and modification time are only stored if they are checked
+    if ((configuration->options & stat_options) != stat_options) {
+        return false;
+    }
+
+    if (fim_db_get_path(file, callback_data) != FIMDB_OK) {
+        return false;
+    }
+
+    if ((stored.options & stat_options) != stat_options ||
+        (stored.options & hash_options) != (configuration->options & hash_options)) {
+        return false;
+    }
+
+    if (stored.size != data->size || stored.mtime != data->mtime || stored.inode != data->inode ||
+        stored.dev != data->dev) {
+        return false;
+    }
+
+    // A file modified in the same second its hashes were calculated could have changed afterwards
+    // without changing its modification time
+    if (stored.mtime >= stored.last_event) {
+        return false;
+    }
+
+    snprintf(data->hash_md5, sizeof(os_md5), "%s", stored.hash_md5);
+    snprintf(data->hash_sha1, sizeof(os_sha1), "%s", stored.hash_sha1);
+    snprintf(data->hash_sha256, sizeof(os_sha256), "%s", stored.hash_sha256);
+
+    return true;
+}
+
 // Get data from file
-fim_file_data *fim_get_data(const char *file, const directory_t *configuration, const struct stat *statbuf) {
+fim_file_data *fim_get_data(const char *file,
+                            const directory_t *configuration,
+                            const struct stat *statbuf,
+                            fim_scan_hashes_t *hashes) {
     fim_file_data * data = NULL;
 
     os_calloc(1, sizeof(fim_file_data), data);
@@ -1315,15 +1402,41 @@ fim_file_data *fim_get_data(const char *file, const directory_t *configuration,
 
     // The file exists and we don't have to delete it from the hash tables
     data->scanned = 1;
+    data->inode = statbuf->st_ino;
+    data->dev = statbuf->st_dev;
 
     // We won't calculate hash for symbolic links, empty or large files
     if (S_ISREG(statbuf->st_mode) && (statbuf->st_size > 0 && statbuf->st_size < syscheck.file_max_size) &&
         (configuration->options & (CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM))) {
-        if (OS_MD5_SHA1_SHA256_File(file, syscheck.prefilter_cmd, data->hash_md5,
-                                    data->hash_sha1, data->hash_sha256, OS_BINARY, syscheck.file_max_size) < 0) {
-            LogDebug(FIM_HASHES_FAIL, file);
-            free_file_data(data);
-            return NULL;
+        if (hashes != NULL && hashes->reuse && fim_reuse_stored_hashes(file, configuration, data)) {
+            hashes->files_reused++;
+            hashes->bytes_reused += statbuf->st_size;
+        } else {
+            int digests = 0;
+
+            if (configuration->options & CHECK_MD5SUM) {
+                digests |= OS_HASH_MD5;
+            }
+
+            if (configuration->options & CHECK_SHA1SUM) {
+                digests |= OS_HASH_SHA1;
+            }
+
+            if (configuration->options & CHECK_SHA256SUM) {
+                digests |= OS_HASH_SHA256;
+            }
+
+            if (OS_Hash_File(file, syscheck.prefilter_cmd, digests, data->hash_md5, data->hash_sha1,
+                             data->hash_sha256, OS_BINARY, syscheck.file_max_size) < 0) {
+                LogDebug(FIM_HASHES_FAIL, file);
+                free_file_data(data);
+                return NULL;
+            }
+
+            if (hashes != NULL) {
+                hashes->files_hashed++;
+                hashes->bytes_hashed += statbuf->st_size;
+            }
         }
     }
 
@@ -1339,8 +1452,6 @@ fim_file_data *fim_get_data(const char *file, const directory_t *configuration,
         data->hash_sha256[0] = '\0';
     }
 
-    data->inode = statbuf->st_ino;
-    data->dev = statbuf->st_dev;
     data->options = configuration->options;
     data->last_event = time(NULL);
     fim_get_checksum(data);
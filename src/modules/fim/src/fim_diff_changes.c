@@ -8,7 +8,6 @@
  */
 
 #include "shared.h"
-#include "../os_crypto/md5/md5_op.h"
 #include "syscheck.h"
 
 
@@ -23,15 +22,12 @@
 #endif
 
 #ifdef WIN32
-#define unlink(x) _unlink(x)
 #define FileSize(x) FileSizeWin(x)
 #define PATH_OFFSET 0
 #else
 #define PATH_OFFSET 1
 #endif
 
-static const char *STR_MORE_CHANGES = "More changes...";
-
 #ifdef WIN32
 
 /* Prototypes */
@@ -124,31 +120,32 @@ int fim_diff_create_compress_file(const diff_data *diff);
 void fim_diff_modify_compress_estimation(float compressed_size, float uncompressed_size);
 
 /**
- * @brief Compares MD5 hashes of the old and new files to see if they are the same
+ * @brief Reads the whole content of a file
  *
- * @param diff Structure with all the data necessary to compute differences
+ * @param path Path of the file
+ * @param size Size of the content
  *
- * @return -1 if old and new files are the same, 0 if they are different
+ * @return Null-terminated content of the file, NULL on error
  */
-int fim_diff_compare(const diff_data *diff);
+char *fim_diff_read_file(const char *path, size_t *size);
 
 /**
- * @brief Generates the diff file with the result of the diff/fc command (only if nodiff is not configured)
+ * @brief Loads the current content of the file and compares it with the stored one
  *
  * @param diff Structure with all the data necessary to compute differences
  *
- * @return String with the changes to add to the alert
+ * @return -1 if the content can't be read or is the same as the stored one, 0 if they are different
  */
-char *fim_diff_generate(const diff_data *diff);
+int fim_diff_compare(diff_data *diff);
 
 /**
- * @brief Reads the diff file and generates the string with the differences
+ * @brief Generates the differences between the stored and the current content (only if nodiff is not configured)
  *
  * @param diff Structure with all the data necessary to compute differences
  *
- * @return String with the changes to add to the alert
+ * @return String with the changes to add to the alert, or a fixed notice if either content is binary
  */
-char *gen_diff_str(const diff_data *diff);
+char *fim_diff_generate(const diff_data *diff);
 
 /**
  * @brief Checks if a specific file has been configured with the ``nodiff`` option
@@ -168,15 +165,6 @@ int is_file_nodiff(const char *filename);
  */
 int is_registry_nodiff(const char *key_name, const char *value_name, int arch);
 
-/**
- * @brief Filter a path so that it cannot contain strange symbols. In the case of Windows, change the '/' to '\'.
- *
- * @param string String with the path to be filtered
- *
- * @return A pointer to the filtered path
- */
-char* filter(const char *string);
-
 /**
  * @brief Saves the temporal compress file into the compress folder
  *
@@ -186,15 +174,6 @@ void save_compress_file(const diff_data *diff);
 
 #ifdef WIN32
 
-/**
- * @brief Adapts the fc output to be the same as the diff
- *
- * @param command_output Output of the fc command
- *
- * @return Adapted output
- */
-char *adapt_win_fc_output(char *command_output);
-
 /* Definitions */
 
 char *fim_registry_value_diff(const char *key_name,
@@ -243,7 +222,7 @@ char *fim_registry_value_diff(const char *key_name,
     }
 
     // If the file is not there, create compressed file and return.
-    if (w_uncompress_gzfile(diff->compress_file, diff->uncompress_file) != 0) {
+    if (diff->baseline = w_get_gzfile_content(diff->compress_file, &diff->baseline_size), !diff->baseline) {
         if (ret = fim_diff_create_compress_file(diff), ret == 0){
             mkdir_ex(diff->compress_folder);
             save_compress_file(diff);
@@ -331,15 +310,9 @@ diff_data *initialize_registry_diff_data(const char *key_name, const char *value
     }
     os_strdup(buffer, diff->file_origin);
 
-    snprintf(buffer, PATH_MAX, "%s/tmp-entry", diff->tmp_folder);
-    os_strdup(buffer, diff->uncompress_file);
-
     snprintf(buffer, PATH_MAX, "%s/tmp-entry.gz", diff->tmp_folder);
     os_strdup(buffer, diff->compress_tmp_file);
 
-    snprintf(buffer, PATH_MAX, "%s/diff-file", diff->tmp_folder);
-    os_strdup(buffer, diff->diff_file);
-
     return diff;
 }
 
@@ -427,7 +400,7 @@ char *fim_file_diff(const char *filename, const directory_t *configuration) {
     }
 
     // If the file is not there, create compressed file and return.
-    if (w_uncompress_gzfile(diff->compress_file, diff->uncompress_file) != 0) {
+    if (diff->baseline = w_get_gzfile_content(diff->compress_file, &diff->baseline_size), !diff->baseline) {
         if (ret = fim_diff_create_compress_file(diff), ret == 0){
             mkdir_ex(diff->compress_folder);
             save_compress_file(diff);
@@ -525,15 +498,9 @@ diff_data *initialize_file_diff_data(const char *filename, const directory_t *co
     os_snprintf(buffer, PATH_MAX, "%s/tmp", abs_diff_dir_path);
     os_strdup(buffer, diff->tmp_folder);
 
-    snprintf(buffer, PATH_MAX, "%s/tmp-entry", diff->tmp_folder);
-    os_strdup(buffer, diff->uncompress_file);
-
     snprintf(buffer, PATH_MAX, "%s/tmp-entry.gz", diff->tmp_folder);
     os_strdup(buffer, diff->compress_tmp_file);
 
-    snprintf(buffer, PATH_MAX, "%s/diff-file", diff->tmp_folder);
-    os_strdup(buffer, diff->diff_file);
-
     return diff;
 
 error:
@@ -550,9 +517,9 @@ void free_diff_data(diff_data *diff) {
     os_free(diff->compress_file);
     os_free(diff->tmp_folder);
     os_free(diff->file_origin);
-    os_free(diff->uncompress_file);
     os_free(diff->compress_tmp_file);
-    os_free(diff->diff_file);
+    os_free(diff->baseline);
+    os_free(diff->content);
 
     free(diff);
 }
@@ -643,135 +610,71 @@ void fim_diff_modify_compress_estimation(float compressed_size, float uncompress
     }
 }
 
-int fim_diff_compare(const diff_data *diff) {
-    os_md5 md5sum_old;
-    os_md5 md5sum_new;
-
-    md5sum_new[0] = '\0';
-    md5sum_old[0] = '\0';
-
-    /* Get md5sum of the old file */
-    if (OS_MD5_File(diff->uncompress_file, md5sum_old, OS_BINARY) != 0) {
-        return -1;
-    }
-
-    /* Get md5sum of the new file */
-    if (OS_MD5_File(diff->file_origin, md5sum_new, OS_BINARY) != 0) {
-        return -1;
-    }
-
-    /* If they match (not changes), keep the compress file and remove the uncompress, wait for changes */
-    if (strcmp(md5sum_new, md5sum_old) == 0) {
-        return -1;
-    }
-
-    return 0;
-}
+char *fim_diff_read_file(const char *path, size_t *size) {
+    FILE *fp;
+    char *content;
+    size_t capacity = OS_SIZE_8192;
+    size_t length = 0;
+    size_t n;
 
-char *fim_diff_generate(const diff_data *diff) {
-    char diff_cmd[PATH_MAX * 3 + OS_SIZE_1024];
-    char *diff_str = NULL;
-    char *uncompress_file_filtered = NULL;
-    char *file_origin_filtered = NULL;
-    char *diff_file_filtered = NULL;
-    int status = -1;
-
-    uncompress_file_filtered = filter(diff->uncompress_file);
-    file_origin_filtered = filter(diff->file_origin);
-    diff_file_filtered = filter(diff->diff_file);
-
-    if (!(uncompress_file_filtered && file_origin_filtered && diff_file_filtered)) {
-        LogDebug(FIM_DIFF_SKIPPED);
-        os_free(uncompress_file_filtered);
-        os_free(file_origin_filtered);
-        os_free(diff_file_filtered);
+    if (fp = wfopen(path, "rb"), !fp) {
+        LogError(FIM_ERROR_GENDIFF_OPEN, path);
         return NULL;
     }
 
-    snprintf(
-        diff_cmd,
-        sizeof(diff_cmd),
-#ifndef WIN32
-        "diff \"%s\" \"%s\" > \"%s\" 2> /dev/null",
-#else
-        "fc /n \"%s\" \"%s\" > \"%s\" 2> nul",
-#endif
-        uncompress_file_filtered,
-        file_origin_filtered,
-        diff_file_filtered
-    );
-    os_free(uncompress_file_filtered);
-    os_free(file_origin_filtered);
-    os_free(diff_file_filtered);
-
-    status = system(diff_cmd);
-
-#ifndef WIN32
-    if (status == 256){
-#else
-    if (status == 0){
-        LogDebug(FIM_DIFF_COMMAND_OUTPUT_EQUAL);
-    } else if (status == 1){
-#endif
-        diff_str = gen_diff_str(diff);
-    } else {
-        LogError(FIM_DIFF_COMMAND_OUTPUT_ERROR);
-    }
+    // Keep room for the terminating null byte
+    os_malloc(capacity + 1, content);
 
-    return diff_str;
-}
+    while (n = fread(content + length, 1, capacity - length, fp), n > 0) {
+        length += n;
 
-char *gen_diff_str(const diff_data *diff){
-    FILE *fp;
-    char buf[OS_MAXSTR + 1];
-    char *diff_str;
-    size_t n = 0;
+        if (length == capacity) {
+            capacity *= 2;
+            os_realloc(content, capacity + 1, content);
+        }
+    }
 
-    fp = wfopen(diff->diff_file, "rb");
-    if (!fp) {
-        LogError(FIM_ERROR_GENDIFF_OPEN, diff->diff_file);
+    if (ferror(fp)) {
+        LogError(FIM_ERROR_GENDIFF_READ);
+        fclose(fp);
+        os_free(content);
         return NULL;
     }
 
-    n = fread(buf, 1, OS_MAXSTR - OS_SK_HEADER - 1, fp);
     fclose(fp);
-    unlink(diff->diff_file);
 
-    if (!n){
-        LogError(FIM_ERROR_GENDIFF_READ);
-        return NULL;
-    }
+    content[length] = '\0';
+    *size = length;
 
-    buf[n] = '\0';
+    return content;
+}
 
-#ifdef WIN32
-    if (diff_str = adapt_win_fc_output(buf), !diff_str) {
-        return NULL;
+int fim_diff_compare(diff_data *diff) {
+    if (diff->content = fim_diff_read_file(diff->file_origin, &diff->content_size), !diff->content) {
+        return -1;
     }
-    n = strlen(diff_str);
-    char *p = strchr(buf, '\n');
 
-    if (p && p[1] != '*') {
-        if (n + strlen(STR_MORE_CHANGES) >= OS_MAXSTR - OS_SK_HEADER - 1) {
-            n -= strlen(STR_MORE_CHANGES);
-
-            while (n > 0 && diff_str[n - 1] != '\n')
-                n--;
-        }
-        strcpy(diff_str + n, STR_MORE_CHANGES);
+    /* If they match (no changes), keep the compress file, wait for changes */
+    if (diff->content_size == diff->baseline_size && memcmp(diff->content, diff->baseline, diff->content_size) == 0) {
+        return -1;
     }
-#else
-    os_strdup(buf, diff_str);
 
-    if(n >= OS_MAXSTR - OS_SK_HEADER - 1) {
-        n -= strlen(STR_MORE_CHANGES);
+    return 0;
+}
+
+char *fim_diff_generate(const diff_data *diff) {
+    char *diff_str;
 
-        while (n > 0 && diff_str[n - 1] != '\n')
-            n--;
+    diff_str = fim_line_diff(diff->baseline,
+                             diff->baseline_size,
+                             diff->content,
+                             diff->content_size,
+                             OS_MAXSTR - OS_SK_HEADER - 1);
 
-        strcpy(diff_str + n, STR_MORE_CHANGES);
+    if (!diff_str) {
+        LogDebug(FIM_DIFF_BINARY_CONTENT, diff->file_origin);
+        os_strdup("Binary files differ", diff_str);
     }
-#endif
 
     return diff_str;
 }
@@ -840,114 +743,6 @@ int is_registry_nodiff(const char *key_name, const char *value_name, int arch){
 }
 #endif
 
-char* filter(const char *string) {
-#ifndef WIN32
-    /* Unix version: we'll escape expansion symbols */
-    char *out;
-    const char *ptr;
-    size_t clen;
-    size_t len = strcspn(string, "\"\\$`");
-    os_malloc(len + 1, out);
-    ptr = string + len;
-    strncpy(out, string, len);
-
-    while (*ptr) {
-        clen = strcspn(ptr + 1, "\"\\$`");
-        out = realloc(out, len + clen + 3);
-        if(!out){
-            LogCritical(MEM_ERROR, errno, strerror(errno)); // LCOV_EXCL_LINE
-        }
-        out[len] = '\\';
-        out[len + 1] = *ptr;
-        strncpy(out + len + 2, ptr + 1, clen);
-        len += clen + 2;
-        ptr += clen + 1;
-    }
-
-    out[len] = '\0';
-    return out;
-#else
-    /* Windows file names can't contain the following characters:
-        \ / : * ? " < > |
-        We'll ban strings that contain dangerous characters and convert / into \ */
-
-    char *s;
-    char *c;
-
-    if (strchr(string, '%'))
-        return NULL;
-
-    s = strdup(string);
-    c = s;
-
-    while (c = strchr(c, '/'), c)
-        *c = '\\';
-
-    return s;
-#endif
-}
-
-#ifdef WIN32
-char *adapt_win_fc_output(char *command_output) {
-    char *adapted_output;
-    char *line;
-    char *next_line;
-    const char *line_tag = ":  ";
-    const char *split_tag = "---";
-    char line_mode = 0; // 0: waiting for section, 1: remove, 2: add
-    char first_line = 0;
-    size_t line_tag_size = strlen(line_tag);
-    size_t written = 0;
-
-    if (line = strchr(command_output, '\n'), !line) {
-        LogDebug("%s: %s", FIM_ERROR_GENDIFF_SECONDLINE_MISSING, command_output);
-        return strdup(command_output);
-    }
-
-    os_calloc(OS_MAXSTR + 1, sizeof(char), adapted_output);
-
-    while (line) {
-        next_line = strstr(++line, "\r\n");
-
-        if (*line == '*') {
-            if (next_line) {
-                next_line++;
-            }
-
-            if (!line_mode) {
-                if (first_line) {
-                    written += snprintf(adapted_output + written, OS_MAXSTR - written, "%s\n", split_tag);
-                }
-                first_line = 1;
-            } else if (line_mode == 1) {
-                written += snprintf(adapted_output + written, OS_MAXSTR - written, "%s\n", split_tag);
-            }
-
-            line_mode = (line_mode + 1) % 3;
-            goto next_it;
-        }
-
-        if (next_line) {
-            *(next_line++) = '\0';
-            *next_line = '\0';
-        }
-
-        if (line = strstr(line, line_tag), !line) {
-            goto next_it;
-        } else {
-            line += line_tag_size;
-        }
-
-        written += snprintf(adapted_output + written, OS_MAXSTR - written, "%s%s%s", line_mode == 1 ? "< " : "> ", line, next_line ? "\n" : "");
-
-next_it:
-        line = next_line;
-    }
-
-    return adapted_output;
-}
-#endif
-
 void fim_diff_process_delete_file(const char *filename){
     char *full_path;
     char buffer[PATH_MAX];
@@ -0,0 +1,613 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "syscheck.h"
+
+// Remove static qualifier from tests
+#ifdef WAZUH_UNIT_TESTING
+#define static
+#endif
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static const char *STR_MORE_CHANGES = "More changes...";
+static const char *STR_NO_NEWLINE = "\\ No newline at end of file\n";
+
+/* A line of one of the compared contents, including its newline if it has one */
+typedef struct fim_diff_line_t {
+    const char *start;
+    size_t length;
+} fim_diff_line_t;
+
+/* Entry of the table that gives the same id to the lines with the same content */
+typedef struct fim_diff_slot_t {
+    uint64_t hash;
+    const fim_diff_line_t *line;
+    unsigned int id;
+} fim_diff_slot_t;
+
+/* State of the comparison of two contents */
+typedef struct fim_diff_context_t {
+    unsigned int *old_ids;
+    unsigned int *new_ids;
+    char *old_changed;          // Lines of the old content that aren't in the new one
+    char *new_changed;          // Lines of the new content that aren't in the old one
+    long *forward;              // Furthest point reached on each diagonal by the forward search
+    long *backward;             // Furthest point reached on each diagonal by the backward search
+    long max_cost;              // Cost after which a split is chosen without finding the shortest script
+} fim_diff_context_t;
+
+/* Output of the diff, cut once it reaches the maximum length */
+typedef struct fim_diff_output_t {
+    char *data;
+    size_t length;
+    size_t capacity;
+    size_t max_length;
+    bool full;
+} fim_diff_output_t;
+
+/**
+ * @brief Splits a content into lines
+ *
+ * @param data Content to split
+ * @param size Size of the content
+ * @param lines Array with the lines, pointing into data. Must be freed by the caller
+ * @return Number of lines
+ */
+static size_t fim_diff_split_lines(const char *data, size_t size, fim_diff_line_t **lines) {
+    const char *end = data + size;
+    const char *next;
+    const char *it;
+    size_t count = 0;
+
+    for (it = data; it < end; it = next, count++) {
+        next = memchr(it, '\n', end - it);
+        next = next ? next + 1 : end;
+    }
+
+    os_calloc(count + 1, sizeof(fim_diff_line_t), *lines);
+
+    for (it = data, count = 0; it < end; it = next, count++) {
+        next = memchr(it, '\n', end - it);
+        next = next ? next + 1 : end;
+
+        (*lines)[count].start = it;
+        (*lines)[count].length = next - it;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Gives each line an id, so that the search compares integers instead of strings
+ *
+ * @param old_lines Lines of the old content
+ * @param old_count Number of lines of the old content
+ * @param new_lines Lines of the new content
+ * @param new_count Number of lines of the new content
+ * @param old_ids Id of each line of the old content
+ * @param new_ids Id of each line of the new content
+ * @return Number of different ids
+ */
+static unsigned int fim_diff_assign_ids(const fim_diff_line_t *old_lines,
+                                        size_t old_count,
+                                        const fim_diff_line_t *new_lines,
+                                        size_t new_count,
+                                        unsigned int *old_ids,
+                                        unsigned int *new_ids) {
+    fim_diff_slot_t *table;
+    size_t table_size = 16;
+    unsigned int next_id = 0;
+    size_t i;
+    size_t j;
+
+    while (table_size < (old_count + new_count) * 2) {
+        table_size <<= 1;
+    }
+
+    os_calloc(table_size, sizeof(fim_diff_slot_t), table);
+
+    for (i = 0; i < old_count + new_count; i++) {
+        const fim_diff_line_t *line = i < old_count ? &old_lines[i] : &new_lines[i - old_count];
+        uint64_t hash = FNV_OFFSET_BASIS;
+        fim_diff_slot_t *slot;
+
+        for (j = 0; j < line->length; j++) {
+            hash = (hash ^ (unsigned char)line->start[j]) * FNV_PRIME;
+        }
+
+        for (j = hash & (table_size - 1);; j = (j + 1) & (table_size - 1)) {
+            slot = &table[j];
+
+            if (slot->line == NULL) {
+                slot->hash = hash;
+                slot->line = line;
+                slot->id = next_id++;
+                break;
+            }
+
+            if (slot->hash == hash && slot->line->length == line->length &&
+                memcmp(slot->line->start, line->start, line->length) == 0) {
+                break;
+            }
+        }
+
+        if (i < old_count) {
+            old_ids[i] = slot->id;
+        } else {
+            new_ids[i - old_count] = slot->id;
+        }
+    }
+
+    os_free(table);
+
+    return next_id;
+}
+
+/**
+ * @brief Leaves out of the search the lines that don't appear in the other content, which are changes for sure.
+ * Rewritten files have many of them, and the search is much faster without them.
+ *
+ * @param ids Id of each line
+ * @param count Number of lines
+ * @param in_other Whether each id appears in the other content
+ * @param kept_ids Ids of the lines that are kept for the search
+ * @param kept_lines Index of each kept line in the content
+ * @param changed Marks the lines left out as changed
+ * @return Number of kept lines
+ */
+static long fim_diff_discard_lines(const unsigned int *ids,
+                                   size_t count,
+                                   const char *in_other,
+                                   unsigned int *kept_ids,
+                                   size_t *kept_lines,
+                                   char *changed) {
+    long kept = 0;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        if (in_other[ids[i]]) {
+            kept_ids[kept] = ids[i];
+            kept_lines[kept++] = i;
+        } else {
+            changed[i] = 1;
+        }
+    }
+
+    return kept;
+}
+
+/**
+ * @brief Finds the middle snake of the shortest edit script between old[xoff, xlim) and new[yoff, ylim), searching
+ * from both ends at once. Once the cost exceeds max_cost, it settles for the point that went furthest.
+ *
+ * Both ranges must be non-empty and differ on their first and last lines.
+ *
+ * @param context Comparison context
+ * @param xoff First line of the old range
+ * @param xlim End of the old range
+ * @param yoff First line of the new range
+ * @param ylim End of the new range
+ * @param xmid Line of the old range where it's split
+ * @param ymid Line of the new range where it's split
+ */
+static void fim_diff_split(fim_diff_context_t *context,
+                           long xoff,
+                           long xlim,
+                           long yoff,
+                           long ylim,
+                           long *xmid,
+                           long *ymid) {
+    const unsigned int *old_ids = context->old_ids;
+    const unsigned int *new_ids = context->new_ids;
+    long *fd = context->forward;
+    long *bd = context->backward;
+    const long dmin = xoff - ylim;
+    const long dmax = xlim - yoff;
+    const long fmid = xoff - yoff;
+    const long bmid = xlim - ylim;
+    const bool odd = (fmid - bmid) & 1;
+    long fmin = fmid;
+    long fmax = fmid;
+    long bmin = bmid;
+    long bmax = bmid;
+    long cost;
+    long d;
+
+    fd[fmid] = xoff;
+    bd[bmid] = xlim;
+
+    for (cost = 1;; cost++) {
+        // Extend the forward search by one edit
+        if (fmin > dmin) {
+            fd[--fmin - 1] = -1;
+        } else {
+            ++fmin;
+        }
+
+        if (fmax < dmax) {
+            fd[++fmax + 1] = -1;
+        } else {
+            --fmax;
+        }
+
+        for (d = fmax; d >= fmin; d -= 2) {
+            long x = fd[d - 1] >= fd[d + 1] ? fd[d - 1] + 1 : fd[d + 1];
+            long y = x - d;
+
+            while (x < xlim && y < ylim && old_ids[x] == new_ids[y]) {
+                x++;
+                y++;
+            }
+
+            fd[d] = x;
+
+            if (odd && bmin <= d && d <= bmax && bd[d] <= x) {
+                *xmid = x;
+                *ymid = y;
+                return;
+            }
+        }
+
+        // Extend the backward search by one edit
+        if (bmin > dmin) {
+            bd[--bmin - 1] = LONG_MAX;
+        } else {
+            ++bmin;
+        }
+
+        if (bmax < dmax) {
+            bd[++bmax + 1] = LONG_MAX;
+        } else {
+            --bmax;
+        }
+
+        for (d = bmax; d >= bmin; d -= 2) {
+            long x = bd[d - 1] < bd[d + 1] ? bd[d - 1] : bd[d + 1] - 1;
+            long y = x - d;
+
+            while (x > xoff && y > yoff && old_ids[x - 1] == new_ids[y - 1]) {
+                x--;
+                y--;
+            }
+
+            bd[d] = x;
+
+            if (!odd && fmin <= d && d <= fmax && x <= fd[d]) {
+                *xmid = x;
+                *ymid = y;
+                return;
+            }
+        }
+
+        if (cost >= context->max_cost) {
+            // Too expensive: split where either search got closest to its end
+            long fxybest = -1;
+            long fxbest = xoff;
+            long bxybest = LONG_MAX;
+            long bxbest = xlim;
+
+            for (d = fmax; d >= fmin; d -= 2) {
+                long x = fd[d] < xlim ? fd[d] : xlim;
+                long y = x - d;
+
+                if (ylim < y) {
+                    x = ylim + d;
+                    y = ylim;
+                }
+
+                if (fxybest < x + y) {
+                    fxybest = x + y;
+                    fxbest = x;
+                }
+            }
+
+            for (d = bmax; d >= bmin; d -= 2) {
+                long x = bd[d] > xoff ? bd[d] : xoff;
+                long y = x - d;
+
+                if (y < yoff) {
+                    x = yoff + d;
+                    y = yoff;
+                }
+
+                if (x + y < bxybest) {
+                    bxybest = x + y;
+                    bxbest = x;
+                }
+            }
+
+            if ((xlim + ylim) - bxybest < fxybest - (xoff + yoff)) {
+                *xmid = fxbest;
+                *ymid = fxybest - fxbest;
+            } else {
+                *xmid = bxbest;
+                *ymid = bxybest - bxbest;
+            }
+
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Marks the lines of old[xoff, xlim) and new[yoff, ylim) that aren't common to both ranges
+ *
+ * @param context Comparison context
+ * @param xoff First line of the old range
+ * @param xlim End of the old range
+ * @param yoff First line of the new range
+ * @param ylim End of the new range
+ */
+static void fim_diff_compare_ranges(fim_diff_context_t *context, long xoff, long xlim, long yoff, long ylim) {
+    long xmid;
+    long ymid;
+
+    // Skip the lines that both ranges start and end with
+    while (xoff < xlim && yoff < ylim && context->old_ids[xoff] == context->new_ids[yoff]) {
+        xoff++;
+        yoff++;
+    }
+
+    while (xoff < xlim && yoff < ylim && context->old_ids[xlim - 1] == context->new_ids[ylim - 1]) {
+        xlim--;
+        ylim--;
+    }
+
+    if (xoff == xlim) {
+        memset(context->new_changed + yoff, 1, ylim - yoff);
+    } else if (yoff == ylim) {
+        memset(context->old_changed + xoff, 1, xlim - xoff);
+    } else {
+        fim_diff_split(context, xoff, xlim, yoff, ylim, &xmid, &ymid);
+        fim_diff_compare_ranges(context, xoff, xmid, yoff, ymid);
+        fim_diff_compare_ranges(context, xmid, xlim, ymid, ylim);
+    }
+}
+
+/**
+ * @brief Appends data to the output, marking it as full once it reaches the maximum length
+ *
+ * @param output Output of the diff
+ * @param data Data to append
+ * @param length Length of the data
+ */
+static void fim_diff_append(fim_diff_output_t *output, const char *data, size_t length) {
+    if (output->full) {
+        return;
+    }
+
+    if (output->length + length >= output->max_length) {
+        length = output->max_length - output->length;
+        output->full = true;
+    }
+
+    if (output->length + length + 1 > output->capacity) {
+        while (output->length + length + 1 > output->capacity) {
+            output->capacity *= 2;
+        }
+
+        os_realloc(output->data, output->capacity, output->data);
+    }
+
+    memcpy(output->data + output->length, data, length);
+    output->length += length;
+    output->data[output->length] = '\0';
+}
+
+/**
+ * @brief Appends a range of lines as diff prints it: "first,last", or just "first" if it has a single line
+ *
+ * @param output Output of the diff
+ * @param first Index of the first line of the range
+ * @param end Index after the last line of the range
+ */
+static void fim_diff_append_range(fim_diff_output_t *output, size_t first, size_t end) {
+    char buffer[OS_SIZE_64];
+    int length;
+
+    if (end - first > 1) {
+        length = snprintf(buffer, sizeof(buffer), "%zu,%zu", first + 1, end);
+    } else {
+        length = snprintf(buffer, sizeof(buffer), "%zu", end > first ? first + 1 : first);
+    }
+
+    fim_diff_append(output, buffer, length);
+}
+
+/**
+ * @brief Appends the lines of a hunk, each one preceded by the given prefix
+ *
+ * @param output Output of the diff
+ * @param prefix "< " for removed lines, "> " for added lines
+ * @param lines Lines of the hunk
+ * @param count Number of lines
+ */
+static void fim_diff_append_lines(fim_diff_output_t *output,
+                                  const char *prefix,
+                                  const fim_diff_line_t *lines,
+                                  size_t count) {
+    size_t i;
+
+    for (i = 0; i < count && !output->full; i++) {
+        fim_diff_append(output, prefix, 2);
+        fim_diff_append(output, lines[i].start, lines[i].length);
+
+        if (lines[i].start[lines[i].length - 1] != '\n') {
+            fim_diff_append(output, "\n", 1);
+            fim_diff_append(output, STR_NO_NEWLINE, strlen(STR_NO_NEWLINE));
+        }
+    }
+}
+
+char *fim_line_diff(const char *old_data, size_t old_size, const char *new_data, size_t new_size, size_t max_length) {
+    fim_diff_output_t output = { .length = 0, .capacity = OS_SIZE_1024, .max_length = max_length, .full = false };
+    fim_diff_context_t context = { .max_cost = 1 };
+    fim_diff_line_t *old_lines = NULL;
+    fim_diff_line_t *new_lines = NULL;
+    unsigned int *old_ids = NULL;
+    unsigned int *new_ids = NULL;
+    size_t *old_kept_lines = NULL;
+    size_t *new_kept_lines = NULL;
+    char *old_changed = NULL;
+    char *new_changed = NULL;
+    char *in_old = NULL;
+    char *in_new = NULL;
+    unsigned int id_count;
+    size_t old_count;
+    size_t new_count;
+    long old_kept;
+    long new_kept;
+    size_t diagonals;
+    size_t i = 0;
+    size_t j = 0;
+    long k;
+
+    // Like diff, don't compare binary contents line by line
+    if (memchr(old_data, '\0', old_size) != NULL || memchr(new_data, '\0', new_size) != NULL) {
+        return NULL;
+    }
+
+    old_count = fim_diff_split_lines(old_data, old_size, &old_lines);
+    new_count = fim_diff_split_lines(new_data, new_size, &new_lines);
+
+    os_calloc(old_count + 1, sizeof(unsigned int), old_ids);
+    os_calloc(new_count + 1, sizeof(unsigned int), new_ids);
+    os_calloc(old_count + 1, sizeof(char), old_changed);
+    os_calloc(new_count + 1, sizeof(char), new_changed);
+
+    id_count = fim_diff_assign_ids(old_lines, old_count, new_lines, new_count, old_ids, new_ids);
+
+    os_calloc(id_count + 1, sizeof(char), in_old);
+    os_calloc(id_count + 1, sizeof(char), in_new);
+
+    for (i = 0; i < old_count; i++) {
+        in_old[old_ids[i]] = 1;
+    }
+
+    for (j = 0; j < new_count; j++) {
+        in_new[new_ids[j]] = 1;
+    }
+
+    os_calloc(old_count + 1, sizeof(unsigned int), context.old_ids);
+    os_calloc(new_count + 1, sizeof(unsigned int), context.new_ids);
+    os_calloc(old_count + 1, sizeof(size_t), old_kept_lines);
+    os_calloc(new_count + 1, sizeof(size_t), new_kept_lines);
+
+    old_kept = fim_diff_discard_lines(old_ids, old_count, in_new, context.old_ids, old_kept_lines, old_changed);
+    new_kept = fim_diff_discard_lines(new_ids, new_count, in_old, context.new_ids, new_kept_lines, new_changed);
+
+    os_calloc(old_kept + 1, sizeof(char), context.old_changed);
+    os_calloc(new_kept + 1, sizeof(char), context.new_changed);
+
+    // The diagonals go from -new_kept to old_kept, with room for one more on each side
+    diagonals = old_kept + new_kept + 3;
+    os_calloc(diagonals, sizeof(long), context.forward);
+    os_calloc(diagonals, sizeof(long), context.backward);
+
+    // Allow a cost of about the square root of the number of diagonals before looking for a shortcut
+    for (; diagonals != 0; diagonals >>= 2) {
+        context.max_cost <<= 1;
+    }
+
+    if (context.max_cost < OS_SIZE_4096) {
+        context.max_cost = OS_SIZE_4096;
+    }
+
+    // Index the searches by diagonal, which can be negative
+    context.forward += new_kept + 1;
+    context.backward += new_kept + 1;
+
+    fim_diff_compare_ranges(&context, 0, old_kept, 0, new_kept);
+
+    context.forward -= new_kept + 1;
+    context.backward -= new_kept + 1;
+
+    for (k = 0; k < old_kept; k++) {
+        old_changed[old_kept_lines[k]] = context.old_changed[k];
+    }
+
+    for (k = 0; k < new_kept; k++) {
+        new_changed[new_kept_lines[k]] = context.new_changed[k];
+    }
+
+    i = 0;
+    j = 0;
+
+    os_malloc(output.capacity, output.data);
+    output.data[0] = '\0';
+
+    // Print each group of consecutive changes as a hunk of the normal diff format
+    while ((i < old_count || j < new_count) && !output.full) {
+        size_t old_first;
+        size_t new_first;
+
+        if (i < old_count && j < new_count && !old_changed[i] && !new_changed[j]) {
+            i++;
+            j++;
+            continue;
+        }
+
+        old_first = i;
+        new_first = j;
+
+        while (i < old_count && old_changed[i]) {
+            i++;
+        }
+
+        while (j < new_count && new_changed[j]) {
+            j++;
+        }
+
+        fim_diff_append_range(&output, old_first, i);
+        fim_diff_append(&output, i == old_first ? "a" : j == new_first ? "d" : "c", 1);
+        fim_diff_append_range(&output, new_first, j);
+        fim_diff_append(&output, "\n", 1);
+
+        fim_diff_append_lines(&output, "< ", old_lines + old_first, i - old_first);
+
+        if (i > old_first && j > new_first) {
+            fim_diff_append(&output, "---\n", 4);
+        }
+
+        fim_diff_append_lines(&output, "> ", new_lines + new_first, j - new_first);
+    }
+
+    if (output.full) {
+        // Cut the output at the end of a line to make room for the notice
+        size_t n = output.length > strlen(STR_MORE_CHANGES) ? output.length - strlen(STR_MORE_CHANGES) : 0;
+
+        while (n > 0 && output.data[n - 1] != '\n') {
+            n--;
+        }
+
+        strcpy(output.data + n, STR_MORE_CHANGES);
+    }
+
+    os_free(old_lines);
+    os_free(new_lines);
+    os_free(old_ids);
+    os_free(new_ids);
+    os_free(old_kept_lines);
+    os_free(new_kept_lines);
+    os_free(old_changed);
+    os_free(new_changed);
+    os_free(in_old);
+    os_free(in_new);
+    os_free(context.old_ids);
+    os_free(context.new_ids);
+    os_free(context.old_changed);
+    os_free(context.new_changed);
+    os_free(context.forward);
+    os_free(context.backward);
+
+    return output.data;
+}
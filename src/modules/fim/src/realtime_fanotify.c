@@ -0,0 +1,315 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+// open_by_handle_at and O_PATH are Linux specific and are only picked up with _GNU_SOURCE
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "shared.h"
+#include "syscheck.h"
+
+#ifdef INOTIFY_ENABLED
+#include <fcntl.h>
+#include <sys/fanotify.h>
+#include <sys/statfs.h>
+
+#ifdef WAZUH_UNIT_TESTING
+/* Remove static qualifier when unit testing */
+#define static
+#endif
+
+/* The agent may be built against headers older than the kernel it runs on. The ABI is stable, so the
+ * constants are defined here when missing and an old kernel just fails fanotify_init. */
+#ifndef FAN_ATTRIB
+#define FAN_ATTRIB 0x00000004
+#endif
+#ifndef FAN_MOVED_FROM
+#define FAN_MOVED_FROM 0x00000040
+#endif
+#ifndef FAN_MOVED_TO
+#define FAN_MOVED_TO 0x00000080
+#endif
+#ifndef FAN_CREATE
+#define FAN_CREATE 0x00000100
+#endif
+#ifndef FAN_DELETE
+#define FAN_DELETE 0x00000200
+#endif
+#ifndef FAN_MARK_FILESYSTEM
+#define FAN_MARK_FILESYSTEM 0x00000100
+#endif
+#ifndef FAN_REPORT_DFID_NAME
+#define FAN_REPORT_DFID_NAME (0x00000400 | 0x00000800)
+#endif
+#ifndef FAN_EVENT_INFO_TYPE_DFID_NAME
+#define FAN_EVENT_INFO_TYPE_DFID_NAME 2
+#endif
+
+#ifndef FAN_EVENT_INFO_TYPE_FID
+struct fanotify_event_info_header {
+    __u8 info_type;
+    __u8 pad;
+    __u16 len;
+};
+
+struct fanotify_event_info_fid {
+    struct fanotify_event_info_header hdr;
+    __kernel_fsid_t fsid;
+    unsigned char handle[0];
+};
+#endif
+
+#define FANOTIFY_MONITOR_FLAGS  (FAN_MODIFY | FAN_ATTRIB | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_CREATE | FAN_DELETE | FAN_ONDIR)
+#define FANOTIFY_EVENT_BUFFER   (64 * 1024)
+
+/* Filesystem seen by fim_fanotify_watch, marked or not */
+typedef struct fim_fanotify_fs_s {
+    dev_t dev;
+    fsid_t fsid;
+    int mount_fd;                       // Directory of the marked path to resolve file handles, -1 if not marked
+} fim_fanotify_fs_t;
+
+/* Directory resolved for the previous event, events on the same directory tend to come together */
+typedef struct fim_fanotify_cache_s {
+    unsigned char handle[sizeof(struct file_handle) + MAX_HANDLE_SZ];
+    size_t handle_size;
+    fsid_t fsid;
+    char path[PATH_MAX];
+} fim_fanotify_cache_t;
+
+static int _fanotify_fd = -1;
+static fim_fanotify_fs_t *_filesystems = NULL;
+static size_t _filesystems_count = 0;
+
+int fim_fanotify_start() {
+    _fanotify_fd = fanotify_init(FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_REPORT_DFID_NAME, O_RDONLY | O_LARGEFILE);
+
+    if (_fanotify_fd < 0) {
+        LogWarn(FIM_WARN_FANOTIFY_INITIALIZE, errno, strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+int fim_fanotify_get_fd() {
+    return _fanotify_fd;
+}
+
+unsigned int fim_fanotify_get_marks() {
+    unsigned int marks = 0;
+    size_t i;
+
+    for (i = 0; i < _filesystems_count; i++) {
+        if (_filesystems[i].mount_fd >= 0) {
+            marks++;
+        }
+    }
+
+    return marks;
+}
+
+int fim_fanotify_watch(const char *path, const directory_t *configuration) {
+    const int follow = configuration->options & CHECK_FOLLOW;
+    fim_fanotify_fs_t *filesystem;
+    char directory[PATH_MAX];
+    const char *separator;
+    struct statfs fs_info;
+    struct stat statbuf;
+    size_t i;
+
+    if (_fanotify_fd < 0) {
+        return 0;
+    }
+
+    if ((follow ? stat(path, &statbuf) : lstat(path, &statbuf)) != 0) {
+        return 0;
+    }
+
+    for (i = 0; i < _filesystems_count; i++) {
+        if (_filesystems[i].dev == statbuf.st_dev) {
+            return _filesystems[i].mount_fd >= 0;
+        }
+    }
+
+    // First path seen on this filesystem, a failed mark is remembered so its directories go straight to inotify
+    os_realloc(_filesystems, (_filesystems_count + 1) * sizeof(fim_fanotify_fs_t), _filesystems);
+    filesystem = &_filesystems[_filesystems_count++];
+    filesystem->dev = statbuf.st_dev;
+    filesystem->mount_fd = -1;
+
+    if (statfs(path, &fs_info) != 0 ||
+        fanotify_mark(_fanotify_fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM | (follow ? 0 : FAN_MARK_DONT_FOLLOW),
+                      FANOTIFY_MONITOR_FLAGS, AT_FDCWD, path) != 0) {
+        LogDebug(FIM_FANOTIFY_MARK_FAILED, path, errno, strerror(errno));
+        return 0;
+    }
+
+    // open_by_handle_at needs a readable descriptor, files and links are resolved through their directory
+    if (S_ISDIR(statbuf.st_mode)) {
+        snprintf(directory, sizeof(directory), "%s", path);
+    } else if (separator = strrchr(path, PATH_SEP), separator != NULL && separator != path) {
+        snprintf(directory, sizeof(directory), "%.*s", (int) (separator - path), path);
+    } else {
+        snprintf(directory, sizeof(directory), "%c", PATH_SEP);
+    }
+
+    filesystem->fsid = fs_info.f_fsid;
+    filesystem->mount_fd = open(directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (filesystem->mount_fd < 0) {
+        LogDebug(FIM_FANOTIFY_MARK_FAILED, path, errno, strerror(errno));
+        fanotify_mark(_fanotify_fd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM | (follow ? 0 : FAN_MARK_DONT_FOLLOW),
+                      FANOTIFY_MONITOR_FLAGS, AT_FDCWD, path);
+        return 0;
+    }
+
+    LogDebug(FIM_FANOTIFY_MARK, path);
+    return 1;
+}
+
+/**
+ * @brief Builds the path of the entry an event refers to, from its parent directory handle and its name
+ *
+ * @param fid Directory handle and name reported with the event
+ * @param cache Directory resolved for the previous event
+ * @param path Buffer where the path is written
+ * @return 0 on success, -1 if the directory doesn't exist anymore or isn't in a marked filesystem
+ */
+static int fim_fanotify_event_path(const struct fanotify_event_info_fid *fid, fim_fanotify_cache_t *cache, char *path) {
+    const struct file_handle *handle = (const struct file_handle *) fid->handle;
+    const size_t handle_size = sizeof(struct file_handle) + handle->handle_bytes;
+    const char *name = (const char *) handle->f_handle + handle->handle_bytes;
+    char proc_path[OS_SIZE_64];
+    ssize_t length;
+    size_t i;
+    int fd;
+
+    if (handle_size > sizeof(cache->handle)) {
+        return -1;
+    }
+
+    if (handle_size != cache->handle_size || memcmp(&cache->fsid, &fid->fsid, sizeof(fsid_t)) != 0 ||
+        memcmp(cache->handle, handle, handle_size) != 0) {
+        for (i = 0; i < _filesystems_count; i++) {
+            if (_filesystems[i].mount_fd >= 0 && memcmp(&_filesystems[i].fsid, &fid->fsid, sizeof(fsid_t)) == 0) {
+                break;
+            }
+        }
+
+        if (i == _filesystems_count) {
+            return -1;
+        }
+
+        if (fd = open_by_handle_at(_filesystems[i].mount_fd, (struct file_handle *) handle, O_PATH | O_CLOEXEC),
+            fd < 0) {
+            return -1;
+        }
+
+        snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", fd);
+        length = readlink(proc_path, cache->path, PATH_MAX - 1);
+        close(fd);
+
+        if (length <= 0) {
+            cache->handle_size = 0;
+            return -1;
+        }
+
+        cache->path[length] = '\0';
+        memcpy(cache->handle, handle, handle_size);
+        memcpy(&cache->fsid, &fid->fsid, sizeof(fsid_t));
+        cache->handle_size = handle_size;
+    }
+
+    // Events on the directory itself come with the name "."
+    if (strcmp(name, ".") == 0) {
+        snprintf(path, PATH_MAX, "%s", cache->path);
+    } else if (cache->path[strlen(cache->path) - 1] == PATH_SEP) {
+        snprintf(path, PATH_MAX, "%s%s", cache->path, name);
+    } else {
+        snprintf(path, PATH_MAX, "%s/%s", cache->path, name);
+    }
+
+    return 0;
+}
+
+void fim_fanotify_process() {
+    char buf[FANOTIFY_EVENT_BUFFER] __attribute__((aligned(__alignof__(struct fanotify_event_metadata))));
+    const struct fanotify_event_metadata *event;
+    fim_fanotify_cache_t cache = { .handle_size = 0 };
+    char path[PATH_MAX];
+    bool overflow = false;
+    ssize_t len;
+
+    w_mutex_lock(&syscheck.fim_realtime_mutex);
+    len = read(_fanotify_fd, buf, sizeof(buf));
+    w_mutex_unlock(&syscheck.fim_realtime_mutex);
+
+    if (len < 0) {
+        LogError(FIM_ERROR_REALTIME_READ_BUFFER);
+        return;
+    }
+
+    rb_tree *tree = rbtree_init();
+
+    // The marks cover whole filesystems, so events outside the realtime directories are dropped here
+    w_rwlock_rdlock(&syscheck.directories_lock);
+    w_mutex_lock(&syscheck.fim_realtime_mutex);
+
+    for (event = (const struct fanotify_event_metadata *) buf; FAN_EVENT_OK(event, len); event = FAN_EVENT_NEXT(event, len)) {
+        const struct fanotify_event_info_fid *fid = (const struct fanotify_event_info_fid *) (event + 1);
+        const directory_t *configuration;
+
+        if (event->mask & FAN_Q_OVERFLOW) {
+            overflow = true;
+            continue;
+        }
+
+        if (event->event_len < sizeof(*event) + sizeof(*fid) || fid->hdr.info_type != FAN_EVENT_INFO_TYPE_DFID_NAME) {
+            continue;
+        }
+
+        if (fim_fanotify_event_path(fid, &cache, path) != 0) {
+            continue;
+        }
+
+        configuration = fim_configuration_directory(path);
+
+        if (configuration == NULL || FIM_MODE(configuration->options) != FIM_REALTIME) {
+            continue;
+        }
+
+        if (rbtree_insert(tree, path, NULL) == NULL) {
+            LogDebug("Duplicate event in real-time buffer: %s", path);
+        }
+    }
+
+    w_mutex_unlock(&syscheck.fim_realtime_mutex);
+    w_rwlock_unlock(&syscheck.directories_lock);
+
+    if (overflow) {
+        LogWarn("Real-time fanotify kernel queue is full. Some events may be lost. Next scheduled scan will recover lost data.");
+        fim_realtime_set_queue_overflow(true);
+        send_log_msg("ossec: Real-time fanotify kernel queue is full. Some events may be lost. Next scheduled scan will recover lost data.");
+    }
+
+    char **paths = rbtree_keys(tree);
+
+    for (int i = 0; paths[i] != NULL; i++) {
+        w_rwlock_rdlock(&syscheck.directories_lock);
+        fim_realtime_event(paths[i]);
+        w_rwlock_unlock(&syscheck.directories_lock);
+    }
+
+    free_strarray(paths);
+    rbtree_destroy(tree);
+}
+
+#endif /* INOTIFY_ENABLED */
@@ -457,6 +457,7 @@ DWORD WINAPI fim_run_realtime(__attribute__((unused)) void * args) {
 #elif defined INOTIFY_ENABLED
 void *fim_run_realtime(__attribute__((unused)) void * args) {
     int nfds = -1;
+    int fanotify_fd = -1;
 
     fim_realtime_print_watches();
 
@@ -465,6 +466,7 @@ void *fim_run_realtime(__attribute__((unused)) void * args) {
         if (syscheck.realtime && (syscheck.realtime->fd >= 0)) {
             nfds = syscheck.realtime->fd;
         }
+        fanotify_fd = fim_fanotify_get_fd();
         w_mutex_unlock(&syscheck.fim_realtime_mutex);
 
         if (nfds >= 0) {
@@ -479,14 +481,22 @@ void *fim_run_realtime(__attribute__((unused)) void * args) {
             // zero-out the fd_set
             FD_ZERO (&rfds);
             FD_SET(nfds, &rfds);
-            run_now = select(nfds + 1, &rfds, NULL, NULL, &selecttime);
+            if (fanotify_fd >= 0) {
+                FD_SET(fanotify_fd, &rfds);
+            }
+            run_now = select((fanotify_fd > nfds ? fanotify_fd : nfds) + 1, &rfds, NULL, NULL, &selecttime);
 
             if (run_now < 0) {
                 LogError(FIM_ERROR_SELECT);
             } else if (run_now == 0) {
                 // Timeout
-            } else if (FD_ISSET (nfds, &rfds)) {
-                realtime_process();
+            } else {
+                if (FD_ISSET (nfds, &rfds)) {
+                    realtime_process();
+                }
+                if (fanotify_fd >= 0 && FD_ISSET (fanotify_fd, &rfds)) {
+                    fim_fanotify_process();
+                }
             }
 
         } else {
@@ -51,6 +51,11 @@ int realtime_start() {
         goto error;
     }
 
+    // inotify stays available for the filesystems fanotify can't mark
+    if (fim_realtime_fanotify) {
+        fim_fanotify_start();
+    }
+
     return (0);
 
 error:
@@ -75,6 +80,10 @@ int fim_add_inotify_watch(const char *dir, const directory_t *configuration) {
     if (syscheck.realtime->fd < 0) {
         w_mutex_unlock(&syscheck.fim_realtime_mutex);
         return (-1);
+    } else if (fim_fanotify_watch(dir, configuration) == 1) {
+        // The whole filesystem is already monitored by fanotify
+        w_mutex_unlock(&syscheck.fim_realtime_mutex);
+        return 1;
     } else {
         int wd = 0;
 
@@ -778,6 +787,11 @@ void fim_realtime_print_watches() {
     w_mutex_lock(&syscheck.fim_realtime_mutex);
     if (syscheck.realtime != NULL) {
         LogDebug(FIM_NUM_WATCHES, OSHash_Get_Elem_ex(syscheck.realtime->dirtb));
+#ifdef INOTIFY_ENABLED
+        if (fim_fanotify_get_fd() >= 0) {
+            LogDebug(FIM_NUM_FANOTIFY_MARKS, fim_fanotify_get_marks());
+        }
+#endif
     }
     w_mutex_unlock(&syscheck.fim_realtime_mutex);
 }
@@ -0,0 +1,513 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef WIN32
+
+#include "shared.h"
+#include "syscheck.h"
+#include "db/include/db.h"
+
+#ifdef WAZUH_UNIT_TESTING
+/* Remove static qualifier when unit testing */
+#define static
+#endif
+
+/* Files hashed and waiting for the writer, per scan thread */
+#define FIM_WALK_RESULTS_PER_THREAD 64
+
+/* File hashed by a scan thread, to be synced into the DB by the writer */
+typedef struct fim_walk_result_s {
+    char *path;
+    fim_file_data *data;
+} fim_walk_result_t;
+
+typedef struct fim_walker_s fim_walker_t;
+
+/* Scan thread */
+typedef struct fim_walk_worker_s {
+    fim_walker_t *walker;
+    int id;
+    fim_walk_deque_t deque;             // Paths queued to this thread and not processed yet
+    fim_scan_hashes_t hashes;           // Hashing of the files scanned by this thread
+} fim_walk_worker_t;
+
+struct fim_walker_s {
+    fim_walk_worker_t *workers;
+    int threads;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t work_available;
+    size_t queued;                      // Paths in the deques
+    size_t pending;                     // Paths in the deques or being processed
+
+    pthread_mutex_t results_mutex;
+    pthread_cond_t results_available;
+    pthread_cond_t results_space;
+    fim_walk_result_t *results;
+    size_t results_head;
+    size_t results_count;
+    size_t results_capacity;
+    int running;                        // Scan threads that haven't finished yet
+};
+
+void fim_walk_deque_init(fim_walk_deque_t *deque) {
+    w_mutex_init(&deque->mutex, NULL);
+    deque->items = NULL;
+    deque->head = 0;
+    deque->count = 0;
+    deque->capacity = 0;
+}
+
+void fim_walk_deque_destroy(fim_walk_deque_t *deque) {
+    fim_walk_item_t item;
+
+    while (fim_walk_deque_pop(deque, &item)) {
+        os_free(item.path);
+    }
+
+    os_free(deque->items);
+    w_mutex_destroy(&deque->mutex);
+}
+
+void fim_walk_deque_push(fim_walk_deque_t *deque, const fim_walk_item_t *item) {
+    w_mutex_lock(&deque->mutex);
+
+    if (deque->count == deque->capacity) {
+        size_t capacity = deque->capacity > 0 ? deque->capacity * 2 : 64;
+        fim_walk_item_t *items;
+        size_t i;
+
+        os_calloc(capacity, sizeof(fim_walk_item_t), items);
+
+        for (i = 0; i < deque->count; i++) {
+            items[i] = deque->items[(deque->head + i) % deque->capacity];
+        }
+
+        os_free(deque->items);
+        deque->items = items;
+        deque->head = 0;
+        deque->capacity = capacity;
+    }
+
+    deque->items[(deque->head + deque->count) % deque->capacity] = *item;
+    deque->count++;
+
+    w_mutex_unlock(&deque->mutex);
+}
+
+bool fim_walk_deque_pop(fim_walk_deque_t *deque, fim_walk_item_t *item) {
+    bool found = false;
+
+    w_mutex_lock(&deque->mutex);
+
+    if (deque->count > 0) {
+        deque->count--;
+        *item = deque->items[(deque->head + deque->count) % deque->capacity];
+        found = true;
+    }
+
+    w_mutex_unlock(&deque->mutex);
+
+    return found;
+}
+
+bool fim_walk_deque_steal(fim_walk_deque_t *deque, fim_walk_item_t *item) {
+    bool found = false;
+
+    w_mutex_lock(&deque->mutex);
+
+    if (deque->count > 0) {
+        *item = deque->items[deque->head];
+        deque->head = (deque->head + 1) % deque->capacity;
+        deque->count--;
+        found = true;
+    }
+
+    w_mutex_unlock(&deque->mutex);
+
+    return found;
+}
+
+/**
+ * @brief Queue a path to be processed by a scan thread
+ *
+ * @param walker The walker the path belongs to
+ * @param worker Scan thread whose deque receives the path
+ * @param item The path, the walker takes ownership of it
+ */
+static void fim_walk_queue(fim_walker_t *walker, fim_walk_worker_t *worker, const fim_walk_item_t *item) {
+    // The path is counted before it can be taken, otherwise a thread could steal and finish it first, wrapping
+    // queued around and taking pending to 0 while this thread still has work
+    w_mutex_lock(&walker->mutex);
+    walker->queued++;
+    walker->pending++;
+    fim_walk_deque_push(&worker->deque, item);
+    w_cond_signal(&walker->work_available);
+    w_mutex_unlock(&walker->mutex);
+}
+
+/**
+ * @brief Take the next path to process: the latest one queued by the thread, or else the oldest one queued
+ * by any other thread, which is usually the closest to the top of the tree and so the largest task
+ *
+ * @param worker Scan thread looking for work
+ * @param item The path taken
+ * @return true if a path was taken, false if all the deques were empty
+ */
+static bool fim_walk_take(fim_walk_worker_t *worker, fim_walk_item_t *item) {
+    fim_walker_t *walker = worker->walker;
+    bool found = fim_walk_deque_pop(&worker->deque, item);
+    int i;
+
+    for (i = 1; !found && i < walker->threads; i++) {
+        found = fim_walk_deque_steal(&walker->workers[(worker->id + i) % walker->threads].deque, item);
+    }
+
+    if (found) {
+        w_mutex_lock(&walker->mutex);
+        walker->queued--;
+        w_mutex_unlock(&walker->mutex);
+    }
+
+    return found;
+}
+
+/**
+ * @brief Hand a scanned file to the writer, waiting while the writer is behind
+ *
+ * @param walker The walker the file belongs to
+ * @param path Path of the file, the writer takes ownership of it
+ * @param data Data of the file, the writer takes ownership of it
+ */
+static void fim_walk_push_result(fim_walker_t *walker, char *path, fim_file_data *data) {
+    w_mutex_lock(&walker->results_mutex);
+
+    while (walker->results_count == walker->results_capacity) {
+        w_cond_wait(&walker->results_space, &walker->results_mutex);
+    }
+
+    fim_walk_result_t *result =
+        &walker->results[(walker->results_head + walker->results_count) % walker->results_capacity];
+    result->path = path;
+    result->data = data;
+    walker->results_count++;
+
+    w_cond_signal(&walker->results_available);
+    w_mutex_unlock(&walker->results_mutex);
+}
+
+/**
+ * @brief Take the next scanned file, waiting while the scan threads are running
+ *
+ * @param walker The walker the file belongs to
+ * @param result The file taken
+ * @return true if a file was taken, false once every scan thread has finished and all the files were taken
+ */
+static bool fim_walk_pop_result(fim_walker_t *walker, fim_walk_result_t *result) {
+    bool found = false;
+
+    w_mutex_lock(&walker->results_mutex);
+
+    while (walker->results_count == 0 && walker->running > 0) {
+        w_cond_wait(&walker->results_available, &walker->results_mutex);
+    }
+
+    if (walker->results_count > 0) {
+        *result = walker->results[walker->results_head];
+        walker->results_head = (walker->results_head + 1) % walker->results_capacity;
+        walker->results_count--;
+        found = true;
+        w_cond_signal(&walker->results_space);
+    }
+
+    w_mutex_unlock(&walker->results_mutex);
+
+    return found;
+}
+
+/**
+ * @brief Apply the checks of fim_checker to a path found by the walk. Files are scanned and handed to the
+ * writer, directories are queued to be enumerated
+ *
+ * @param worker Scan thread checking the path
+ * @param path Path to check
+ * @param parent_configuration Configuration of the directory the path was found in
+ * @param dir_fd File descriptor of the directory the path was found in, -1 for the monitored paths
+ * @param name Name of the path in its directory
+ */
+static void fim_walk_check(fim_walk_worker_t *worker,
+                           const char *path,
+                           const directory_t *parent_configuration,
+                           int dir_fd,
+                           const char *name) {
+    directory_t *configuration;
+    struct stat statbuf;
+    int depth;
+
+    if (!w_utf8_valid(path)) {
+        LogWarn(FIM_INVALID_FILE_NAME, path);
+        return;
+    }
+
+    configuration = fim_configuration_directory(path);
+
+    // If the path has another configuration it will be scanned with that configuration
+    if (configuration == NULL || configuration != parent_configuration) {
+        return;
+    }
+
+    depth = fim_check_depth(path, configuration);
+
+    if (depth > configuration->recursion_level) {
+        LogDebug(FIM_MAX_RECURSION_LEVEL, depth, configuration->recursion_level, path);
+        return;
+    }
+
+    // Resolving the name in the open directory saves walking the whole path again
+    if ((dir_fd >= 0 ? fstatat(dir_fd, name, &statbuf, AT_SYMLINK_NOFOLLOW) : w_stat(path, &statbuf)) == -1) {
+        // Deleted files are reported by the deleted rows operation of the transaction
+        if (errno != ENOENT) {
+            LogDebug(FIM_STAT_FAILED, path, errno, strerror(errno));
+        }
+        return;
+    }
+
+    if (HasFilesystem(path, syscheck.skip_fs)) {
+        return;
+    }
+
+    if (fim_check_ignore(path) == 1) {
+        return;
+    }
+
+    switch (statbuf.st_mode & S_IFMT) {
+    case FIM_LINK:
+        // Fallthrough
+    case FIM_REGULAR: {
+        fim_file_data *data;
+        char *file_path;
+
+        if (fim_check_restrict(path, configuration->filerestrict) == 1) {
+            return;
+        }
+
+        check_max_fps();
+
+        if (data = fim_get_data(path, configuration, &statbuf, &worker->hashes), data == NULL) {
+            LogDebug(FIM_GET_ATTRIBUTES, path);
+            return;
+        }
+
+        os_strdup(path, file_path);
+        fim_walk_push_result(worker->walker, file_path, data);
+        break;
+    }
+
+    case FIM_DIRECTORY: {
+        fim_walk_item_t item = { .configuration = configuration, .monitored = false };
+
+        if (depth == configuration->recursion_level) {
+            LogDebug(FIM_DIR_RECURSION_LEVEL, path, depth);
+            return;
+        }
+
+        os_strdup(path, item.path);
+        fim_walk_queue(worker->walker, worker, &item);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Enumerate a directory, checking each of its entries
+ *
+ * @param worker Scan thread enumerating the directory
+ * @param item The directory
+ */
+static void fim_walk_directory(fim_walk_worker_t *worker, const fim_walk_item_t *item) {
+    char f_name[PATH_MAX + 2];
+    struct dirent *entry;
+    size_t path_size;
+    DIR *dp;
+
+    if (dp = opendir(item->path), dp == NULL) {
+        LogWarn(FIM_PATH_NOT_OPEN, item->path, strerror(errno));
+        return;
+    }
+
+    path_size = snprintf(f_name, sizeof(f_name), "%s", item->path);
+
+    if (path_size > 0 && path_size < PATH_MAX && f_name[path_size - 1] != PATH_SEP) {
+        f_name[path_size++] = PATH_SEP;
+    }
+
+    while ((entry = readdir(dp)) != NULL) {
+        // Ignore . and ..
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+
+        snprintf(f_name + path_size, sizeof(f_name) - path_size, "%s", entry->d_name);
+        fim_walk_check(worker, f_name, item->configuration, dirfd(dp), entry->d_name);
+    }
+
+    closedir(dp);
+
+#ifdef INOTIFY_ENABLED
+    if (FIM_MODE(item->configuration->options) == FIM_REALTIME) {
+        fim_add_inotify_watch(item->path, item->configuration);
+    }
+#endif
+}
+
+/**
+ * @brief Scan thread: process paths until there are none left in any deque nor being processed
+ *
+ * @param args The fim_walk_worker_t of the thread
+ * @return NULL
+ */
+static void *fim_walk_main(void *args) {
+    fim_walk_worker_t *worker = (fim_walk_worker_t *)args;
+    fim_walker_t *walker = worker->walker;
+    fim_walk_item_t item;
+    bool done = false;
+
+    while (!done) {
+        if (fim_walk_take(worker, &item)) {
+            if (item.monitored) {
+                // Monitored path, it can be a file or a directory
+                fim_walk_check(worker, item.path, item.configuration, -1, NULL);
+            } else {
+                fim_walk_directory(worker, &item);
+            }
+
+            os_free(item.path);
+
+            w_mutex_lock(&walker->mutex);
+            if (--walker->pending == 0) {
+                w_cond_broadcast(&walker->work_available);
+            }
+            w_mutex_unlock(&walker->mutex);
+            continue;
+        }
+
+        // Other threads may still queue directories while they enumerate theirs
+        w_mutex_lock(&walker->mutex);
+        while (walker->queued == 0 && walker->pending > 0) {
+            w_cond_wait(&walker->work_available, &walker->mutex);
+        }
+        done = walker->pending == 0;
+        w_mutex_unlock(&walker->mutex);
+    }
+
+    w_mutex_lock(&walker->results_mutex);
+    walker->running--;
+    w_cond_broadcast(&walker->results_available);
+    w_mutex_unlock(&walker->results_mutex);
+
+    return NULL;
+}
+
+int fim_scan_walk(OSList *directories, TXN_HANDLE dbsync_txn, fim_txn_context_t *txn_context) {
+    fim_walker_t walker = { .threads = fim_scan_threads };
+    pthread_t *threads;
+    fim_walk_result_t result;
+    OSListNode *node_it;
+    int started = 0;
+    int seeded = 0;
+    int i;
+
+    os_calloc(walker.threads, sizeof(fim_walk_worker_t), walker.workers);
+    os_calloc(walker.threads, sizeof(pthread_t), threads);
+    walker.results_capacity = walker.threads * FIM_WALK_RESULTS_PER_THREAD;
+    os_calloc(walker.results_capacity, sizeof(fim_walk_result_t), walker.results);
+    w_mutex_init(&walker.mutex, NULL);
+    w_cond_init(&walker.work_available, NULL);
+    w_mutex_init(&walker.results_mutex, NULL);
+    w_cond_init(&walker.results_available, NULL);
+    w_cond_init(&walker.results_space, NULL);
+
+    for (i = 0; i < walker.threads; i++) {
+        walker.workers[i].walker = &walker;
+        walker.workers[i].id = i;
+        walker.workers[i].hashes.reuse = txn_context->hashes != NULL && txn_context->hashes->reuse;
+        fim_walk_deque_init(&walker.workers[i].deque);
+    }
+
+    // The monitored paths are checked by the scan threads too, they may be files
+    OSList_foreach(node_it, directories) {
+        fim_walk_item_t item = { .configuration = node_it->data, .monitored = true };
+
+        item.path = fim_get_real_path(item.configuration);
+        fim_walk_queue(&walker, &walker.workers[seeded++ % walker.threads], &item);
+    }
+
+    walker.running = walker.threads;
+
+    for (i = 0; i < walker.threads; i++) {
+        if (CreateThreadJoinable(&threads[i], fim_walk_main, &walker.workers[i]) < 0) {
+            break;
+        }
+        started++;
+    }
+
+    if (started < walker.threads) {
+        w_mutex_lock(&walker.results_mutex);
+        walker.running -= walker.threads - started;
+        w_mutex_unlock(&walker.results_mutex);
+    }
+
+    if (started == 0) {
+        LogWarn(FIM_SCAN_THREADS_FAILED);
+    } else {
+        LogDebug(FIM_SCAN_THREADS, started);
+
+        // Single writer: the DB transaction and its callback are only used from this thread
+        while (fim_walk_pop_result(&walker, &result)) {
+            fim_entry new_entry = { .type = FIM_TYPE_FILE };
+
+            new_entry.file_entry.path = result.path;
+            new_entry.file_entry.data = result.data;
+
+            txn_context->latest_entry = &new_entry;
+            fim_db_transaction_sync_row(dbsync_txn, &new_entry);
+            txn_context->latest_entry = NULL;
+
+            free_file_data(result.data);
+            os_free(result.path);
+        }
+
+        for (i = 0; i < started; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    for (i = 0; i < walker.threads; i++) {
+        if (txn_context->hashes != NULL) {
+            txn_context->hashes->files_hashed += walker.workers[i].hashes.files_hashed;
+            txn_context->hashes->bytes_hashed += walker.workers[i].hashes.bytes_hashed;
+            txn_context->hashes->files_reused += walker.workers[i].hashes.files_reused;
+            txn_context->hashes->bytes_reused += walker.workers[i].hashes.bytes_reused;
+        }
+        fim_walk_deque_destroy(&walker.workers[i].deque);
+    }
+
+    w_cond_destroy(&walker.results_space);
+    w_cond_destroy(&walker.results_available);
+    w_mutex_destroy(&walker.results_mutex);
+    w_cond_destroy(&walker.work_available);
+    w_mutex_destroy(&walker.mutex);
+    os_free(walker.results);
+    os_free(threads);
+    os_free(walker.workers);
+
+    return started > 0 ? 0 : OS_INVALID;
+}
+
+#endif /* WIN32 */
@@ -21,6 +21,9 @@
 syscheck_config syscheck;
 int sys_debug_level;
 int audit_queue_full_reported = 0;
+int fim_hash_reuse_scans = 0;
+int fim_scan_threads = 1;
+int fim_realtime_fanotify = 0;
 
 #ifdef USE_MAGIC
 #include <magic.h>
@@ -54,9 +57,12 @@ void read_internal(int debug_level)
     syscheck.max_depth = getDefine_Int("syscheck", "default_max_depth", 1, 320);
     syscheck.file_max_size = (size_t)getDefine_Int("syscheck", "file_max_size", 0, 4095) * 1024 * 1024;
     syscheck.sym_checker_interval = getDefine_Int("syscheck", "symlink_scan_interval", 1, 2592000);
+    fim_hash_reuse_scans = getDefine_Int("syscheck", "hash_reuse_scans", 0, 1000);
 
 #ifndef WIN32
     syscheck.max_audit_entries = getDefine_Int("syscheck", "max_audit_entries", 1, 4096);
+    fim_scan_threads = getDefine_Int("syscheck", "scan_threads", 1, 64);
+    fim_realtime_fanotify = getDefine_Int("syscheck", "realtime_fanotify", 0, 1);
 #endif
     sys_debug_level = getDefine_Int("syscheck", "debug", 0, 2);
 
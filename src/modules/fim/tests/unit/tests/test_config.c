@@ -684,7 +684,11 @@ void test_getSyscheckInternalOptions(void **state)
     cJSON *items = cJSON_GetObjectItem(ret, "internal");
     assert_int_equal(cJSON_GetArraySize(items), 2);
     cJSON *sys_items = cJSON_GetObjectItem(items, "syscheck");
-    assert_int_equal(cJSON_GetArraySize(sys_items), 6);
+    #ifndef TEST_WINAGENT
+    assert_int_equal(cJSON_GetArraySize(sys_items), 9);
+    #else
+    assert_int_equal(cJSON_GetArraySize(sys_items), 7);
+    #endif
     cJSON *root_items = cJSON_GetObjectItem(items, "rootcheck");
     assert_int_equal(cJSON_GetArraySize(root_items), 1);
 }
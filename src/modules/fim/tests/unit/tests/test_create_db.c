@@ -638,14 +638,15 @@ void expect_get_data (char *user, char *group, char *file_path, int calculate_ch
     will_return(__wrap_get_UTC_modification_time, 123456);
 #endif
     if (calculate_checksums) {
-        expect_OS_MD5_SHA1_SHA256_File_call(file_path,
-                                            syscheck.prefilter_cmd,
-                                            "d41d8cd98f00b204e9800998ecf8427e",
-                                            "da39a3ee5e6b4b0d3255bfef95601890afd80709",
-                                            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
-                                            OS_BINARY,
-                                            0x400,
-                                            0);
+        expect_OS_Hash_File_call(file_path,
+                                 syscheck.prefilter_cmd,
+                                 OS_HASH_ALL,
+                                 "d41d8cd98f00b204e9800998ecf8427e",
+                                 "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                                 "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                                 OS_BINARY,
+                                 0x400,
+                                 0);
     }
 }
 
@@ -1383,10 +1384,9 @@ static void test_fim_file_modify_transaction(void **state) {
     expect_value(__wrap_decode_win_acl_json, perms, permissions);
 #endif
 
-    expect_OS_MD5_SHA1_SHA256_File_call(file_path, syscheck.prefilter_cmd, "d41d8cd98f00b204e9800998ecf8427e",
-                                        "da39a3ee5e6b4b0d3255bfef95601890afd80709",
-                                        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", OS_BINARY,
-                                        0x400, 0);
+    expect_OS_Hash_File_call(file_path, syscheck.prefilter_cmd, OS_HASH_ALL, "d41d8cd98f00b204e9800998ecf8427e",
+                             "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                             "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", OS_BINARY, 0x400, 0);
 
     will_return(__wrap_fim_db_transaction_sync_row, FIMDB_OK);
 
@@ -1440,10 +1440,9 @@ static void test_fim_file_modify(void **state) {
     expect_value(__wrap_decode_win_acl_json, perms, permissions);
 #endif
 
-    expect_OS_MD5_SHA1_SHA256_File_call(file_path, syscheck.prefilter_cmd, "d41d8cd98f00b204e9800998ecf8427e",
-                                        "da39a3ee5e6b4b0d3255bfef95601890afd80709",
-                                        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", OS_BINARY,
-                                        0x400, 0);
+    expect_OS_Hash_File_call(file_path, syscheck.prefilter_cmd, OS_HASH_ALL, "d41d8cd98f00b204e9800998ecf8427e",
+                             "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                             "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", OS_BINARY, 0x400, 0);
 
     will_return(__wrap_fim_db_file_update, FIMDB_OK);
 
@@ -1475,14 +1474,15 @@ static void test_fim_file_no_attributes(void **state) {
     expect_value(__wrap_decode_win_acl_json, perms, permissions);
 #endif
 
-    expect_OS_MD5_SHA1_SHA256_File_call(file_path,
-                                        syscheck.prefilter_cmd,
-                                        "d41d8cd98f00b204e9800998ecf8427e",
-                                        "da39a3ee5e6b4b0d3255bfef95601890afd80709",
-                                        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
-                                        OS_BINARY,
-                                        0x400,
-                                        -1);
+    expect_OS_Hash_File_call(file_path,
+                             syscheck.prefilter_cmd,
+                             OS_HASH_ALL,
+                             "d41d8cd98f00b204e9800998ecf8427e",
+                             "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                             "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                             OS_BINARY,
+                             0x400,
+                             -1);
 
     snprintf(buffer1, OS_SIZE_256, FIM_HASHES_FAIL, file_path);
     snprintf(buffer2, OS_SIZE_256, FIM_GET_ATTRIBUTES, file_path);
@@ -1538,18 +1538,19 @@ static void test_fim_file_error_on_insert(void **state) {
 
     expect_value(__wrap_decode_win_acl_json, perms, permissions);
 #endif
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, fname, file_path);
+    expect_string(__wrap_OS_Hash_File, fname, file_path);
 #ifndef TEST_WINAGENT
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, prefilter_cmd, syscheck.prefilter_cmd);
+    expect_string(__wrap_OS_Hash_File, prefilter_cmd, syscheck.prefilter_cmd);
 #else
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, prefilter_cmd, syscheck.prefilter_cmd);
+    expect_string(__wrap_OS_Hash_File, prefilter_cmd, syscheck.prefilter_cmd);
 #endif
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, md5output, "d41d8cd98f00b204e9800998ecf8427e");
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, sha1output, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, sha256output, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
-    expect_value(__wrap_OS_MD5_SHA1_SHA256_File, mode, OS_BINARY);
-    expect_value(__wrap_OS_MD5_SHA1_SHA256_File, max_size, 0x400);
-    will_return(__wrap_OS_MD5_SHA1_SHA256_File, 0);
+    expect_string(__wrap_OS_Hash_File, md5output, "d41d8cd98f00b204e9800998ecf8427e");
+    expect_string(__wrap_OS_Hash_File, sha1output, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    expect_string(__wrap_OS_Hash_File, sha256output, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    expect_value(__wrap_OS_Hash_File, digests, OS_HASH_ALL);
+    expect_value(__wrap_OS_Hash_File, mode, OS_BINARY);
+    expect_value(__wrap_OS_Hash_File, max_size, 0x400);
+    will_return(__wrap_OS_Hash_File, 0);
 
     will_return(__wrap_fim_db_file_update, FIMDB_OK);
 
@@ -2044,6 +2045,8 @@ static void test_fim_scan_db_full_double_scan(void **state) {
 
     // fim_send_scan_info
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 }
@@ -2100,6 +2103,8 @@ static void test_fim_scan_db_full_not_double_scan(void **state) {
     expect_wrapper_fim_db_get_count_file_entry(25000);
 
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 }
@@ -2175,6 +2180,8 @@ static void test_fim_scan_realtime_enabled(void **state) {
     will_return(__wrap_send_log_msg, 1);
 
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 
@@ -2230,6 +2237,8 @@ static void test_fim_scan_no_limit(void **state) {
 
     // In fim_scan
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 }
@@ -2626,6 +2635,8 @@ static void test_fim_scan_db_full_double_scan(void **state) {
 
     expect_function_call(__wrap_fim_db_transaction_deleted_rows);
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
     fim_scan();
 }
 
@@ -2686,6 +2697,8 @@ static void test_fim_scan_db_full_not_double_scan(void **state) {
 
     expect_function_call(__wrap_fim_db_transaction_deleted_rows);
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 }
@@ -2742,6 +2755,8 @@ static void test_fim_scan_no_limit(void **state) {
 
     expect_function_call(__wrap_fim_db_transaction_deleted_rows);
     expect_string(__wrap__minfo, formatted_msg, FIM_FREQUENCY_ENDED);
+    expect_string(__wrap__minfo, formatted_msg,
+                  "(6047): Hashed 0 files (0 bytes), reused the stored hashes of 0 unchanged files (0 bytes).");
 
     fim_scan();
 }
@@ -3133,7 +3148,7 @@ static void test_fim_get_data(void **state) {
                             .st_mtime = 3456 };
 
     expect_get_data(strdup("user"), strdup("group"), "test", 1);
-    fim_data->local_data = fim_get_data("test", &configuration, &statbuf);
+    fim_data->local_data = fim_get_data("test", &configuration, &statbuf, NULL);
 
 #ifndef TEST_WINAGENT
     assert_string_equal(fim_data->local_data->perm, "r--r--r--");
@@ -3159,7 +3174,7 @@ static void test_fim_get_data_no_hashes(void **state) {
 
     expect_get_data(strdup("user"), strdup("group"), "test", 0);
 
-    fim_data->local_data = fim_get_data("test", &configuration, &statbuf);
+    fim_data->local_data = fim_get_data("test", &configuration, &statbuf, NULL);
 
 #ifndef TEST_WINAGENT
     assert_string_equal(fim_data->local_data->perm, "r--r--r--");
@@ -3172,6 +3187,40 @@ static void test_fim_get_data_no_hashes(void **state) {
     assert_string_equal(fim_data->local_data->hash_sha256, "");
 }
 
+static void test_fim_get_data_sha256_only(void **state) {
+    fim_data_t *fim_data = *state;
+    directory_t configuration = { .options = CHECK_SHA256SUM | CHECK_MTIME | CHECK_SIZE | CHECK_PERM | CHECK_OWNER |
+                                             CHECK_GROUP };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+
+    expect_get_data(strdup("user"), strdup("group"), "test", 0);
+
+    // Only the configured digest is calculated
+    expect_OS_Hash_File_call("test",
+                             syscheck.prefilter_cmd,
+                             OS_HASH_SHA256,
+                             "d41d8cd98f00b204e9800998ecf8427e",
+                             "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                             "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                             OS_BINARY,
+                             0x400,
+                             0);
+
+    fim_data->local_data = fim_get_data("test", &configuration, &statbuf, NULL);
+
+    assert_non_null(fim_data->local_data);
+    assert_string_equal(fim_data->local_data->hash_md5, "");
+    assert_string_equal(fim_data->local_data->hash_sha1, "");
+    assert_string_equal(fim_data->local_data->hash_sha256,
+                        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
 static void test_fim_get_data_hash_error(void **state) {
     fim_data_t *fim_data = *state;
     directory_t configuration = { .options = CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM | CHECK_MTIME |
@@ -3186,26 +3235,143 @@ static void test_fim_get_data_hash_error(void **state) {
 
     expect_get_data(strdup("user"), strdup("group"), "test", 0);
 
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, fname, "test");
+    expect_string(__wrap_OS_Hash_File, fname, "test");
 #ifndef TEST_WINAGENT
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, prefilter_cmd, syscheck.prefilter_cmd);
+    expect_string(__wrap_OS_Hash_File, prefilter_cmd, syscheck.prefilter_cmd);
 #else
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, prefilter_cmd, syscheck.prefilter_cmd);
+    expect_string(__wrap_OS_Hash_File, prefilter_cmd, syscheck.prefilter_cmd);
 #endif
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, md5output, "d41d8cd98f00b204e9800998ecf8427e");
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, sha1output, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
-    expect_string(__wrap_OS_MD5_SHA1_SHA256_File, sha256output, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
-    expect_value(__wrap_OS_MD5_SHA1_SHA256_File, mode, OS_BINARY);
-    expect_value(__wrap_OS_MD5_SHA1_SHA256_File, max_size, 0x400);
-    will_return(__wrap_OS_MD5_SHA1_SHA256_File, -1);
+    expect_string(__wrap_OS_Hash_File, md5output, "d41d8cd98f00b204e9800998ecf8427e");
+    expect_string(__wrap_OS_Hash_File, sha1output, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    expect_string(__wrap_OS_Hash_File, sha256output, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    expect_value(__wrap_OS_Hash_File, digests, OS_HASH_ALL);
+    expect_value(__wrap_OS_Hash_File, mode, OS_BINARY);
+    expect_value(__wrap_OS_Hash_File, max_size, 0x400);
+    will_return(__wrap_OS_Hash_File, -1);
 
     expect_string(__wrap__mdebug1, formatted_msg, "(6324): Couldn't generate hashes for 'test'");
 
-    fim_data->local_data = fim_get_data("test", &configuration, &statbuf);
+    fim_data->local_data = fim_get_data("test", &configuration, &statbuf, NULL);
 
     assert_null(fim_data->local_data);
 }
 
+static void test_fim_get_data_reuse_stored_hashes(void **state) {
+    fim_data_t *fim_data = *state;
+    const char *file_path = "test";
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_MTIME | CHECK_OWNER | CHECK_GROUP |
+                                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+#ifndef TEST_WINAGENT
+    fim_file_data stored_data = { .size = 1000, .mtime = 3456, .inode = 1234, .dev = 2345, .last_event = 200000 };
+#else
+    fim_file_data stored_data = { .size = 1000, .mtime = 123456, .inode = 1234, .dev = 2345, .last_event = 200000 };
+#endif
+    fim_entry stored = { .type = FIM_TYPE_FILE, .file_entry.path = "test", .file_entry.data = &stored_data };
+    fim_scan_hashes_t hashes = { .reuse = true };
+
+    stored_data.options = configuration.options;
+    strcpy(stored_data.hash_md5, "3691689a513ace7e508297b583d7050d");
+    strcpy(stored_data.hash_sha1, "07f05add1049244e7e71ad0f54f24d8094cd8f8b");
+    strcpy(stored_data.hash_sha256, "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40");
+
+    expect_get_data(strdup("user"), strdup("group"), (char *)file_path, 0);
+    expect_fim_db_get_path_entry(file_path, &stored);
+
+    fim_data->local_data = fim_get_data(file_path, &configuration, &statbuf, &hashes);
+
+    assert_non_null(fim_data->local_data);
+    assert_string_equal(fim_data->local_data->hash_md5, "3691689a513ace7e508297b583d7050d");
+    assert_string_equal(fim_data->local_data->hash_sha1, "07f05add1049244e7e71ad0f54f24d8094cd8f8b");
+    assert_string_equal(fim_data->local_data->hash_sha256,
+                        "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40");
+    assert_int_equal(hashes.files_reused, 1);
+    assert_int_equal(hashes.bytes_reused, 1000);
+    assert_int_equal(hashes.files_hashed, 0);
+    assert_int_equal(hashes.bytes_hashed, 0);
+}
+
+static void test_fim_get_data_stored_hashes_file_changed(void **state) {
+    fim_data_t *fim_data = *state;
+    const char *file_path = "test";
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_MTIME | CHECK_OWNER | CHECK_GROUP |
+                                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+    // Same modification time, different size
+#ifndef TEST_WINAGENT
+    fim_file_data stored_data = { .size = 999, .mtime = 3456, .inode = 1234, .dev = 2345, .last_event = 200000 };
+#else
+    fim_file_data stored_data = { .size = 999, .mtime = 123456, .inode = 1234, .dev = 2345, .last_event = 200000 };
+#endif
+    fim_entry stored = { .type = FIM_TYPE_FILE, .file_entry.path = "test", .file_entry.data = &stored_data };
+    fim_scan_hashes_t hashes = { .reuse = true };
+
+    stored_data.options = configuration.options;
+    strcpy(stored_data.hash_md5, "3691689a513ace7e508297b583d7050d");
+    strcpy(stored_data.hash_sha1, "07f05add1049244e7e71ad0f54f24d8094cd8f8b");
+    strcpy(stored_data.hash_sha256, "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40");
+
+    expect_get_data(strdup("user"), strdup("group"), (char *)file_path, 1);
+    expect_fim_db_get_path_entry(file_path, &stored);
+
+    fim_data->local_data = fim_get_data(file_path, &configuration, &statbuf, &hashes);
+
+    assert_non_null(fim_data->local_data);
+    assert_string_equal(fim_data->local_data->hash_md5, "d41d8cd98f00b204e9800998ecf8427e");
+    assert_int_equal(hashes.files_reused, 0);
+    assert_int_equal(hashes.files_hashed, 1);
+    assert_int_equal(hashes.bytes_hashed, 1000);
+}
+
+static void test_fim_get_data_stored_hashes_modified_while_hashing(void **state) {
+    fim_data_t *fim_data = *state;
+    const char *file_path = "test";
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_MTIME | CHECK_OWNER | CHECK_GROUP |
+                                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+    // The hashes were calculated in the same second the file was modified
+#ifndef TEST_WINAGENT
+    fim_file_data stored_data = { .size = 1000, .mtime = 3456, .inode = 1234, .dev = 2345, .last_event = 3456 };
+#else
+    fim_file_data stored_data = { .size = 1000, .mtime = 123456, .inode = 1234, .dev = 2345, .last_event = 123456 };
+#endif
+    fim_entry stored = { .type = FIM_TYPE_FILE, .file_entry.path = "test", .file_entry.data = &stored_data };
+    fim_scan_hashes_t hashes = { .reuse = true };
+
+    stored_data.options = configuration.options;
+    strcpy(stored_data.hash_md5, "3691689a513ace7e508297b583d7050d");
+    strcpy(stored_data.hash_sha1, "07f05add1049244e7e71ad0f54f24d8094cd8f8b");
+    strcpy(stored_data.hash_sha256, "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40");
+
+    expect_get_data(strdup("user"), strdup("group"), (char *)file_path, 1);
+    expect_fim_db_get_path_entry(file_path, &stored);
+
+    fim_data->local_data = fim_get_data(file_path, &configuration, &statbuf, &hashes);
+
+    assert_non_null(fim_data->local_data);
+    assert_string_equal(fim_data->local_data->hash_md5, "d41d8cd98f00b204e9800998ecf8427e");
+    assert_int_equal(hashes.files_reused, 0);
+    assert_int_equal(hashes.files_hashed, 1);
+}
+
 #ifdef TEST_WINAGENT
 static void test_fim_get_data_fail_to_get_file_premissions(void **state) {
     fim_data_t *fim_data = *state;
@@ -3220,7 +3386,7 @@ static void test_fim_get_data_fail_to_get_file_premissions(void **state) {
     will_return(__wrap_w_get_file_permissions, ERROR_ACCESS_DENIED);
 
 
-    fim_data->local_data = fim_get_data("test", &configuration, &statbuf);
+    fim_data->local_data = fim_get_data("test", &configuration, &statbuf, NULL);
 
     assert_null(fim_data->local_data);
 }
@@ -4407,7 +4573,11 @@ int main(void) {
         /* fim_get_data */
         cmocka_unit_test_teardown(test_fim_get_data, teardown_local_data),
         cmocka_unit_test_teardown(test_fim_get_data_no_hashes, teardown_local_data),
+        cmocka_unit_test_teardown(test_fim_get_data_sha256_only, teardown_local_data),
         cmocka_unit_test(test_fim_get_data_hash_error),
+        cmocka_unit_test_teardown(test_fim_get_data_reuse_stored_hashes, teardown_local_data),
+        cmocka_unit_test_teardown(test_fim_get_data_stored_hashes_file_changed, teardown_local_data),
+        cmocka_unit_test_teardown(test_fim_get_data_stored_hashes_modified_while_hashing, teardown_local_data),
 #ifdef TEST_WINAGENT
         cmocka_unit_test(test_fim_get_data_fail_to_get_file_premissions),
 #endif
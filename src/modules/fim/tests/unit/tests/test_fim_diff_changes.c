@@ -17,7 +17,6 @@
 
 #include "../syscheckd/include/syscheck.h"
 #include "../config/syscheck-config.h"
-#include "../wrappers/wazuh/os_crypto/md5_op_wrappers.h"
 #include "../wrappers/wazuh/shared/file_op_wrappers.h"
 #include "../wrappers/libc/stdio_wrappers.h"
 #include "../wrappers/libc/stdlib_wrappers.h"
@@ -56,7 +55,6 @@ static const char GENERIC_PATH [OS_SIZE_256] =        "c:\\file\\path";
 static const char COMPRESS_FOLDER_REG [OS_SIZE_256] = "queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED;
 static const char COMPRESS_FOLDER [OS_SIZE_256] =     "queue/diff/file/" FILE_NAME_HASHED "";
 static const char COMPRESS_FILE [OS_SIZE_256] =       "queue/diff/file/" FILE_NAME_HASHED "/last-entry.gz";
-static const char UNCOMPRESS_FILE [OS_SIZE_256] =     "queue/diff/tmp/tmp-entry";
 static const char COMPRESS_TMP_FILE [OS_SIZE_256] =   "queue/diff/tmp/tmp-entry.gz";
 
 #else
@@ -66,7 +64,6 @@ static const char COMPRESS_TMP_FILE [OS_SIZE_256] =   "queue/diff/tmp/tmp-entry.
 static const char GENERIC_PATH [OS_SIZE_256] =        "/path/to/file";
 static const char COMPRESS_FOLDER [OS_SIZE_256] =     "queue/diff/file/" FILE_NAME_HASHED "";
 static const char COMPRESS_FILE [OS_SIZE_256] =       "queue/diff/file/" FILE_NAME_HASHED "/last-entry.gz";
-static const char UNCOMPRESS_FILE [OS_SIZE_256] =     "queue/diff/tmp/tmp-entry";
 static const char COMPRESS_TMP_FILE [OS_SIZE_256] =   "queue/diff/tmp/tmp-entry.gz";
 
 #endif
@@ -80,53 +77,33 @@ static OSMatch *syscheck_nodiff_regex[] = { NULL, NULL };
 
 static const char *STR_MORE_CHANGES = "More changes...";
 
+static const char *STORED_CONTENT = "First line\n";
+static const char *CURRENT_CONTENT = "First Line 123\nLast line\n";
+static const char *CONTENT_DIFF = "1c1,2\n< First line\n---\n> First Line 123\n> Last line\n";
+static const char BINARY_CONTENT[] = "First\0line\n";
+
 #define DEFAULT_OPTIONS                                                                                    \
     CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM | CHECK_PERM | CHECK_SIZE | CHECK_OWNER | CHECK_GROUP | \
     CHECK_MTIME | CHECK_INODE
 
-typedef struct gen_diff_struct {
-    diff_data *diff;
-    char **strarray;
-} gen_diff_struct;
-
-
 #ifdef TEST_WINAGENT
-char *adapt_win_fc_output(char *command_output);
 diff_data *initialize_registry_diff_data(const char *key_name, const char *value_name, const registry_t *configuration);
 int fim_diff_registry_tmp(const char *value_data, DWORD data_type, const diff_data *diff);
 #endif
 
 diff_data *initialize_file_diff_data(const char *filename);
-char* filter(const char *string);
 void free_diff_data(diff_data *diff);
 int fim_diff_check_limits(diff_data *diff);
 int fim_diff_delete_compress_folder(const char *folder);
 int fim_diff_estimate_compression(float file_size);
 int fim_diff_create_compress_file(const diff_data *diff);
 void fim_diff_modify_compress_estimation(float compressed_size, float uncompressed_size);
-int fim_diff_compare(const diff_data *diff);
+int fim_diff_compare(diff_data *diff);
 void save_compress_file(const diff_data *diff);
 int is_file_nodiff(const char *filename);
 int is_registry_nodiff(const char *key_name, const char *value_name, int arch);
-char *gen_diff_str(const diff_data *diff);
 char *fim_diff_generate(const diff_data *diff);
 
-void expect_gen_diff_generate(gen_diff_struct *gen_diff_data_container) {
-    FILE *fp = (FILE*)2345;
-    size_t n = strlen(gen_diff_data_container->strarray[0]);
-
-    expect_wfopen(gen_diff_data_container->diff->diff_file, "rb", fp);
-
-    expect_fread(gen_diff_data_container->strarray[0], n);
-
-    expect_fclose(fp, 0);
-
-#ifndef TEST_WINAGENT
-    expect_string(__wrap_unlink, file, gen_diff_data_container->diff->diff_file);
-    will_return(__wrap_unlink, 0);
-#endif
-}
-
 void expect_initialize_file_diff_data(const char *path, int ret_abspath){
     expect_abspath(path, ret_abspath);
     if (!ret_abspath) {
@@ -186,24 +163,14 @@ void expect_save_compress_file(const char *compress_tmp_file, const char *compre
     expect_rename_ex(compress_tmp_file, compress_file, rename_fail);
 }
 
-void expect_fim_diff_compare(const char *uncompress_file, const char *file_origin, os_md5 md5sum_old, os_md5 md5sum_new, int ret) {
-    expect_OS_MD5_File_call(uncompress_file, md5sum_old, OS_BINARY, ret);
-    if (!ret) {
-        expect_OS_MD5_File_call(file_origin, md5sum_new, OS_BINARY, ret);
-    }
-}
+void expect_fim_diff_compare(const char *file_origin, const char *content) {
+    FILE *fp = (FILE*)2345;
 
-void expect_fim_diff_generate(gen_diff_struct *gen_diff_data_container, int generate_fail) {
-    if (generate_fail) {
-        expect_system(-1);
-    } else {
-#ifndef TEST_WINAGENT
-        expect_system(256);
-#else
-        expect_system(1);
-#endif
-        expect_gen_diff_generate(gen_diff_data_container);
-    }
+    expect_wfopen(file_origin, "rb", fp);
+    expect_fread((char *)content, strlen(content));
+    expect_fread("", 0);
+    expect_ferror(fp, 0);
+    expect_fclose(fp, 0);
 }
 
 void expect_fim_diff_delete_compress_folder(const char *folder, int isDir_ret, int rmdir_ex_ret, int remove_empty_folder_ret) {
@@ -282,12 +249,6 @@ static int teardown_group(void **state) {
     return 0;
 }
 
-static int teardown_free_string(void **state) {
-    char * string = *state;
-    free(string);
-    return 0;
-}
-
 static int setup_diff_data(void **state) {
     diff_data *diff = calloc(1, sizeof(diff_data));
     if (!diff) {
@@ -312,85 +273,8 @@ static int teardown_disk_quota_exceeded(void **state) {
     return 0;
 }
 
-static int setup_array_strings(void **state) {
-    char **strarray = calloc(2, sizeof(char*));
-
-    if(strarray == NULL)
-        return -1;
-
-    *state = strarray;
-
-    return 0;
-}
-
-static int teardown_array_strings(void **state) {
-    char **strarray = *state;
-
-    free(strarray[0]);
-    free(strarray[1]);
-    free(strarray);
-
-    return 0;
-}
-
-static int setup_gen_diff_str(void **state) {
-    gen_diff_struct *gen_diff_data_container = calloc(1, sizeof(gen_diff_struct));
-
-    if(gen_diff_data_container == NULL)
-        return -1;
-
-    setup_array_strings((void **)&gen_diff_data_container->strarray);
-    setup_diff_data((void **)&gen_diff_data_container->diff);
-
-#ifdef TEST_WINAGENT
-    gen_diff_data_container->strarray[0] = strdup(
-        "Comparing files start.txt and end.txt\r\n"
-        "***** start.txt\r\n"
-        "    1:  First line\r\n"
-        "***** END.TXT\r\n"
-        "    1:  First Line 123\r\n"
-        "    2:  Last line\r\n"
-        "*****\r\n\r\n\r\n");
-#else
-    gen_diff_data_container->strarray[0] = strdup(
-        "< First line\n"
-        "---\n"
-        "> First Line 123\n"
-        "> Last line\n");
-#endif
-    if(gen_diff_data_container->strarray[0] == NULL) fail();
-
-    char *output = strdup(
-        "< First line\n"
-        "---\n"
-        "> First Line 123\n"
-        "> Last line\n");
-
-    if(output == NULL) fail();
-    gen_diff_data_container->strarray[1] = output;
-
-    *state = gen_diff_data_container;
-
-    return 0;
-}
-
-static int teardown_free_gen_diff_str(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-
-    teardown_array_strings((void **)&gen_diff_data_container->strarray);
-
-    teardown_free_diff_data((void **)&gen_diff_data_container->diff);
-    os_free(gen_diff_data_container);
-
-    return 0;
-}
-
 #ifdef TEST_WINAGENT
 static int setup_full_diff_functionality(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-
-    setup_gen_diff_str(state);
-
     syscheck.registry_nodiff = NULL;
     syscheck.registry_nodiff_regex = NULL;
 
@@ -398,8 +282,6 @@ static int setup_full_diff_functionality(void **state) {
 }
 
 static int teardown_full_diff_functionality(void **state) {
-    teardown_free_gen_diff_str(state);
-
     syscheck.registry_nodiff = default_reg_nodiff;
     syscheck.registry_nodiff_regex = default_reg_ignore_regex;
 
@@ -411,114 +293,9 @@ static int teardown_full_diff_functionality(void **state) {
  * Tests
 \**********************************************************************************************************************/
 
-void test_filter(void **state) {
-    (void) state;
-
-#ifdef TEST_WINAGENT
-    const char * file_name = "a/unix/style/path/";
-#else
-    const char * file_name = "$file/$test";
-#endif
-
-    char * out = filter(file_name);
-    *state = out;
-    assert_non_null(out);
-
-#ifdef TEST_WINAGENT
-    assert_string_equal(out, "a\\unix\\style\\path\\");
-#else
-    assert_string_equal(out, "\\$file/\\$test");
-#endif
-}
-
 // Windows test
 
 #ifdef TEST_WINAGENT
-void test_filter_unchanged_string(void **state) {
-    char *input = "This string wont change";
-    char *output;
-
-    output = filter(input);
-
-    *state = output;
-
-    assert_string_equal(output, input);
-}
-
-void test_filter_percentage_char(void **state) {
-    char *input = "This % is not valid";
-    char *output;
-
-    output = filter(input);
-
-    assert_null(output);
-}
-
-void test_adapt_win_fc_output_success(void **state) {
-    char **strarray = *state;
-    char *output;
-    char *input = strdup(
-        "Comparing files start.txt and end.txt\r\n"
-        "***** start.txt\r\n"
-        "    1:  First line\r\n"
-        "***** END.TXT\r\n"
-        "    1:  First Line 123\r\n"
-        "    2:  Last line\r\n"
-        "*****\r\n\r\n\r\n");
-
-    if(input == NULL) fail();
-
-    strarray[0] = input;
-
-    output = adapt_win_fc_output(input);
-
-    assert_non_null(output);
-
-    strarray[1] = output;
-
-    assert_string_equal(output, "< First line\n---\n> First Line 123\n> Last line\n");
-}
-
-void test_adapt_win_fc_output_invalid_input(void **state) {
-    char **strarray = *state;
-    char *output;
-    char *input = strdup("This is invalid");
-
-    if(input == NULL) fail();
-
-    strarray[0] = input;
-
-    expect_string(__wrap__mdebug2, formatted_msg, "(6667): Unable to find second line of alert string.: This is invalid");
-
-    output = adapt_win_fc_output(input);
-
-    assert_non_null(output);
-
-    strarray[1] = output;
-
-    assert_string_equal(output, input);
-}
-
-void test_adapt_win_fc_output_no_differences(void **state) {
-    char **strarray = *state;
-    char *output;
-    char *input = strdup(
-        "Comparing files start.txt and end.txt\r\n"
-        "FC: no differences encountered\r\n\r\n\r\n");
-
-    if(input == NULL) fail();
-
-    strarray[0] = input;
-
-    output = adapt_win_fc_output(input);
-
-    assert_non_null(output);
-
-    strarray[1] = output;
-
-    assert_string_equal(output, "");
-}
-
 void test_initialize_registry_diff_data(void **state) {
     diff_data *diff = *state;
     registry_t *configuration = &syscheck.registry[0];
@@ -530,9 +307,7 @@ void test_initialize_registry_diff_data(void **state) {
     assert_string_equal(diff->compress_file, "queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz");
     assert_string_equal(diff->tmp_folder, "queue/diff/tmp");
     assert_string_equal(diff->file_origin, "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED);
-    assert_string_equal(diff->uncompress_file, "queue/diff/tmp/tmp-entry");
     assert_string_equal(diff->compress_tmp_file, "queue/diff/tmp/tmp-entry.gz");
-    assert_string_equal(diff->diff_file, "queue/diff/tmp/diff-file");
 }
 
 void test_initialize_file_diff_data(void **state) {
@@ -548,9 +323,7 @@ void test_initialize_file_diff_data(void **state) {
     assert_string_equal(diff->compress_file, "queue/diff/file/95632dd0fe0cc86cd21b6b7cf6d9db8d0cc1fe6c/last-entry.gz");
     assert_string_equal(diff->tmp_folder, "queue/diff/tmp");
     assert_string_equal(diff->file_origin, "C:\\path\\to\\file");
-    assert_string_equal(diff->uncompress_file, "queue/diff/tmp/tmp-entry");
     assert_string_equal(diff->compress_tmp_file, "queue/diff/tmp/tmp-entry.gz");
-    assert_string_equal(diff->diff_file, "queue/diff/tmp/diff-file");
 }
 
 #else // END TEST_WINAGENT
@@ -568,9 +341,7 @@ void test_initialize_file_diff_data(void **state) {
     assert_string_equal(diff->compress_file, COMPRESS_FILE);
     assert_string_equal(diff->tmp_folder, TMP_FOLDER);
     assert_string_equal(diff->file_origin, GENERIC_PATH);
-    assert_string_equal(diff->uncompress_file, UNCOMPRESS_FILE);
     assert_string_equal(diff->compress_tmp_file, COMPRESS_TMP_FILE);
-    assert_string_equal(diff->diff_file, "queue/diff/tmp/diff-file");
 }
 
 #endif // END TEST_AGENT
@@ -826,57 +597,65 @@ void test_fim_diff_modify_compress_estimation_ok(void **state) {
     assert_float_equal(syscheck.comp_estimation_perc, 0.7, 0.001);
 }
 
-void test_fim_diff_compare_fail_uncompress_MD5(void **state) {
+void test_fim_diff_compare_fopen_fail(void **state) {
     diff_data *diff = *state;
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
+    diff->file_origin = strdup("/path/to/original/file");
+    diff->baseline = strdup(STORED_CONTENT);
+    diff->baseline_size = strlen(STORED_CONTENT);
+
+    expect_wfopen(diff->file_origin, "rb", NULL);
 
-    expect_OS_MD5_File_call(diff->uncompress_file, md5sum_old, OS_BINARY, -1);
+    expect_string(__wrap__merror, formatted_msg, "(6665): Unable to generate diff alert (fopen)'/path/to/original/file'.");
 
     int ret = fim_diff_compare(diff);
 
     assert_int_equal(ret, -1);
+    assert_null(diff->content);
 }
 
-void test_fim_diff_compare_fail_origin_MD5(void **state) {
+void test_fim_diff_compare_fread_fail(void **state) {
     diff_data *diff = *state;
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
     diff->file_origin = strdup("/path/to/original/file");
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "3c183a30cffcda1408daf1c61d47b274";
+    diff->baseline = strdup(STORED_CONTENT);
+    diff->baseline_size = strlen(STORED_CONTENT);
+    FILE *fp = (FILE*)2345;
+
+    expect_wfopen(diff->file_origin, "rb", fp);
+    expect_fread("", 0);
+    expect_ferror(fp, 1);
+
+    expect_string(__wrap__merror, formatted_msg, "(6666): Unable to generate diff alert (fread).");
 
-    expect_OS_MD5_File_call(diff->uncompress_file, md5sum_old, OS_BINARY, 0);
-    expect_OS_MD5_File_call(diff->file_origin, md5sum_new, OS_BINARY, 0);
+    expect_fclose(fp, 0);
 
     int ret = fim_diff_compare(diff);
 
     assert_int_equal(ret, -1);
+    assert_null(diff->content);
 }
 
-void test_fim_diff_compare_fail_not_match(void **state) {
+void test_fim_diff_compare_not_match(void **state) {
     diff_data *diff = *state;
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
     diff->file_origin = strdup("/path/to/original/file");
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
+    diff->baseline = strdup(STORED_CONTENT);
+    diff->baseline_size = strlen(STORED_CONTENT);
 
-    expect_OS_MD5_File_call(diff->uncompress_file, md5sum_old, OS_BINARY, 0);
-    expect_OS_MD5_File_call(diff->file_origin, md5sum_new, OS_BINARY, 0);
+    expect_fim_diff_compare(diff->file_origin, CURRENT_CONTENT);
 
     int ret = fim_diff_compare(diff);
 
     assert_int_equal(ret, 0);
+    assert_int_equal(diff->content_size, strlen(CURRENT_CONTENT));
+    assert_string_equal(diff->content, CURRENT_CONTENT);
 }
 
-void test_fim_diff_compare_fail_match(void **state) {
+void test_fim_diff_compare_match(void **state) {
     diff_data *diff = *state;
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
     diff->file_origin = strdup("/path/to/original/file");
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "3c183a30cffcda1408daf1c61d47b274";
+    diff->baseline = strdup(STORED_CONTENT);
+    diff->baseline_size = strlen(STORED_CONTENT);
 
-    expect_OS_MD5_File_call(diff->uncompress_file, md5sum_old, OS_BINARY, 0);
-    expect_OS_MD5_File_call(diff->file_origin, md5sum_new, OS_BINARY, 0);
+    expect_fim_diff_compare(diff->file_origin, STORED_CONTENT);
 
     int ret = fim_diff_compare(diff);
 
@@ -954,130 +733,35 @@ void test_is_registry_nodiff_not_match(void **state) {
 }
 #endif
 
-// gen_diff_str function tests
-
-void test_gen_diff_str_wfropen_fail(void **state) {
-    diff_data *diff = *state;
-    diff->diff_file = strdup("/path/to/diff/file");
-
-    expect_wfopen(diff->diff_file, "rb", NULL);
-
-    expect_string(__wrap__merror, formatted_msg, "(6665): Unable to generate diff alert (fopen)'/path/to/diff/file'.");
-
-    char *diff_str = gen_diff_str(diff);
-    assert_ptr_equal(diff_str, NULL);
-}
+// fim_diff_generate function tests
 
-void test_gen_diff_str_fread_fail(void **state) {
+void test_fim_diff_generate_binary(void **state) {
     diff_data *diff = *state;
-    diff->diff_file = strdup("/path/to/diff/file");
-    FILE *fp = (FILE*)2345;
-    char *diff_contain = "diff_contain";
-
-    expect_wfopen(diff->diff_file, "rb", fp);
-
-    expect_fread(diff_contain, 0);
-
-    expect_fclose(fp, 0);
-
-#ifndef TEST_WINAGENT
-    expect_string(__wrap_unlink, file, "/path/to/diff/file");
-    will_return(__wrap_unlink, 0);
-#endif
-
-    expect_string(__wrap__merror, formatted_msg, "(6666): Unable to generate diff alert (fread).");
-
-    char *diff_str = gen_diff_str(diff);
-    assert_ptr_equal(diff_str, NULL);
-}
-
-void test_gen_diff_str_ok(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-    gen_diff_data_container->diff->diff_file = strdup("/path/to/diff/file");
-
-    FILE *fp = (FILE*)2345;
-    size_t n = 145;
-
-    expect_wfopen(gen_diff_data_container->diff->diff_file, "rb", fp);
+    diff->file_origin = strdup("/path/to/file/origin");
+    os_calloc(sizeof(BINARY_CONTENT), sizeof(char), diff->baseline);
+    memcpy(diff->baseline, BINARY_CONTENT, sizeof(BINARY_CONTENT));
+    diff->baseline_size = sizeof(BINARY_CONTENT) - 1;
+    diff->content = strdup(CURRENT_CONTENT);
+    diff->content_size = strlen(CURRENT_CONTENT);
 
-    expect_fread(gen_diff_data_container->strarray[0], n);
+    expect_string(__wrap__mdebug2, formatted_msg, "(6377): Binary content, don't compute differences for '/path/to/file/origin'");
 
-    expect_fclose(fp, 0);
-
-#ifndef TEST_WINAGENT
-    expect_string(__wrap_unlink, file, "/path/to/diff/file");
-    will_return(__wrap_unlink, 0);
-#endif
+    char *diff_str = fim_diff_generate(diff);
+    assert_string_equal(diff_str, "Binary files differ");
 
-    char *diff_str = gen_diff_str(gen_diff_data_container->diff);
-    assert_string_equal(diff_str, gen_diff_data_container->strarray[1]);
     free(diff_str);
 }
 
-#ifdef TEST_WINAGENT
-void test_fim_diff_generate_filters_fail(void **state) {
-    diff_data *diff = *state;
-    diff->uncompress_file = strdup("\%wrong path");
-    diff->file_origin = strdup("\%wrong path");
-    diff->diff_file = strdup("\%wrong path");
-
-    expect_string(__wrap__mdebug1, formatted_msg, "(6200): Diff execution skipped for containing insecure characters.");
-
-    char *diff_str = fim_diff_generate(diff);
-    assert_ptr_equal(diff_str, NULL);
-}
-
-void test_fim_diff_generate_status_equal(void **state) {
+void test_fim_diff_generate_ok(void **state) {
     diff_data *diff = *state;
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
     diff->file_origin = strdup("/path/to/file/origin");
-    diff->diff_file = strdup("/path/to/diff/file");
-
-    expect_system(0);
-
-    expect_string(__wrap__mdebug2, formatted_msg, "(6352): Command diff/fc output 0, files are the same");
+    diff->baseline = strdup(STORED_CONTENT);
+    diff->baseline_size = strlen(STORED_CONTENT);
+    diff->content = strdup(CURRENT_CONTENT);
+    diff->content_size = strlen(CURRENT_CONTENT);
 
     char *diff_str = fim_diff_generate(diff);
-    assert_ptr_equal(diff_str, NULL);
-}
-#endif
-
-void test_fim_diff_generate_status_error(void **state) {
-    diff_data *diff = *state;
-
-    diff->uncompress_file = strdup("/path/to/uncompress/file");
-    diff->file_origin = strdup("/path/to/file/origin");
-    diff->diff_file = strdup("/path/to/diff/file");
-
-    expect_system(-1);
-
-#ifdef TEST_WINAGENT
-    expect_string(__wrap__merror, formatted_msg, "(6714): Command fc output an error");
-#else
-    expect_string(__wrap__merror, formatted_msg, "(6714): Command diff output an error");
-#endif
-
-    char *diff_str = fim_diff_generate(diff);
-    assert_ptr_equal(diff_str, NULL);
-}
-
-void test_fim_diff_generate_status_ok(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-
-    gen_diff_data_container->diff->uncompress_file = strdup("/path/to/uncompress/file");
-    gen_diff_data_container->diff->file_origin = strdup("/path/to/file/origin");
-    gen_diff_data_container->diff->diff_file = strdup("/path/to/diff/file");
-
-#ifndef TEST_WINAGENT
-    expect_system(256);
-#else
-    expect_system(1);
-#endif
-
-    expect_gen_diff_generate(gen_diff_data_container);
-
-    char *diff_str = fim_diff_generate(gen_diff_data_container->diff);
-    assert_string_equal(diff_str, gen_diff_data_container->strarray[1]);
+    assert_string_equal(diff_str, CONTENT_DIFF);
     free(diff_str);
 }
 
@@ -1305,7 +989,7 @@ void test_fim_registry_value_diff_wrong_quota_reached(void **state) {
     free(diff_str);
 }
 
-void test_fim_registry_value_diff_uncompress_fail(void **state) {
+void test_fim_registry_value_diff_no_stored_content(void **state) {
     const char *key_name = "HKEY_LOCAL_MACHINE\\Software\\Classes\\batfile";
     const char *value_name = "valuename";
     const char *value_data = "value_data";
@@ -1316,7 +1000,7 @@ void test_fim_registry_value_diff_uncompress_fail(void **state) {
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", (FILE *)1234);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", NULL, 0);
 
     expect_fim_diff_create_compress_file("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, "queue/diff/tmp/tmp-entry.gz", 0);
 
@@ -1345,7 +1029,7 @@ void test_fim_registry_value_diff_create_compress_fail(void **state) {
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", NULL);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 1024 * 1024);
 
@@ -1367,20 +1051,18 @@ void test_fim_registry_value_diff_compare_fail(void **state) {
     const char *value_data = "value_data";
     DWORD data_type = REG_EXPAND_SZ;
     registry_t *configuration = &syscheck.registry[0];
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "3c183a30cffcda1408daf1c61d47b274";
 
     expect_fim_diff_registry_tmp("queue/diff/tmp", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, (FILE *)1234, value_data);
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", NULL);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, "queue/diff/tmp/tmp-entry.gz", 0);
 
-    expect_fim_diff_compare("queue/diff/tmp/tmp-entry", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, md5sum_old, md5sum_new, -1);
+    expect_fim_diff_compare("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, STORED_CONTENT);
 
     expect_string(__wrap__mdebug2, formatted_msg, "(6351): The files are identical, don't compute differences");
 
@@ -1400,20 +1082,18 @@ void test_fim_registry_value_diff_nodiff(void **state) {
     const char *value_data = "value_data";
     DWORD data_type = REG_EXPAND_SZ;
     registry_t *configuration = &syscheck.registry[0];
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
 
     expect_fim_diff_registry_tmp("queue/diff/tmp", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, (FILE *)1234, value_data);
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", NULL);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, "queue/diff/tmp/tmp-entry.gz", 0);
 
-    expect_fim_diff_compare("queue/diff/tmp/tmp-entry", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, md5sum_old, md5sum_new, 0);
+    expect_fim_diff_compare("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, CURRENT_CONTENT);
 
     expect_string(__wrap_rmdir_ex, name, "queue/diff/tmp");
     will_return(__wrap_rmdir_ex, 0);
@@ -1425,73 +1105,57 @@ void test_fim_registry_value_diff_nodiff(void **state) {
     free(diff_str);
 }
 
-void test_fim_registry_value_diff_generate_fail(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-
+void test_fim_registry_value_diff_binary_content(void **state) {
     const char *key_name = "HKEY_LOCAL_MACHINE\\Software\\Classes\\batfile";
     const char *value_name = "valuename";
     const char *value_data = "value_data";
     DWORD data_type = REG_EXPAND_SZ;
     registry_t *configuration = &syscheck.registry[0];
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
-
-    gen_diff_data_container->diff->uncompress_file = "queue/diff/tmp/tmp-entry";
-    gen_diff_data_container->diff->file_origin = "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED;
-    gen_diff_data_container->diff->diff_file = "queue/diff/tmp/diff-file";
 
     expect_fim_diff_registry_tmp("queue/diff/tmp", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, (FILE *)1234, value_data);
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", NULL);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", BINARY_CONTENT, sizeof(BINARY_CONTENT) - 1);
 
     expect_FileSize("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, "queue/diff/tmp/tmp-entry.gz", 0);
 
-    expect_fim_diff_compare("queue/diff/tmp/tmp-entry", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, md5sum_old, md5sum_new, 0);
+    expect_fim_diff_compare("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, CURRENT_CONTENT);
 
-    expect_fim_diff_generate(gen_diff_data_container, 1);
+    expect_string(__wrap__mdebug2, formatted_msg, "(6377): Binary content, don't compute differences for 'queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED "'");
 
-    expect_string(__wrap__merror, formatted_msg, "(6714): Command fc output an error");
+    expect_save_compress_file("queue/diff/tmp/tmp-entry.gz", "queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 0);
 
     expect_string(__wrap_rmdir_ex, name, "queue/diff/tmp");
     will_return(__wrap_rmdir_ex, 0);
 
     char *diff_str = fim_registry_value_diff(key_name, value_name, value_data, data_type, configuration);
 
-    assert_ptr_equal(diff_str, NULL);
+    assert_string_equal(diff_str, "Binary files differ");
+
+    free(diff_str);
 }
 
 void test_fim_registry_value_diff_generate_diff_str(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-
     const char *key_name = "HKEY_LOCAL_MACHINE\\Software\\Classes\\batfile";
     const char *value_name = "valuename";
     const char *value_data = "value_data";
     DWORD data_type = REG_EXPAND_SZ;
     registry_t *configuration = &syscheck.registry[0];
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
-
-    gen_diff_data_container->diff->uncompress_file = "queue/diff/tmp/tmp-entry";
-    gen_diff_data_container->diff->file_origin = "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED;
-    gen_diff_data_container->diff->diff_file = "queue/diff/tmp/diff-file";
 
     expect_fim_diff_registry_tmp("queue/diff/tmp", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, (FILE *)1234, value_data);
 
     expect_fim_diff_check_limits("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, COMPRESS_FOLDER_REG, 0);
 
-    expect_w_uncompress_gzfile("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", "queue/diff/tmp/tmp-entry", NULL);
+    expect_w_get_gzfile_content("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, "queue/diff/tmp/tmp-entry.gz", 0);
 
-    expect_fim_diff_compare("queue/diff/tmp/tmp-entry", "queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, md5sum_old, md5sum_new, 0);
-
-    expect_fim_diff_generate(gen_diff_data_container, 0);
+    expect_fim_diff_compare("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED, CURRENT_CONTENT);
 
     expect_save_compress_file("queue/diff/tmp/tmp-entry.gz", "queue/diff/registry/[x64] " KEY_NAME_HASHED "/" VALUE_NAME_HASHED "/last-entry.gz", 0);
 
@@ -1500,7 +1164,9 @@ void test_fim_registry_value_diff_generate_diff_str(void **state) {
 
     char *diff_str = fim_registry_value_diff(key_name, value_name, value_data, data_type, configuration);
 
-    assert_string_equal(diff_str, gen_diff_data_container->strarray[1]);
+    assert_string_equal(diff_str, CONTENT_DIFF);
+
+    free(diff_str);
 }
 #endif
 
@@ -1566,7 +1232,7 @@ void test_fim_file_diff_wrong_quota_reached(void **state) {
     free(diff_str);
 }
 
-void test_fim_file_diff_uncompress_fail(void **state) {
+void test_fim_file_diff_no_stored_content(void **state) {
     const char *filename = GENERIC_PATH;
     syscheck.comp_estimation_perc = 0.4;
     syscheck.diff_folder_size = 512;
@@ -1578,7 +1244,7 @@ void test_fim_file_diff_uncompress_fail(void **state) {
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, (FILE *)1234);
+    expect_w_get_gzfile_content(COMPRESS_FILE, NULL, 0);
 
     expect_fim_diff_create_compress_file(GENERIC_PATH, COMPRESS_TMP_FILE, 0);
 
@@ -1608,7 +1274,7 @@ void test_fim_file_diff_create_compress_fail(void **state) {
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content(COMPRESS_FILE, STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize(COMPRESS_FILE, 1024 * 1024);
 
@@ -1630,8 +1296,6 @@ void test_fim_file_diff_create_compress_fail(void **state) {
 
 void test_fim_file_diff_compare_fail(void **state) {
     const char *filename = GENERIC_PATH;
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
     const directory_t configuration = { .diff_size_limit = 1024 };
 
     syscheck.comp_estimation_perc = 0.4;
@@ -1643,13 +1307,13 @@ void test_fim_file_diff_compare_fail(void **state) {
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content(COMPRESS_FILE, STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize(COMPRESS_FILE, 1024 * 1024);
 
     expect_fim_diff_create_compress_file(GENERIC_PATH, COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, GENERIC_PATH, md5sum_old, md5sum_new, -1);
+    expect_fim_diff_compare(GENERIC_PATH, STORED_CONTENT);
 
     expect_string(__wrap__mdebug2, formatted_msg, "(6351): The files are identical, don't compute differences");
 
@@ -1666,8 +1330,6 @@ void test_fim_file_diff_compare_fail(void **state) {
 #ifdef TEST_WINAGENT
 void test_fim_file_diff_nodiff(void **state) {
     const char *filename = "c:\\file\\nodiff";
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
     const directory_t configuration = { .diff_size_limit = 1024 };
 
     syscheck.comp_estimation_perc = 0.4;
@@ -1679,13 +1341,13 @@ void test_fim_file_diff_nodiff(void **state) {
 
     expect_fim_diff_check_limits("c:\\file\\nodiff", "aaa", 0);
 
-    expect_w_uncompress_gzfile("queue/diff/file/2ddcb012cae2957e19d31b10df12abc8c852cfb7/last-entry.gz", UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content("queue/diff/file/2ddcb012cae2957e19d31b10df12abc8c852cfb7/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/file/2ddcb012cae2957e19d31b10df12abc8c852cfb7/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("c:\\file\\nodiff", COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, "c:\\file\\nodiff", md5sum_old, md5sum_new, 0);
+    expect_fim_diff_compare("c:\\file\\nodiff", CURRENT_CONTENT);
 
     expect_string(__wrap_rmdir_ex, name, TMP_FOLDER);
     will_return(__wrap_rmdir_ex, 0);
@@ -1699,8 +1361,6 @@ void test_fim_file_diff_nodiff(void **state) {
 #else
 void test_fim_file_diff_nodiff(void **state) {
     const char *filename = "/path/to/ignore";
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
     const directory_t configuration = { .diff_size_limit = 1024 };
 
     syscheck.comp_estimation_perc = 0.4;
@@ -1712,13 +1372,13 @@ void test_fim_file_diff_nodiff(void **state) {
 
     expect_fim_diff_check_limits("/path/to/ignore", "aaa", 0);
 
-    expect_w_uncompress_gzfile("queue/diff/file/2ee531af6f6a5f133cdd38e818e1de895c29114c/last-entry.gz", UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content("queue/diff/file/2ee531af6f6a5f133cdd38e818e1de895c29114c/last-entry.gz", STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize("queue/diff/file/2ee531af6f6a5f133cdd38e818e1de895c29114c/last-entry.gz", 1024 * 1024);
 
     expect_fim_diff_create_compress_file("/path/to/ignore", COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, "/path/to/ignore", md5sum_old, md5sum_new, 0);
+    expect_fim_diff_compare("/path/to/ignore", CURRENT_CONTENT);
 
     expect_string(__wrap_rmdir_ex, name, TMP_FOLDER);
     will_return(__wrap_rmdir_ex, 0);
@@ -1731,89 +1391,63 @@ void test_fim_file_diff_nodiff(void **state) {
 }
 #endif
 
-void test_fim_file_diff_generate_fail(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
+void test_fim_file_diff_binary_content(void **state) {
     const directory_t configuration = { .diff_size_limit = 1024 };
 
     syscheck.comp_estimation_perc = 0.4;
     syscheck.diff_folder_size = 512;
 
-#ifndef TEST_WINAGENT
-    gen_diff_data_container->diff->uncompress_file = strdup(UNCOMPRESS_FILE);
-    gen_diff_data_container->diff->file_origin = strdup("/path/to/file/origin");
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#else
-    gen_diff_data_container->diff->uncompress_file = strdup("queue/diff/tmp/tmp-entry");
-    gen_diff_data_container->diff->file_origin = strdup("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED);
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#endif
-
     expect_initialize_file_diff_data(GENERIC_PATH, 1);
 
     expect_mkdir_ex(TMP_FOLDER, 0);
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content(COMPRESS_FILE, BINARY_CONTENT, sizeof(BINARY_CONTENT) - 1);
 
     expect_FileSize(COMPRESS_FILE, 1024 * 1024);
 
     expect_fim_diff_create_compress_file(GENERIC_PATH, COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, GENERIC_PATH, md5sum_old, md5sum_new, 0);
-
-    expect_fim_diff_generate(gen_diff_data_container, 1);
+    expect_fim_diff_compare(GENERIC_PATH, CURRENT_CONTENT);
 
 #ifndef TEST_WINAGENT
-    expect_string(__wrap__merror, formatted_msg, "(6714): Command diff output an error");
+    expect_string(__wrap__mdebug2, formatted_msg, "(6377): Binary content, don't compute differences for '/path/to/file'");
 #else
-    expect_string(__wrap__merror, formatted_msg, "(6714): Command fc output an error");
+    expect_string(__wrap__mdebug2, formatted_msg, "(6377): Binary content, don't compute differences for 'c:\\file\\path'");
 #endif
 
+    expect_save_compress_file(COMPRESS_TMP_FILE, COMPRESS_FILE, 0);
+
     expect_string(__wrap_rmdir_ex, name, TMP_FOLDER);
     will_return(__wrap_rmdir_ex, 0);
 
     char *diff_str = fim_file_diff(GENERIC_PATH, &configuration);
 
-    assert_ptr_equal(diff_str, NULL);
+    assert_string_equal(diff_str, "Binary files differ");
+
+    free(diff_str);
 }
 
 void test_fim_file_diff_generate_diff_str(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
     const directory_t configuration = { .diff_size_limit = 1024 };
 
     syscheck.comp_estimation_perc = 0.4;
     syscheck.diff_folder_size = 512;
 
-#ifndef TEST_WINAGENT
-    gen_diff_data_container->diff->uncompress_file = strdup(UNCOMPRESS_FILE);
-    gen_diff_data_container->diff->file_origin = strdup("/path/to/file/origin");
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#else
-    gen_diff_data_container->diff->uncompress_file = strdup("queue/diff/tmp/tmp-entry");
-    gen_diff_data_container->diff->file_origin = strdup("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED);
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#endif
-
     expect_initialize_file_diff_data(GENERIC_PATH, 1);
 
     expect_mkdir_ex(TMP_FOLDER, 0);
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content(COMPRESS_FILE, STORED_CONTENT, strlen(STORED_CONTENT));
 
     expect_FileSize(COMPRESS_FILE, 1024 * 1024);
 
     expect_fim_diff_create_compress_file(GENERIC_PATH, COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, GENERIC_PATH, md5sum_old, md5sum_new, 0);
-
-    expect_fim_diff_generate(gen_diff_data_container, 0);
+    expect_fim_diff_compare(GENERIC_PATH, CURRENT_CONTENT);
 
     expect_save_compress_file(COMPRESS_TMP_FILE, COMPRESS_FILE, 0);
 
@@ -1822,54 +1456,28 @@ void test_fim_file_diff_generate_diff_str(void **state) {
 
     char *diff_str = fim_file_diff(GENERIC_PATH, &configuration);
 
-    assert_string_equal(diff_str, gen_diff_data_container->strarray[1]);
+    assert_string_equal(diff_str, CONTENT_DIFF);
 
     free(diff_str);
 }
 
 void test_fim_file_diff_generate_diff_str_too_long(void **state) {
-    gen_diff_struct *gen_diff_data_container = *state;
-    os_md5 md5sum_old = "3c183a30cffcda1408daf1c61d47b274";
-    os_md5 md5sum_new = "abc44bfb4ab4cf4af49a4fa9b04fa44a";
     const directory_t configuration = { .diff_size_limit = 1024 };
+    const size_t stored_lines = 20000;
+    char *stored_content;
+    char *diff_str;
+    size_t length;
+    size_t i;
 
     syscheck.comp_estimation_perc = 0.4;
     syscheck.diff_folder_size = 512;
 
-#ifndef TEST_WINAGENT
-    int input_size = strlen(gen_diff_data_container->strarray[0]);
-    os_realloc(gen_diff_data_container->strarray[0], OS_MAXSTR, gen_diff_data_container->strarray[0]);
-    memset(gen_diff_data_container->strarray[0] + input_size - 1, 'a', OS_MAXSTR - input_size);
-    gen_diff_data_container->strarray[0][OS_MAXSTR - 1] = '\0';
-
-    os_realloc(gen_diff_data_container->strarray[1], strlen(gen_diff_data_container->strarray[1]) - 12 + strlen(STR_MORE_CHANGES) + 1, gen_diff_data_container->strarray[1]);
-    strcpy(gen_diff_data_container->strarray[1] + strlen(gen_diff_data_container->strarray[1]) - 12, STR_MORE_CHANGES);
-
-    gen_diff_data_container->diff->uncompress_file = strdup(UNCOMPRESS_FILE);
-    gen_diff_data_container->diff->file_origin = strdup("/path/to/file/origin");
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#else
-    strcpy(gen_diff_data_container->strarray[0], "Comparing files start.txt and end.txt\r\n"
-                                                 "Error diffs\r\n"
-                                                 "***** start.txt\r\n"
-                                                 "    1:  First line\r\n"
-                                                 "***** END.TXT\r\n"
-                                                 "    1:  First Line 123\r\n"
-                                                 "    2:  Last line");
-    int input_size = strlen(gen_diff_data_container->strarray[0]);
-    os_realloc(gen_diff_data_container->strarray[0], OS_MAXSTR, gen_diff_data_container->strarray[0]);
-    memset(gen_diff_data_container->strarray[0] + input_size, 'a', OS_MAXSTR - input_size);
-    gen_diff_data_container->strarray[0][OS_MAXSTR - 1] = '\0';
-
-    int output_size = strlen(gen_diff_data_container->strarray[1]);
-    os_realloc(gen_diff_data_container->strarray[1], OS_MAXSTR, gen_diff_data_container->strarray[1]);
-    memset(gen_diff_data_container->strarray[1] + output_size - 1, 'a', OS_MAXSTR - output_size - OS_SK_HEADER - 85 - strlen(STR_MORE_CHANGES));
-    strcat(gen_diff_data_container->strarray[1], STR_MORE_CHANGES);
-
-    gen_diff_data_container->diff->uncompress_file = strdup("queue/diff/tmp/tmp-entry");
-    gen_diff_data_container->diff->file_origin = strdup("queue/diff/tmp/[x64] " KEY_NAME_HASHED VALUE_NAME_HASHED);
-    gen_diff_data_container->diff->diff_file = strdup("queue/diff/tmp/diff-file");
-#endif
+    // Every stored line is replaced, so the diff goes well beyond the event size
+    os_malloc(stored_lines * 5 + 1, stored_content);
+    for (i = 0; i < stored_lines; i++) {
+        memcpy(stored_content + i * 5, "line\n", 5);
+    }
+    stored_content[stored_lines * 5] = '\0';
 
     expect_initialize_file_diff_data(GENERIC_PATH, 1);
 
@@ -1877,23 +1485,30 @@ void test_fim_file_diff_generate_diff_str_too_long(void **state) {
 
     expect_fim_diff_check_limits(GENERIC_PATH, COMPRESS_FOLDER, 0);
 
-    expect_w_uncompress_gzfile(COMPRESS_FILE, UNCOMPRESS_FILE, NULL);
+    expect_w_get_gzfile_content(COMPRESS_FILE, stored_content, stored_lines * 5);
 
     expect_FileSize(COMPRESS_FILE, 1024 * 1024);
 
     expect_fim_diff_create_compress_file(GENERIC_PATH, COMPRESS_TMP_FILE, 0);
 
-    expect_fim_diff_compare(UNCOMPRESS_FILE, GENERIC_PATH, md5sum_old, md5sum_new, 0);
-
-    expect_fim_diff_generate(gen_diff_data_container, 0);
+    expect_fim_diff_compare(GENERIC_PATH, CURRENT_CONTENT);
 
     expect_save_compress_file(COMPRESS_TMP_FILE, COMPRESS_FILE, 0);
 
     expect_string(__wrap_rmdir_ex, name, TMP_FOLDER);
     will_return(__wrap_rmdir_ex, 0);
-    char *diff_str = fim_file_diff(GENERIC_PATH, &configuration);
 
-    assert_string_equal(diff_str, gen_diff_data_container->strarray[1]);
+    diff_str = fim_file_diff(GENERIC_PATH, &configuration);
+    free(stored_content);
+
+    assert_non_null(diff_str);
+    length = strlen(diff_str);
+
+    assert_true(length <= OS_MAXSTR - OS_SK_HEADER - 1);
+    assert_memory_equal(diff_str, "1,20000c1,2\n< line\n", strlen("1,20000c1,2\n< line\n"));
+    assert_string_equal(diff_str + length - strlen(STR_MORE_CHANGES), STR_MORE_CHANGES);
+    assert_int_equal(diff_str[length - strlen(STR_MORE_CHANGES) - 1], '\n');
+
     free(diff_str);
 }
 
@@ -1984,15 +1599,6 @@ int main(void) {
     const struct CMUnitTest tests[] = {
 
 #ifdef TEST_WINAGENT
-        // filter
-        cmocka_unit_test_teardown(test_filter_unchanged_string, teardown_free_string),
-        cmocka_unit_test(test_filter_percentage_char),
-
-        // adapt_win_fc_output
-        cmocka_unit_test_setup_teardown(test_adapt_win_fc_output_success, setup_array_strings, teardown_array_strings),
-        cmocka_unit_test_setup_teardown(test_adapt_win_fc_output_invalid_input, setup_array_strings, teardown_array_strings),
-        cmocka_unit_test_setup_teardown(test_adapt_win_fc_output_no_differences, setup_array_strings, teardown_array_strings),
-
         // initialize_registry_diff_data
         cmocka_unit_test_teardown(test_initialize_registry_diff_data, teardown_free_diff_data),
 #endif
@@ -2000,9 +1606,6 @@ int main(void) {
         cmocka_unit_test_teardown(test_initialize_file_diff_data, teardown_free_diff_data),
         cmocka_unit_test_teardown(test_initialize_file_diff_data_abspath_fail, teardown_free_diff_data),
 
-        // filter
-        cmocka_unit_test_teardown(test_filter, teardown_free_string),
-
         // fim_diff_check_limits
         cmocka_unit_test_setup_teardown(test_fim_diff_check_limits, setup_diff_data, teardown_free_diff_data),
         cmocka_unit_test_setup_teardown(test_fim_diff_check_limits_size_limit_reached, setup_diff_data, teardown_free_diff_data),
@@ -2029,10 +1632,10 @@ int main(void) {
         cmocka_unit_test(test_fim_diff_modify_compress_estimation_ok),
 
         // fim_diff_compare
-        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fail_uncompress_MD5, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fail_origin_MD5, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fail_not_match, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fail_match, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fopen_fail, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_compare_fread_fail, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_compare_not_match, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_compare_match, setup_diff_data, teardown_free_diff_data),
 
         // save_compress_file
         cmocka_unit_test_setup_teardown(test_save_compress_file_ok, setup_diff_data, teardown_free_diff_data),
@@ -2050,18 +1653,11 @@ int main(void) {
         cmocka_unit_test(test_is_registry_nodiff_not_match),
 #endif
 
-        // gen_diff_str
-        cmocka_unit_test_setup_teardown(test_gen_diff_str_wfropen_fail, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_gen_diff_str_fread_fail, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_gen_diff_str_ok, setup_gen_diff_str, teardown_free_gen_diff_str),
-
         // fim_diff_generate
-        cmocka_unit_test_setup_teardown(test_fim_diff_generate_status_error, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_fim_diff_generate_status_ok, setup_gen_diff_str, teardown_free_gen_diff_str),
-#ifdef TEST_WINAGENT
-        cmocka_unit_test_setup_teardown(test_fim_diff_generate_filters_fail, setup_diff_data, teardown_free_diff_data),
-        cmocka_unit_test_setup_teardown(test_fim_diff_generate_status_equal, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_generate_binary, setup_diff_data, teardown_free_diff_data),
+        cmocka_unit_test_setup_teardown(test_fim_diff_generate_ok, setup_diff_data, teardown_free_diff_data),
 
+#ifdef TEST_WINAGENT
         // fim_diff_registry_tmp
         cmocka_unit_test_setup_teardown(test_fim_diff_registry_tmp_fopen_fail, setup_diff_data, teardown_free_diff_data),
         cmocka_unit_test_setup_teardown(test_fim_diff_registry_tmp_REG_SZ, setup_diff_data, teardown_free_diff_data),
@@ -2076,11 +1672,11 @@ int main(void) {
         cmocka_unit_test(test_fim_registry_value_diff_wrong_registry_tmp),
         cmocka_unit_test(test_fim_registry_value_diff_wrong_too_big_file),
         cmocka_unit_test(test_fim_registry_value_diff_wrong_quota_reached),
-        cmocka_unit_test(test_fim_registry_value_diff_uncompress_fail),
+        cmocka_unit_test(test_fim_registry_value_diff_no_stored_content),
         cmocka_unit_test(test_fim_registry_value_diff_create_compress_fail),
         cmocka_unit_test(test_fim_registry_value_diff_compare_fail),
         cmocka_unit_test(test_fim_registry_value_diff_nodiff),
-        cmocka_unit_test_setup_teardown(test_fim_registry_value_diff_generate_fail, setup_full_diff_functionality, teardown_full_diff_functionality),
+        cmocka_unit_test_setup_teardown(test_fim_registry_value_diff_binary_content, setup_full_diff_functionality, teardown_full_diff_functionality),
         cmocka_unit_test_setup_teardown(test_fim_registry_value_diff_generate_diff_str, setup_full_diff_functionality, teardown_full_diff_functionality),
 #endif
 
@@ -2088,18 +1684,18 @@ int main(void) {
         cmocka_unit_test(test_fim_file_diff_wrong_initialize),
         cmocka_unit_test(test_fim_file_diff_wrong_too_big_file),
         cmocka_unit_test(test_fim_file_diff_wrong_quota_reached),
-        cmocka_unit_test(test_fim_file_diff_uncompress_fail),
+        cmocka_unit_test(test_fim_file_diff_no_stored_content),
         cmocka_unit_test(test_fim_file_diff_create_compress_fail),
         cmocka_unit_test(test_fim_file_diff_compare_fail),
         cmocka_unit_test(test_fim_file_diff_nodiff),
 #ifdef TEST_WINAGENT
-        cmocka_unit_test_setup_teardown(test_fim_file_diff_generate_fail, setup_full_diff_functionality, teardown_full_diff_functionality),
+        cmocka_unit_test_setup_teardown(test_fim_file_diff_binary_content, setup_full_diff_functionality, teardown_full_diff_functionality),
         cmocka_unit_test_setup_teardown(test_fim_file_diff_generate_diff_str, setup_full_diff_functionality, teardown_full_diff_functionality),
 #else
-        cmocka_unit_test_setup_teardown(test_fim_file_diff_generate_fail, setup_gen_diff_str, teardown_free_gen_diff_str),
-        cmocka_unit_test_setup_teardown(test_fim_file_diff_generate_diff_str, setup_gen_diff_str, teardown_free_gen_diff_str),
+        cmocka_unit_test(test_fim_file_diff_binary_content),
+        cmocka_unit_test(test_fim_file_diff_generate_diff_str),
 #endif
-        cmocka_unit_test_setup_teardown(test_fim_file_diff_generate_diff_str_too_long, setup_gen_diff_str, teardown_free_gen_diff_str),
+        cmocka_unit_test(test_fim_file_diff_generate_diff_str_too_long),
 
         // fim_diff_process_delete_file
         cmocka_unit_test(test_fim_diff_process_delete_file_ok),
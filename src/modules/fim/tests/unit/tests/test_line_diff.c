@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+#include "../syscheckd/include/syscheck.h"
+#include "../config/syscheck-config.h"
+
+#define MAX_LENGTH (OS_MAXSTR - OS_SK_HEADER - 1)
+
+
+/* teardown */
+
+static int teardown_free_string(void **state) {
+    free(*state);
+
+    return 0;
+}
+
+static void assert_line_diff(void **state, const char *old_data, const char *new_data, const char *expected) {
+    char *diff = fim_line_diff(old_data, strlen(old_data), new_data, strlen(new_data), MAX_LENGTH);
+
+    *state = diff;
+
+    assert_non_null(diff);
+    assert_string_equal(diff, expected);
+}
+
+
+/* tests */
+
+void test_fim_line_diff_change(void **state) {
+    assert_line_diff(state, "a\nb\nc\n", "a\nB\nc\nd\n", "2c2\n< b\n---\n> B\n3a4\n> d\n");
+}
+
+void test_fim_line_diff_add(void **state) {
+    assert_line_diff(state, "a\nc\n", "a\nb\nc\n", "1a2\n> b\n");
+}
+
+void test_fim_line_diff_delete(void **state) {
+    assert_line_diff(state, "a\nb\nc\n", "a\nc\n", "2d1\n< b\n");
+}
+
+void test_fim_line_diff_moved_line(void **state) {
+    assert_line_diff(state, "a\nb\nc\n", "c\na\nb\n", "0a1\n> c\n3d3\n< c\n");
+}
+
+void test_fim_line_diff_empty_old_content(void **state) {
+    assert_line_diff(state, "", "a\nb\n", "0a1,2\n> a\n> b\n");
+}
+
+void test_fim_line_diff_no_newline_at_end(void **state) {
+    assert_line_diff(state,
+                     "a\nb",
+                     "a\nc",
+                     "2c2\n< b\n\\ No newline at end of file\n---\n> c\n\\ No newline at end of file\n");
+}
+
+void test_fim_line_diff_identical(void **state) {
+    assert_line_diff(state, "a\nb\n", "a\nb\n", "");
+}
+
+void test_fim_line_diff_binary(void **state) {
+    const char old_data[] = "a\0b\n";
+    char *diff = fim_line_diff(old_data, sizeof(old_data) - 1, "a\nb\n", 4, MAX_LENGTH);
+
+    assert_null(diff);
+}
+
+void test_fim_line_diff_truncated(void **state) {
+    char old_data[100 * 5 + 1];
+    char *diff;
+    int i;
+
+    for (i = 0; i < 100; i++) {
+        memcpy(old_data + i * 5, "line\n", 5);
+    }
+    old_data[100 * 5] = '\0';
+
+    // The output is cut at the end of the last line that leaves room for the notice
+    diff = fim_line_diff(old_data, strlen(old_data), "", 0, 64);
+    *state = diff;
+
+    assert_non_null(diff);
+    assert_string_equal(diff, "1,100d0\n< line\n< line\n< line\n< line\n< line\nMore changes...");
+}
+
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_teardown(test_fim_line_diff_change, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_add, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_delete, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_moved_line, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_empty_old_content, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_no_newline_at_end, teardown_free_string),
+        cmocka_unit_test_teardown(test_fim_line_diff_identical, teardown_free_string),
+        cmocka_unit_test(test_fim_line_diff_binary),
+        cmocka_unit_test_teardown(test_fim_line_diff_truncated, teardown_free_string),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
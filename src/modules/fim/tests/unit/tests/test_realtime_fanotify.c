@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/fanotify.h>
+
+#include "../wrappers/common.h"
+#include "../wrappers/posix/stat_wrappers.h"
+#include "../wrappers/posix/unistd_wrappers.h"
+#include "../wrappers/linux/fanotify_wrappers.h"
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+#include "../wrappers/wazuh/syscheckd/create_db_wrappers.h"
+#include "../wrappers/wazuh/syscheckd/run_check_wrappers.h"
+
+#include "../syscheckd/include/syscheck.h"
+#include "../config/syscheck-config.h"
+
+#define HANDLE_BYTES 8
+
+extern int _fanotify_fd;
+extern size_t _filesystems_count;
+
+static directory_t realtime_configuration = { .options = REALTIME_ACTIVE };
+static directory_t scheduled_configuration = { .options = SCHEDULED_ACTIVE };
+
+
+/* setup/teardown */
+
+static int setup_group(void **state) {
+    syscheck.realtime = (rtfim *) calloc(1, sizeof(rtfim));
+
+    if (syscheck.realtime == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int teardown_group(void **state) {
+    os_free(syscheck.realtime);
+
+    return 0;
+}
+
+static int setup_fanotify(void **state) {
+    _fanotify_fd = 5;
+    _filesystems_count = 0;
+    syscheck.realtime->queue_overflow = 0;
+
+    return 0;
+}
+
+static int teardown_fanotify(void **state) {
+    _fanotify_fd = -1;
+    _filesystems_count = 0;
+
+    return 0;
+}
+
+
+/* auxiliary functions */
+
+/* Marks /tmp as the filesystem with the given id, its mount descriptor is opened for real */
+static void mark_filesystem(dev_t dev, int fsid) {
+    struct stat statbuf = { .st_dev = dev, .st_mode = S_IFDIR };
+    struct statfs fs_info = { .f_fsid = { .__val = { fsid, 0 } } };
+
+    expect_string(__wrap_lstat, filename, "/tmp");
+    will_return(__wrap_lstat, &statbuf);
+    will_return(__wrap_lstat, 0);
+
+    expect_string(__wrap_statfs, path, "/tmp");
+    will_return(__wrap_statfs, &fs_info);
+    will_return(__wrap_statfs, 0);
+
+    expect_value(__wrap_fanotify_mark, flags, FAN_MARK_ADD | FAN_MARK_FILESYSTEM | FAN_MARK_DONT_FOLLOW);
+    expect_string(__wrap_fanotify_mark, pathname, "/tmp");
+    will_return(__wrap_fanotify_mark, 0);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "(6378): Monitoring the filesystem of '/tmp' with fanotify.");
+
+    assert_int_equal(fim_fanotify_watch("/tmp", &realtime_configuration), 1);
+}
+
+/* Writes an event as reported with FAN_REPORT_DFID_NAME: the handle of the parent directory and the name */
+static size_t write_event(char *buffer, uint64_t mask, int fsid, const char *name) {
+    struct fanotify_event_metadata *event = (struct fanotify_event_metadata *) buffer;
+    struct fanotify_event_info_fid *fid = (struct fanotify_event_info_fid *) (event + 1);
+    struct file_handle *handle = (struct file_handle *) fid->handle;
+    size_t len = sizeof(*event) + sizeof(*fid) + sizeof(*handle) + HANDLE_BYTES + strlen(name) + 1;
+
+    len = (len + 7) & ~7;
+    memset(buffer, 0, len);
+
+    event->event_len = len;
+    event->vers = FANOTIFY_METADATA_VERSION;
+    event->metadata_len = sizeof(*event);
+    event->mask = mask;
+    event->fd = FAN_NOFD;
+
+    fid->hdr.info_type = FAN_EVENT_INFO_TYPE_DFID_NAME;
+    fid->hdr.len = len - sizeof(*event);
+    fid->fsid.val[0] = fsid;
+
+    handle->handle_bytes = HANDLE_BYTES;
+    handle->handle_type = 1;
+    memset(handle->f_handle, 0xab, HANDLE_BYTES);
+    strcpy((char *) handle->f_handle + HANDLE_BYTES, name);
+
+    return len;
+}
+
+/* The directory handle is opened as /tmp, so the event refers to /tmp/<name> */
+static void expect_open_by_handle_at() {
+    expect_any(__wrap_open_by_handle_at, mount_fd);
+    will_return(__wrap_open_by_handle_at, open("/tmp", O_RDONLY | O_DIRECTORY));
+}
+
+
+/* tests */
+
+void test_fim_fanotify_start_success(void **state) {
+    expect_value(__wrap_fanotify_init, flags, FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_REPORT_DFID_NAME);
+    will_return(__wrap_fanotify_init, 7);
+
+    assert_int_equal(fim_fanotify_start(), 0);
+    assert_int_equal(fim_fanotify_get_fd(), 7);
+}
+
+void test_fim_fanotify_start_failure(void **state) {
+    expect_value(__wrap_fanotify_init, flags, FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_REPORT_DFID_NAME);
+    will_return(__wrap_fanotify_init, -1);
+    errno = EPERM;
+
+    expect_string(__wrap__mwarn, formatted_msg,
+                  "(6959): Unable to initialize fanotify (1) 'Operation not permitted'. Real-time monitoring will use inotify.");
+
+    assert_int_equal(fim_fanotify_start(), -1);
+    assert_int_equal(fim_fanotify_get_fd(), -1);
+}
+
+void test_fim_fanotify_watch_not_started(void **state) {
+    _fanotify_fd = -1;
+
+    assert_int_equal(fim_fanotify_watch("/tmp", &realtime_configuration), 0);
+}
+
+void test_fim_fanotify_watch_lstat_failure(void **state) {
+    expect_string(__wrap_lstat, filename, "/tmp");
+    will_return(__wrap_lstat, NULL);
+    will_return(__wrap_lstat, -1);
+
+    assert_int_equal(fim_fanotify_watch("/tmp", &realtime_configuration), 0);
+    assert_int_equal(fim_fanotify_get_marks(), 0);
+}
+
+void test_fim_fanotify_watch_mark(void **state) {
+    mark_filesystem(1, 10);
+
+    assert_int_equal(fim_fanotify_get_marks(), 1);
+}
+
+void test_fim_fanotify_watch_same_filesystem(void **state) {
+    struct stat statbuf = { .st_dev = 1, .st_mode = S_IFDIR };
+
+    mark_filesystem(1, 10);
+
+    // Directories in a marked filesystem don't add marks
+    expect_string(__wrap_lstat, filename, "/tmp/dir");
+    will_return(__wrap_lstat, &statbuf);
+    will_return(__wrap_lstat, 0);
+
+    assert_int_equal(fim_fanotify_watch("/tmp/dir", &realtime_configuration), 1);
+    assert_int_equal(fim_fanotify_get_marks(), 1);
+}
+
+void test_fim_fanotify_watch_mark_failure(void **state) {
+    struct stat statbuf = { .st_dev = 2, .st_mode = S_IFDIR };
+    struct statfs fs_info = { .f_fsid = { .__val = { 20, 0 } } };
+
+    expect_string(__wrap_lstat, filename, "/proc");
+    will_return(__wrap_lstat, &statbuf);
+    will_return(__wrap_lstat, 0);
+
+    expect_string(__wrap_statfs, path, "/proc");
+    will_return(__wrap_statfs, &fs_info);
+    will_return(__wrap_statfs, 0);
+
+    expect_value(__wrap_fanotify_mark, flags, FAN_MARK_ADD | FAN_MARK_FILESYSTEM | FAN_MARK_DONT_FOLLOW);
+    expect_string(__wrap_fanotify_mark, pathname, "/proc");
+    will_return(__wrap_fanotify_mark, -1);
+    errno = EOPNOTSUPP;
+
+    expect_string(__wrap__mdebug2, formatted_msg,
+                  "(6379): Unable to add fanotify mark for '/proc' (95) 'Operation not supported'. Its directories will be monitored with inotify.");
+
+    assert_int_equal(fim_fanotify_watch("/proc", &realtime_configuration), 0);
+
+    // The filesystem isn't marked again, its directories go straight to inotify
+    expect_string(__wrap_lstat, filename, "/proc/sys");
+    will_return(__wrap_lstat, &statbuf);
+    will_return(__wrap_lstat, 0);
+
+    assert_int_equal(fim_fanotify_watch("/proc/sys", &realtime_configuration), 0);
+    assert_int_equal(fim_fanotify_get_marks(), 0);
+}
+
+void test_fim_fanotify_process_read_failure(void **state) {
+    will_return(__wrap_read, NULL);
+    will_return(__wrap_read, 0);
+
+    expect_string(__wrap__merror, formatted_msg, FIM_ERROR_REALTIME_READ_BUFFER);
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_event(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_MODIFY, 10, "file");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    expect_open_by_handle_at();
+    expect_fim_configuration_directory_call("/tmp/file", &realtime_configuration);
+    expect_string(__wrap__mdebug2, formatted_msg, "Duplicate event in real-time buffer: /tmp/file");
+
+    paths = os_AddStrArray("/tmp/file", paths);
+    will_return(__wrap_rbtree_keys, paths);
+    expect_string(__wrap_fim_realtime_event, file, "/tmp/file");
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_directory_itself(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_ATTRIB | FAN_ONDIR, 10, ".");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    expect_open_by_handle_at();
+    expect_fim_configuration_directory_call("/tmp", &realtime_configuration);
+    expect_string(__wrap__mdebug2, formatted_msg, "Duplicate event in real-time buffer: /tmp");
+
+    paths = os_AddStrArray("/tmp", paths);
+    will_return(__wrap_rbtree_keys, paths);
+    expect_string(__wrap_fim_realtime_event, file, "/tmp");
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_same_directory(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_CREATE, 10, "first");
+    len += write_event(buffer + len, FAN_MODIFY, 10, "second");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    // The directory is resolved once for both events
+    expect_open_by_handle_at();
+    expect_fim_configuration_directory_call("/tmp/first", &realtime_configuration);
+    expect_string(__wrap__mdebug2, formatted_msg, "Duplicate event in real-time buffer: /tmp/first");
+    expect_fim_configuration_directory_call("/tmp/second", &realtime_configuration);
+    expect_string(__wrap__mdebug2, formatted_msg, "Duplicate event in real-time buffer: /tmp/second");
+
+    paths = os_AddStrArray("/tmp/first", paths);
+    paths = os_AddStrArray("/tmp/second", paths);
+    will_return(__wrap_rbtree_keys, paths);
+    expect_string(__wrap_fim_realtime_event, file, "/tmp/first");
+    expect_string(__wrap_fim_realtime_event, file, "/tmp/second");
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_not_realtime(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_MODIFY, 10, "scheduled");
+    len += write_event(buffer + len, FAN_MODIFY, 10, "unmonitored");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    // Events outside the realtime directories are dropped before fim_realtime_event
+    expect_open_by_handle_at();
+    expect_fim_configuration_directory_call("/tmp/scheduled", &scheduled_configuration);
+    expect_fim_configuration_directory_call("/tmp/unmonitored", NULL);
+
+    os_calloc(1, sizeof(char *), paths);
+    will_return(__wrap_rbtree_keys, paths);
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_unknown_filesystem(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_MODIFY, 11, "file");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    os_calloc(1, sizeof(char *), paths);
+    will_return(__wrap_rbtree_keys, paths);
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_stale_directory(void **state) {
+    char buffer[OS_SIZE_1024] __attribute__((aligned(8)));
+    char **paths = NULL;
+    size_t len;
+
+    mark_filesystem(1, 10);
+    len = write_event(buffer, FAN_DELETE, 10, "file");
+
+    will_return(__wrap_read, buffer);
+    will_return(__wrap_read, len);
+
+    // The directory was removed before the event was read, its own deletion event reports the change
+    expect_any(__wrap_open_by_handle_at, mount_fd);
+    will_return(__wrap_open_by_handle_at, -1);
+
+    os_calloc(1, sizeof(char *), paths);
+    will_return(__wrap_rbtree_keys, paths);
+
+    fim_fanotify_process();
+}
+
+void test_fim_fanotify_process_overflow(void **state) {
+    struct fanotify_event_metadata event = { .event_len = sizeof(event),
+                                             .vers = FANOTIFY_METADATA_VERSION,
+                                             .metadata_len = sizeof(event),
+                                             .mask = FAN_Q_OVERFLOW,
+                                             .fd = FAN_NOFD };
+    char **paths = NULL;
+
+    will_return(__wrap_read, &event);
+    will_return(__wrap_read, sizeof(event));
+
+    expect_string(__wrap__mwarn, formatted_msg,
+                  "Real-time fanotify kernel queue is full. Some events may be lost. Next scheduled scan will recover lost data.");
+    expect_string(__wrap_send_log_msg, msg,
+                  "ossec: Real-time fanotify kernel queue is full. Some events may be lost. Next scheduled scan will recover lost data.");
+    will_return(__wrap_send_log_msg, 1);
+
+    os_calloc(1, sizeof(char *), paths);
+    will_return(__wrap_rbtree_keys, paths);
+
+    fim_fanotify_process();
+
+    assert_int_equal(syscheck.realtime->queue_overflow, true);
+}
+
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        /* fim_fanotify_start */
+        cmocka_unit_test_teardown(test_fim_fanotify_start_success, teardown_fanotify),
+        cmocka_unit_test_teardown(test_fim_fanotify_start_failure, teardown_fanotify),
+
+        /* fim_fanotify_watch */
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_watch_not_started, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_watch_lstat_failure, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_watch_mark, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_watch_same_filesystem, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_watch_mark_failure, setup_fanotify, teardown_fanotify),
+
+        /* fim_fanotify_process */
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_read_failure, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_event, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_directory_itself, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_same_directory, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_not_realtime, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_unknown_filesystem, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_stale_directory, setup_fanotify, teardown_fanotify),
+        cmocka_unit_test_setup_teardown(test_fim_fanotify_process_overflow, setup_fanotify, teardown_fanotify),
+    };
+
+    return cmocka_run_group_tests(tests, setup_group, teardown_group);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+#include "../../syscheckd/include/syscheck.h"
+#include "../../config/syscheck-config.h"
+
+
+/* setup/teardown */
+
+static int setup_deque(void **state) {
+    fim_walk_deque_t *deque = calloc(1, sizeof(fim_walk_deque_t));
+
+    if (deque == NULL) {
+        return -1;
+    }
+
+    fim_walk_deque_init(deque);
+    *state = deque;
+
+    return 0;
+}
+
+static int teardown_deque(void **state) {
+    fim_walk_deque_t *deque = *state;
+
+    fim_walk_deque_destroy(deque);
+    free(deque);
+
+    return 0;
+}
+
+static void push_path(fim_walk_deque_t *deque, const char *path) {
+    fim_walk_item_t item = { .configuration = NULL, .monitored = false };
+
+    item.path = strdup(path);
+    fim_walk_deque_push(deque, &item);
+}
+
+
+/* tests */
+
+void test_fim_walk_deque_empty(void **state) {
+    fim_walk_deque_t *deque = *state;
+    fim_walk_item_t item;
+
+    assert_false(fim_walk_deque_pop(deque, &item));
+    assert_false(fim_walk_deque_steal(deque, &item));
+}
+
+void test_fim_walk_deque_pop_latest_steal_oldest(void **state) {
+    fim_walk_deque_t *deque = *state;
+    fim_walk_item_t item;
+
+    push_path(deque, "/a");
+    push_path(deque, "/b");
+    push_path(deque, "/c");
+
+    assert_true(fim_walk_deque_pop(deque, &item));
+    assert_string_equal(item.path, "/c");
+    free(item.path);
+
+    assert_true(fim_walk_deque_steal(deque, &item));
+    assert_string_equal(item.path, "/a");
+    free(item.path);
+
+    assert_true(fim_walk_deque_pop(deque, &item));
+    assert_string_equal(item.path, "/b");
+    free(item.path);
+
+    assert_false(fim_walk_deque_pop(deque, &item));
+}
+
+void test_fim_walk_deque_grows_keeping_order(void **state) {
+    fim_walk_deque_t *deque = *state;
+    fim_walk_item_t item;
+    char path[16];
+    int i;
+
+    // Steal some paths first so the queued ones wrap around the end of the buffer before it grows
+    for (i = 0; i < 40; i++) {
+        snprintf(path, sizeof(path), "/%d", i);
+        push_path(deque, path);
+    }
+
+    for (i = 0; i < 40; i++) {
+        assert_true(fim_walk_deque_steal(deque, &item));
+        free(item.path);
+    }
+
+    for (i = 0; i < 200; i++) {
+        snprintf(path, sizeof(path), "/%d", i);
+        push_path(deque, path);
+    }
+
+    for (i = 0; i < 100; i++) {
+        snprintf(path, sizeof(path), "/%d", i);
+        assert_true(fim_walk_deque_steal(deque, &item));
+        assert_string_equal(item.path, path);
+        free(item.path);
+    }
+
+    for (i = 199; i >= 100; i--) {
+        snprintf(path, sizeof(path), "/%d", i);
+        assert_true(fim_walk_deque_pop(deque, &item));
+        assert_string_equal(item.path, path);
+        free(item.path);
+    }
+
+    assert_false(fim_walk_deque_steal(deque, &item));
+}
+
+void test_fim_walk_deque_destroy_frees_queued_paths(void **state) {
+    fim_walk_deque_t *deque = *state;
+
+    // The teardown frees the paths left in the deque
+    push_path(deque, "/a");
+    push_path(deque, "/b");
+}
+
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_fim_walk_deque_empty, setup_deque, teardown_deque),
+        cmocka_unit_test_setup_teardown(test_fim_walk_deque_pop_latest_steal_oldest, setup_deque, teardown_deque),
+        cmocka_unit_test_setup_teardown(test_fim_walk_deque_grows_keeping_order, setup_deque, teardown_deque),
+        cmocka_unit_test_setup_teardown(test_fim_walk_deque_destroy_frees_queued_paths, setup_deque, teardown_deque),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -25,10 +25,17 @@ int __wrap_fim_db_get_count_registry_key(){
     return mock();
 }
 
+static fim_entry *_fim_db_get_path_entry = NULL;
+
 FIMDBErrorCode __wrap_fim_db_get_path(const char* file_path,
-                                     __attribute__((unused))callback_context_t callback) {
+                                     callback_context_t callback) {
     check_expected(file_path);
 
+    if (_fim_db_get_path_entry != NULL) {
+        callback.callback(_fim_db_get_path_entry, callback.context);
+        _fim_db_get_path_entry = NULL;
+    }
+
     return mock();
 }
 
@@ -37,6 +44,11 @@ void expect_fim_db_get_path(const char* path, int ret_val) {
     will_return(__wrap_fim_db_get_path, ret_val);
 }
 
+void expect_fim_db_get_path_entry(const char* path, fim_entry *entry) {
+    _fim_db_get_path_entry = entry;
+    expect_fim_db_get_path(path, FIMDB_OK);
+}
+
 FIMDBErrorCode __wrap_fim_db_init(int storage,
                                   int sync_interval,
                                   uint32_t sync_max_interval,
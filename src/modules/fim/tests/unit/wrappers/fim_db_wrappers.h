@@ -38,6 +38,7 @@ int __wrap_fim_db_get_count_range(fdb_t *fim_sql,
 
 FIMDBErrorCode __wrap_fim_db_get_path(const char *file_path, callback_context_t callback);
 void expect_fim_db_get_path(const char* path, int ret_val);
+void expect_fim_db_get_path_entry(const char* path, fim_entry *entry);
 
 FIMDBErrorCode __wrap_fim_db_init(int storage,
                                   int sync_interval,
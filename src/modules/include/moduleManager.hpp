@@ -5,11 +5,15 @@
 #include <moduleWrapper.hpp>
 #include <task_manager.hpp>
 
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 class ModuleManager
 {
@@ -87,7 +91,21 @@ public:
     /// @brief Stop the modules
     void Stop();
 
+    /// @brief Reload the modules affected by a configuration change
+    ///
+    /// Only the modules whose section, or the agent section shared by all of them, is in \p changedSections are
+    /// stopped, set up again with the current configuration and started. The rest keep running. A module is only
+    /// set up again once the Start of its previous run has returned.
+    ///
+    /// @param[in] changedSections Top-level configuration sections changed by the reload
+    void Reload(const std::set<std::string>& changedSections);
+
 private:
+    /// @brief Enqueues the Start of the modules and waits until it has been called for all of them
+    ///
+    /// @param[in] modules The modules to start
+    void StartModules(const std::vector<std::shared_ptr<ModuleWrapper>>& modules);
+
     /// @brief The task manager
     TaskManager m_taskManager;
 
@@ -106,6 +124,12 @@ private:
     /// @brief The mutex for the modules
     std::mutex m_mutex;
 
+    /// @brief Serializes Start, Stop and Reload, which wait for the modules without holding m_mutex
+    std::mutex m_lifecycleMutex;
+
+    /// @brief Futures ready once the Start of each started module has returned, by module name
+    std::map<std::string, std::shared_future<void>> m_running;
+
     /// @brief The number of modules that have started
     std::atomic<int> m_started {0};
 };
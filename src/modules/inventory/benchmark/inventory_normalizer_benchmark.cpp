@@ -0,0 +1,187 @@
+#include <inventoryNormalizer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_PACKAGES = 10000;
+    constexpr size_t ROUNDS = 5;
+    constexpr auto TARGET = "macos";
+    constexpr auto TYPE = "packages";
+
+    /// @brief Normalizer as it was before compiling the config: a regex built for each item and rule
+    class RegexPerItemNormalizer
+    {
+    public:
+        explicit RegexPerItemNormalizer(const std::string& configFile)
+        {
+            std::ifstream config {configFile};
+            const auto json = nlohmann::json::parse(config);
+
+            for (const auto& item : json.at("exclusions"))
+            {
+                if (item.at("target") == TARGET && item.at("data_type") == TYPE)
+                {
+                    m_exclusions.push_back(item);
+                }
+            }
+
+            for (const auto& item : json.at("dictionary"))
+            {
+                if (item.at("target") == TARGET && item.at("data_type") == TYPE)
+                {
+                    m_dictionary.push_back(item);
+                }
+            }
+        }
+
+        void Normalize(nlohmann::json& data) const
+        {
+            for (auto& item : data)
+            {
+                for (const auto& dictItem : m_dictionary)
+                {
+                    if (dictItem.contains("find_pattern"))
+                    {
+                        const std::regex pattern {dictItem["find_pattern"].get_ref<const std::string&>()};
+                        const auto fieldIt = item.find(dictItem["find_field"].get_ref<const std::string&>());
+
+                        if (fieldIt == item.end() || !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+                        {
+                            continue;
+                        }
+                    }
+
+                    if (dictItem.contains("replace_pattern"))
+                    {
+                        const std::regex pattern {dictItem["replace_pattern"].get_ref<const std::string&>()};
+                        const auto fieldIt = item.find(dictItem["replace_field"].get_ref<const std::string&>());
+
+                        if (fieldIt != item.end())
+                        {
+                            *fieldIt = std::regex_replace(fieldIt->get_ref<const std::string&>(),
+                                                          pattern,
+                                                          dictItem["replace_value"].get_ref<const std::string&>());
+                        }
+                    }
+
+                    if (dictItem.contains("add_field"))
+                    {
+                        item[dictItem["add_field"].get_ref<const std::string&>()] = dictItem["add_value"];
+                    }
+                }
+            }
+        }
+
+        void RemoveExcluded(nlohmann::json& data) const
+        {
+            for (const auto& exclusionItem : m_exclusions)
+            {
+                const std::regex pattern {exclusionItem["pattern"].get_ref<const std::string&>()};
+                const auto& fieldName = exclusionItem["field_name"].get_ref<const std::string&>();
+
+                for (auto item = data.begin(); item != data.end();)
+                {
+                    const auto fieldIt = item->find(fieldName);
+
+                    if (fieldIt != item->end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+                    {
+                        item = data.erase(item);
+                    }
+                    else
+                    {
+                        ++item;
+                    }
+                }
+            }
+        }
+
+    private:
+        std::vector<nlohmann::json> m_exclusions;
+        std::vector<nlohmann::json> m_dictionary;
+    };
+
+    /// @brief Builds a macOS-like package inventory, a few packages matching the rules among many that do not
+    nlohmann::json MakeInventory(size_t packages)
+    {
+        const std::vector<std::string> names {"Microsoft Word",
+                                              "McAfee Endpoint Protection For Mac",
+                                              "AVGAntivirus",
+                                              "Kaspersky Internet Security For Mac",
+                                              "Siri",
+                                              "zoom.us",
+                                              "TotalDefenseAntivirusforMac",
+                                              "Quick Heal Total Security"};
+        auto inventory = nlohmann::json::array();
+
+        for (size_t i = 0; i < packages; ++i)
+        {
+            const auto name = i % 10 == 0 ? names[(i / 10) % names.size()] : "Application " + std::to_string(i);
+
+            inventory.push_back({{"name", name},
+                                 {"version", "1." + std::to_string(i % 100)},
+                                 {"description", "com.vendor.app" + std::to_string(i)},
+                                 {"group", "public.app-category.productivity"}});
+        }
+
+        return inventory;
+    }
+
+    template<typename Normalizer>
+    double Run(const Normalizer& normalizer, const nlohmann::json& inventory, nlohmann::json& result)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t round = 0; round < ROUNDS; ++round)
+        {
+            result = inventory;
+            normalizer.Normalize(result);
+            normalizer.RemoveExcluded(result);
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+    }
+
+    /// @brief Adapts the normalizer to the interface of the one it is compared to
+    struct CompiledNormalizer
+    {
+        void Normalize(nlohmann::json& data) const
+        {
+            m_normalizer.Normalize(TYPE, data);
+        }
+
+        void RemoveExcluded(nlohmann::json& data) const
+        {
+            m_normalizer.RemoveExcluded(TYPE, data);
+        }
+
+        InvNormalizer m_normalizer;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t packages = argc > 1 ? std::stoul(argv[1]) : DEFAULT_PACKAGES;
+    const std::string configFile = argc > 2 ? argv[2] : NORM_CONFIG_FILE;
+    const auto inventory = MakeInventory(packages);
+
+    nlohmann::json legacyResult;
+    nlohmann::json compiledResult;
+
+    const auto legacyMs = Run(RegexPerItemNormalizer(configFile), inventory, legacyResult);
+    const auto compiledMs = Run(CompiledNormalizer {InvNormalizer(configFile, TARGET)}, inventory, compiledResult);
+
+    std::printf("%-16s %8zu packages %10.2f ms\n", "regex per item", packages, legacyMs);
+    std::printf("%-16s %8zu packages %10.2f ms %8.1fx speedup %s\n",
+                "compiled",
+                packages,
+                compiledMs,
+                legacyMs / compiledMs,
+                legacyResult == compiledResult ? "same result" : "DIFFERENT RESULT");
+    return 0;
+}
@@ -3,8 +3,11 @@
 #include <chrono>
 #include <condition_variable>
 #include <ctime>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <stack>
 #include <string>
 #include <thread>
@@ -67,6 +70,19 @@ private:
     Inventory(const Inventory&) = delete;
     Inventory& operator=(const Inventory&) = delete;
 
+    /// @brief Collector of a table, scanned on its own interval by the scheduler of \ref SyncLoop
+    struct Collector
+    {
+        Collector(std::function<void()> scan, const bool& enabled);
+
+        std::function<void()> Scan;
+        const bool& Enabled;                            // Collector switch
+        std::time_t Interval;                           // Scan interval, in milliseconds
+        std::chrono::steady_clock::time_point NextScan; // Time the next scan is due
+        bool Running;                                   // Scan queued or in progress
+        std::string ScanTime;                           // Timestamp of the events of the current scan
+    };
+
     void Destroy();
 
     std::string GetCreateStatement() const;
@@ -101,10 +117,12 @@ private:
     void ScanSystem();
     void ScanNetwork();
     void ScanPackages();
+    void ScanAllPackages();
+    void ScanPackageSources(const std::set<std::string>& formats);
     void ScanHotfixes();
     void ScanPorts();
     void ScanProcesses();
-    void Scan();
+    void RunCollector(const std::string& table);
     void SyncLoop();
     void ShowConfig();
     cJSON* Dump() const;
@@ -155,8 +173,11 @@ private:
     std::unique_ptr<DBSync> m_spDBSync;
     std::condition_variable m_cv;
     std::mutex m_mutex;
+    std::mutex m_syncMutex; // Serializes the DBSync work of the collectors, which share one connection
     std::unique_ptr<InvNormalizer> m_spNormalizer;
-    std::string m_scanTime;
+    std::map<std::string, Collector> m_collectors;                    // Collectors by table, fixed on construction
+    size_t m_runningScans;                                            // Scans of the current evaluation running
+    std::map<std::string, std::chrono::milliseconds> m_scanDurations; // Scans of the current evaluation finished
     std::function<int(Message)> m_pushMessage;
     bool m_hardwareFirstScan;  // Hardware first scan flag
     bool m_systemFirstScan;    // System first scan flag
@@ -165,4 +186,6 @@ private:
     bool m_portsFirstScan;     // Opened ports first scan flag
     bool m_processesFirstScan; // Running processes first scan flag
     bool m_hotfixesFirstScan;  // Windows hotfixes installed first scan flag
+
+    nlohmann::json m_packageSources; // Package sources signatures on the last packages scan
 };
@@ -1,7 +1,10 @@
 #pragma once
 #include <map>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <regex>
 #include <string>
+#include <vector>
 
 class InvNormalizer
 {
@@ -11,9 +14,89 @@ public:
     void Normalize(const std::string& type, nlohmann::json& data) const;
     void RemoveExcluded(const std::string& type, nlohmann::json& data) const;
 
+    /// @brief Pattern of the config, matched against a whole value
+    ///
+    /// Patterns that are a literal, optionally grouped and preceded or followed by ".*", are matched as plain
+    /// strings, the other ones (and values with line breaks, which "." does not match) with the regex compiled
+    /// once.
+    class Matcher
+    {
+    public:
+        /// @brief Compiles a pattern
+        /// @param pattern Regex pattern
+        /// @throws std::regex_error If the pattern is not a valid regex
+        explicit Matcher(const std::string& pattern);
+
+        /// @brief Checks whether the whole value matches the pattern
+        bool Match(const std::string& value) const;
+
+    private:
+        enum class Kind
+        {
+            Equals,
+            Prefix,
+            Suffix,
+            Contains,
+            Regex
+        };
+
+        Kind m_kind {Kind::Regex};
+        std::string m_literal;
+        std::regex m_regex;
+    };
+
+    /// @brief Pattern of the config, replaced everywhere it appears in a value
+    ///
+    /// Literal patterns, optionally grouped, are replaced as plain strings unless the replacement refers to the
+    /// match, the other ones with a regex compiled once.
+    class Replacer
+    {
+    public:
+        /// @brief Compiles a pattern
+        /// @param pattern Regex pattern
+        /// @param replacement Replacement, in ECMAScript format
+        /// @throws std::regex_error If the pattern is not a valid regex
+        Replacer(const std::string& pattern, std::string replacement);
+
+        /// @brief Replaces every match of the pattern in a value
+        std::string Replace(const std::string& value) const;
+
+    private:
+        std::optional<std::string> m_literal;
+        std::regex m_regex;
+        std::string m_replacement;
+    };
+
 private:
+    /// @brief Exclusion rule: items whose field matches are removed
+    struct Exclusion
+    {
+        std::string FieldName;
+        Matcher Pattern;
+    };
+
+    /// @brief Dictionary rule: items whose field matches, or all of them when there is no find pattern, get a field
+    /// replaced and/or a field added
+    struct DictionaryRule
+    {
+        std::optional<std::pair<std::string, Matcher>> Find;
+        std::optional<std::pair<std::string, Replacer>> Replace;
+        std::optional<std::pair<std::string, std::string>> Add;
+    };
+
     static std::map<std::string, nlohmann::json>
     GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type);
-    const std::map<std::string, nlohmann::json> m_typeExclusions;
-    const std::map<std::string, nlohmann::json> m_typeDictionary;
+
+    /// @brief Compiles the exclusions of the config, skipping the invalid ones
+    static std::map<std::string, std::vector<Exclusion>>
+    CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions);
+
+    /// @brief Compiles the dictionary of the config, skipping the invalid or incomplete rules
+    static std::map<std::string, std::vector<DictionaryRule>>
+    CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary);
+
+    static void NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item);
+
+    const std::map<std::string, std::vector<Exclusion>> m_typeExclusions;
+    const std::map<std::string, std::vector<DictionaryRule>> m_typeDictionary;
 };
@@ -73,6 +73,18 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
     m_processes =
         configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_PROCESSES, "inventory", "processes");
     m_hotfixes = configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_HOTFIXES, "inventory", "hotfixes");
+
+    // Collectors without an interval of their own are scanned on the module one
+    const auto intervals =
+        configurationParser->GetConfigOrDefault(std::map<std::string, std::string> {}, "inventory", "intervals");
+
+    for (auto& [table, collector] : m_collectors)
+    {
+        collector.Interval = intervals.contains(table)
+                                 ? configurationParser->GetTimeConfigOrDefault(
+                                       std::to_string(m_intervalValue) + "ms", "inventory", "intervals", table)
+                                 : m_intervalValue;
+    }
 }
 
 void Inventory::Stop()
@@ -186,6 +198,12 @@ cJSON* Inventory::Dump() const
         cJSON_AddStringToObject(invJson, "scan-on-start", "no");
     }
     cJSON_AddNumberToObject(invJson, "interval", static_cast<double>(m_intervalValue));
+    cJSON* intervalsJson = cJSON_CreateObject();
+    for (const auto& [table, collector] : m_collectors)
+    {
+        cJSON_AddNumberToObject(intervalsJson, table.c_str(), static_cast<double>(collector.Interval));
+    }
+    cJSON_AddItemToObject(invJson, "intervals", intervalsJson);
     if (m_networks)
     {
         cJSON_AddStringToObject(invJson, "networks", "yes");
@@ -9,6 +9,9 @@
 #include <stringHelper.hpp>
 #include <timeHelper.hpp>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
 constexpr auto EMPTY_VALUE {""};
 
 constexpr std::time_t INVENTORY_DEFAULT_INTERVAL {3600000};
@@ -16,6 +19,9 @@ constexpr size_t MAX_ID_SIZE = 512;
 
 constexpr auto QUEUE_SIZE {4096};
 
+// Collectors scanned at once, their DBSync work is still serialized as they share one connection
+constexpr size_t SCAN_WORKERS {4};
+
 static const std::map<ReturnTypeCallback, std::string> OPERATION_MAP {
     {MODIFIED, "update"},
     {DELETED, "delete"},
@@ -348,7 +354,7 @@ void Inventory::NotifyEvent(ReturnTypeCallback result,
         msg["stateless"] = stateless;
     }
 
-    msg["data"]["@timestamp"] = m_scanTime;
+    msg["data"]["@timestamp"] = m_collectors.at(table).ScanTime;
 
     const auto msgToSend = msg.dump();
     m_reportDiffFunction(msgToSend);
@@ -361,7 +367,7 @@ void Inventory::UpdateChanges(const std::string& table, const nlohmann::json& va
                              NotifyChange(result, data, table, isFirstScan);
                          }};
 
-    const std::unique_lock<std::mutex> lock {m_mutex};
+    const std::unique_lock<std::mutex> lock {m_syncMutex};
     DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {table}, 0, QUEUE_SIZE, callback};
     nlohmann::json input;
     input["table"] = table;
@@ -409,6 +415,7 @@ Inventory::Inventory()
     , m_hotfixes {true}
     , m_stopping {true}
     , m_notify {true}
+    , m_runningScans {0}
     , m_hardwareFirstScan {true}
     , m_systemFirstScan {true}
     , m_networksFirstScan {true}
@@ -416,6 +423,21 @@ Inventory::Inventory()
     , m_portsFirstScan {true}
     , m_processesFirstScan {true}
     , m_hotfixesFirstScan {true}
+{
+    m_collectors.try_emplace(HARDWARE_TABLE, [this]() { ScanHardware(); }, m_hardware);
+    m_collectors.try_emplace(SYSTEM_TABLE, [this]() { ScanSystem(); }, m_system);
+    m_collectors.try_emplace(PACKAGES_TABLE, [this]() { ScanPackages(); }, m_packages);
+    m_collectors.try_emplace(PROCESSES_TABLE, [this]() { ScanProcesses(); }, m_processes);
+    m_collectors.try_emplace(HOTFIXES_TABLE, [this]() { ScanHotfixes(); }, m_hotfixes);
+    m_collectors.try_emplace(PORTS_TABLE, [this]() { ScanPorts(); }, m_ports);
+    m_collectors.try_emplace(NETWORKS_TABLE, [this]() { ScanNetwork(); }, m_networks);
+}
+
+Inventory::Collector::Collector(std::function<void()> scan, const bool& enabled)
+    : Scan {std::move(scan)}
+    , Enabled {enabled}
+    , Interval {INVENTORY_DEFAULT_INTERVAL}
+    , Running {false}
 {
 }
 
@@ -455,6 +477,7 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
     m_systemFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(SYSTEM_TABLE)).empty() ? false : true;
     m_networksFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(NETWORKS_TABLE)).empty() ? false : true;
     m_packagesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PACKAGES_TABLE)).empty() ? false : true;
+    m_packageSources.clear();
     m_portsFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PORTS_TABLE)).empty() ? false : true;
     m_processesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PROCESSES_TABLE)).empty() ? false : true;
     m_hotfixesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(HOTFIXES_TABLE)).empty() ? false : true;
@@ -506,7 +529,10 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
 
 void Inventory::Destroy()
 {
-    m_stopping = true;
+    {
+        const std::unique_lock<std::mutex> lock {m_mutex};
+        m_stopping = true;
+    }
     m_cv.notify_all();
 }
 
@@ -780,49 +806,176 @@ void Inventory::ScanPackages()
     if (m_packages)
     {
         LogTrace("Starting packages scan");
-        const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
-                             {
-                                 NotifyChange(result, data, PACKAGES_TABLE, !m_packagesFirstScan);
-                             }};
+        auto sources = m_spInfo->packageSources();
 
-        const std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PACKAGES_TABLE}, 0, QUEUE_SIZE, callback};
-        m_spInfo->packages(
-            [this, &txn](nlohmann::json& rawData)
+        // The sources can only be skipped once the table holds a full scan made by this run, the signatures say
+        // nothing about the rows written by a previous one (with, maybe, another normalizer config)
+        if (!m_packagesFirstScan || !sources.is_object() || sources.empty() || m_packageSources.empty())
+        {
+            ScanAllPackages();
+            LogDebug("Packages scan: 0 sources skipped, {} reparsed", sources.size());
+        }
+        else
+        {
+            std::set<std::string> changedFormats;
+            size_t skippedSources {0};
+
+            for (const auto& [format, signature] : sources.items())
             {
-                if (m_stopping)
+                if (m_packageSources.contains(format) && m_packageSources[format] == signature)
                 {
-                    return;
+                    ++skippedSources;
                 }
+                else
+                {
+                    changedFormats.insert(format);
+                }
+            }
 
-                nlohmann::json input;
-
-                input["table"] = PACKAGES_TABLE;
-                m_spNormalizer->Normalize("packages", rawData);
-                m_spNormalizer->RemoveExcluded("packages", rawData);
-
-                if (!rawData.empty())
+            for (const auto& [format, signature] : m_packageSources.items())
+            {
+                if (!sources.contains(format))
                 {
-                    input["data"] = nlohmann::json::array({rawData});
-                    if (m_packagesFirstScan)
-                    {
-                        input["options"]["return_old_data"] = true;
-                    }
-                    txn.syncTxnRow(input);
+                    changedFormats.insert(format);
                 }
-            });
-        txn.getDeletedRows(callback);
+            }
 
-        if (!m_packagesFirstScan && !m_stopping)
+            if (!changedFormats.empty())
+            {
+                ScanPackageSources(changedFormats);
+            }
+
+            LogDebug("Packages scan: {} sources skipped, {} reparsed", skippedSources, changedFormats.size());
+        }
+
+        if (!m_stopping)
         {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(PACKAGES_TABLE), Utils::getCurrentISO8601());
-            m_packagesFirstScan = true;
+            m_packageSources = std::move(sources);
         }
 
         LogTrace("Ending packages scan");
     }
 }
 
+void Inventory::ScanAllPackages()
+{
+    nlohmann::json packages = nlohmann::json::array();
+
+    m_spInfo->packages(
+        [this, &packages](nlohmann::json& rawData)
+        {
+            if (m_stopping)
+            {
+                return;
+            }
+
+            m_spNormalizer->Normalize("packages", rawData);
+            m_spNormalizer->RemoveExcluded("packages", rawData);
+
+            if (!rawData.empty())
+            {
+                packages.push_back(std::move(rawData));
+            }
+        });
+
+    if (m_stopping)
+    {
+        return;
+    }
+
+    UpdateChanges(PACKAGES_TABLE, packages, !m_packagesFirstScan);
+
+    if (!m_packagesFirstScan && !m_stopping)
+    {
+        WriteMetadata(TABLE_TO_KEY_MAP.at(PACKAGES_TABLE), Utils::getCurrentISO8601());
+        m_packagesFirstScan = true;
+    }
+}
+
+void Inventory::ScanPackageSources(const std::set<std::string>& formats)
+{
+    const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
+                         {
+                             NotifyChange(result, data, PACKAGES_TABLE, false);
+                         }};
+    const auto packageKey {[](const nlohmann::json& package)
+                           {
+                               return package.value("name", "") + ":" + package.value("version", "") + ":" +
+                                      package.value("architecture", "") + ":" + package.value("format", "") + ":" +
+                                      package.value("location", "");
+                           }};
+
+    // Rows of the formats reparsed, the ones left once the packages found are taken out were removed
+    std::string filter;
+
+    for (const auto& format : formats)
+    {
+        filter += (filter.empty() ? "WHERE format IN ('" : "','") + format;
+    }
+    filter += "')";
+
+    std::map<std::string, nlohmann::json> storedPackages;
+    auto selectQuery = SelectQuery::builder().table(PACKAGES_TABLE).columnList({"*"}).rowFilter(filter).build();
+
+    {
+        const std::unique_lock<std::mutex> lock {m_syncMutex};
+        m_spDBSync->selectRows(selectQuery.query(),
+                               [&storedPackages, &packageKey](ReturnTypeCallback, const nlohmann::json& row)
+                               { storedPackages.insert_or_assign(packageKey(row), row); });
+    }
+
+    auto syncQuery = SyncRowQuery::builder().table(PACKAGES_TABLE).returnOldData();
+    bool packagesFound {false};
+
+    m_spInfo->sourcePackages(formats,
+                             [this, &syncQuery, &packagesFound, &storedPackages, &packageKey](nlohmann::json& rawData)
+                             {
+                                 if (m_stopping)
+                                 {
+                                     return;
+                                 }
+
+                                 m_spNormalizer->Normalize("packages", rawData);
+                                 m_spNormalizer->RemoveExcluded("packages", rawData);
+
+                                 if (!rawData.empty())
+                                 {
+                                     storedPackages.erase(packageKey(rawData));
+                                     syncQuery.data(rawData);
+                                     packagesFound = true;
+                                 }
+                             });
+
+    if (m_stopping)
+    {
+        return;
+    }
+
+    const std::unique_lock<std::mutex> lock {m_syncMutex};
+
+    if (packagesFound)
+    {
+        m_spDBSync->syncRow(syncQuery.query(), callback);
+    }
+
+    if (!storedPackages.empty())
+    {
+        auto deleteQuery = DeleteQuery::builder().table(PACKAGES_TABLE).rowFilter("");
+
+        for (const auto& [key, package] : storedPackages)
+        {
+            deleteQuery.data(package);
+        }
+
+        m_spDBSync->deleteRows(deleteQuery.query());
+
+        for (const auto& [key, package] : storedPackages)
+        {
+            callback(DELETED, package);
+        }
+    }
+}
+
 void Inventory::ScanHotfixes()
 {
     if (m_hotfixes)
@@ -927,32 +1080,23 @@ void Inventory::ScanProcesses()
     if (m_processes)
     {
         LogTrace("Starting processes scan");
-        const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
-                             {
-                                 NotifyChange(result, data, PROCESSES_TABLE, !m_processesFirstScan);
-                             }};
-        const std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PROCESSES_TABLE}, 0, QUEUE_SIZE, callback};
+        nlohmann::json processes = nlohmann::json::array();
+
         m_spInfo->processes(std::function<void(nlohmann::json&)>(
-            [this, &txn](nlohmann::json& rawData)
+            [this, &processes](nlohmann::json& rawData)
             {
-                if (m_stopping)
+                if (!m_stopping)
                 {
-                    return;
+                    processes.push_back(std::move(rawData));
                 }
+            }));
 
-                nlohmann::json input;
-                input["table"] = PROCESSES_TABLE;
-                input["data"] = nlohmann::json::array({rawData});
+        if (m_stopping)
+        {
+            return;
+        }
 
-                if (m_processesFirstScan)
-                {
-                    input["options"]["return_old_data"] = true;
-                }
-
-                txn.syncTxnRow(input);
-            }));
-        txn.getDeletedRows(callback);
+        UpdateChanges(PROCESSES_TABLE, processes, !m_processesFirstScan);
 
         if (!m_processesFirstScan && !m_stopping)
         {
@@ -964,47 +1108,113 @@ void Inventory::ScanProcesses()
     }
 }
 
-void Inventory::Scan()
+void Inventory::RunCollector(const std::string& table)
 {
-    LogInfo("Starting evaluation.");
-    m_scanTime = Utils::getCurrentISO8601();
-
-    TryCatchTask([&]() { ScanHardware(); });
-    TryCatchTask([&]() { ScanSystem(); });
-    TryCatchTask([&]() { ScanPackages(); });
-    TryCatchTask([&]() { ScanProcesses(); });
-    TryCatchTask([&]() { ScanHotfixes(); });
-    TryCatchTask([&]() { ScanPorts(); });
-    TryCatchTask([&]() { ScanNetwork(); });
-
-    m_notify = true;
-    LogInfo("Evaluation finished.");
+    auto& collector {m_collectors.at(table)};
+    const auto start {std::chrono::steady_clock::now()};
+
+    collector.ScanTime = Utils::getCurrentISO8601();
+    TryCatchTask(collector.Scan);
+
+    const auto end {std::chrono::steady_clock::now()};
+    const std::unique_lock<std::mutex> lock {m_mutex};
+
+    // Keeps the collectors sharing an interval in step, unless the scan took longer than the interval
+    collector.Running = false;
+    collector.NextScan += std::chrono::milliseconds {collector.Interval};
+
+    if (collector.NextScan < end)
+    {
+        collector.NextScan = end + std::chrono::milliseconds {collector.Interval};
+    }
+    m_scanDurations[table] = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    if (--m_runningScans == 0)
+    {
+        std::string durations;
+
+        for (const auto& [name, duration] : m_scanDurations)
+        {
+            durations += (durations.empty() ? "" : ", ") + name + " " + std::to_string(duration.count()) + " ms";
+        }
+
+        m_scanDurations.clear();
+        LogInfo("Evaluation finished. Scan durations: {}.", durations);
+    }
+
+    m_cv.notify_all();
 }
 
 void Inventory::SyncLoop()
 {
     LogInfo("Module started.");
 
-    if (m_scanOnStart && !m_stopping)
+    boost::asio::thread_pool workers {SCAN_WORKERS};
+    std::unique_lock<std::mutex> lock {m_mutex};
+
+    const auto start {std::chrono::steady_clock::now()};
+
+    for (auto& [table, collector] : m_collectors)
     {
-        Scan();
+        collector.Running = false;
+        collector.NextScan = m_scanOnStart ? start : start + std::chrono::milliseconds {collector.Interval};
     }
 
+    m_runningScans = 0;
+    m_scanDurations.clear();
+
+    // Each collector is scanned on its own interval, concurrently with the other ones, and never queued again while
+    // a scan of it is still pending
     while (!m_stopping)
     {
+        const auto now {std::chrono::steady_clock::now()};
+        auto wakeUp {std::chrono::steady_clock::time_point::max()};
+
+        for (auto& [table, collector] : m_collectors)
         {
-            std::unique_lock<std::mutex> lock {m_mutex};
-            m_cv.wait_for(lock, std::chrono::milliseconds {m_intervalValue}, [&]() { return m_stopping.load(); });
+            if (!collector.Enabled || collector.Running)
+            {
+                continue;
+            }
+
+            if (collector.NextScan <= now)
+            {
+                if (m_runningScans++ == 0)
+                {
+                    LogInfo("Starting evaluation.");
+                }
+
+                collector.Running = true;
+                boost::asio::post(workers, [this, &table]() { RunCollector(table); });
+            }
+            else
+            {
+                wakeUp = std::min(wakeUp, collector.NextScan);
+            }
+        }
+
+        if (wakeUp == std::chrono::steady_clock::time_point::max())
+        {
+            m_cv.wait(lock);
+        }
+        else
+        {
+            m_cv.wait_until(lock, wakeUp);
         }
-        Scan();
     }
-    const std::unique_lock<std::mutex> lock {m_mutex};
+
+    lock.unlock();
+    workers.stop();
+    workers.join();
+
+    lock.lock();
     m_spDBSync.reset(nullptr);
 }
 
 void Inventory::WriteMetadata(const std::string& key, const std::string& value)
 {
     auto insertQuery {InsertQuery::builder().table(MD_TABLE).data({{"key", key}, {"value", value}}).build()};
+    const std::unique_lock<std::mutex> lock {m_syncMutex};
     m_spDBSync->insertData(insertQuery.query());
 }
 
@@ -1109,7 +1319,7 @@ nlohmann::json Inventory::AddPreviousFields(nlohmann::json& current, const nlohm
 nlohmann::json
 Inventory::GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data)
 {
-    auto event = CreateStatelessEvent(type, operation, m_scanTime, data);
+    auto event = CreateStatelessEvent(type, operation, m_collectors.at(type).ScanTime, data);
     return event ? event->generate() : nlohmann::json {};
 }
 
@@ -1,11 +1,140 @@
+#include <algorithm>
 #include <fstream>
 #include <inventoryNormalizer.hpp>
 #include <iostream>
+#include <iterator>
 #include <regex>
+#include <string_view>
+
+namespace
+{
+    constexpr auto REGEX_SPECIAL_CHARS {"\\^$.|?*+()[]{}"};
+    constexpr std::string_view ANY_CHARS {".*"};
+    constexpr auto ANY_CHARS_SIZE {ANY_CHARS.size()};
+    constexpr auto LINE_BREAKS {"\r\n"};
+
+    /// @brief Gets the string a pattern matches, if it is a literal, optionally grouped
+    std::optional<std::string> GetLiteral(std::string_view pattern)
+    {
+        if (pattern.size() > 2 && pattern.front() == '(' && pattern.back() == ')')
+        {
+            pattern = pattern.substr(1, pattern.size() - 2);
+        }
+
+        if (pattern.empty() || pattern.find_first_of(REGEX_SPECIAL_CHARS) != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        return std::string(pattern);
+    }
+
+    /// @brief Gets a string member of a config item, if it has it
+    const std::string* GetString(const nlohmann::json& item, const std::string& key)
+    {
+        const auto it {item.find(key)};
+        return it != item.end() && it->is_string() ? &it->get_ref<const std::string&>() : nullptr;
+    }
+} // namespace
+
+InvNormalizer::Matcher::Matcher(const std::string& pattern)
+    : m_regex {pattern}
+{
+    std::string_view inner {pattern};
+    const auto leading {inner.starts_with(ANY_CHARS)};
+
+    if (leading)
+    {
+        inner.remove_prefix(ANY_CHARS_SIZE);
+    }
+
+    const auto trailing {inner.ends_with(ANY_CHARS)};
+
+    if (trailing)
+    {
+        inner.remove_suffix(ANY_CHARS_SIZE);
+    }
+
+    const auto literal {GetLiteral(inner)};
+
+    if (!literal)
+    {
+        return;
+    }
+
+    m_literal = *literal;
+
+    if (leading && trailing)
+    {
+        m_kind = Kind::Contains;
+    }
+    else if (leading)
+    {
+        m_kind = Kind::Suffix;
+    }
+    else if (trailing)
+    {
+        m_kind = Kind::Prefix;
+    }
+    else
+    {
+        m_kind = Kind::Equals;
+    }
+}
+
+bool InvNormalizer::Matcher::Match(const std::string& value) const
+{
+    if (m_kind == Kind::Equals)
+    {
+        return value == m_literal;
+    }
+
+    if (m_kind == Kind::Regex || value.find_first_of(LINE_BREAKS) != std::string::npos)
+    {
+        return std::regex_match(value, m_regex);
+    }
+
+    switch (m_kind)
+    {
+        case Kind::Prefix: return value.starts_with(m_literal);
+        case Kind::Suffix: return value.ends_with(m_literal);
+        default: return value.find(m_literal) != std::string::npos;
+    }
+}
+
+InvNormalizer::Replacer::Replacer(const std::string& pattern, std::string replacement)
+    : m_regex {pattern}
+    , m_replacement {std::move(replacement)}
+{
+    // "$" in the replacement refers to the match
+    if (m_replacement.find('$') == std::string::npos)
+    {
+        m_literal = GetLiteral(pattern);
+    }
+}
+
+std::string InvNormalizer::Replacer::Replace(const std::string& value) const
+{
+    if (!m_literal)
+    {
+        return std::regex_replace(value, m_regex, m_replacement);
+    }
+
+    std::string result;
+    size_t start {0};
+
+    for (auto pos {value.find(*m_literal)}; pos != std::string::npos; pos = value.find(*m_literal, start))
+    {
+        result.append(value, start, pos - start).append(m_replacement);
+        start = pos + m_literal->size();
+    }
+
+    return result.append(value, start);
+}
 
 InvNormalizer::InvNormalizer(const std::string& configFile, const std::string& target)
-    : m_typeExclusions {GetTypeValues(configFile, target, "exclusions")}
-    , m_typeDictionary {GetTypeValues(configFile, target, "dictionary")}
+    : m_typeExclusions {CompileExclusions(GetTypeValues(configFile, target, "exclusions"))}
+    , m_typeDictionary {CompileDictionary(GetTypeValues(configFile, target, "dictionary"))}
 {
 }
 
@@ -13,95 +142,63 @@ void InvNormalizer::RemoveExcluded(const std::string& type, nlohmann::json& data
 {
     const auto exclusionsIt {m_typeExclusions.find(type)};
 
-    if (exclusionsIt != m_typeExclusions.cend())
+    if (exclusionsIt == m_typeExclusions.cend())
     {
-        for (const auto& exclusionItem : exclusionsIt->second)
-        {
-            try
-            {
-                const std::regex pattern {exclusionItem["pattern"].get_ref<const std::string&>()};
-                const auto& fieldName {exclusionItem["field_name"].get_ref<const std::string&>()};
-
-                if (data.is_array())
-                {
-                    for (auto item {data.begin()}; item != data.end(); ++item)
-                    {
-                        const auto fieldIt {item->find(fieldName)};
+        return;
+    }
 
-                        if (fieldIt != item->end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                        {
-                            data.erase(item);
-                        }
-                    }
-                }
-                else
-                {
-                    const auto fieldIt {data.find(fieldName)};
+    const auto excluded {[&exclusions = exclusionsIt->second](const nlohmann::json& item)
+                         {
+                             return std::any_of(exclusions.begin(),
+                                                exclusions.end(),
+                                                [&item](const Exclusion& exclusion)
+                                                {
+                                                    const auto value {GetString(item, exclusion.FieldName)};
+                                                    return value && exclusion.Pattern.Match(*value);
+                                                });
+                         }};
 
-                    if (fieldIt != data.end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                    {
-                        data.clear();
-                    }
-                }
-            }
-            catch (const std::exception& ex)
-            {
-                std::cout << "Exception caught in RemoveExcluded: " << ex.what() << '\n';
-            }
-            catch (...)
-            {
-                std::cout << "Unknown exception caught in RemoveExcluded." << '\n';
-            }
+    if (data.is_array())
+    {
+        for (auto item {data.begin()}; item != data.end();)
+        {
+            item = excluded(*item) ? data.erase(item) : std::next(item);
         }
     }
+    else if (data.is_object() && excluded(data))
+    {
+        data.clear();
+    }
 }
 
-static void NormalizeItem(const nlohmann::json& dictionary, nlohmann::json& item)
+void InvNormalizer::NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item)
 {
-    for (const auto& dictItem : dictionary)
+    for (const auto& rule : dictionary)
     {
-        const auto itFindPattern {dictItem.find("find_pattern")};
-        const auto itFindField {dictItem.find("find_field")};
-
-        if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+        if (rule.Find)
         {
-            const auto fieldIt {item.find(itFindField->get_ref<const std::string&>())};
-            const std::regex pattern {itFindPattern->get_ref<const std::string&>()};
+            const auto value {GetString(item, rule.Find->first)};
 
-            if (fieldIt == item.end() || !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+            if (!value || !rule.Find->second.Match(*value))
             {
                 // no field in the item or no matching, we continue
                 continue;
             }
         }
-        else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
-        {
-            // we won't evaluate an incomplete item.
-            continue;
-        }
 
-        const auto itReplacePattern {dictItem.find("replace_pattern")};
-        const auto itReplaceField {dictItem.find("replace_field")};
-        const auto itReplaceValue {dictItem.find("replace_value")};
-
-        if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() && itReplaceValue != dictItem.end())
+        if (rule.Replace)
         {
-            const std::regex pattern {itReplacePattern->get_ref<const std::string&>()};
-            const auto fieldIt {item.find(itReplaceField->get_ref<const std::string&>())};
+            const auto fieldIt {item.find(rule.Replace->first)};
 
-            if (fieldIt != item.end())
+            if (fieldIt != item.end() && fieldIt->is_string())
             {
-                *fieldIt = std::regex_replace(
-                    fieldIt->get_ref<const std::string&>(), pattern, itReplaceValue->get_ref<const std::string&>());
+                *fieldIt = rule.Replace->second.Replace(fieldIt->get_ref<const std::string&>());
             }
         }
 
-        const auto itAddField {dictItem.find("add_field")};
-        const auto itAddValue {dictItem.find("add_value")};
-
-        if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+        if (rule.Add)
         {
-            item[itAddField->get_ref<const std::string&>()] = itAddValue->get_ref<const std::string&>();
+            item[rule.Add->first] = rule.Add->second;
         }
     }
 }
@@ -126,6 +223,94 @@ void InvNormalizer::Normalize(const std::string& type, nlohmann::json& data) con
     }
 }
 
+std::map<std::string, std::vector<InvNormalizer::Exclusion>>
+InvNormalizer::CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions)
+{
+    std::map<std::string, std::vector<Exclusion>> ret;
+
+    for (const auto& [type, exclusions] : typeExclusions)
+    {
+        for (const auto& exclusionItem : exclusions)
+        {
+            const auto pattern {GetString(exclusionItem, "pattern")};
+            const auto fieldName {GetString(exclusionItem, "field_name")};
+
+            if (!pattern || !fieldName)
+            {
+                std::cout << "Incomplete exclusion skipped: " << exclusionItem.dump() << '\n';
+                continue;
+            }
+
+            try
+            {
+                ret[type].push_back({*fieldName, Matcher {*pattern}});
+            }
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileExclusions: " << ex.what() << '\n';
+            }
+        }
+    }
+
+    return ret;
+}
+
+std::map<std::string, std::vector<InvNormalizer::DictionaryRule>>
+InvNormalizer::CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary)
+{
+    std::map<std::string, std::vector<DictionaryRule>> ret;
+
+    for (const auto& [type, dictionary] : typeDictionary)
+    {
+        for (const auto& dictItem : dictionary)
+        {
+            const auto findPattern {GetString(dictItem, "find_pattern")};
+            const auto findField {GetString(dictItem, "find_field")};
+
+            // we won't evaluate an incomplete item.
+            if ((findPattern == nullptr) != (findField == nullptr))
+            {
+                continue;
+            }
+
+            try
+            {
+                DictionaryRule rule;
+
+                if (findPattern)
+                {
+                    rule.Find.emplace(*findField, Matcher {*findPattern});
+                }
+
+                const auto replacePattern {GetString(dictItem, "replace_pattern")};
+                const auto replaceField {GetString(dictItem, "replace_field")};
+                const auto replaceValue {GetString(dictItem, "replace_value")};
+
+                if (replacePattern && replaceField && replaceValue)
+                {
+                    rule.Replace.emplace(*replaceField, Replacer {*replacePattern, *replaceValue});
+                }
+
+                const auto addField {GetString(dictItem, "add_field")};
+                const auto addValue {GetString(dictItem, "add_value")};
+
+                if (addField && addValue)
+                {
+                    rule.Add.emplace(*addField, *addValue);
+                }
+
+                ret[type].push_back(std::move(rule));
+            }
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileDictionary: " << ex.what() << '\n';
+            }
+        }
+    }
+
+    return ret;
+}
+
 std::map<std::string, nlohmann::json>
 InvNormalizer::GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type)
 {
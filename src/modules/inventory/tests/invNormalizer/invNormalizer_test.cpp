@@ -4,6 +4,9 @@
 #include "test_input.hpp"
 #include <cstdio>
 #include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
 
 void InvNormalizerTest::SetUp()
 {
@@ -235,6 +238,82 @@ TEST_F(InvNormalizerTest, normalizeItemMatch)
     EXPECT_NE(inputJson, origJson);
 }
 
+TEST_F(InvNormalizerTest, excludeAdjacentItems)
+{
+    auto inputJson(nlohmann::json::parse(R"([{"name":"Siri"},{"name":"iCloud"},{"name":"FaceTime"}])"));
+    const InvNormalizer normalizer {TEST_CONFIG_FILE_NAME, "macos"};
+    normalizer.RemoveExcluded("packages", inputJson);
+    EXPECT_EQ(inputJson, nlohmann::json::parse(R"([{"name":"FaceTime"}])"));
+}
+
+TEST_F(InvNormalizerTest, invalidPatternIsSkipped)
+{
+    constexpr auto INVALID_PATTERN_FILE {"invalid_pattern.json"};
+    std::ofstream testConfigFile {INVALID_PATTERN_FILE};
+
+    if (testConfigFile.is_open())
+    {
+        testConfigFile << R"({"dictionary":[
+            {"target":"macos","data_type":"packages","find_field":"name","find_pattern":"(Zoom","add_field":"vendor",
+             "add_value":"Zoom"},
+            {"target":"macos","data_type":"packages","find_field":"name","find_pattern":"Zoom.*","add_field":"vendor",
+             "add_value":"Zoom Video"}]})";
+        testConfigFile.close();
+    }
+
+    auto inputJson(nlohmann::json::parse(R"({"name":"Zoom Workplace"})"));
+    const InvNormalizer normalizer {INVALID_PATTERN_FILE, "macos"};
+    normalizer.Normalize("packages", inputJson);
+    EXPECT_EQ(inputJson["vendor"], "Zoom Video");
+    std::remove(INVALID_PATTERN_FILE);
+}
+
+TEST(InvNormalizerMatcherTest, matchesAsRegex)
+{
+    const std::vector<std::string> patterns {
+        "(Siri)", "Siri", ".*Microsoft.*", ".*(Quick ).*", "Kaspersky.*", ".*Mac", "zoom.us", ".*", "(a)(b)", "a|b"};
+    const std::vector<std::string> values {
+        "", "Siri", "Siri ", "Microsoft", "A Microsoft app", "Microsoft\nEdge", "Quick Heal", "QuickHeal", "Kaspersky",
+        "Kaspersky For Mac", "Mac", "zoomXus", "zoom.us", "ab", "a", "b"};
+
+    for (const auto& pattern : patterns)
+    {
+        const InvNormalizer::Matcher matcher {pattern};
+        const std::regex regex {pattern};
+
+        for (const auto& value : values)
+        {
+            EXPECT_EQ(matcher.Match(value), std::regex_match(value, regex)) << pattern << " / " << value;
+        }
+    }
+}
+
+TEST(InvNormalizerMatcherTest, replacesAsRegex)
+{
+    const std::vector<std::pair<std::string, std::string>> rules {
+        {"( For Mac)", ""}, {"(Antivirus)", "Anti-Virus"}, {"(AVG)", "[$1]"}, {"(zoom.us)", "zoom"}, {"a", "aa"}};
+    const std::vector<std::string> values {
+        "", "McAfee For Mac", "For Mac For Mac", "AntivirusAntivirus", "AVG AVG", "zoom.us zoomXus", "banana"};
+
+    for (const auto& [pattern, replacement] : rules)
+    {
+        const InvNormalizer::Replacer replacer {pattern, replacement};
+        const std::regex regex {pattern};
+
+        for (const auto& value : values)
+        {
+            EXPECT_EQ(replacer.Replace(value), std::regex_replace(value, regex, replacement))
+                << pattern << " / " << value;
+        }
+    }
+}
+
+TEST(InvNormalizerMatcherTest, invalidPatternThrows)
+{
+    EXPECT_THROW(InvNormalizer::Matcher {"(Siri"}, std::regex_error);
+    EXPECT_THROW((InvNormalizer::Replacer {"[Siri", ""}), std::regex_error);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,6 +1,8 @@
 #include "inventoryImp_test.hpp"
 #include "inventory.hpp"
+#include <atomic>
 #include <cstdio>
+#include <future>
 #include <gtest/gtest.h>
 
 constexpr auto INVENTORY_DB_PATH {"TEMP.db"};
@@ -39,6 +41,16 @@ public:
     MOCK_METHOD(nlohmann::json, hotfixes, (), (override));
 };
 
+class IncrementalSysInfoWrapper : public SysInfoWrapper
+{
+public:
+    MOCK_METHOD(nlohmann::json, packageSources, (), (override));
+    MOCK_METHOD(void,
+                sourcePackages,
+                (const std::set<std::string>&, std::function<void(nlohmann::json&)>),
+                (override));
+};
+
 class CallbackMock
 {
 public:
@@ -192,6 +204,78 @@ TEST_F(InventoryImpTest, intervalSeconds)
     }
 }
 
+TEST_F(InventoryImpTest, collectorIntervals)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    std::atomic<int> portScans {0};
+    std::promise<void> portsScannedPromise;
+    const auto portsScanned {portsScannedPromise.get_future().share()};
+
+    EXPECT_CALL(*spInfoWrapper, hardware()).Times(0);
+    EXPECT_CALL(*spInfoWrapper, os()).Times(0);
+    EXPECT_CALL(*spInfoWrapper, networks()).Times(0);
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_)).Times(0);
+    EXPECT_CALL(*spInfoWrapper, hotfixes()).Times(0);
+    EXPECT_CALL(*spInfoWrapper, ports())
+        .Times(::testing::AtLeast(3))
+        .WillRepeatedly(
+            [&portScans, &portsScannedPromise]()
+            {
+                if (++portScans == 3)
+                {
+                    portsScannedPromise.set_value();
+                }
+
+                return nlohmann::json::parse(
+                    R"([{"inode":0,"local_ip":"127.0.0.1","scan_time":"2020/12/28 21:49:50", "local_port":631,"pid":0,"process_name":"System Idle Process","protocol":"tcp","remote_ip":"0.0.0.0","remote_port":0,"rx_queue":0,"state":"listening","tx_queue":0}])");
+            });
+    // The package scan doesn't finish until the ports have been scanned three times, so a slow collector must not
+    // delay the scans of the other ones
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(1)
+        .WillOnce(
+            [portsScanned](const std::function<void(nlohmann::json&)>& callback)
+            {
+                auto package {
+                    R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json};
+                portsScanned.wait();
+                callback(package);
+            });
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            intervals:
+                ports: 10ms
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: true
+            ports_all: true
+            processes: false
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, ReportFunction, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    portsScanned.wait();
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
 TEST_F(InventoryImpTest, noScanOnStart)
 {
     const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
@@ -1320,6 +1404,83 @@ TEST_F(InventoryImpTest, PackagesDuplicated)
     }
 }
 
+TEST_F(InventoryImpTest, packagesUnchangedSourcesSkipped)
+{
+    const auto spInfoWrapper {std::make_shared<IncrementalSysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, packageSources())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(R"({"deb":"/var/lib/dpkg/status:1:10:1.0;","npm":""})"_json))
+        .WillRepeatedly(Return(R"({"deb":"/var/lib/dpkg/status:2:10:2.0;","npm":""})"_json));
+    // The first scan reads every package, the next ones only the formats whose source changed since the last one
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(1)
+        .WillOnce(::testing::DoAll(
+            ::testing::InvokeArgument<0>(
+                R"({"architecture":"amd64","name":"xserver-xorg","size":4111222333,"version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json),
+            ::testing::InvokeArgument<0>(
+                R"({"architecture":" ","name":"npm-package","size":1234,"version":"1.0.0","format":"npm","location":"/usr/lib/node_modules/npm-package/package.json"})"_json)));
+    EXPECT_CALL(*spInfoWrapper, sourcePackages(std::set<std::string> {"deb"}, testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<1>(
+            R"({"architecture":"amd64","name":"xserver-xorg","size":4111222333,"version":"1:7.7+19ubuntu15","format":"deb","location":" "})"_json));
+
+    CallbackMock wrapper;
+    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
+                                                          {
+                                                              auto delta = nlohmann::json::parse(data);
+                                                              delta["data"].erase("@timestamp");
+                                                              delta["metadata"].erase("id");
+                                                              delta.erase("stateless");
+                                                              wrapper.callbackMock(delta.dump());
+                                                          }};
+
+    const auto expectedResult1 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":4111222333,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"package":{"architecture":" ","description":null,"installed":null,"name":"npm-package","path":"/usr/lib/node_modules/npm-package/package.json","size":1234,"type":"npm","version":"1.0.0"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult3 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":4111222333,"type":"deb","version":"1:7.7+19ubuntu15"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult4 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":4111222333,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"delete"}})"};
+
+    EXPECT_CALL(wrapper, callbackMock(expectedResult1)).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(expectedResult2)).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(expectedResult3)).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(expectedResult4)).Times(1);
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackData]()
+                   {
+                       Inventory::Instance().Init(spInfoWrapper, callbackData, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {2500});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
 TEST_F(InventoryImpTest, hashId)
 {
     const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
@@ -0,0 +1,136 @@
+#include <file_reader.hpp>
+#include <logcollector.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+    constexpr size_t DEFAULT_FILES = 1000;
+    constexpr size_t SAMPLES = 100;
+    constexpr std::time_t READ_INTERVAL_MS = 500;
+    constexpr std::time_t RELOAD_INTERVAL_MS = 60000;
+    constexpr auto IDLE_TIME = std::chrono::seconds(5);
+    constexpr auto STARTUP_TIME = std::chrono::seconds(1);
+
+    /// @brief Logcollector that records the time the last log was pushed, optionally polling the files
+    class BenchmarkLogcollector : public logcollector::Logcollector
+    {
+    public:
+        explicit BenchmarkLogcollector(bool poll)
+            : m_poll(poll)
+        {
+            SetPushMessageFunction(
+                [this](const Message&)
+                {
+                    m_pushed.store(std::chrono::steady_clock::now().time_since_epoch().count());
+                    return 1;
+                });
+        }
+
+        ~BenchmarkLogcollector() override = default;
+
+        /// @brief Polls instead of waiting for a change, as the reader did before watching files
+        boost::asio::awaitable<void> WaitForChange(const std::string& path,
+                                                   std::chrono::milliseconds pollInterval,
+                                                   std::chrono::milliseconds maxWait) override
+        {
+            if (m_poll)
+            {
+                co_await Wait(pollInterval);
+            }
+            else
+            {
+                co_await Logcollector::WaitForChange(path, pollInterval, maxWait);
+            }
+        }
+
+        bool m_poll;
+        std::atomic<std::chrono::steady_clock::rep> m_pushed = 0;
+    };
+
+    /// @brief Gets the CPU time used by the process
+    double CpuSeconds()
+    {
+        timespec time {};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+    }
+
+    /// @brief Watches the files, measures the CPU used while they are idle, then the time from writing a log
+    /// to pushing it
+    void Run(const char* label, const std::filesystem::path& directory, size_t files, bool poll)
+    {
+        BenchmarkLogcollector logcollector(poll);
+        logcollector.AddReader(std::make_shared<logcollector::FileReader>(
+            logcollector, (directory / "*.log").string(), READ_INTERVAL_MS, RELOAD_INTERVAL_MS));
+
+        std::thread ioThread([&logcollector]() { logcollector.Start(); });
+        std::this_thread::sleep_for(STARTUP_TIME);
+
+        const auto cpuStart = CpuSeconds();
+        std::this_thread::sleep_for(IDLE_TIME);
+        const auto idleCpu = (CpuSeconds() - cpuStart) / std::chrono::duration<double>(IDLE_TIME).count();
+
+        double totalLatency = 0;
+        double maxLatency = 0;
+
+        for (size_t i = 0; i < SAMPLES; ++i)
+        {
+            const auto path = directory / (std::to_string(i * files / SAMPLES) + ".log");
+            const auto before = logcollector.m_pushed.load();
+
+            std::ofstream(path, std::ios::app) << "sample " << i << "\n";
+            const auto written = std::chrono::steady_clock::now();
+
+            while (logcollector.m_pushed.load() == before)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+
+            const auto pushed = std::chrono::steady_clock::time_point(
+                std::chrono::steady_clock::duration(logcollector.m_pushed.load()));
+            const auto latency = std::chrono::duration<double, std::milli>(pushed - written).count();
+
+            totalLatency += latency;
+            maxLatency = std::max(maxLatency, latency);
+        }
+
+        logcollector.Stop();
+        ioThread.join();
+
+        std::printf("%-8s %6zu files %8.2f%% idle CPU %10.2f ms mean latency %10.2f ms max latency\n",
+                    label,
+                    files,
+                    idleCpu * 100,
+                    totalLatency / SAMPLES,
+                    maxLatency);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t files = argc > 1 ? std::stoul(argv[1]) : DEFAULT_FILES;
+    const auto directory = std::filesystem::temp_directory_path() / "benchmark_file_watch";
+
+    std::filesystem::create_directories(directory);
+
+    for (size_t i = 0; i < files; ++i)
+    {
+        std::ofstream(directory / (std::to_string(i) + ".log"));
+    }
+
+    Run("polling", directory, files, true);
+    Run("watched", directory, files, false);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
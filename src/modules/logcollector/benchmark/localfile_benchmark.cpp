@@ -0,0 +1,107 @@
+#include <config.h>
+#include <file_reader.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t DEFAULT_SIZE_MB = 512;
+    constexpr size_t MEGABYTE = 1024 * 1024;
+    constexpr size_t SHORT_LINE_SIZE = 120;
+    constexpr size_t LONG_LINE_SIZE = 16 * 1024;
+
+    /// @brief Line reader as Localfile implemented it before block reads: one getline call per line into a
+    /// buffer allocated for each line. The buffer size must exceed the longest line, otherwise the reader stalls.
+    class GetlineReader
+    {
+    public:
+        GetlineReader(const std::string& filename, size_t bufferSize)
+            : m_stream(std::make_shared<std::ifstream>(filename))
+            , m_bufferSize(bufferSize)
+        {
+        }
+
+        std::string NextLog()
+        {
+            auto buffer = std::vector<char>(m_bufferSize);
+
+            if (m_stream->getline(buffer.data(), static_cast<std::streamsize>(m_bufferSize)).good())
+            {
+                m_pos = m_stream->tellg();
+                return {buffer.data(), static_cast<size_t>(m_stream->gcount()) - 1};
+            }
+
+            m_stream->seekg(m_pos);
+            m_stream->clear();
+            return {};
+        }
+
+    private:
+        std::shared_ptr<std::ifstream> m_stream;
+        size_t m_bufferSize;
+        std::streampos m_pos;
+    };
+
+    void WriteLog(const std::filesystem::path& path, size_t bytes, size_t lineSize)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        std::string line(lineSize - 1, 'x');
+        line += '\n';
+
+        for (size_t written = 0; written < bytes; written += line.size())
+        {
+            line[written % (lineSize - 1)] = static_cast<char>('a' + written % 26);
+            file << line;
+        }
+    }
+
+    template<typename Reader>
+    void Run(const char* label, const std::filesystem::path& path, Reader& reader)
+    {
+        size_t logs = 0;
+        size_t bytes = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto log = reader.NextLog(); !log.empty(); log = reader.NextLog())
+        {
+            ++logs;
+            bytes += log.size();
+        }
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto megabytes = static_cast<double>(std::filesystem::file_size(path)) / MEGABYTE;
+
+        std::printf("%-20s %12zu logs %14zu bytes %10.1f MB/s\n", label, logs, bytes, megabytes / seconds);
+    }
+
+    void Compare(const char* name, const std::filesystem::path& path, size_t bytes, size_t lineSize)
+    {
+        WriteLog(path, bytes, lineSize);
+
+        GetlineReader getlineReader(path.string(), std::max<size_t>(config::logcollector::BUFFER_SIZE, lineSize + 1));
+        Run((std::string(name) + " getline").c_str(), path, getlineReader);
+
+        logcollector::Localfile localfile(path.string());
+        Run((std::string(name) + " block").c_str(), path, localfile);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t sizeMB = argc > 1 ? std::stoul(argv[1]) : DEFAULT_SIZE_MB;
+    const auto path = std::filesystem::temp_directory_path() / "benchmark_localfile.log";
+
+    Compare("short lines", path, sizeMB * MEGABYTE, SHORT_LINE_SIZE);
+    Compare("long lines", path, sizeMB * MEGABYTE, LONG_LINE_SIZE);
+
+    std::filesystem::remove(path);
+    return 0;
+}
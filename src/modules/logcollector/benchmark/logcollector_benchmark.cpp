@@ -0,0 +1,109 @@
+#include <file_reader.hpp>
+#include <logcollector.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    constexpr size_t DEFAULT_SIZE_MB = 2048;
+    constexpr size_t MEGABYTE = 1024 * 1024;
+    constexpr size_t BATCH_SIZE = 65536;
+    constexpr std::time_t BATCH_INTERVAL_MS = 1000;
+
+    /// @brief Logcollector that counts the pushed logs and stops the reader once the file is read
+    class BenchmarkLogcollector : public logcollector::Logcollector
+    {
+    public:
+        BenchmarkLogcollector()
+        {
+            SetPushMessageFunction(
+                [this](const Message& message)
+                {
+                    m_logs += message.data.is_array() ? message.data.size() : 1;
+                    ++m_pushes;
+                    return 1;
+                });
+        }
+
+        /// @brief The reader only waits when it reaches the end of the file
+        boost::asio::awaitable<void> Wait(std::chrono::milliseconds) override
+        {
+            m_reader->Stop();
+            co_return;
+        }
+
+        boost::asio::awaitable<void>
+        WaitForChange(const std::string&, std::chrono::milliseconds pollInterval, std::chrono::milliseconds) override
+        {
+            co_await Wait(pollInterval);
+        }
+
+        logcollector::FileReader* m_reader = nullptr;
+        size_t m_logs = 0;
+        size_t m_pushes = 0;
+    };
+
+    /// @brief Writes a synthetic nginx access log
+    void WriteLog(const std::filesystem::path& path, size_t bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        size_t written = 0;
+
+        for (size_t i = 0; written < bytes; ++i)
+        {
+            const auto line = "192.168.1." + std::to_string(i % 255) +
+                              R"( - - [22/Jan/2025:18:45:01 -0300] "GET /api/v1/items/)" + std::to_string(i) +
+                              R"( HTTP/1.1" 200 )" + std::to_string(i % 4096) +
+                              R"( "-" "Mozilla/5.0 (X11; Linux x86_64; rv:134.0) Gecko/20100101 Firefox/134.0")" + "\n";
+            file << line;
+            written += line.size();
+        }
+    }
+
+    /// @brief Reads the whole file through FileReader
+    void Run(const char* label, const std::filesystem::path& path, size_t batchSize)
+    {
+        BenchmarkLogcollector logcollector;
+        logcollector::FileReader reader(logcollector, path.string(), 0, 0, batchSize, BATCH_INTERVAL_MS);
+        logcollector::Localfile localfile(path.string());
+        logcollector.m_reader = &reader;
+
+        boost::asio::io_context ioContext;
+        boost::asio::co_spawn(ioContext, reader.ReadLocalfile(&localfile), boost::asio::detached);
+
+        const auto start = std::chrono::steady_clock::now();
+        ioContext.run();
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto megabytes = static_cast<double>(std::filesystem::file_size(path)) / MEGABYTE;
+
+        std::printf("%-8s %12zu logs %12.0f logs/s %8.1f MB/s %10zu pushes\n",
+                    label,
+                    logcollector.m_logs,
+                    static_cast<double>(logcollector.m_logs) / seconds,
+                    megabytes / seconds,
+                    logcollector.m_pushes);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t sizeMB = argc > 1 ? std::stoul(argv[1]) : DEFAULT_SIZE_MB;
+    const auto path = std::filesystem::temp_directory_path() / "benchmark_logcollector.log";
+
+    WriteLog(path, sizeMB * MEGABYTE);
+
+    Run("per-log", path, 0);
+    Run("batched", path, BATCH_SIZE);
+
+    std::filesystem::remove(path);
+    return 0;
+}
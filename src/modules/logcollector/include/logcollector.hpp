@@ -17,6 +17,12 @@ namespace logcollector
     /// @brief Interface for log readers
     class IReader;
 
+    /// @brief Watcher of file changes
+    class FileWatcher;
+
+    /// @brief Batch of logs read from a source
+    class LogBatch;
+
     /// @brief Logcollector module class
     ///
     /// This module is responsible for collecting logs from various sources and processing them.
@@ -57,6 +63,16 @@ namespace logcollector
         /// @pre The message queue must be set with SetMessageQueue
         virtual void SendMessage(const std::string& location, const std::string& log, const std::string& collectorType);
 
+        /// @brief Pushes the logs of a batch to the queue, removing them from the batch
+        ///
+        /// The queue only takes messages it has space for as a whole, so a batch it rejects is pushed in
+        /// smaller parts. The logs that do not fit are kept in the batch to be pushed later.
+        ///
+        /// @param batch Batch to push
+        /// @return True if every log was pushed, false if the queue is full
+        /// @pre The message queue must be set with SetPushMessageFunction
+        virtual bool PushBatch(LogBatch& batch);
+
         /// @brief Enqueues an ASIO task (coroutine)
         /// @param task Task to enqueue
         virtual void EnqueueTask(boost::asio::awaitable<void> task);
@@ -70,6 +86,22 @@ namespace logcollector
         /// @param ms Time to wait in milliseconds
         virtual boost::asio::awaitable<void> Wait(std::chrono::milliseconds ms);
 
+        /// @brief Waits for a file or directory to change
+        ///
+        /// On Linux, the path is watched through inotify, and the wait ends as soon as it changes, or after the
+        /// maximum wait as a safety net. Where the path cannot be watched, it is polled.
+        ///
+        /// @param path File or directory to wait on
+        /// @param pollInterval Time to wait if the path cannot be watched
+        /// @param maxWait Maximum time to wait for a change of a watched path
+        virtual boost::asio::awaitable<void> WaitForChange(const std::string& path,
+                                                           std::chrono::milliseconds pollInterval,
+                                                           std::chrono::milliseconds maxWait);
+
+        /// @brief Stops watching a file or directory that is no longer read, releasing its inotify watch
+        /// @param path File or directory waited on through \ref WaitForChange
+        void StopWatching(const std::string& path);
+
         /// @brief Gets the instance of the Logcollector module
         /// @return Instance of the Logcollector module
         static Logcollector& Instance()
@@ -109,6 +141,9 @@ namespace logcollector
         /// @brief Boost ASIO context
         boost::asio::io_context m_ioContext;
 
+        /// @brief Watcher of file changes, created on the first wait for a change
+        std::shared_ptr<FileWatcher> m_fileWatcher;
+
         /// @brief List of readers
         std::list<std::shared_ptr<IReader>> m_readers;
 
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <exception>
 #include <fstream>
 #include <list>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <logcollector.hpp>
 #include <reader.hpp>
@@ -29,17 +33,21 @@ namespace logcollector
         Localfile(std::shared_ptr<std::istream> stream);
 
         /// @brief Gets the next log from the file
-        /// @return A log, or an empty string if the end of the file has been reached
-        std::string NextLog();
+        ///
+        /// The file is read in blocks of config::logcollector::BUFFER_SIZE bytes. Empty lines are skipped, and
+        /// lines longer than config::logcollector::MAX_LOG_SIZE are split into several logs.
+        ///
+        /// @return A log, or an empty view if there is no complete line left. The view is valid until the next
+        /// call to a method of this object
+        std::string_view NextLog();
 
         /// @brief Seeks to the end of the file
         void SeekEnd();
 
         /// @brief Checks if the file has been rotated
         ///
-        /// This method checks if the file has been rotated by comparing the current
-        /// size of the file with the reading position. If the file size is lower
-        /// than the reading position, the file has been rotated.
+        /// The file has been rotated if its path leads to a different file than the one opened (on Unix, a
+        /// different device or inode), or if its size is lower than the reading position, as when it is truncated.
         ///
         /// @return True if the file has been rotated, false otherwise
         bool Rotated();
@@ -55,14 +63,44 @@ namespace logcollector
         }
 
     private:
+        /// @brief Reads the next block of the file into the buffer
+        ///
+        /// The unconsumed data is moved to the front of the buffer first, the buffer grows if it is full.
+        ///
+        /// @return True if any data was read
+        bool FillBuffer();
+
+        /// @brief Discards the buffered data
+        void ResetBuffer();
+
+        /// @brief Gets the identity of the file a path leads to
+        /// @param filename File name
+        /// @return Device and inode of the file, or zeros if they are unknown
+        static std::pair<uintmax_t, uintmax_t> FileIdentity(const std::string& filename);
+
         /// @brief File name
         std::string m_filename;
 
+        /// @brief Identity of the file opened, taken before opening it so that a rotation in between is detected
+        std::pair<uintmax_t, uintmax_t> m_identity {};
+
         /// @brief Shared pointer to the input stream
         std::shared_ptr<std::istream> m_stream;
 
-        /// @brief Current position in the file
-        std::streampos m_pos;
+        /// @brief Position in the file up to which data has been read into the buffer
+        uintmax_t m_offset = 0;
+
+        /// @brief Buffer the file is read into, reused between reads
+        std::vector<char> m_buffer;
+
+        /// @brief Start of the data not returned yet
+        size_t m_begin = 0;
+
+        /// @brief Position from which to look for the next newline
+        size_t m_searchFrom = 0;
+
+        /// @brief End of the data in the buffer
+        size_t m_end = 0;
     };
 
     /// @brief File reader class
@@ -79,7 +117,14 @@ namespace logcollector
         /// @param pattern File pattern
         /// @param fileWait File wait time in milliseconds
         /// @param reloadInterval Reload interval in milliseconds
-        FileReader(Logcollector& logcollector, std::string pattern, std::time_t fileWait, std::time_t reloadInterval);
+        /// @param batchSize Size of the logs pushed together, 0 pushes every log as it is read
+        /// @param batchInterval Maximum time a log is held in a batch, in milliseconds
+        FileReader(Logcollector& logcollector,
+                   std::string pattern,
+                   std::time_t fileWait,
+                   std::time_t reloadInterval,
+                   size_t batchSize = 0,
+                   std::time_t batchInterval = 0);
 
         /// @copydoc IReader::Run
         Awaitable Run() override;
@@ -115,6 +160,11 @@ namespace logcollector
         /// @post The file is destroyed and may not be used anymore
         void RemoveLocalfile(const std::string& filename);
 
+        /// @brief Pushes the logs held in a batch when the file is no longer read, dropping them if the queue is full
+        /// @param batch Batch of the file
+        /// @param filename File name
+        void PushPendingLogs(LogBatch& batch, const std::string& filename);
+
         /// @brief File pattern
         std::string m_filePattern;
 
@@ -127,6 +177,12 @@ namespace logcollector
         /// @brief Reload (wildcard expand) interval in milliseconds
         std::time_t m_reloadInterval;
 
+        /// @brief Size of the logs pushed together
+        size_t m_batchSize;
+
+        /// @brief Maximum time a log is held in a batch, in milliseconds
+        std::time_t m_batchInterval;
+
         /// @brief File pattern
         const std::string m_collectorType = FILE_READER_TYPE;
     };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+
+namespace logcollector
+{
+    /// @brief Watches files and directories for changes through inotify (Linux only)
+    ///
+    /// Readers subscribe the timer they wait on to a path, and the timer is canceled as soon as the path changes:
+    /// a file is modified, truncated, moved or deleted, or an entry is created in or moved into a directory.
+    /// The events are read by a coroutine running on the I/O context, so all the methods must be called from the
+    /// thread running it.
+    class FileWatcher
+    {
+    public:
+        /// @brief Constructor
+        ///
+        /// If inotify cannot be initialized, the watcher is not available and every subscription fails.
+        ///
+        /// @param ioContext I/O context the events are read on
+        explicit FileWatcher(boost::asio::io_context& ioContext);
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        /// @brief Checks whether inotify could be initialized
+        bool Available() const;
+
+        /// @brief Watches a path and subscribes a timer to its changes
+        ///
+        /// If the path changed since the last wait on it, the timer expires right away.
+        ///
+        /// @param path File or directory to watch
+        /// @param timer Timer to cancel when the path changes
+        /// @return False if the path cannot be watched, so it must be polled
+        bool Subscribe(const std::string& path, boost::asio::steady_timer& timer);
+
+        /// @brief Unsubscribes a timer
+        /// @param path Path the timer was subscribed to
+        /// @param timer Timer to unsubscribe
+        void Unsubscribe(const std::string& path, boost::asio::steady_timer& timer);
+
+        /// @brief Stops watching a path, once it is not waited on anymore
+        ///
+        /// The inotify watch is removed unless another path, like a hard link, leads to the same inode.
+        ///
+        /// @param path File or directory watched
+        void Remove(const std::string& path);
+
+        /// @brief Gets the number of paths watched
+        size_t Watched() const;
+
+    private:
+        /// @brief Watch of an inode, shared by the paths that lead to it
+        struct Watch
+        {
+            /// @brief Timers waiting for a change
+            std::list<boost::asio::steady_timer*> Waiters;
+
+            /// @brief Whether the inode changed while no timer was waiting
+            bool Changed = false;
+        };
+
+        /// @brief Reads the inotify events until the descriptor is closed
+        boost::asio::awaitable<void> ReadEvents();
+
+        /// @brief Reads the pending events and wakes the timers waiting on the paths that changed
+        void DispatchEvents();
+
+        /// @brief Wakes the timers waiting on a watch
+        /// @param wd Watch descriptor
+        /// @param mask Mask of the event
+        void Notify(int wd, uint32_t mask);
+
+        /// @brief Removes a watch, waking the timers waiting on it
+        /// @param wd Watch descriptor
+        void Forget(int wd);
+
+        /// @brief inotify descriptor, integrated with the I/O context
+        boost::asio::posix::stream_descriptor m_descriptor;
+
+        /// @brief Watches by watch descriptor
+        std::map<int, Watch> m_watches;
+
+        /// @brief Watch descriptors by path
+        std::map<std::string, int> m_paths;
+    };
+} // namespace logcollector
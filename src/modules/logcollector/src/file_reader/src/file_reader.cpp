@@ -1,10 +1,13 @@
 #include "file_reader.hpp"
 
 #include <config.h>
+#include <log_batch.hpp>
 #include <logcollector.hpp>
 #include <logger.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <string>
 
 using namespace logcollector;
@@ -12,28 +15,45 @@ using namespace logcollector;
 FileReader::FileReader(Logcollector& logcollector,
                        std::string pattern,
                        std::time_t fileWait,
-                       std::time_t reloadInterval)
+                       std::time_t reloadInterval,
+                       size_t batchSize,
+                       std::time_t batchInterval)
     : IReader(logcollector)
     , m_filePattern(std::move(pattern))
     , m_localfiles()
     , m_fileWait(fileWait)
     , m_reloadInterval(reloadInterval)
+    , m_batchSize(batchSize)
+    , m_batchInterval(batchInterval)
 {
 }
 
 Awaitable FileReader::Run()
 {
+    // Files found at startup are read from their end, files created later are read from their beginning
+    auto initialReload = true;
+    const auto directory = std::filesystem::path(m_filePattern).parent_path().string();
+
     while (m_keepRunning.load())
     {
         Reload(
             [&](Localfile& lf)
             {
-                lf.SeekEnd();
+                if (initialReload)
+                {
+                    lf.SeekEnd();
+                }
                 m_logcollector.EnqueueTask(ReadLocalfile(&lf));
             });
 
-        co_await m_logcollector.Wait(std::chrono::milliseconds(m_reloadInterval));
+        initialReload = false;
+
+        co_await m_logcollector.WaitForChange(directory,
+                                              std::chrono::milliseconds(m_reloadInterval),
+                                              std::chrono::milliseconds(m_reloadInterval));
     }
+
+    m_logcollector.StopWatching(directory);
 }
 
 void FileReader::Stop()
@@ -43,14 +63,36 @@ void FileReader::Stop()
 
 Awaitable FileReader::ReadLocalfile(Localfile* lf)
 {
+    LogBatch batch(m_logcollector.Name(),
+                   lf->Filename(),
+                   m_collectorType,
+                   m_batchSize,
+                   std::chrono::milliseconds(m_batchInterval));
+
     while (m_keepRunning.load())
     {
-        auto log = lf->NextLog();
+        // While the queue is full, the logs are left in the file and the batch is pushed again after waiting
+        auto queueFull = batch.Full() && !m_logcollector.PushBatch(batch);
+
+        while (!queueFull)
+        {
+            const auto log = lf->NextLog();
+
+            if (log.empty())
+            {
+                break;
+            }
+
+            if (batch.Add(log))
+            {
+                queueFull = !m_logcollector.PushBatch(batch);
+            }
+        }
 
-        while (!log.empty())
+        // Logs of a file that is written slowly are held until the batch interval expires
+        if (!queueFull && batch.Due())
         {
-            m_logcollector.SendMessage(lf->Filename(), log, m_collectorType);
-            log = lf->NextLog();
+            m_logcollector.PushBatch(batch);
         }
 
         try
@@ -64,15 +106,32 @@ Awaitable FileReader::ReadLocalfile(Localfile* lf)
         catch (OpenError&)
         {
             LogInfo("File inaccesible: {}", lf->Filename());
+            PushPendingLogs(batch, lf->Filename());
+            m_logcollector.StopWatching(lf->Filename());
             co_return;
         }
 
-        co_await m_logcollector.Wait(std::chrono::milliseconds(m_fileWait));
+        // Without a change notification, the file is checked again after the reload interval as a safety net,
+        // or earlier if a batch is to be due
+        const auto maxWait = batch.Empty() ? m_reloadInterval : std::min(m_reloadInterval, m_batchInterval);
+
+        co_await m_logcollector.WaitForChange(
+            lf->Filename(), std::chrono::milliseconds(m_fileWait), std::chrono::milliseconds(maxWait));
     }
 
+    PushPendingLogs(batch, lf->Filename());
+    m_logcollector.StopWatching(lf->Filename());
     RemoveLocalfile(lf->Filename());
 }
 
+void FileReader::PushPendingLogs(LogBatch& batch, const std::string& filename)
+{
+    if (!batch.Empty() && !m_logcollector.PushBatch(batch))
+    {
+        LogWarn("Message queue full, {} logs from '{}' dropped", batch.Size(), filename);
+    }
+}
+
 void FileReader::AddLocalfiles(const std::list<std::string>& paths, const std::function<void(Localfile&)>& callback)
 {
     for (auto& path : paths)
@@ -93,8 +152,8 @@ void FileReader::RemoveLocalfile(const std::string& filename)
 
 Localfile::Localfile(std::string filename)
     : m_filename(std::move(filename))
-    , m_stream(make_shared<std::ifstream>(m_filename))
-    , m_pos()
+    , m_identity(FileIdentity(m_filename))
+    , m_stream(make_shared<std::ifstream>(m_filename, std::ios::binary))
 {
     if (m_stream->fail())
     {
@@ -108,45 +167,94 @@ Localfile::Localfile(std::shared_ptr<std::istream> stream)
 {
 }
 
-std::string Localfile::NextLog()
+std::string_view Localfile::NextLog()
 {
-    auto buffer = std::vector<char>(config::logcollector::BUFFER_SIZE);
+    while (true)
+    {
+        const auto* data = m_buffer.data();
+        const auto* newline = static_cast<const char*>(
+            m_end > m_searchFrom ? std::memchr(data + m_searchFrom, '\n', m_end - m_searchFrom) : nullptr);
+
+        if (newline != nullptr)
+        {
+            const auto lineBegin = m_begin;
+            const auto lineEnd = static_cast<size_t>(newline - data);
+            m_begin = m_searchFrom = lineEnd + 1;
+
+            // Lines ending in CRLF are returned without the carriage return
+            const auto length = lineEnd - lineBegin - (lineEnd > lineBegin && data[lineEnd - 1] == '\r' ? 1 : 0);
+
+            if (length > 0)
+            {
+                return {data + lineBegin, length};
+            }
 
-    if (m_stream->getline(buffer.data(), config::logcollector::BUFFER_SIZE).good())
+            continue;
+        }
+
+        m_searchFrom = m_end;
+
+        if (m_end - m_begin >= config::logcollector::MAX_LOG_SIZE)
+        {
+            const auto lineBegin = m_begin;
+            m_begin += config::logcollector::MAX_LOG_SIZE;
+            m_searchFrom = m_begin;
+            return {data + lineBegin, config::logcollector::MAX_LOG_SIZE};
+        }
+
+        if (!FillBuffer())
+        {
+            return {};
+        }
+    }
+}
+
+bool Localfile::FillBuffer()
+{
+    if (m_begin > 0)
     {
-        m_pos = m_stream->tellg();
-        return {buffer.data(), static_cast<size_t>(m_stream->gcount()) - 1};
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_searchFrom -= m_begin;
+        m_begin = 0;
     }
-    else
+
+    if (m_buffer.size() - m_end < config::logcollector::BUFFER_SIZE)
     {
-        m_stream->seekg(m_pos);
-        m_stream->clear();
-        return {};
+        m_buffer.resize(m_end + config::logcollector::BUFFER_SIZE);
     }
+
+    m_stream->read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+    const auto bytesRead = static_cast<size_t>(m_stream->gcount());
+
+    // Reaching the end of the file is expected, data appended later is read by the next call
+    m_stream->clear();
+
+    m_end += bytesRead;
+    m_offset += bytesRead;
+    return bytesRead > 0;
 }
 
-void Localfile::SeekEnd()
+void Localfile::ResetBuffer()
 {
-    m_stream->seekg(0, std::ios::end);
+    m_begin = 0;
+    m_searchFrom = 0;
+    m_end = 0;
 }
 
-bool Localfile::Rotated()
+void Localfile::SeekEnd()
 {
-    try
-    {
-        auto fileSize = std::filesystem::file_size(m_filename);
-        auto streamSize = static_cast<uintmax_t>(m_stream->tellg());
-        return fileSize < streamSize;
-    }
-    catch (std::filesystem::filesystem_error&)
-    {
-        throw OpenError(m_filename);
-    }
+    m_stream->seekg(0, std::ios::end);
+    m_offset = static_cast<uintmax_t>(m_stream->tellg());
+    ResetBuffer();
 }
 
 void Localfile::Reopen()
 {
-    m_stream = std::make_shared<std::ifstream>(m_filename);
+    m_identity = FileIdentity(m_filename);
+    m_stream = std::make_shared<std::ifstream>(m_filename, std::ios::binary);
+    m_offset = 0;
+    ResetBuffer();
 
     if (m_stream->fail())
     {
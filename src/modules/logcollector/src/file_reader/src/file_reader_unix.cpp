@@ -5,6 +5,7 @@
 #include <logger.hpp>
 
 #include <span>
+#include <sys/stat.h>
 
 using namespace logcollector;
 
@@ -40,3 +41,36 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(localfiles, callback);
     globfree(&globResult);
 }
+
+namespace
+{
+    std::pair<uintmax_t, uintmax_t> Identity(const struct stat& fileStat)
+    {
+        return {static_cast<uintmax_t>(fileStat.st_dev), static_cast<uintmax_t>(fileStat.st_ino)};
+    }
+} // namespace
+
+std::pair<uintmax_t, uintmax_t> Localfile::FileIdentity(const std::string& filename)
+{
+    struct stat fileStat {};
+
+    if (stat(filename.c_str(), &fileStat) != 0)
+    {
+        return {};
+    }
+
+    return Identity(fileStat);
+}
+
+bool Localfile::Rotated()
+{
+    struct stat fileStat {};
+
+    if (stat(m_filename.c_str(), &fileStat) != 0)
+    {
+        throw OpenError(m_filename);
+    }
+
+    // A file moved away and replaced by a new one may have grown beyond the reading position already
+    return Identity(fileStat) != m_identity || static_cast<uintmax_t>(fileStat.st_size) < m_offset;
+}
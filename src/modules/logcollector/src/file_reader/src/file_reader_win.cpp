@@ -3,6 +3,7 @@
 #include <logcollector.hpp>
 #include <logger.hpp>
 
+#include <filesystem>
 #include <list>
 #include <string>
 #include <windows.h>
@@ -39,3 +40,21 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(files, callback);
     FindClose(hFind);
 }
+
+std::pair<uintmax_t, uintmax_t> Localfile::FileIdentity([[maybe_unused]] const std::string& filename)
+{
+    // The identity of a file is not tracked on Windows, where an open file cannot be moved nor deleted
+    return {};
+}
+
+bool Localfile::Rotated()
+{
+    try
+    {
+        return std::filesystem::file_size(m_filename) < m_offset;
+    }
+    catch (std::filesystem::filesystem_error&)
+    {
+        throw OpenError(m_filename);
+    }
+}
@@ -0,0 +1,212 @@
+#include "file_watcher.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+using namespace logcollector;
+
+namespace
+{
+    constexpr size_t EVENTS_BUFFER_SIZE = 4096;
+
+    constexpr uint32_t FILE_EVENTS = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+    constexpr uint32_t DIRECTORY_EVENTS = IN_CREATE | IN_MOVED_TO | IN_MOVE_SELF | IN_DELETE_SELF;
+} // namespace
+
+FileWatcher::FileWatcher(boost::asio::io_context& ioContext)
+    : m_descriptor(ioContext)
+{
+    const auto fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (fd < 0)
+    {
+        LogWarn("Cannot initialize inotify, files will be polled: {}", std::strerror(errno));
+        return;
+    }
+
+    m_descriptor.assign(fd);
+    boost::asio::co_spawn(ioContext, ReadEvents(), boost::asio::detached);
+}
+
+bool FileWatcher::Available() const
+{
+    return m_descriptor.is_open();
+}
+
+bool FileWatcher::Subscribe(const std::string& path, boost::asio::steady_timer& timer)
+{
+    if (!Available())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    const auto mask = std::filesystem::is_directory(path, ec) ? DIRECTORY_EVENTS : FILE_EVENTS;
+    const auto wd = inotify_add_watch(m_descriptor.native_handle(), path.c_str(), mask);
+
+    if (wd < 0)
+    {
+        LogDebug("Cannot watch '{}', it will be polled: {}", path, std::strerror(errno));
+        return false;
+    }
+
+    // A different descriptor means the path leads to a new inode, as after a rotation
+    if (const auto known = m_paths.find(path); known != m_paths.end() && known->second != wd)
+    {
+        Forget(known->second);
+    }
+
+    m_paths[path] = wd;
+    auto& watch = m_watches[wd];
+
+    if (watch.Changed)
+    {
+        watch.Changed = false;
+        timer.expires_at(boost::asio::steady_timer::time_point::min());
+    }
+
+    watch.Waiters.push_back(&timer);
+    return true;
+}
+
+void FileWatcher::Unsubscribe(const std::string& path, boost::asio::steady_timer& timer)
+{
+    const auto known = m_paths.find(path);
+
+    if (known == m_paths.end())
+    {
+        return;
+    }
+
+    if (const auto watch = m_watches.find(known->second); watch != m_watches.end())
+    {
+        watch->second.Waiters.remove(&timer);
+    }
+}
+
+void FileWatcher::Remove(const std::string& path)
+{
+    const auto known = m_paths.find(path);
+
+    if (known == m_paths.end())
+    {
+        return;
+    }
+
+    const auto wd = known->second;
+    m_paths.erase(known);
+
+    if (std::none_of(m_paths.begin(), m_paths.end(), [wd](const auto& other) { return other.second == wd; }))
+    {
+        Forget(wd);
+    }
+}
+
+size_t FileWatcher::Watched() const
+{
+    return m_paths.size();
+}
+
+boost::asio::awaitable<void> FileWatcher::ReadEvents()
+{
+    while (true)
+    {
+        boost::system::error_code ec;
+        co_await m_descriptor.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+                                         boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        // The descriptor was closed, the watcher may not exist anymore
+        if (ec)
+        {
+            co_return;
+        }
+
+        DispatchEvents();
+    }
+}
+
+void FileWatcher::DispatchEvents()
+{
+    alignas(inotify_event) std::array<char, EVENTS_BUFFER_SIZE> buffer {};
+    ssize_t length = 0;
+
+    while ((length = read(m_descriptor.native_handle(), buffer.data(), buffer.size())) > 0)
+    {
+        for (size_t offset = 0; offset + sizeof(inotify_event) <= static_cast<size_t>(length);)
+        {
+            inotify_event event {};
+            std::memcpy(&event, buffer.data() + offset, sizeof(event));
+            offset += sizeof(inotify_event) + event.len;
+
+            if ((event.mask & IN_Q_OVERFLOW) != 0)
+            {
+                LogDebug("inotify event queue overflowed, waking all file readers");
+
+                for (const auto& watch : m_watches)
+                {
+                    Notify(watch.first, event.mask);
+                }
+                continue;
+            }
+
+            Notify(event.wd, event.mask);
+        }
+    }
+}
+
+void FileWatcher::Notify(int wd, uint32_t mask)
+{
+    const auto watch = m_watches.find(wd);
+
+    if (watch == m_watches.end())
+    {
+        return;
+    }
+
+    // The kernel removed the watch, because the inode was deleted
+    if ((mask & IN_IGNORED) != 0)
+    {
+        Forget(wd);
+        return;
+    }
+
+    if (watch->second.Waiters.empty())
+    {
+        watch->second.Changed = true;
+    }
+
+    for (const auto& timer : watch->second.Waiters)
+    {
+        timer->cancel();
+    }
+}
+
+void FileWatcher::Forget(int wd)
+{
+    const auto watch = m_watches.find(wd);
+
+    if (watch == m_watches.end())
+    {
+        return;
+    }
+
+    for (const auto& timer : watch->second.Waiters)
+    {
+        timer->cancel();
+    }
+
+    inotify_rm_watch(m_descriptor.native_handle(), wd);
+    m_watches.erase(watch);
+    std::erase_if(m_paths, [wd](const auto& path) { return path.second == wd; });
+}
@@ -0,0 +1,133 @@
+#include <log_batch.hpp>
+
+#include <timeHelper.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include "file_reader.hpp"
+
+using namespace logcollector;
+
+CoarseClock::CoarseClock(std::chrono::milliseconds resolution)
+    : m_resolution(resolution)
+{
+}
+
+const std::string& CoarseClock::NowISO8601()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    if (m_now.empty() || now - m_updated >= m_resolution)
+    {
+        m_now = Utils::getCurrentISO8601();
+        m_updated = now;
+    }
+
+    return m_now;
+}
+
+LogBatch::LogBatch(std::string moduleName,
+                   std::string location,
+                   std::string collectorType,
+                   size_t maxBytes,
+                   std::chrono::milliseconds maxDelay)
+    : m_moduleName(std::move(moduleName))
+    , m_location(std::move(location))
+    , m_collectorType(std::move(collectorType))
+    , m_metadata(MakeMetadata(m_moduleName, m_collectorType))
+    , m_maxBytes(maxBytes)
+    , m_maxDelay(maxDelay)
+{
+}
+
+bool LogBatch::Add(std::string_view log)
+{
+    if (m_logs.empty())
+    {
+        m_firstAdded = std::chrono::steady_clock::now();
+    }
+
+    m_logs.push_back({std::string(log), m_clock.NowISO8601()});
+    m_bytes += log.size();
+
+    return Full();
+}
+
+bool LogBatch::Full() const
+{
+    return !m_logs.empty() && m_bytes >= m_maxBytes;
+}
+
+bool LogBatch::Due() const
+{
+    return !m_logs.empty() && std::chrono::steady_clock::now() - m_firstAdded >= m_maxDelay;
+}
+
+bool LogBatch::Empty() const
+{
+    return m_logs.empty();
+}
+
+size_t LogBatch::Size() const
+{
+    return m_logs.size();
+}
+
+Message LogBatch::MakeMessage(size_t count) const
+{
+    count = std::min(count, m_logs.size());
+
+    auto events = nlohmann::json::array();
+    events.get_ref<nlohmann::json::array_t&>().reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        events.push_back(MakeEvent(m_location, m_logs[i].Log, m_collectorType, m_logs[i].Created));
+    }
+
+    return Message(MessageType::STATELESS, std::move(events), m_moduleName, m_collectorType, m_metadata);
+}
+
+void LogBatch::Remove(size_t count)
+{
+    const auto last = m_logs.begin() + static_cast<std::ptrdiff_t>(std::min(count, m_logs.size()));
+
+    for (auto it = m_logs.begin(); it != last; ++it)
+    {
+        m_bytes -= it->Log.size();
+    }
+
+    m_logs.erase(m_logs.begin(), last);
+}
+
+nlohmann::json LogBatch::MakeEvent(const std::string& location,
+                                   std::string_view log,
+                                   const std::string& collectorType,
+                                   const std::string& created)
+{
+    auto data = nlohmann::json::object();
+
+    if (collectorType == FILE_READER_TYPE)
+    {
+        data["log"]["file"]["path"] = location;
+    }
+    else
+    {
+        data["event"]["provider"] = location;
+    }
+    data["event"]["original"] = log;
+    data["event"]["created"] = created;
+
+    return data;
+}
+
+std::string LogBatch::MakeMetadata(const std::string& moduleName, const std::string& collectorType)
+{
+    auto metadata = nlohmann::json::object();
+
+    metadata["module"] = moduleName;
+    metadata["collector"] = collectorType;
+
+    return metadata.dump();
+}
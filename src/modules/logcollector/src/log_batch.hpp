@@ -0,0 +1,141 @@
+#pragma once
+
+#include <message.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logcollector
+{
+    /// @brief Clock that formats the current time at most once per resolution period
+    ///
+    /// Logs read in a burst share the same timestamp instead of formatting the time for each of them.
+    class CoarseClock
+    {
+    public:
+        /// @brief Constructor
+        /// @param resolution Maximum time a formatted timestamp is reused for
+        explicit CoarseClock(std::chrono::milliseconds resolution = std::chrono::milliseconds(10));
+
+        /// @brief Gets the current time in ISO 8601 format, as Utils::getCurrentISO8601 does
+        /// @return The timestamp, at most one resolution period old
+        const std::string& NowISO8601();
+
+    private:
+        /// @brief Maximum time a formatted timestamp is reused for
+        std::chrono::milliseconds m_resolution;
+
+        /// @brief Time the timestamp was formatted
+        std::chrono::steady_clock::time_point m_updated;
+
+        /// @brief Last formatted timestamp
+        std::string m_now;
+    };
+
+    /// @brief Accumulates the logs read from a source to push them to the queue as a single message
+    ///
+    /// The metadata of the source is computed once, and the logs become the items of the message data array,
+    /// so that the queue stores them in a single transaction. The logs are held until the queue takes them.
+    class LogBatch
+    {
+    public:
+        /// @brief Constructor
+        /// @param moduleName Name of the module the logs are sent from
+        /// @param location Location of the logs (file path or provider)
+        /// @param collectorType Type of the collector reading the logs
+        /// @param maxBytes Size of the logs that completes a batch, 0 completes it with every log
+        /// @param maxDelay Maximum time a log is held before the batch is due
+        LogBatch(std::string moduleName,
+                 std::string location,
+                 std::string collectorType,
+                 size_t maxBytes,
+                 std::chrono::milliseconds maxDelay);
+
+        /// @brief Adds a log
+        /// @param log The log
+        /// @return True if the batch is complete and must be taken
+        bool Add(std::string_view log);
+
+        /// @brief Checks whether the logs held complete the batch
+        bool Full() const;
+
+        /// @brief Checks whether the oldest log has been held for the maximum delay
+        /// @return True if the batch is not empty and must be taken
+        bool Due() const;
+
+        /// @brief Checks whether the batch holds no logs
+        bool Empty() const;
+
+        /// @brief Gets the number of logs held
+        size_t Size() const;
+
+        /// @brief Builds the message of the oldest logs held, which are kept until they are removed
+        /// @param count Number of logs to include
+        /// @return A stateless message whose data is the array of events
+        Message MakeMessage(size_t count) const;
+
+        /// @brief Removes the oldest logs held, once they are pushed
+        /// @param count Number of logs to remove
+        void Remove(size_t count);
+
+        /// @brief Builds the event of a log
+        /// @param location Location of the log (file path or provider)
+        /// @param log The log
+        /// @param collectorType Type of the collector that read the log
+        /// @param created Time the log was collected, in ISO 8601 format
+        /// @return The event data
+        static nlohmann::json MakeEvent(const std::string& location,
+                                        std::string_view log,
+                                        const std::string& collectorType,
+                                        const std::string& created);
+
+        /// @brief Builds the metadata of the messages of a collector
+        /// @param moduleName Name of the module the logs are sent from
+        /// @param collectorType Type of the collector
+        /// @return The serialized metadata
+        static std::string MakeMetadata(const std::string& moduleName, const std::string& collectorType);
+
+    private:
+        /// @brief Log held until it is pushed
+        struct HeldLog
+        {
+            std::string Log;
+            std::string Created;
+        };
+
+        /// @brief Name of the module the logs are sent from
+        std::string m_moduleName;
+
+        /// @brief Location of the logs
+        std::string m_location;
+
+        /// @brief Type of the collector reading the logs
+        std::string m_collectorType;
+
+        /// @brief Serialized metadata, computed once
+        std::string m_metadata;
+
+        /// @brief Size of the logs that completes a batch
+        size_t m_maxBytes;
+
+        /// @brief Maximum time a log is held
+        std::chrono::milliseconds m_maxDelay;
+
+        /// @brief Logs held, oldest first
+        std::vector<HeldLog> m_logs;
+
+        /// @brief Size of the logs held
+        size_t m_bytes = 0;
+
+        /// @brief Time the oldest log held was added
+        std::chrono::steady_clock::time_point m_firstAdded;
+
+        /// @brief Clock the event timestamps are taken from
+        CoarseClock m_clock;
+    };
+} // namespace logcollector
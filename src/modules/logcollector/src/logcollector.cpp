@@ -7,18 +7,22 @@
 #include <logger.hpp>
 #include <timeHelper.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <map>
 #include <sstream>
 
 #include "file_reader.hpp"
+#include "log_batch.hpp"
 
 using namespace logcollector;
 
 namespace logcollector
 {
     constexpr int ACTIVE_READERS_WAIT_MS = 10;
+    constexpr size_t MAX_BATCH_SIZE = 10000000;
+    constexpr std::time_t MAX_BATCH_INTERVAL_MS = 60000;
 }
 
 void Logcollector::Start()
@@ -84,13 +88,19 @@ void Logcollector::SetupFileReader(const std::shared_ptr<const configuration::Co
     const auto reloadInterval = configurationParser->GetTimeConfigOrDefault(
         config::logcollector::DEFAULT_RELOAD_INTERVAL, "logcollector", "reload_interval");
 
+    const auto batchSize = configurationParser->GetBytesConfigInRangeOrDefault(
+        config::logcollector::DEFAULT_BATCH_SIZE, 0, MAX_BATCH_SIZE, "logcollector", "batch_size");
+
+    const auto batchInterval = configurationParser->GetTimeConfigInRangeOrDefault(
+        config::logcollector::DEFAULT_BATCH_INTERVAL, 1, MAX_BATCH_INTERVAL_MS, "logcollector", "batch_interval");
+
     const auto localFilesDefault = std::vector<std::string> {config::logcollector::DEFAULT_LOCALFILES};
 
     const auto localfiles = configurationParser->GetConfigOrDefault(localFilesDefault, "logcollector", "localfiles");
 
     for (const auto& lf : localfiles)
     {
-        AddReader(std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval));
+        AddReader(std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval, batchSize, batchInterval));
     }
 }
 
@@ -133,27 +143,47 @@ void Logcollector::SendMessage(const std::string& location, const std::string& l
         throw std::runtime_error("Message queue not set, cannot send message.");
     }
 
-    auto metadata = nlohmann::json::object();
-    auto data = nlohmann::json::object();
+    auto message = Message(MessageType::STATELESS,
+                           LogBatch::MakeEvent(location, log, collectorType, Utils::getCurrentISO8601()),
+                           m_moduleName,
+                           collectorType,
+                           LogBatch::MakeMetadata(m_moduleName, collectorType));
+    m_pushMessage(message);
 
-    metadata["module"] = m_moduleName;
-    metadata["collector"] = collectorType;
+    LogTrace("Message pushed: '{}':'{}'", location, log);
+}
 
-    if (collectorType == FILE_READER_TYPE)
+bool Logcollector::PushBatch(LogBatch& batch)
+{
+    if (!m_pushMessage)
     {
-        data["log"]["file"]["path"] = location;
+        throw std::runtime_error("Message queue not set, cannot send message.");
     }
-    else
+
+    auto count = batch.Size();
+
+    while (!batch.Empty())
     {
-        data["event"]["provider"] = location;
-    }
-    data["event"]["original"] = log;
-    data["event"]["created"] = Utils::getCurrentISO8601();
+        count = std::min(count, batch.Size());
 
-    auto message = Message(MessageType::STATELESS, data, m_moduleName, collectorType, metadata.dump());
-    m_pushMessage(message);
+        if (m_pushMessage(batch.MakeMessage(count)) > 0)
+        {
+            batch.Remove(count);
+            LogTrace("{} messages pushed", count);
+        }
+        else if (count > 1)
+        {
+            // The queue has no space for the whole message, half of it may fit
+            count /= 2;
+        }
+        else
+        {
+            LogDebug("Message queue full, {} messages held", batch.Size());
+            return false;
+        }
+    }
 
-    LogTrace("Message pushed: '{}':'{}'", location, log);
+    return true;
 }
 
 void Logcollector::AddReader(std::shared_ptr<IReader> reader)
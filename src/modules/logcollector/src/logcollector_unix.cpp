@@ -1,8 +1,13 @@
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <config.h>
+#include <file_watcher.hpp>
 #include <journald_reader.hpp>
 #include <logcollector.hpp>
+#include <logger.hpp>
 
 #include <memory>
+#include <mutex>
 
 namespace logcollector
 {
@@ -54,4 +59,51 @@ namespace logcollector
         }
     }
 
+    boost::asio::awaitable<void> Logcollector::WaitForChange(const std::string& path,
+                                                             std::chrono::milliseconds pollInterval,
+                                                             std::chrono::milliseconds maxWait)
+    {
+        if (m_ioContext.stopped())
+        {
+            co_return;
+        }
+
+        if (!m_fileWatcher)
+        {
+            m_fileWatcher = std::make_shared<FileWatcher>(m_ioContext);
+        }
+
+        auto timer = boost::asio::steady_timer(m_ioContext, maxWait);
+
+        if (!m_fileWatcher->Subscribe(path, timer))
+        {
+            co_await Wait(pollInterval);
+            co_return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(m_timersMutex);
+            m_timers.push_back(&timer);
+        }
+
+        // The watcher cancels the timer when the path changes
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        m_fileWatcher->Unsubscribe(path, timer);
+
+        {
+            const std::lock_guard<std::mutex> lock(m_timersMutex);
+            m_timers.remove(&timer);
+        }
+    }
+
+    void Logcollector::StopWatching(const std::string& path)
+    {
+        if (m_fileWatcher)
+        {
+            m_fileWatcher->Remove(path);
+        }
+    }
+
 } // namespace logcollector
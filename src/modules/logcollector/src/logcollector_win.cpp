@@ -29,4 +29,13 @@ namespace logcollector
         }
     }
 
+    boost::asio::awaitable<void> Logcollector::WaitForChange([[maybe_unused]] const std::string& path,
+                                                             std::chrono::milliseconds pollInterval,
+                                                             [[maybe_unused]] std::chrono::milliseconds maxWait)
+    {
+        co_await Wait(pollInterval);
+    }
+
+    void Logcollector::StopWatching([[maybe_unused]] const std::string& path) {}
+
 } // namespace logcollector
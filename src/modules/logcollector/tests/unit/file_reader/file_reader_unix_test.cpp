@@ -1,8 +1,12 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
 #include <gtest/gtest.h>
 #include <list>
 #include <spdlog/spdlog.h>
 #include <sstream>
 
+#include <config.h>
 #include <file_reader.hpp>
 #include <logcollector.hpp>
 #include <logcollector_mock.hpp>
@@ -10,6 +14,14 @@
 
 using namespace logcollector;
 
+namespace
+{
+    Awaitable NoWait()
+    {
+        co_return;
+    }
+} // namespace
+
 class MockCallback
 {
 public:
@@ -40,6 +52,45 @@ TEST(Localfile, PartialLine)
     ASSERT_EQ(answer, "Hello World");
 }
 
+TEST(Localfile, MultipleLinesInOneRead)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    *stream << "first\n\nsecond\r\nthird\nfour";
+    ASSERT_EQ(lf.NextLog(), "first");
+    ASSERT_EQ(lf.NextLog(), "second");
+    ASSERT_EQ(lf.NextLog(), "third");
+    ASSERT_EQ(lf.NextLog(), "");
+
+    *stream << "th\n";
+    ASSERT_EQ(lf.NextLog(), "fourth");
+    ASSERT_EQ(lf.NextLog(), "");
+}
+
+TEST(Localfile, LineLongerThanBuffer)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    const auto longLine = std::string(config::logcollector::BUFFER_SIZE * 3 + 1, 'x');
+    *stream << longLine << "\nshort\n";
+
+    ASSERT_EQ(lf.NextLog(), longLine);
+    ASSERT_EQ(lf.NextLog(), "short");
+}
+
+TEST(Localfile, LineLongerThanMaxLogSizeIsSplit)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    *stream << std::string(config::logcollector::MAX_LOG_SIZE, 'a') << "bc\n";
+
+    ASSERT_EQ(lf.NextLog(), std::string(config::logcollector::MAX_LOG_SIZE, 'a'));
+    ASSERT_EQ(lf.NextLog(), "bc");
+}
+
 TEST(Localfile, OpenError)
 {
     try
@@ -65,6 +116,24 @@ TEST(Localfile, Rotated)
     ASSERT_TRUE(lf.Rotated());
 }
 
+TEST(Localfile, RotatedWhenReplaced)
+{
+    auto fileA = TempFile("/tmp/A.log", "Hello World");
+    auto lf = Localfile("/tmp/A.log");
+
+    lf.SeekEnd();
+    std::filesystem::rename("/tmp/A.log", "/tmp/A.log.1");
+    auto newFileA = TempFile("/tmp/A.log", "A new file larger than the old one\n");
+
+    ASSERT_TRUE(lf.Rotated());
+
+    lf.Reopen();
+    ASSERT_FALSE(lf.Rotated());
+    ASSERT_EQ(lf.NextLog(), "A new file larger than the old one");
+
+    std::filesystem::remove("/tmp/A.log.1");
+}
+
 TEST(Localfile, Deleted)
 {
     auto fileA = std::make_unique<TempFile>("/tmp/A.log", "Hello World");
@@ -104,3 +173,113 @@ TEST(FileReader, Reload)
     auto d = TempFile("/tmp/fileD.log");
     reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
 }
+
+TEST(FileReader, ReadLocalfilePushesBatches)
+{
+    spdlog::default_logger()->sinks().clear();
+    auto file = TempFile("/tmp/batch.log", "first\nsecond\nthird\n");
+
+    PushMessageMock pushMock;
+    LogcollectorMock logcollector;
+    logcollector.SetPushMessageFunction([&pushMock](Message message) { return pushMock.Call(std::move(message)); });
+
+    // Two logs complete a batch, the third one is pushed when the reader stops
+    FileReader reader(logcollector, file.Path(), 500, 60000, 10, 60000); // NOLINT
+    Localfile lf(file.Path());
+
+    std::vector<size_t> batchSizes;
+    EXPECT_CALL(pushMock, Call(::testing::_))
+        .Times(2)
+        .WillRepeatedly(::testing::Invoke(
+            [&batchSizes](const Message& message)
+            {
+                batchSizes.push_back(message.data.size());
+                return 1;
+            }));
+
+    EXPECT_CALL(logcollector, Wait(::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&reader](std::chrono::milliseconds)
+            {
+                reader.Stop();
+                return NoWait();
+            }));
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(ioContext, reader.ReadLocalfile(&lf), boost::asio::detached);
+    ioContext.run();
+
+    ASSERT_EQ(batchSizes, (std::vector<size_t> {2, 1}));
+}
+
+TEST(FileReader, ReadLocalfileHoldsLogsWhileTheQueueIsFull)
+{
+    spdlog::default_logger()->sinks().clear();
+    auto file = TempFile("/tmp/queue_full.log", "first\nsecond\nthird\n");
+
+    PushMessageMock pushMock;
+    LogcollectorMock logcollector;
+    logcollector.SetPushMessageFunction([&pushMock](Message message) { return pushMock.Call(std::move(message)); });
+
+    FileReader reader(logcollector, file.Path(), 500, 60000, 10, 60000); // NOLINT
+    Localfile lf(file.Path());
+
+    auto queueFull = true;
+    std::vector<size_t> batchSizes;
+    EXPECT_CALL(pushMock, Call(::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&queueFull, &batchSizes](const Message& message)
+            {
+                if (queueFull)
+                {
+                    return 0;
+                }
+                batchSizes.push_back(message.data.size());
+                return static_cast<int>(message.data.size());
+            }));
+
+    // The third log is not read until the queue takes the first batch
+    EXPECT_CALL(logcollector, Wait(::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&queueFull](std::chrono::milliseconds)
+            {
+                queueFull = false;
+                return NoWait();
+            }))
+        .WillOnce(::testing::Invoke(
+            [&reader, &batchSizes](std::chrono::milliseconds)
+            {
+                EXPECT_EQ(batchSizes, (std::vector<size_t> {2}));
+                reader.Stop();
+                return NoWait();
+            }));
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(ioContext, reader.ReadLocalfile(&lf), boost::asio::detached);
+    ioContext.run();
+
+    ASSERT_EQ(batchSizes, (std::vector<size_t> {2, 1}));
+}
+
+TEST(FileReader, ReadLocalfileWaitsForFileChanges)
+{
+    spdlog::default_logger()->sinks().clear();
+    auto file = TempFile("/tmp/wait.log", "log\n");
+
+    LogcollectorMock logcollector;
+    FileReader reader(logcollector, file.Path(), 500, 60000); // NOLINT
+    Localfile lf(file.Path());
+
+    EXPECT_CALL(logcollector,
+                WaitForChange(file.Path(), std::chrono::milliseconds(500), std::chrono::milliseconds(60000)))
+        .WillOnce(::testing::Invoke(
+            [&reader](const std::string&, std::chrono::milliseconds, std::chrono::milliseconds)
+            {
+                reader.Stop();
+                return NoWait();
+            }));
+
+    boost::asio::io_context ioContext;
+    boost::asio::co_spawn(ioContext, reader.ReadLocalfile(&lf), boost::asio::detached);
+    ioContext.run();
+}
@@ -0,0 +1,171 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+#include <file_watcher.hpp>
+#include <tempfile.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+
+using namespace logcollector;
+
+namespace
+{
+    constexpr auto TEST_TIMEOUT = std::chrono::seconds(5);
+
+    /// @brief Waits on a path while an action is run, and checks whether the wait ended before the timeout
+    bool WokenBy(const std::string& path, const std::function<void()>& action)
+    {
+        boost::asio::io_context ioContext;
+        FileWatcher watcher(ioContext);
+        boost::asio::steady_timer timer(ioContext, std::chrono::hours(1));
+        auto woken = false;
+
+        if (!watcher.Subscribe(path, timer))
+        {
+            return false;
+        }
+
+        boost::asio::co_spawn(
+            ioContext,
+            [&]() -> boost::asio::awaitable<void>
+            {
+                boost::system::error_code ec;
+                co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                watcher.Unsubscribe(path, timer);
+                woken = true;
+            },
+            boost::asio::detached);
+
+        ioContext.poll();
+        action();
+
+        const auto deadline = std::chrono::steady_clock::now() + TEST_TIMEOUT;
+
+        while (!woken && std::chrono::steady_clock::now() < deadline)
+        {
+            ioContext.run_one_for(std::chrono::milliseconds(100));
+        }
+
+        return woken;
+    }
+} // namespace
+
+TEST(FileWatcher, Available)
+{
+    boost::asio::io_context ioContext;
+    FileWatcher watcher(ioContext);
+
+    ASSERT_TRUE(watcher.Available());
+}
+
+TEST(FileWatcher, WakesOnModification)
+{
+    auto file = TempFile("/tmp/watched.log");
+
+    ASSERT_TRUE(WokenBy(file.Path(), [&file]() { file.Write("log\n"); }));
+}
+
+TEST(FileWatcher, WakesOnTruncation)
+{
+    auto file = TempFile("/tmp/watched.log", "log\n");
+
+    ASSERT_TRUE(WokenBy(file.Path(), [&file]() { file.Truncate(); }));
+}
+
+TEST(FileWatcher, WakesOnRename)
+{
+    auto file = TempFile("/tmp/watched.log", "log\n");
+
+    ASSERT_TRUE(WokenBy(file.Path(), []() { std::filesystem::rename("/tmp/watched.log", "/tmp/watched.log.1"); }));
+
+    std::filesystem::remove("/tmp/watched.log.1");
+}
+
+TEST(FileWatcher, WakesOnCreationInDirectory)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "file_watcher_test";
+    std::filesystem::create_directories(directory);
+
+    ASSERT_TRUE(WokenBy(directory.string(), [&directory]() { TempFile((directory / "new.log").string()); }));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, ChangeWhileNotWaitingExpiresNextWait)
+{
+    spdlog::default_logger()->sinks().clear();
+    auto file = TempFile("/tmp/watched.log");
+
+    boost::asio::io_context ioContext;
+    FileWatcher watcher(ioContext);
+    boost::asio::steady_timer timer(ioContext, std::chrono::hours(1));
+
+    ASSERT_TRUE(watcher.Subscribe(file.Path(), timer));
+    watcher.Unsubscribe(file.Path(), timer);
+
+    file.Write("log\n");
+    ioContext.run_for(std::chrono::milliseconds(100));
+
+    ASSERT_TRUE(watcher.Subscribe(file.Path(), timer));
+    ASSERT_LE(timer.expiry(), std::chrono::steady_clock::now());
+}
+
+TEST(FileWatcher, RotatedPathIsWatchedOnce)
+{
+    auto file = TempFile("/tmp/watched.log");
+
+    boost::asio::io_context ioContext;
+    FileWatcher watcher(ioContext);
+    boost::asio::steady_timer timer(ioContext, std::chrono::hours(1));
+
+    ASSERT_TRUE(watcher.Subscribe(file.Path(), timer));
+    watcher.Unsubscribe(file.Path(), timer);
+
+    std::filesystem::rename("/tmp/watched.log", "/tmp/watched.log.1");
+    auto newFile = TempFile("/tmp/watched.log");
+
+    ASSERT_TRUE(watcher.Subscribe(newFile.Path(), timer));
+    ASSERT_EQ(watcher.Watched(), 1);
+
+    std::filesystem::remove("/tmp/watched.log.1");
+}
+
+TEST(FileWatcher, RemovedPathIsNotWatched)
+{
+    auto file = TempFile("/tmp/watched.log");
+
+    boost::asio::io_context ioContext;
+    FileWatcher watcher(ioContext);
+    boost::asio::steady_timer timer(ioContext, std::chrono::hours(1));
+
+    ASSERT_TRUE(watcher.Subscribe(file.Path(), timer));
+    watcher.Unsubscribe(file.Path(), timer);
+    watcher.Remove(file.Path());
+    ASSERT_EQ(watcher.Watched(), 0);
+
+    // Without the watch, the change is not seen and doesn't expire the next wait
+    file.Write("log\n");
+    ioContext.run_for(std::chrono::milliseconds(100));
+
+    ASSERT_TRUE(watcher.Subscribe(file.Path(), timer));
+    ASSERT_GT(timer.expiry(), std::chrono::steady_clock::now());
+}
+
+TEST(FileWatcher, UnwatchablePath)
+{
+    spdlog::default_logger()->sinks().clear();
+
+    boost::asio::io_context ioContext;
+    FileWatcher watcher(ioContext);
+    boost::asio::steady_timer timer(ioContext, std::chrono::hours(1));
+
+    ASSERT_FALSE(watcher.Subscribe("/tmp/unexisting/*.log", timer));
+    ASSERT_EQ(watcher.Watched(), 0);
+}
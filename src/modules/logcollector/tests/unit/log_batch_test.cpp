@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <file_reader.hpp>
+#include <log_batch.hpp>
+
+#include <thread>
+
+using namespace logcollector;
+
+TEST(LogBatch, CompletesAtMaxBytes)
+{
+    LogBatch batch("logcollector", "/tmp/A.log", FILE_READER_TYPE, 10, std::chrono::hours(1));
+
+    ASSERT_TRUE(batch.Empty());
+    ASSERT_FALSE(batch.Add("12345"));
+    ASSERT_TRUE(batch.Add("67890"));
+    ASSERT_EQ(batch.Size(), 2);
+}
+
+TEST(LogBatch, ZeroMaxBytesCompletesWithEveryLog)
+{
+    LogBatch batch("logcollector", "/tmp/A.log", FILE_READER_TYPE, 0, std::chrono::hours(1));
+
+    ASSERT_TRUE(batch.Add("log"));
+}
+
+TEST(LogBatch, MakeMessageBuildsArrayMessage)
+{
+    LogBatch batch("logcollector", "/tmp/A.log", FILE_READER_TYPE, 1000, std::chrono::hours(1));
+
+    batch.Add("first");
+    batch.Add("second");
+
+    const auto message = batch.MakeMessage(batch.Size());
+
+    ASSERT_EQ(message.type, MessageType::STATELESS);
+    ASSERT_EQ(message.moduleName, "logcollector");
+    ASSERT_EQ(message.moduleType, FILE_READER_TYPE);
+    ASSERT_EQ(message.metaData, R"({"collector":"file","module":"logcollector"})");
+    ASSERT_TRUE(message.data.is_array());
+    ASSERT_EQ(message.data.size(), 2);
+    ASSERT_EQ(message.data[0]["log"]["file"]["path"], "/tmp/A.log");
+    ASSERT_EQ(message.data[0]["event"]["original"], "first");
+    ASSERT_EQ(message.data[1]["event"]["original"], "second");
+    ASSERT_TRUE(message.data[1]["event"].contains("created"));
+    ASSERT_EQ(batch.Size(), 2);
+}
+
+TEST(LogBatch, RemoveKeepsNewerLogs)
+{
+    LogBatch batch("logcollector", "/tmp/A.log", FILE_READER_TYPE, 10, std::chrono::hours(1));
+
+    batch.Add("12345");
+    ASSERT_TRUE(batch.Add("67890"));
+
+    batch.Remove(1);
+
+    ASSERT_FALSE(batch.Full());
+    ASSERT_EQ(batch.Size(), 1);
+    ASSERT_EQ(batch.MakeMessage(1).data[0]["event"]["original"], "67890");
+
+    batch.Remove(1);
+
+    ASSERT_TRUE(batch.Empty());
+    ASSERT_FALSE(batch.Add("third"));
+}
+
+TEST(LogBatch, DueAfterMaxDelay)
+{
+    LogBatch batch("logcollector", "/tmp/A.log", FILE_READER_TYPE, 1000, std::chrono::milliseconds(1));
+
+    ASSERT_FALSE(batch.Due());
+
+    batch.Add("log");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    ASSERT_TRUE(batch.Due());
+}
+
+TEST(LogBatch, MakeEventProvider)
+{
+    const auto event = LogBatch::MakeEvent("Audit", "log", "windows-eventlog", "2025-01-22T21:45:01.916Z");
+
+    ASSERT_EQ(event["event"]["provider"], "Audit");
+    ASSERT_EQ(event["event"]["original"], "log");
+    ASSERT_EQ(event["event"]["created"], "2025-01-22T21:45:01.916Z");
+    ASSERT_FALSE(event.contains("log"));
+}
+
+TEST(CoarseClock, ReusesTimestampWithinResolution)
+{
+    CoarseClock clock(std::chrono::hours(1));
+
+    const auto first = clock.NowISO8601();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    ASSERT_FALSE(first.empty());
+    ASSERT_EQ(clock.NowISO8601(), first);
+}
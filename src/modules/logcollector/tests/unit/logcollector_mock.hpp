@@ -20,8 +20,14 @@ namespace logcollector
                 .WillByDefault(
                     ::testing::Invoke([](std::chrono::milliseconds) -> boost::asio::awaitable<void> { co_return; }));
 
+            // Waits for a change are polls, so that tests expecting waits keep working
+            ON_CALL(*this, WaitForChange(::testing::_, ::testing::_, ::testing::_))
+                .WillByDefault(::testing::Invoke(
+                    [this](const std::string&, std::chrono::milliseconds pollInterval, std::chrono::milliseconds)
+                    { return this->Wait(pollInterval); }));
+
             this->SetPushMessageFunction([](Message) -> int // NOLINT(performance-unnecessary-value-param)
-                                         { return 0; });
+                                         { return 1; });
         }
 
         void SetupFileReader(std::shared_ptr<const configuration::ConfigurationParser> configurationParser)
@@ -32,6 +38,12 @@ namespace logcollector
         MOCK_METHOD(void, AddReader, (std::shared_ptr<IReader> reader), (override));
         MOCK_METHOD(void, EnqueueTask, (Awaitable task), (override));
         MOCK_METHOD(boost::asio::awaitable<void>, Wait, (std::chrono::milliseconds ms), (override));
+        MOCK_METHOD(boost::asio::awaitable<void>,
+                    WaitForChange,
+                    (const std::string& path,
+                     std::chrono::milliseconds pollInterval,
+                     std::chrono::milliseconds maxWait),
+                    (override));
     };
 
     class PushMessageMock
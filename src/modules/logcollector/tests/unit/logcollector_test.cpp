@@ -3,6 +3,7 @@
 #include <configuration_parser.hpp>
 #include <file_reader.hpp>
 #include <gtest/gtest.h>
+#include <log_batch.hpp>
 #include <regex>
 
 using namespace configuration;
@@ -103,6 +104,74 @@ TEST(Logcollector, SendMessageApp)
     ASSERT_EQ(capturedMessage.metaData, METADATA);
 }
 
+TEST(Logcollector, PushBatch)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    Message capturedMessage(MessageType::STATELESS, nlohmann::json::object(), "", "", "");
+
+    EXPECT_CALL(mock, Call(::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SaveArg<0>(&capturedMessage), ::testing::Return(2)));
+
+    const auto LOG = "test log";
+    const auto METADATA = R"({"collector":"file","module":"logcollector"})";
+
+    LogBatch batch(logcollector.Name(), "/test/location", "file", 0, std::chrono::milliseconds(0));
+    batch.Add(LOG);
+    batch.Add(LOG);
+
+    ASSERT_TRUE(logcollector.PushBatch(batch));
+    ASSERT_TRUE(batch.Empty());
+
+    ASSERT_EQ(capturedMessage.type, MessageType::STATELESS);
+    ASSERT_EQ(capturedMessage.data.size(), 2);
+    ASSERT_EQ(capturedMessage.data[0]["event"]["original"], LOG);
+    ASSERT_TRUE(IsISO8601(capturedMessage.data[1]["event"]["created"]));
+    ASSERT_EQ(capturedMessage.metaData, METADATA);
+}
+
+TEST(Logcollector, PushBatchSplitsWhatTheQueueRejects)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    // The queue has space for 3 messages, and takes whole messages only
+    size_t space = 3;
+    std::vector<size_t> pushed;
+    EXPECT_CALL(mock, Call(::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&space, &pushed](const Message& message)
+            {
+                if (message.data.size() > space)
+                {
+                    return 0;
+                }
+                space -= message.data.size();
+                pushed.push_back(message.data.size());
+                return static_cast<int>(message.data.size());
+            }));
+
+    LogBatch batch(logcollector.Name(), "/test/location", "file", 0, std::chrono::milliseconds(0));
+    for (const auto* log : {"1", "2", "3", "4", "5"})
+    {
+        batch.Add(log);
+    }
+
+    ASSERT_FALSE(logcollector.PushBatch(batch));
+    ASSERT_EQ(pushed, (std::vector<size_t> {2, 1}));
+    ASSERT_EQ(batch.Size(), 2);
+    ASSERT_EQ(batch.MakeMessage(1).data[0]["event"]["original"], "4");
+
+    space = 2;
+    ASSERT_TRUE(logcollector.PushBatch(batch));
+    ASSERT_TRUE(batch.Empty());
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -12,6 +12,10 @@ using logcollector::Logcollector;
 namespace
 {
     constexpr int MODULES_START_WAIT_SECS = 60;
+    constexpr int MODULES_STOP_WAIT_SECS = 60;
+
+    /// @brief Section with the settings shared by all the modules, like the data path
+    const std::string SHARED_SECTION = "agent";
 }
 
 ModuleManager::ModuleManager(const std::function<int(Message)>& pushMessage,
@@ -63,26 +67,60 @@ std::shared_ptr<ModuleWrapper> ModuleManager::GetModule(const std::string& name)
 
 void ModuleManager::Start()
 {
-    const std::lock_guard<std::mutex> lock(m_mutex);
+    const std::lock_guard<std::mutex> lifecycleLock(m_lifecycleMutex);
+
+    std::vector<std::shared_ptr<ModuleWrapper>> modules;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_taskManager.Start(m_modules.size());
+
+        for (const auto& [_, module] : m_modules)
+        {
+            modules.push_back(module);
+        }
+    }
 
-    m_taskManager.Start(m_modules.size());
+    StartModules(modules);
+}
 
+void ModuleManager::StartModules(const std::vector<std::shared_ptr<ModuleWrapper>>& modules)
+{
     m_started.store(0);
 
-    for (const auto& [_, module] : m_modules)
     {
-        m_taskManager.EnqueueTask(
-            [this, module]
-            {
-                ++m_started;
-                module->Start();
-            },
-            module->Name());
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& module : modules)
+        {
+            const auto name = module->Name();
+            auto returned = std::make_shared<std::promise<void>>();
+            m_running[name] = returned->get_future().share();
+
+            m_taskManager.EnqueueTask(
+                [this, module, returned]
+                {
+                    ++m_started;
+
+                    try
+                    {
+                        module->Start();
+                    }
+                    catch (...)
+                    {
+                        returned->set_value();
+                        throw;
+                    }
+                    returned->set_value();
+                },
+                name);
+        }
     }
 
     const auto start = std::chrono::steady_clock::now();
 
-    while (m_started.load() != static_cast<int>(m_modules.size()))
+    while (m_started.load() != static_cast<int>(modules.size()))
     {
         const auto end = std::chrono::steady_clock::now();
         const auto elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(end - start);
@@ -96,7 +134,7 @@ void ModuleManager::Start()
         std::this_thread::sleep_for(sleepTime);
     }
 
-    if (m_started.load() != static_cast<int>(m_modules.size()))
+    if (m_started.load() != static_cast<int>(modules.size()))
     {
         LogError("Error when starting some modules. Modules started: {}", m_started.load());
     }
@@ -114,6 +152,7 @@ void ModuleManager::Setup()
 
 void ModuleManager::Stop()
 {
+    const std::lock_guard<std::mutex> lifecycleLock(m_lifecycleMutex);
     const std::lock_guard<std::mutex> lock(m_mutex);
 
     for (const auto& [_, module] : m_modules)
@@ -121,4 +160,115 @@ void ModuleManager::Stop()
         module->Stop();
     }
     m_taskManager.Stop();
+    m_running.clear();
+}
+
+void ModuleManager::Reload(const std::set<std::string>& changedSections)
+{
+    const std::lock_guard<std::mutex> lifecycleLock(m_lifecycleMutex);
+
+    std::vector<std::shared_ptr<ModuleWrapper>> modules;
+    std::map<std::string, std::shared_future<void>> running;
+    size_t modulesCount = 0;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        modulesCount = m_modules.size();
+
+        for (const auto& [name, module] : m_modules)
+        {
+            if (changedSections.contains(name) || changedSections.contains(SHARED_SECTION))
+            {
+                modules.push_back(module);
+
+                if (const auto it = m_running.find(name); it != m_running.end())
+                {
+                    running.emplace(name, it->second);
+                }
+            }
+        }
+    }
+
+    if (modules.empty())
+    {
+        LogInfo("No module affected by the configuration change, {} modules kept running", modulesCount);
+        return;
+    }
+
+    const auto elapsedMs = [](std::chrono::steady_clock::time_point& since)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - since).count();
+        since = now;
+        return elapsed;
+    };
+
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    for (const auto& module : modules)
+    {
+        LogDebug("Stopping module {} to apply its configuration change", module->Name());
+        module->Stop();
+    }
+
+    // The module state can only be set up again once its Start has returned, which also leaves its task manager
+    // thread free for the new one. A module that doesn't stop in time is left as it is
+    const auto deadline = phaseStart + std::chrono::seconds(MODULES_STOP_WAIT_SECS);
+    std::vector<std::shared_ptr<ModuleWrapper>> stopped;
+
+    for (const auto& module : modules)
+    {
+        const auto name = module->Name();
+
+        if (const auto it = running.find(name);
+            it != running.end() && it->second.wait_until(deadline) == std::future_status::timeout)
+        {
+            LogError("Module {} didn't stop in {} seconds, its configuration change is not applied",
+                     name,
+                     MODULES_STOP_WAIT_SECS);
+            continue;
+        }
+
+        stopped.push_back(module);
+    }
+
+    // The task manager releases the thread of a task right after it returns
+    while (m_taskManager.GetNumEnqueuedThreads() + stopped.size() > modulesCount)
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            LogError("Task manager threads of the stopped modules not released in {} seconds",
+                     MODULES_STOP_WAIT_SECS);
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto stopMs = elapsedMs(phaseStart);
+
+    if (stopped.empty())
+    {
+        return;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& module : stopped)
+        {
+            module->Setup(m_configurationParser);
+        }
+    }
+    const auto setupMs = elapsedMs(phaseStart);
+
+    StartModules(stopped);
+    const auto startMs = elapsedMs(phaseStart);
+
+    LogInfo("{} of {} modules reloaded (stop {} ms, setup {} ms, start {} ms)",
+            stopped.size(),
+            modulesCount,
+            stopMs,
+            setupMs,
+            startMs);
 }
@@ -228,6 +228,111 @@ TEST_F(ModuleManagerTest, StopMultipleModules)
     manager->Stop();
 }
 
+TEST_F(ModuleManagerTest, ReloadOnlyAffectedModules)
+{
+    MockModule mockModule1, mockModule2;
+
+    EXPECT_CALL(mockModule1, Name()).WillRepeatedly(testing::Return("MockModule1"));
+    EXPECT_CALL(mockModule2, Name()).WillRepeatedly(testing::Return("MockModule2"));
+
+    EXPECT_CALL(mockModule1, Start()).Times(2);
+    EXPECT_CALL(mockModule1, Setup(testing::_)).Times(1);
+    EXPECT_CALL(mockModule1, Stop()).Times(2);
+    EXPECT_CALL(mockModule2, Start()).Times(1);
+    EXPECT_CALL(mockModule2, Setup(testing::_)).Times(0);
+    EXPECT_CALL(mockModule2, Stop()).Times(1);
+
+    manager->AddModule(mockModule1);
+    manager->AddModule(mockModule2);
+    manager->Start();
+
+    manager->Reload({"MockModule1", "events"});
+
+    manager->Stop();
+}
+
+TEST_F(ModuleManagerTest, ReloadAllModulesOnAgentSectionChange)
+{
+    MockModule mockModule1, mockModule2;
+
+    EXPECT_CALL(mockModule1, Name()).WillRepeatedly(testing::Return("MockModule1"));
+    EXPECT_CALL(mockModule2, Name()).WillRepeatedly(testing::Return("MockModule2"));
+
+    EXPECT_CALL(mockModule1, Start()).Times(2);
+    EXPECT_CALL(mockModule1, Setup(testing::_)).Times(1);
+    EXPECT_CALL(mockModule1, Stop()).Times(2);
+    EXPECT_CALL(mockModule2, Start()).Times(2);
+    EXPECT_CALL(mockModule2, Setup(testing::_)).Times(1);
+    EXPECT_CALL(mockModule2, Stop()).Times(2);
+
+    manager->AddModule(mockModule1);
+    manager->AddModule(mockModule2);
+    manager->Start();
+
+    manager->Reload({"agent"});
+
+    manager->Stop();
+}
+
+TEST_F(ModuleManagerTest, ReloadWithoutChangesKeepsModulesRunning)
+{
+    EXPECT_CALL(mockModule, Name()).WillRepeatedly(testing::Return("MockModule"));
+    EXPECT_CALL(mockModule, Start()).Times(1);
+    EXPECT_CALL(mockModule, Setup(testing::_)).Times(0);
+    EXPECT_CALL(mockModule, Stop()).Times(1);
+
+    manager->AddModule(mockModule);
+    manager->Start();
+
+    manager->Reload({});
+    manager->Reload({"events"});
+
+    manager->Stop();
+}
+
+TEST_F(ModuleManagerTest, ReloadWaitsForTheStartOfTheModuleToReturn)
+{
+    int starts = 0;
+    int stops = 0;
+    std::atomic<bool> running {false};
+
+    EXPECT_CALL(mockModule, Name()).WillRepeatedly(testing::Return("MockModule"));
+    // As the modules do, each Start runs until Stop is called
+    EXPECT_CALL(mockModule, Start())
+        .Times(2)
+        .WillRepeatedly(testing::InvokeWithoutArgs(
+            [&]()
+            {
+                running = true;
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    const int run = starts++;
+                    cv.wait(lock, [&]() { return stops > run; });
+                }
+                running = false;
+            }));
+    EXPECT_CALL(mockModule, Stop())
+        .Times(2)
+        .WillRepeatedly(testing::InvokeWithoutArgs(
+            [&]()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mtx);
+                    ++stops;
+                }
+                cv.notify_all();
+            }));
+    EXPECT_CALL(mockModule, Setup(testing::_)).WillOnce(testing::InvokeWithoutArgs([&]() { EXPECT_FALSE(running); }));
+
+    manager->AddModule(mockModule);
+    manager->Start();
+
+    manager->Reload({"MockModule"});
+    EXPECT_NE(manager->GetModule("MockModule"), nullptr);
+
+    manager->Stop();
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -10,7 +10,7 @@ def generateUUIDv7() {
 
 }
 
-def actions = [
+actions = [
     ["name": "set-group", "version": "v5.0.0", "args": ["groups": ["validYaml", "invalidYaml"]]],
     ["name": "set-group", "version": "v5.0.0", "args": ["groups": []]],
     ["name": "set-group", "version": "v5.0.0", "args": ["groups": [""]]],
@@ -23,10 +23,10 @@ def actions = [
     ["name": "fetch-config", "version": "v5.0.0", "args": ""]
 ]
 
-def numCommands = new Random().nextInt(3)
+def generateCommands() {
+    def numCommands = new Random().nextInt(3)
+    def commands = []
 
-def commands = []
-if (numCommands > 0) {
     for (int i = 0; i < numCommands; i++) {
         def action = actions[new Random().nextInt(actions.size())]
         def command = [
@@ -37,6 +37,18 @@ if (numCommands > 0) {
         ]
         commands << command
     }
+
+    return commands
+}
+
+// Long-poll: the request is held until there are commands for the agent or the wait expires
+def longPollSeconds = (System.env.COMMANDS_LONG_POLL ?: "30") as int
+def deadline = System.currentTimeMillis() + longPollSeconds * 1000L
+def commands = generateCommands()
+
+while (commands.isEmpty() && System.currentTimeMillis() < deadline) {
+    Thread.sleep(1000)
+    commands = generateCommands()
 }
 
 if (commands.isEmpty()) {